@@ -0,0 +1,8 @@
+/// <summary>
+/// Support code shared by all the standalone benchmarks, linked into each of their executables.
+/// </summary>
+
+#include <cstdio>
+
+// The prebuilt Windows libraries the engine links against still refer to the stdio streams the way older runtimes exposed them, so the benchmarks need to provide them the same way Main.cpp does for the game.
+extern "C" { FILE __iob_func[3] = { *stdin,*stdout,*stderr }; }
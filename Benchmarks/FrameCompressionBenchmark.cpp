@@ -0,0 +1,219 @@
+/// <summary>
+/// Standalone benchmark and correctness check of the multiplayer frame box compression.
+/// Loads a sequence of recorded frames, splits each into boxes like the NetworkServer does, and compresses the boxes that changed since the previous frame with every FrameBoxCodec encoding and LZ4 mode.
+/// Reports how many bytes and how much time each took, and checks that every box decompresses back to what it was.
+/// Frames are 8 bit images in the game palette, like the ones saved with FrameMan::SaveBitmapToPNG. Images in other color depths are converted to the game palette, for which the benchmark must be run from the data directory.
+/// Returns non-zero if any box didn't decompress correctly.
+/// Usage: FrameCompressionBenchmark [-box width height] [-level highCompressionLevel] [-acceleration accelerationFactor] frame...
+/// </summary>
+
+#include "System.h"
+#include "RTEError.h"
+#include "Constants.h"
+#include "FrameBoxCodec.h"
+
+using namespace RTE;
+
+namespace RTE {
+
+	/// <summary>
+	/// One way of compressing the boxes to compare.
+	/// </summary>
+	struct BenchmarkMode {
+		std::string Name; //!< The name to report the results under.
+		unsigned char AllowedEncodings; //!< The FrameBoxCodec::Encoding flags that may be used.
+		bool UseHighCompression; //!< Whether to use LZ4HC instead of fast LZ4.
+	};
+
+	/// <summary>
+	/// The results of compressing all the changed boxes in one mode.
+	/// </summary>
+	struct BenchmarkResults {
+		unsigned long long CompressedBytes = 0; //!< The total size of the boxes as they would be sent, including the ones sent as is because they didn't compress.
+		double CompressMS = 0; //!< The total time compressing the boxes took.
+		double DecompressMS = 0; //!< The total time decompressing the boxes took.
+		int FailureCount = 0; //!< How many boxes didn't decompress back to what they were.
+	};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// <summary>
+	/// Loads a recorded frame as an 8 bit bitmap in the game palette.
+	/// </summary>
+	/// <param name="framePath">The path of the image to load.</param>
+	/// <returns>The loaded frame, or nullptr if it couldn't be loaded. Ownership IS transferred!</returns>
+	BITMAP * LoadFrame(const std::string &framePath) {
+		PALETTE framePalette;
+		BITMAP *loadedFrame = load_bitmap(framePath.c_str(), framePalette);
+		if (!loadedFrame || bitmap_color_depth(loadedFrame) == 8) {
+			return loadedFrame;
+		}
+		// Blitting down to 8 bits maps every pixel to the closest color in the selected palette
+		BITMAP *frame = create_bitmap_ex(8, loadedFrame->w, loadedFrame->h);
+		blit(loadedFrame, frame, 0, 0, 0, 0, loadedFrame->w, loadedFrame->h);
+		destroy_bitmap(loadedFrame);
+		return frame;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// <summary>
+	/// Compresses and decompresses one box in one mode and adds up the results.
+	/// </summary>
+	/// <param name="mode">The mode to compress the box in.</param>
+	/// <param name="box">The pixels of the box.</param>
+	/// <param name="previousBox">The pixels of the box in the previous frame, or nullptr if it's compressed on its own.</param>
+	/// <param name="boxWidth">The width of the box.</param>
+	/// <param name="boxHeight">The height of the box.</param>
+	/// <param name="highCompressionLevel">The LZ4HC level to compress with.</param>
+	/// <param name="accelerationFactor">The acceleration factor to use for fast LZ4 compression.</param>
+	/// <param name="results">The results to add to.</param>
+	void BenchmarkBox(const BenchmarkMode &mode, const unsigned char *box, const unsigned char *previousBox, int boxWidth, int boxHeight, int highCompressionLevel, int accelerationFactor, BenchmarkResults &results) {
+		int size = boxWidth * boxHeight;
+		std::array<unsigned char, c_MaxPixelLineBufferSize> compressedBox;
+		std::array<unsigned char, c_MaxPixelLineBufferSize> decompressedBox;
+		unsigned char encoding = FrameBoxCodec::Plain;
+
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+		int compressedSize = FrameBoxCodec::Compress(box, boxWidth, boxHeight, previousBox, mode.AllowedEncodings, mode.UseHighCompression ? highCompressionLevel : 0, accelerationFactor, compressedBox.data(), size, encoding);
+		results.CompressMS += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+		if (compressedSize == 0) {
+			results.CompressedBytes += size;
+			return;
+		}
+		results.CompressedBytes += compressedSize;
+
+		startTime = std::chrono::steady_clock::now();
+		bool decompressed = FrameBoxCodec::Decompress(compressedBox.data(), compressedSize, boxWidth, boxHeight, encoding, previousBox, decompressedBox.data());
+		results.DecompressMS += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+		if (!decompressed || std::memcmp(decompressedBox.data(), box, size) != 0) { results.FailureCount++; }
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// Implementation of the main function.
+/// </summary>
+int main(int argc, char **argv) {
+	std::vector<std::string> framePaths;
+	int boxWidth = 64;
+	int boxHeight = 88;
+	// Same as the server's defaults
+	int highCompressionLevel = 10;
+	int accelerationFactor = 10;
+	for (int i = 1; i < argc; ++i) {
+		std::string currentArg = argv[i];
+		if (i + 2 < argc && currentArg == "-box") {
+			boxWidth = std::clamp(std::atoi(argv[++i]), 1, 255);
+			boxHeight = std::clamp(std::atoi(argv[++i]), 1, 255);
+		} else if (i + 1 < argc && currentArg == "-level") {
+			highCompressionLevel = std::max(std::atoi(argv[++i]), 1);
+		} else if (i + 1 < argc && currentArg == "-acceleration") {
+			accelerationFactor = std::max(std::atoi(argv[++i]), 1);
+		} else {
+			framePaths.emplace_back(currentArg);
+		}
+	}
+
+	set_config_file("Base.rte/AllegroConfig.txt");
+	allegro_init();
+	loadpng_init();
+
+	System::Initialize();
+	System::EnableLoggingToCLI();
+
+	if (framePaths.empty()) {
+		System::PrintToCLI("Usage: FrameCompressionBenchmark [-box width height] [-level highCompressionLevel] [-acceleration accelerationFactor] frame...");
+		return 1;
+	}
+	if (boxWidth * boxHeight > c_MaxPixelLineBufferSize) {
+		System::PrintToCLI("ERROR: Boxes can't be bigger than " + std::to_string(c_MaxPixelLineBufferSize) + " pixels!");
+		return 1;
+	}
+
+	set_color_conversion(COLORCONV_NONE);
+
+	PALETTE gamePalette;
+	if (BITMAP *paletteBitmap = load_bitmap("Base.rte/palette.bmp", gamePalette)) {
+		select_palette(gamePalette);
+		destroy_bitmap(paletteBitmap);
+	}
+
+	// Plain is how boxes were always compressed, the others are what the server does with prediction
+	const std::array<BenchmarkMode, 6> benchmarkModes = { {
+		{ "LZ4HC plain", FrameBoxCodec::Plain, true },
+		{ "LZ4HC up filter", FrameBoxCodec::UpFiltered, true },
+		{ "LZ4HC up filter + previous box", FrameBoxCodec::UpFiltered | FrameBoxCodec::PreviousAsDictionary, true },
+		{ "LZ4 fast plain", FrameBoxCodec::Plain, false },
+		{ "LZ4 fast up filter", FrameBoxCodec::UpFiltered, false },
+		{ "LZ4 fast up filter + previous box", FrameBoxCodec::UpFiltered | FrameBoxCodec::PreviousAsDictionary, false }
+	} };
+	std::array<BenchmarkResults, benchmarkModes.size()> benchmarkResults;
+
+	std::vector<unsigned char> box(c_MaxPixelLineBufferSize);
+	std::vector<unsigned char> previousBox(c_MaxPixelLineBufferSize);
+	BITMAP *previousFrame = nullptr;
+	int frameCount = 0;
+	int changedBoxCount = 0;
+	unsigned long long uncompressedBytes = 0;
+
+	for (const std::string &framePath : framePaths) {
+		BITMAP *frame = LoadFrame(framePath);
+		if (!frame) {
+			System::PrintToCLI("ERROR: Failed to load frame \"" + framePath + "\"!");
+			continue;
+		}
+		// Frames of a different size start over, like the server does when a client's back buffer changes
+		if (previousFrame && (previousFrame->w != frame->w || previousFrame->h != frame->h)) {
+			destroy_bitmap(previousFrame);
+			previousFrame = nullptr;
+		}
+		frameCount++;
+
+		for (int boxY = 0; boxY < frame->h; boxY += boxHeight) {
+			for (int boxX = 0; boxX < frame->w; boxX += boxWidth) {
+				int width = std::min(boxWidth, frame->w - boxX);
+				int height = std::min(boxHeight, frame->h - boxY);
+				int size = width * height;
+
+				for (int line = 0; line < height; ++line) {
+					std::memcpy(box.data() + line * width, frame->line[boxY + line] + boxX, width);
+					if (previousFrame) { std::memcpy(previousBox.data() + line * width, previousFrame->line[boxY + line] + boxX, width); }
+				}
+				// Unchanged boxes aren't sent, and empty ones are sent without any data
+				if ((previousFrame && std::memcmp(box.data(), previousBox.data(), size) == 0) || std::all_of(box.begin(), box.begin() + size, [](unsigned char pixel) { return pixel == 0; })) {
+					continue;
+				}
+				changedBoxCount++;
+				uncompressedBytes += size;
+
+				for (size_t modeIndex = 0; modeIndex < benchmarkModes.size(); ++modeIndex) {
+					BenchmarkBox(benchmarkModes[modeIndex], box.data(), previousFrame ? previousBox.data() : nullptr, width, height, highCompressionLevel, accelerationFactor, benchmarkResults[modeIndex]);
+				}
+			}
+		}
+		if (previousFrame) { destroy_bitmap(previousFrame); }
+		previousFrame = frame;
+	}
+	if (previousFrame) { destroy_bitmap(previousFrame); }
+
+	System::PrintToCLI(std::to_string(frameCount) + " frames, " + std::to_string(changedBoxCount) + " changed boxes of " + std::to_string(boxWidth) + "x" + std::to_string(boxHeight) + ", " + std::to_string(uncompressedBytes / 1024) + " KB uncompressed:");
+
+	int failureCount = 0;
+	for (size_t modeIndex = 0; modeIndex < benchmarkModes.size(); ++modeIndex) {
+		const BenchmarkResults &results = benchmarkResults[modeIndex];
+		char resultsString[512];
+		std::snprintf(resultsString, sizeof(resultsString), "  %-34s %10llu bytes, %.3f of uncompressed, %.3f of plain, %.3f ms compressing, %.3f ms decompressing per frame, %d failed",
+			benchmarkModes[modeIndex].Name.c_str(), results.CompressedBytes, uncompressedBytes > 0 ? static_cast<double>(results.CompressedBytes) / static_cast<double>(uncompressedBytes) : 0.0,
+			benchmarkResults[modeIndex < 3 ? 0 : 3].CompressedBytes > 0 ? static_cast<double>(results.CompressedBytes) / static_cast<double>(benchmarkResults[modeIndex < 3 ? 0 : 3].CompressedBytes) : 0.0,
+			frameCount > 0 ? results.CompressMS / static_cast<double>(frameCount) : 0.0, frameCount > 0 ? results.DecompressMS / static_cast<double>(frameCount) : 0.0, results.FailureCount);
+		System::PrintToCLI(resultsString);
+		failureCount += results.FailureCount;
+	}
+	System::PrintToCLI(failureCount == 0 ? "All boxes decompressed correctly." : "ERROR: " + std::to_string(failureCount) + " failed!");
+
+	return failureCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,629 @@
+/// <summary>
+/// Standalone load test of a running multiplayer server with synthetic clients.
+/// Connects a number of headless clients to the server one after another, sends it scripted or random input from each, and decodes the scene, terrain changes, frames and entity states they're sent with the same NetworkFrameDecoder NetworkClient uses, into bitmaps that are never shown.
+/// Every second, the ping, decoded frames, bytes received and decoding time of each client are printed and optionally logged to a CSV file, followed by a summary at the end. Set ServerStatsLogFile in the server's Settings.ini to log its side of the same run.
+/// The server only takes as many players as c_MaxClients, any clients beyond that are refused and reported as such.
+/// Input scripts are text files with one step per line, "milliseconds mouseX mouseY inputElement...", where the mouse values are the movement sent with every input message and the input elements are the InputElements values held during the step. Lines starting with // are skipped. The script is repeated until the test ends.
+/// Returns non-zero if any client didn't get to receive frames.
+/// Usage: MultiplayerLoadTest [-server address:port] [-clients count] [-seconds duration] [-join milliseconds] [-resolution width height] [-inputfps fps] [-input idle|random|scriptFile] [-seed seed] [-log file.csv]
+/// </summary>
+
+#include "System.h"
+#include "RTEError.h"
+#include "Constants.h"
+#include "NetworkMessages.h"
+#include "NetworkFrameDecoder.h"
+
+#include "RakPeerInterface.h"
+#include "RakNetStatistics.h"
+#include "RakSleep.h"
+
+using namespace RTE;
+
+namespace RTE {
+
+	/// <summary>
+	/// One step of the input a synthetic client sends.
+	/// </summary>
+	struct InputStep {
+		int DurationMS; //!< How long the step lasts.
+		int MouseX; //!< The horizontal mouse movement sent with every input message during the step.
+		int MouseY; //!< The vertical mouse movement sent with every input message during the step.
+		unsigned int InputElementHeld; //!< The InputElements held during the step, as bit flags like in MsgInput.
+	};
+
+	/// <summary>
+	/// What a synthetic client measured, either over the last second or over the whole test.
+	/// </summary>
+	struct LoadTestStats {
+		int Seconds = 0; //!< How many seconds the client received frames for.
+		unsigned long long BytesReceived = 0; //!< The total size of the messages received.
+		unsigned long long LinkBytesReceived = 0; //!< The total size of what was received by RakNet, including its own headers and acknowledgements.
+		int FramesDecoded = 0; //!< How many frames were received, counted by their MsgFrameSetup.
+		int BoxesDecoded = 0; //!< How many frame boxes and lines were decoded.
+		int BoxesFailed = 0; //!< How many frame boxes couldn't be decoded, because they were corrupt or the version they were compressed against was lost.
+		int TerrainChanges = 0; //!< How many terrain changes were applied.
+		int EntityStates = 0; //!< How many entity states were decoded.
+		double DecodeMS = 0; //!< The total time decoding frames, terrain changes and entity states took.
+		double MaxFrameIntervalMS = 0; //!< The longest time between two frames.
+		unsigned long long PingTotal = 0; //!< The total of the pings sampled once a second, to average them by Seconds.
+		int MaxPing = 0; //!< The highest ping sampled.
+	};
+
+	/// <summary>
+	/// A headless multiplayer client that keeps up its end of the protocol like NetworkClient, without drawing anything or playing any sound.
+	/// </summary>
+	class LoadTestClient {
+
+	public:
+
+		/// <summary>
+		/// Enumeration for how far along joining the server the client is.
+		/// </summary>
+		enum class State { Waiting, Connecting, Registering, ReceivingScene, ReceivingFrames, Refused, Disconnected };
+
+		/// <summary>
+		/// Constructor method used to instantiate a LoadTestClient object in system memory.
+		/// </summary>
+		/// <param name="index">The index of the client, to name it by.</param>
+		/// <param name="resX">The horizontal resolution to ask the server frames in.</param>
+		/// <param name="resY">The vertical resolution to ask the server frames in.</param>
+		/// <param name="inputSteps">The input to send, looped over. Random if empty.</param>
+		LoadTestClient(int index, int resX, int resY, const std::vector<InputStep> &inputSteps);
+
+		/// <summary>
+		/// Destructor method used to clean up a LoadTestClient object before deletion from system memory.
+		/// </summary>
+		~LoadTestClient();
+
+		/// <summary>
+		/// Gets how far along joining the server the client is.
+		/// </summary>
+		/// <returns>The State of the client.</returns>
+		State GetState() const { return m_State; }
+
+		/// <summary>
+		/// Gets the time it took from starting to connect until the first frame was received.
+		/// </summary>
+		/// <returns>The time it took to join the server in milliseconds, or -1 if it didn't get that far.</returns>
+		double GetJoinMS() const { return m_JoinMS; }
+
+		/// <summary>
+		/// Gets what the client measured over the whole test.
+		/// </summary>
+		/// <returns>The stats of the whole test.</returns>
+		const LoadTestStats & GetTotalStats() const { return m_TotalStats; }
+
+		/// <summary>
+		/// Starts connecting the client to a server.
+		/// </summary>
+		/// <param name="serverAddress">The address of the server.</param>
+		/// <param name="serverPort">The port of the server.</param>
+		void Connect(const std::string &serverAddress, unsigned short serverPort);
+
+		/// <summary>
+		/// Disconnects the client from the server.
+		/// </summary>
+		void Disconnect();
+
+		/// <summary>
+		/// Handles everything received from the server and sends input if it's time to.
+		/// </summary>
+		/// <param name="inputFps">The rate to send input at.</param>
+		/// <param name="rng">The random number generator to pick random input with, if the client has no input steps.</param>
+		void Update(int inputFps, std::mt19937 &rng);
+
+		/// <summary>
+		/// Samples the ping and link statistics, adds the last second to the totals and starts a new second.
+		/// </summary>
+		/// <returns>What the client measured over the second that ended.</returns>
+		LoadTestStats EndSecond();
+
+	private:
+
+		int m_Index; //!< The index of the client.
+		int m_ResX; //!< The horizontal resolution the client asks the server frames in.
+		int m_ResY; //!< The vertical resolution the client asks the server frames in.
+		State m_State; //!< How far along joining the server the client is.
+
+		RakNet::RakPeerInterface *m_Peer; //!< The client's RakPeerInterface.
+		RakNet::SystemAddress m_ServerID; //!< The server's identifier.
+
+		std::chrono::steady_clock::time_point m_ConnectTime; //!< When the client started connecting.
+		std::chrono::steady_clock::time_point m_LastFrameTime; //!< When the last frame was received.
+		std::chrono::steady_clock::time_point m_LastInputTime; //!< When input was last sent.
+		double m_JoinMS; //!< How long it took from starting to connect until the first frame was received, or -1 if it didn't get that far.
+
+		std::vector<InputStep> m_InputSteps; //!< The input to send, looped over. Random if empty.
+		InputStep m_CurrentInput; //!< The input step currently being sent.
+		size_t m_NextInputStep; //!< The index of the input step to send after the current one.
+		double m_CurrentInputRemainingMS; //!< How long the current input step has left.
+		unsigned int m_LastInputElementHeld; //!< The input elements held in the last input message, to tell which were pressed and released since.
+		unsigned int m_InputSequence; //!< The InputSequence of the last input message.
+
+		BITMAP *m_FrameLayers[2]; //!< The frame and frame GUI layers, at the client's resolution. Owned.
+		NetworkFrameDecoder m_FrameDecoder; //!< Decodes the scene, terrain changes, frames and entity states the client is sent.
+
+		LoadTestStats m_SecondStats; //!< What the client measured over the current second.
+		LoadTestStats m_TotalStats; //!< What the client measured over the whole test, not including the current second.
+
+		/// <summary>
+		/// Handles a scene setup message by making room for the scene and accepting it.
+		/// </summary>
+		/// <param name="packet">The packet to handle.</param>
+		void ReceiveSceneSetupMsg(const RakNet::Packet *packet);
+
+		/// <summary>
+		/// Handles a frame setup message, which ends the previous frame. Decodes the frame boxes and lines of the previous frame, same as NetworkClient does when it draws it.
+		/// </summary>
+		/// <param name="packet">The packet to handle.</param>
+		void ReceiveFrameSetupMsg(const RakNet::Packet *packet);
+
+		/// <summary>
+		/// Handles a message the frame decoder decodes, measuring how long decoding it took.
+		/// </summary>
+		/// <param name="packet">The packet to handle.</param>
+		void ReceiveDecodedMsg(const RakNet::Packet *packet);
+
+		/// <summary>
+		/// Sends a message with only an ID to the server.
+		/// </summary>
+		/// <param name="messageId">The ID of the message to send.</param>
+		void SendIdMsg(unsigned char messageId);
+
+		/// <summary>
+		/// Sends the input of the current input step to the server, moving on to the next step when the current one is over.
+		/// </summary>
+		/// <param name="elapsedMS">How long it's been since input was last sent.</param>
+		/// <param name="rng">The random number generator to pick random input with, if the client has no input steps.</param>
+		void SendInputMsg(double elapsedMS, std::mt19937 &rng);
+
+		// Disallow the use of some implicit methods.
+		LoadTestClient(const LoadTestClient &reference) = delete;
+		LoadTestClient & operator=(const LoadTestClient &rhs) = delete;
+	};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	LoadTestClient::LoadTestClient(int index, int resX, int resY, const std::vector<InputStep> &inputSteps) : m_Index(index), m_ResX(resX), m_ResY(resY), m_State(State::Waiting), m_ServerID(RakNet::UNASSIGNED_SYSTEM_ADDRESS), m_JoinMS(-1), m_InputSteps(inputSteps),
+		m_CurrentInput({ 0, 0, 0, 0 }), m_NextInputStep(0), m_CurrentInputRemainingMS(0), m_LastInputElementHeld(0), m_InputSequence(0) {
+		m_Peer = RakNet::RakPeerInterface::GetInstance();
+		for (BITMAP *&frameLayer : m_FrameLayers) {
+			frameLayer = create_bitmap_ex(8, m_ResX, m_ResY);
+			clear_to_color(frameLayer, g_MaskColor);
+		}
+		m_FrameDecoder.Create(m_FrameLayers[0], m_FrameLayers[1]);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	LoadTestClient::~LoadTestClient() {
+		m_Peer->Shutdown(300);
+		RakNet::RakPeerInterface::DestroyInstance(m_Peer);
+		m_FrameDecoder.Destroy();
+		for (BITMAP *frameLayer : m_FrameLayers) {
+			destroy_bitmap(frameLayer);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void LoadTestClient::Connect(const std::string &serverAddress, unsigned short serverPort) {
+		RakNet::SocketDescriptor socketDescriptor;
+		socketDescriptor.socketFamily = AF_INET;
+		m_ConnectTime = std::chrono::steady_clock::now();
+		m_LastInputTime = m_ConnectTime;
+		if (m_Peer->Startup(1, &socketDescriptor, 1) != RakNet::RAKNET_STARTED || m_Peer->Connect(serverAddress.c_str(), serverPort, nullptr, 0) != RakNet::CONNECTION_ATTEMPT_STARTED) {
+			m_State = State::Refused;
+			return;
+		}
+		m_Peer->SetOccasionalPing(true);
+		m_State = State::Connecting;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void LoadTestClient::Disconnect() {
+		if (m_State == State::Registering || m_State == State::ReceivingScene || m_State == State::ReceivingFrames) {
+			SendIdMsg(ID_CLT_DISCONNECT);
+			m_Peer->CloseConnection(m_ServerID, true);
+		}
+		m_State = State::Disconnected;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void LoadTestClient::Update(int inputFps, std::mt19937 &rng) {
+		if (m_State == State::Waiting || m_State == State::Refused || m_State == State::Disconnected) {
+			return;
+		}
+		for (RakNet::Packet *packet = m_Peer->Receive(); packet; m_Peer->DeallocatePacket(packet), packet = m_Peer->Receive()) {
+			m_SecondStats.BytesReceived += packet->length;
+
+			switch (packet->data[0]) {
+				case ID_CONNECTION_REQUEST_ACCEPTED: {
+					m_ServerID = packet->systemAddress;
+					m_Peer->SetTimeoutTime(5000, m_ServerID);
+					MsgRegister msg = {};
+					msg.Id = ID_CLT_REGISTER;
+					msg.ResolutionX = m_ResX;
+					msg.ResolutionY = m_ResY;
+					std::snprintf(msg.Name, sizeof(msg.Name), "LoadTest %d", m_Index);
+					m_Peer->Send(reinterpret_cast<const char *>(&msg), sizeof(msg), HIGH_PRIORITY, RELIABLE_ORDERED, 0, m_ServerID, false);
+					m_State = State::Registering;
+					break;
+				}
+				case ID_NO_FREE_INCOMING_CONNECTIONS:
+				case ID_CONNECTION_ATTEMPT_FAILED:
+				case ID_CONNECTION_BANNED:
+				case ID_INCOMPATIBLE_PROTOCOL_VERSION:
+					m_State = State::Refused;
+					break;
+				case ID_DISCONNECTION_NOTIFICATION:
+				case ID_CONNECTION_LOST:
+					m_State = State::Disconnected;
+					break;
+				case ID_SRV_ACCEPTED:
+					m_FrameDecoder.ClearFrameBoxVersions();
+					m_State = State::ReceivingScene;
+					break;
+				case ID_SRV_SCENE_SETUP:
+					ReceiveSceneSetupMsg(packet);
+					break;
+				case ID_SRV_SCENE_END:
+					SendIdMsg(ID_CLT_SCENE_ACCEPTED);
+					break;
+				case ID_SRV_FRAME_SETUP:
+					ReceiveFrameSetupMsg(packet);
+					break;
+				case ID_SRV_SCENE:
+				case ID_SRV_TERRAIN:
+				case ID_SRV_FRAME_LINE:
+				case ID_SRV_FRAME_BOX:
+				case ID_SRV_ENTITY_PRESETS:
+				case ID_SRV_ENTITY_STATES:
+					ReceiveDecodedMsg(packet);
+					break;
+				default:
+					// Post-effects, sounds and music are only counted, since they'd only be of use for drawing and playing
+					break;
+			}
+		}
+
+		// Input is only sent once registered, same as NetworkClient
+		if (m_State == State::ReceivingScene || m_State == State::ReceivingFrames) {
+			std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
+			double elapsedMS = std::chrono::duration<double, std::milli>(currentTime - m_LastInputTime).count();
+			if (elapsedMS >= 1000.0 / static_cast<double>(std::max(inputFps, 1))) {
+				m_LastInputTime = currentTime;
+				SendInputMsg(elapsedMS, rng);
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	LoadTestStats LoadTestClient::EndSecond() {
+		if (m_State == State::ReceivingFrames) {
+			m_SecondStats.Seconds = 1;
+			int ping = m_Peer->GetLastPing(m_ServerID);
+			m_SecondStats.PingTotal = static_cast<unsigned long long>(std::max(ping, 0));
+			m_SecondStats.MaxPing = ping;
+		}
+		RakNet::RakNetStatistics rns;
+		if (m_ServerID != RakNet::UNASSIGNED_SYSTEM_ADDRESS && m_Peer->GetStatistics(m_ServerID, &rns)) {
+			m_SecondStats.LinkBytesReceived = rns.valueOverLastSecond[RakNet::ACTUAL_BYTES_RECEIVED];
+		}
+
+		m_TotalStats.Seconds += m_SecondStats.Seconds;
+		m_TotalStats.BytesReceived += m_SecondStats.BytesReceived;
+		m_TotalStats.LinkBytesReceived += m_SecondStats.LinkBytesReceived;
+		m_TotalStats.FramesDecoded += m_SecondStats.FramesDecoded;
+		m_TotalStats.BoxesDecoded += m_SecondStats.BoxesDecoded;
+		m_TotalStats.BoxesFailed += m_SecondStats.BoxesFailed;
+		m_TotalStats.TerrainChanges += m_SecondStats.TerrainChanges;
+		m_TotalStats.EntityStates += m_SecondStats.EntityStates;
+		m_TotalStats.DecodeMS += m_SecondStats.DecodeMS;
+		m_TotalStats.MaxFrameIntervalMS = std::max(m_TotalStats.MaxFrameIntervalMS, m_SecondStats.MaxFrameIntervalMS);
+		m_TotalStats.PingTotal += m_SecondStats.PingTotal;
+		m_TotalStats.MaxPing = std::max(m_TotalStats.MaxPing, m_SecondStats.MaxPing);
+
+		LoadTestStats secondStats = m_SecondStats;
+		m_SecondStats = LoadTestStats();
+		return secondStats;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void LoadTestClient::ReceiveSceneSetupMsg(const RakNet::Packet *packet) {
+		if (packet->length < sizeof(MsgSceneSetup)) {
+			return;
+		}
+		m_FrameDecoder.DecodeSceneSetupMsg(reinterpret_cast<const MsgSceneSetup *>(packet->data));
+		// A new scene can come at any time, after which nothing is sent but the scene until it's accepted
+		if (m_State == State::ReceivingFrames) { m_State = State::ReceivingScene; }
+		SendIdMsg(ID_CLT_SCENE_SETUP_ACCEPTED);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void LoadTestClient::ReceiveFrameSetupMsg(const RakNet::Packet *packet) {
+		std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
+		int decodedCount = m_FrameDecoder.GetDecodedFrameMsgCount();
+		int failedCount = m_FrameDecoder.GetFailedFrameMsgCount();
+		m_FrameDecoder.DecodePendingFrameMsgs();
+		if (m_FrameDecoder.DecodeFrameSetupMsg(packet->data, packet->length) < 0) {
+			return;
+		}
+		std::chrono::steady_clock::time_point decodedTime = std::chrono::steady_clock::now();
+		m_SecondStats.BoxesDecoded += m_FrameDecoder.GetDecodedFrameMsgCount() - decodedCount;
+		m_SecondStats.BoxesFailed += m_FrameDecoder.GetFailedFrameMsgCount() - failedCount;
+		m_SecondStats.DecodeMS += std::chrono::duration<double, std::milli>(decodedTime - currentTime).count();
+
+		if (m_State != State::ReceivingFrames) {
+			if (m_JoinMS < 0) { m_JoinMS = std::chrono::duration<double, std::milli>(currentTime - m_ConnectTime).count(); }
+			m_State = State::ReceivingFrames;
+		} else {
+			m_SecondStats.MaxFrameIntervalMS = std::max(m_SecondStats.MaxFrameIntervalMS, std::chrono::duration<double, std::milli>(currentTime - m_LastFrameTime).count());
+		}
+		m_LastFrameTime = currentTime;
+		m_SecondStats.FramesDecoded++;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void LoadTestClient::ReceiveDecodedMsg(const RakNet::Packet *packet) {
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+		// Boxes and lines waiting for the next frame setup can be decoded early, when one comes for the same part of the frame again
+		int decodedCount = m_FrameDecoder.GetDecodedFrameMsgCount();
+		int failedCount = m_FrameDecoder.GetFailedFrameMsgCount();
+
+		switch (packet->data[0]) {
+			case ID_SRV_SCENE:
+				m_FrameDecoder.DecodeSceneMsg(packet->data, packet->length);
+				break;
+			case ID_SRV_TERRAIN:
+				if (m_FrameDecoder.DecodeTerrainChangeMsg(packet->data, packet->length)) { m_SecondStats.TerrainChanges++; }
+				break;
+			case ID_SRV_FRAME_LINE:
+			case ID_SRV_FRAME_BOX:
+				m_FrameDecoder.QueueFrameMsg(packet->data, packet->length);
+				break;
+			case ID_SRV_ENTITY_PRESETS:
+				// The presets are only of use for drawing the entity states, so they're decoded but not looked up
+				m_FrameDecoder.DecodeEntityPresetsMsg(packet->data, packet->length, [](int, const std::string &, const std::string &, const std::string &) {});
+				break;
+			case ID_SRV_ENTITY_STATES:
+				if (m_FrameDecoder.DecodeEntityStatesMsg(packet->data, packet->length)) { m_SecondStats.EntityStates += reinterpret_cast<const MsgEntityStates *>(packet->data)->EntityCount; }
+				break;
+			default:
+				break;
+		}
+		m_SecondStats.BoxesDecoded += m_FrameDecoder.GetDecodedFrameMsgCount() - decodedCount;
+		m_SecondStats.BoxesFailed += m_FrameDecoder.GetFailedFrameMsgCount() - failedCount;
+		m_SecondStats.DecodeMS += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void LoadTestClient::SendIdMsg(unsigned char messageId) {
+		MsgRegister msg = {};
+		msg.Id = messageId;
+		m_Peer->Send(reinterpret_cast<const char *>(&msg), sizeof(msg), HIGH_PRIORITY, RELIABLE_ORDERED, 0, m_ServerID, false);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void LoadTestClient::SendInputMsg(double elapsedMS, std::mt19937 &rng) {
+		m_CurrentInputRemainingMS -= elapsedMS;
+		if (m_CurrentInputRemainingMS <= 0) {
+			if (!m_InputSteps.empty()) {
+				m_CurrentInput = m_InputSteps[m_NextInputStep];
+				m_NextInputStep = (m_NextInputStep + 1) % m_InputSteps.size();
+			} else {
+				// Hold a few of the movement, aim, fire and jump elements at a time and sweep the mouse around, like someone playing would
+				std::uniform_int_distribution<int> durationDistribution(200, 800);
+				std::uniform_int_distribution<int> mouseDistribution(-8, 8);
+				std::uniform_int_distribution<int> elementDistribution(INPUT_L_UP, INPUT_JUMP);
+				m_CurrentInput = { durationDistribution(rng), mouseDistribution(rng), mouseDistribution(rng), 0 };
+				for (int i = 0; i < 3; i++) {
+					m_CurrentInput.InputElementHeld |= 1U << elementDistribution(rng);
+				}
+			}
+			m_CurrentInputRemainingMS = static_cast<double>(m_CurrentInput.DurationMS);
+		}
+
+		MsgInput msg = {};
+		msg.Id = ID_CLT_INPUT;
+		msg.MouseX = m_CurrentInput.MouseX;
+		msg.MouseY = m_CurrentInput.MouseY;
+		msg.InputElementHeld = m_CurrentInput.InputElementHeld;
+		msg.InputElementPressed = m_CurrentInput.InputElementHeld & ~m_LastInputElementHeld;
+		msg.InputElementReleased = m_LastInputElementHeld & ~m_CurrentInput.InputElementHeld;
+		m_LastInputElementHeld = m_CurrentInput.InputElementHeld;
+		msg.InputSequence = ++m_InputSequence;
+		m_Peer->Send(reinterpret_cast<const char *>(&msg), sizeof(msg), IMMEDIATE_PRIORITY, RELIABLE_ORDERED, 0, m_ServerID, false);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// <summary>
+	/// Loads an input script.
+	/// </summary>
+	/// <param name="scriptPath">The path of the script to load.</param>
+	/// <param name="inputSteps">The vector to add the steps of the script to.</param>
+	/// <returns>Whether the script was loaded and has at least one step.</returns>
+	bool LoadInputScript(const std::string &scriptPath, std::vector<InputStep> &inputSteps) {
+		std::ifstream scriptFile(scriptPath);
+		if (!scriptFile.is_open()) {
+			return false;
+		}
+		std::string line;
+		while (std::getline(scriptFile, line)) {
+			std::istringstream lineStream(line);
+			InputStep inputStep = { 0, 0, 0, 0 };
+			if (line.compare(0, 2, "//") == 0 || !(lineStream >> inputStep.DurationMS >> inputStep.MouseX >> inputStep.MouseY) || inputStep.DurationMS <= 0) {
+				continue;
+			}
+			int inputElement = 0;
+			while (lineStream >> inputElement) {
+				if (inputElement >= 0 && inputElement < INPUT_COUNT) { inputStep.InputElementHeld |= 1U << inputElement; }
+			}
+			inputSteps.emplace_back(inputStep);
+		}
+		return !inputSteps.empty();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// <summary>
+	/// Gets the name of a client state for printing.
+	/// </summary>
+	/// <param name="state">The state to get the name of.</param>
+	/// <returns>The name of the state.</returns>
+	const char * GetStateName(LoadTestClient::State state) {
+		switch (state) {
+			case LoadTestClient::State::Waiting: return "waiting";
+			case LoadTestClient::State::Connecting: return "connecting";
+			case LoadTestClient::State::Registering: return "registering";
+			case LoadTestClient::State::ReceivingScene: return "scene";
+			case LoadTestClient::State::ReceivingFrames: return "frames";
+			case LoadTestClient::State::Refused: return "refused";
+			default: return "disconnected";
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// Implementation of the main function.
+/// </summary>
+int main(int argc, char **argv) {
+	std::string serverAddress = "127.0.0.1";
+	unsigned short serverPort = 8000;
+	int clientCount = c_MaxClients;
+	int testSeconds = 60;
+	int joinIntervalMS = 1000;
+	// Same as the game's defaults
+	int resX = 960;
+	int resY = 540;
+	int inputFps = 120;
+	std::string inputMode = "random";
+	unsigned int seed = 1;
+	std::string logPath;
+	for (int i = 1; i < argc; ++i) {
+		std::string currentArg = argv[i];
+		bool lastArg = i + 1 == argc;
+		if (!lastArg && currentArg == "-server") {
+			serverAddress = argv[++i];
+			if (std::string::size_type portPos = serverAddress.find(':'); portPos != std::string::npos) {
+				serverPort = static_cast<unsigned short>(std::atoi(serverAddress.c_str() + portPos + 1));
+				serverAddress.erase(portPos);
+			}
+		} else if (!lastArg && currentArg == "-clients") {
+			clientCount = std::max(std::atoi(argv[++i]), 1);
+		} else if (!lastArg && currentArg == "-seconds") {
+			testSeconds = std::max(std::atoi(argv[++i]), 1);
+		} else if (!lastArg && currentArg == "-join") {
+			joinIntervalMS = std::max(std::atoi(argv[++i]), 0);
+		} else if (i + 2 < argc && currentArg == "-resolution") {
+			resX = std::clamp(std::atoi(argv[++i]), 64, 4096);
+			resY = std::clamp(std::atoi(argv[++i]), 64, 4096);
+		} else if (!lastArg && currentArg == "-inputfps") {
+			inputFps = std::max(std::atoi(argv[++i]), 1);
+		} else if (!lastArg && currentArg == "-input") {
+			inputMode = argv[++i];
+		} else if (!lastArg && currentArg == "-seed") {
+			seed = static_cast<unsigned int>(std::atoi(argv[++i]));
+		} else if (!lastArg && currentArg == "-log") {
+			logPath = argv[++i];
+		}
+	}
+
+	allegro_init();
+
+	System::Initialize();
+	System::EnableLoggingToCLI();
+
+	// Idle clients send empty input, which is still worth measuring since real ones keep sending it too
+	std::vector<InputStep> inputSteps;
+	if (inputMode == "idle") {
+		inputSteps.push_back({ 1000, 0, 0, 0 });
+	} else if (inputMode != "random" && !LoadInputScript(inputMode, inputSteps)) {
+		System::PrintToCLI("ERROR: Failed to load input script \"" + inputMode + "\"!");
+		return 1;
+	}
+
+	std::ofstream logFile;
+	if (!logPath.empty()) {
+		logFile.open(logPath, std::ios::out | std::ios::trunc);
+		if (!logFile.is_open()) {
+			System::PrintToCLI("ERROR: Failed to open log file \"" + logPath + "\"!");
+			return 1;
+		}
+		logFile << "Seconds,Client,State,Ping,FramesPerSecond,MaxFrameIntervalMS,BytesReceived,LinkBytesReceived,BoxesDecoded,BoxesFailed,TerrainChanges,EntityStates,DecodeMS\n";
+	}
+
+	System::PrintToCLI("Connecting " + std::to_string(clientCount) + " clients at " + std::to_string(resX) + "x" + std::to_string(resY) + " to " + serverAddress + ":" + std::to_string(serverPort) + " for " + std::to_string(testSeconds) + " seconds, sending " + inputMode + " input at " + std::to_string(inputFps) + " fps:");
+
+	std::mt19937 rng(seed);
+	std::vector<std::unique_ptr<LoadTestClient>> clients;
+	for (int i = 0; i < clientCount; ++i) {
+		clients.emplace_back(std::make_unique<LoadTestClient>(i, resX, resY, inputSteps));
+	}
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	int elapsedSeconds = 0;
+	while (elapsedSeconds < testSeconds) {
+		double elapsedMS = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+		// Join one after another, like players would, rather than all asking for the scene at once
+		for (int i = 0; i < clientCount; ++i) {
+			if (clients[i]->GetState() == LoadTestClient::State::Waiting && elapsedMS >= static_cast<double>(i) * static_cast<double>(joinIntervalMS)) {
+				clients[i]->Connect(serverAddress, serverPort);
+			}
+			clients[i]->Update(inputFps, rng);
+		}
+
+		if (elapsedMS >= static_cast<double>(elapsedSeconds + 1) * 1000.0) {
+			elapsedSeconds++;
+			for (int i = 0; i < clientCount; ++i) {
+				LoadTestStats stats = clients[i]->EndSecond();
+				char statsString[256];
+				std::snprintf(statsString, sizeof(statsString), "%d,%d,%s,%d,%d,%.1f,%llu,%llu,%d,%d,%d,%d,%.3f", elapsedSeconds, i, GetStateName(clients[i]->GetState()), stats.MaxPing, stats.FramesDecoded, stats.MaxFrameIntervalMS,
+					stats.BytesReceived, stats.LinkBytesReceived, stats.BoxesDecoded, stats.BoxesFailed, stats.TerrainChanges, stats.EntityStates, stats.DecodeMS);
+				if (logFile.is_open()) { logFile << statsString << "\n"; }
+				std::snprintf(statsString, sizeof(statsString), "  %3ds client %d %-12s ping %4d ms, %3d fps, max %6.1f ms between frames, %7.1f KB received, %4d boxes, %3d failed, %4d terrain changes, %5d entity states, %.3f ms decoding",
+					elapsedSeconds, i, GetStateName(clients[i]->GetState()), stats.MaxPing, stats.FramesDecoded, stats.MaxFrameIntervalMS, static_cast<double>(stats.BytesReceived) / 1024.0, stats.BoxesDecoded, stats.BoxesFailed, stats.TerrainChanges, stats.EntityStates, stats.DecodeMS);
+				System::PrintToCLI(statsString);
+			}
+			if (logFile.is_open()) { logFile.flush(); }
+		}
+		RakSleep(1);
+	}
+
+	for (const std::unique_ptr<LoadTestClient> &client : clients) {
+		client->Disconnect();
+	}
+	RakSleep(250);
+
+	System::PrintToCLI("Summary:");
+	int failureCount = 0;
+	for (int i = 0; i < clientCount; ++i) {
+		const LoadTestStats &stats = clients[i]->GetTotalStats();
+		char summaryString[512];
+		if (stats.Seconds == 0) {
+			failureCount++;
+			std::snprintf(summaryString, sizeof(summaryString), "  client %d never received frames%s", i, clients[i]->GetJoinMS() < 0 && stats.BytesReceived == 0 ? ", the server may be full or not running" : "");
+		} else {
+			double seconds = static_cast<double>(stats.Seconds);
+			std::snprintf(summaryString, sizeof(summaryString), "  client %d joined in %.0f ms, average ping %.0f ms (max %d), %.1f fps, max %.1f ms between frames, %.1f KB/s received (%.1f KB/s on the link), %d of %d boxes failed, %.3f ms decoding per second",
+				i, clients[i]->GetJoinMS(), static_cast<double>(stats.PingTotal) / seconds, stats.MaxPing, static_cast<double>(stats.FramesDecoded) / seconds, stats.MaxFrameIntervalMS,
+				static_cast<double>(stats.BytesReceived) / 1024.0 / seconds, static_cast<double>(stats.LinkBytesReceived) / 1024.0 / seconds, stats.BoxesFailed, stats.BoxesDecoded + stats.BoxesFailed, stats.DecodeMS / seconds);
+		}
+		System::PrintToCLI(summaryString);
+	}
+
+	return failureCount == 0 ? 0 : 1;
+}
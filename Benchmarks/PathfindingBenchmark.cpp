@@ -0,0 +1,303 @@
+/// <summary>
+/// Standalone benchmark and correctness check of the PathFinder.
+/// Loads stored scenes, runs batches of path calculations with varied dig strengths on each, and reports the time each took, how many nodes were expanded and how the path costs compare to a reference Dijkstra search.
+/// Must be run from the data directory, like the game itself. Returns non-zero if any path turned out invalid or costs less than the reference.
+/// Usage: PathfindingBenchmark [-scene "Scene Name"]... [-queries count] [-seed seed]
+/// </summary>
+
+#include "SettingsMan.h"
+#include "PresetMan.h"
+#include "SceneMan.h"
+#include "MovableMan.h"
+#include "ActivityMan.h"
+#include "UInputMan.h"
+#include "ConsoleMan.h"
+#include "PerformanceMan.h"
+#include "PostProcessMan.h"
+#include "ThreadMan.h"
+#include "FrameMan.h"
+#include "TimerMan.h"
+#include "LuaMan.h"
+#include "AudioMan.h"
+#include "MetaMan.h"
+#include "NetworkServer.h"
+#include "NetworkClient.h"
+#include "GUISound.h"
+#include "RotatedSpriteCache.h"
+#include "PathFinder.h"
+#include "Scene.h"
+
+using namespace RTE;
+
+namespace RTE {
+
+	static constexpr std::array<float, 4> c_BenchmarkDigStrengths = { 1.0F, 35.0F, 100.0F, 300.0F }; //!< The dig strengths the queries are spread between. From not digging at all to digging through most things.
+
+	/// <summary>
+	/// The results of all the queries with one dig strength on one scene.
+	/// </summary>
+	struct BenchmarkResults {
+		int QueryCount = 0; //!< How many paths were calculated.
+		int SolvedCount = 0; //!< How many of the paths were found.
+		int FailureCount = 0; //!< How many of the paths were invalid, cost less than the reference, or weren't found when the reference found one.
+		double TotalMS = 0; //!< The total time the first calculations of the paths took.
+		double MaxMS = 0; //!< The longest time the first calculation of any path took.
+		double TotalRepeatMS = 0; //!< The total time calculating the same paths again took, with whatever the pathers cached the first time.
+		unsigned long long ExpandedNodeCount = 0; //!< The total number of nodes expanded by the first calculations of the paths.
+		double TotalCost = 0; //!< The total cost of the found paths.
+		double TotalCostRatio = 0; //!< The total of the ratios between the cost of each found path and the cost of the reference path.
+		double MaxCostRatio = 0; //!< The highest ratio between the cost of a found path and the cost of the reference path.
+	};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// <summary>
+	/// Describes a query for printing.
+	/// </summary>
+	/// <param name="start">The start position of the path.</param>
+	/// <param name="end">The end position of the path.</param>
+	/// <param name="digStrength">What material strength the path was calculated for.</param>
+	/// <returns>A description of the query.</returns>
+	std::string DescribeQuery(const Vector &start, const Vector &end, float digStrength) {
+		char queryString[128];
+		std::snprintf(queryString, sizeof(queryString), "from (%.0f, %.0f) to (%.0f, %.0f) with dig strength %.1f", start.GetX(), start.GetY(), end.GetX(), end.GetY(), digStrength);
+		return queryString;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// <summary>
+	/// Finds the least cost between two nodes with a plain Dijkstra search over the PathFinder's own node costs, to check the paths it calculates against.
+	/// </summary>
+	/// <param name="pathFinder">The PathFinder whose node costs to search over.</param>
+	/// <param name="startNode">The node to start from.</param>
+	/// <param name="endNode">The node to end at.</param>
+	/// <param name="digStrength">What material strength the search is capable of digging through.</param>
+	/// <returns>The least cost between the nodes, or -1 if the end can't be reached.</returns>
+	float CalculateReferenceCost(const PathFinder &pathFinder, PathNode *startNode, PathNode *endNode, float digStrength) {
+		using OpenNode = std::pair<float, PathNode *>;
+		std::priority_queue<OpenNode, std::vector<OpenNode>, std::greater<OpenNode>> openNodes;
+		std::unordered_map<PathNode *, float> nodeCosts;
+		std::vector<micropather::StateCost> adjacentList;
+
+		nodeCosts[startNode] = 0;
+		openNodes.emplace(0.0F, startNode);
+		while (!openNodes.empty()) {
+			auto [nodeCost, node] = openNodes.top();
+			openNodes.pop();
+			if (node == endNode) {
+				return nodeCost;
+			}
+			if (nodeCost > nodeCosts[node]) {
+				continue;
+			}
+			adjacentList.clear();
+			pathFinder.AdjacentCost(static_cast<void *>(node), &adjacentList, digStrength);
+			for (const micropather::StateCost &adjacentCost : adjacentList) {
+				PathNode *adjacentNode = static_cast<PathNode *>(adjacentCost.state);
+				float adjacentNodeCost = nodeCost + adjacentCost.cost;
+				if (std::unordered_map<PathNode *, float>::iterator costItr = nodeCosts.find(adjacentNode); costItr == nodeCosts.end() || adjacentNodeCost < costItr->second) {
+					nodeCosts[adjacentNode] = adjacentNodeCost;
+					openNodes.emplace(adjacentNodeCost, adjacentNode);
+				}
+			}
+		}
+		return -1;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// <summary>
+	/// Sums up the costs between the nodes a calculated path passes through, making sure each of them is adjacent to the one before.
+	/// </summary>
+	/// <param name="pathFinder">The PathFinder the path was calculated by.</param>
+	/// <param name="path">The waypoints of the path.</param>
+	/// <param name="digStrength">What material strength the path was calculated for.</param>
+	/// <returns>The total cost of the path, or -1 if it skips between nodes that aren't adjacent.</returns>
+	float CalculatePathCost(const PathFinder &pathFinder, const std::list<Vector> &path, float digStrength) {
+		float pathCost = 0;
+		std::vector<micropather::StateCost> adjacentList;
+		PathNode *previousNode = nullptr;
+		for (const Vector &waypoint : path) {
+			PathNode *node = pathFinder.GetNodeAt(waypoint);
+			if (previousNode && node != previousNode) {
+				adjacentList.clear();
+				pathFinder.AdjacentCost(static_cast<void *>(previousNode), &adjacentList, digStrength);
+				std::vector<micropather::StateCost>::const_iterator adjacentItr = std::find_if(adjacentList.begin(), adjacentList.end(), [&node](const micropather::StateCost &adjacentCost) { return adjacentCost.state == static_cast<void *>(node); });
+				if (adjacentItr == adjacentList.end()) {
+					return -1;
+				}
+				pathCost += adjacentItr->cost;
+			}
+			previousNode = node;
+		}
+		return pathCost;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// <summary>
+	/// Runs the benchmark queries on the currently loaded scene and prints the results for each dig strength.
+	/// </summary>
+	/// <param name="queryCount">How many paths to calculate for each dig strength.</param>
+	/// <param name="seed">The seed for picking the start and end points of the paths, so runs can be compared.</param>
+	/// <returns>The number of failed queries.</returns>
+	int RunSceneBenchmark(int queryCount, unsigned int seed) {
+		PathFinder *pathFinder = g_SceneMan.GetScene()->GetPathFinder();
+		if (!pathFinder) {
+			System::PrintToCLI("ERROR: Scene has no pathfinding set up!");
+			return 1;
+		}
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> xDistribution(0, static_cast<float>(g_SceneMan.GetSceneWidth() - 1));
+		std::uniform_real_distribution<float> yDistribution(0, static_cast<float>(g_SceneMan.GetSceneHeight() - 1));
+
+		int failureCount = 0;
+		for (float digStrength : c_BenchmarkDigStrengths) {
+			// Start and end on the ground like the AI's paths do, not somewhere up in the air
+			std::vector<std::pair<Vector, Vector>> queries;
+			queries.reserve(queryCount);
+			for (int query = 0; query < queryCount; ++query) {
+				queries.emplace_back(g_SceneMan.MovePointToGround(Vector(xDistribution(rng), yDistribution(rng)), 20, 15), g_SceneMan.MovePointToGround(Vector(xDistribution(rng), yDistribution(rng)), 20, 15));
+			}
+
+			BenchmarkResults results;
+			std::list<Vector> path;
+			float pathCost = 0;
+			for (const auto &[start, end] : queries) {
+				results.QueryCount++;
+				unsigned long long expandedNodeCountBefore = PathFinder::GetExpandedNodeCount();
+				std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+				int result = pathFinder->CalculatePath(start, end, path, pathCost, digStrength);
+				double queryMS = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+				results.ExpandedNodeCount += PathFinder::GetExpandedNodeCount() - expandedNodeCountBefore;
+				results.TotalMS += queryMS;
+				results.MaxMS = std::max(results.MaxMS, queryMS);
+
+				float referenceCost = CalculateReferenceCost(*pathFinder, pathFinder->GetNodeAt(start), pathFinder->GetNodeAt(end), digStrength);
+				if (result == micropather::MicroPather::NO_SOLUTION) {
+					if (referenceCost >= 0) {
+						System::PrintToCLI("ERROR: No path found " + DescribeQuery(start, end, digStrength) + ", but there is one!");
+						results.FailureCount++;
+					}
+					continue;
+				}
+				results.SolvedCount++;
+
+				// The cost of the path must add up from the nodes it passes through, and can't be less than the least possible
+				float summedCost = CalculatePathCost(*pathFinder, path, digStrength);
+				if (summedCost < 0 || std::abs(summedCost - pathCost) > pathCost * 0.01F + 0.1F || pathCost < referenceCost * 0.999F - 0.1F) {
+					System::PrintToCLI("ERROR: Bad path " + DescribeQuery(start, end, digStrength) + ". Cost " + std::to_string(pathCost) + ", summed " + std::to_string(summedCost) + ", reference " + std::to_string(referenceCost) + ".");
+					results.FailureCount++;
+					continue;
+				}
+				results.TotalCost += pathCost;
+				double costRatio = referenceCost > 0 ? pathCost / referenceCost : 1.0;
+				results.TotalCostRatio += costRatio;
+				results.MaxCostRatio = std::max(results.MaxCostRatio, costRatio);
+			}
+
+			// Run the same queries again to see how much whatever was cached the first time helps
+			for (const auto &[start, end] : queries) {
+				std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+				pathFinder->CalculatePath(start, end, path, pathCost, digStrength);
+				results.TotalRepeatMS += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+			}
+
+			char resultsString[512];
+			std::snprintf(resultsString, sizeof(resultsString), "  Dig strength %6.1f: %d/%d solved, %.3f ms avg (%.3f max, %.3f repeated), %.0f nodes expanded avg, %.1f cost avg, %.3f of reference cost avg (%.3f worst), %d failed",
+				digStrength, results.SolvedCount, results.QueryCount, results.TotalMS / static_cast<double>(results.QueryCount), results.MaxMS, results.TotalRepeatMS / static_cast<double>(results.QueryCount),
+				static_cast<double>(results.ExpandedNodeCount) / static_cast<double>(results.QueryCount), results.SolvedCount > 0 ? results.TotalCost / static_cast<double>(results.SolvedCount) : 0.0,
+				results.SolvedCount > 0 ? results.TotalCostRatio / static_cast<double>(results.SolvedCount) : 0.0, results.MaxCostRatio, results.FailureCount);
+			System::PrintToCLI(resultsString);
+			failureCount += results.FailureCount;
+		}
+		return failureCount;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// Implementation of the main function.
+/// </summary>
+int main(int argc, char **argv) {
+	std::vector<std::string> sceneNames;
+	int queryCount = 200;
+	unsigned int seed = 1;
+	for (int i = 1; i < argc; ++i) {
+		std::string currentArg = argv[i];
+		bool lastArg = i + 1 == argc;
+		if (!lastArg && currentArg == "-scene") {
+			sceneNames.emplace_back(argv[++i]);
+		} else if (!lastArg && currentArg == "-queries") {
+			queryCount = std::max(std::atoi(argv[++i]), 1);
+		} else if (!lastArg && currentArg == "-seed") {
+			seed = static_cast<unsigned int>(std::atoi(argv[++i]));
+		}
+	}
+
+	set_config_file("Base.rte/AllegroConfig.txt");
+	allegro_init();
+	loadpng_init();
+
+	System::Initialize();
+	System::EnableLoggingToCLI();
+	SeedRNG();
+
+	// Set up the managers in the same order as the game does, without the menus. Loading scenes goes through the network server and the activity and movable managers too.
+	// SceneMan has no Initialize, it's ready to load scenes once constructed and SettingsMan has read its properties, which is all the game does with it before loading one as well.
+	g_SettingsMan.Initialize();
+	g_ThreadMan.Initialize();
+
+	g_LuaMan.Initialize();
+	g_NetworkServer.Initialize();
+	g_NetworkClient.Initialize();
+	g_TimerMan.Initialize();
+	g_PerformanceMan.Initialize();
+	g_FrameMan.Initialize();
+	g_PostProcessMan.Initialize();
+
+	if (g_AudioMan.Initialize()) { g_GUISound.Initialize(); }
+
+	g_UInputMan.Initialize();
+	g_ConsoleMan.Initialize();
+	g_MovableMan.Initialize();
+	g_MetaMan.Initialize();
+
+	g_PresetMan.LoadAllDataModules();
+
+	if (sceneNames.empty()) { sceneNames.emplace_back(g_SceneMan.GetDefaultSceneName()); }
+
+	int failureCount = 0;
+	for (const std::string &sceneName : sceneNames) {
+		if (g_SceneMan.LoadScene(sceneName, false, false) < 0 || !g_SceneMan.GetScene()) {
+			System::PrintToCLI("ERROR: Failed to load scene \"" + sceneName + "\"!");
+			failureCount++;
+			continue;
+		}
+		System::PrintToCLI("Scene \"" + sceneName + "\" (" + std::to_string(g_SceneMan.GetSceneWidth()) + "x" + std::to_string(g_SceneMan.GetSceneHeight()) + "), " + std::to_string(queryCount) + " paths per dig strength:");
+		failureCount += RunSceneBenchmark(queryCount, seed);
+	}
+	System::PrintToCLI(failureCount == 0 ? "All paths valid." : "ERROR: " + std::to_string(failureCount) + " failed!");
+
+	g_ThreadMan.Destroy();
+	g_NetworkClient.Destroy();
+	g_NetworkServer.Destroy();
+	g_MetaMan.Destroy();
+	g_MovableMan.Destroy();
+	g_SceneMan.Destroy();
+	g_ActivityMan.Destroy();
+	g_GUISound.Destroy();
+	g_AudioMan.Destroy();
+	g_PresetMan.Destroy();
+	g_UInputMan.Destroy();
+	g_FrameMan.Destroy();
+	g_TimerMan.Destroy();
+	g_LuaMan.Destroy();
+	RotatedSpriteCache::Clear();
+	ContentFile::FreeAllLoaded();
+	g_ConsoleMan.Destroy();
+
+	return failureCount == 0 ? 0 : 1;
+}
@@ -27,6 +27,7 @@
 #include "Material.h"
 #include "MOPixel.h"
 #include "Scene.h"
+#include "PathFinder.h"
 #include "SettingsMan.h"
 #include "PerformanceMan.h"
 
@@ -126,6 +127,8 @@ void Actor::Clear() {
     m_PrevPathTarget.Reset();
     m_MoveVector.Reset();
     m_MovePath.clear();
+    m_PathRequest.reset();
+    m_MovePathCostUpdateCount = 0;
     m_UpdateMovePath = true;
     m_MoveProximityLimit = 100.0F;
     m_LateralMoveState = LAT_STILL;
@@ -1207,27 +1210,32 @@ MOID Actor::GetAIMOWaypointID()
 
 bool Actor::UpdateMovePath()
 {
-    // TODO: Do throttling of calls for this function over time??
+    // The path is calculated on the worker threads, so wait for the one we asked for last time to be done
+    if (m_PathRequest && !m_PathRequest->Complete)
+        return false;
 
+    if (!m_PathRequest)
+    {
+        // Update the pathfinding with any changes to the terrain before asking for a path across it.
+        // Doors don't need to be removed from the material representation for this guy to navigate through them (they'll open for him), the pathfinding already ignores door material.
+        // If other paths are being solved right now the update is put off instead of waited on, paths found meanwhile are redone once it goes through if it changed them.
+        g_SceneMan.GetScene()->UpdatePathFindingIfIdle();
+        m_MovePathCostUpdateCount = g_SceneMan.GetScene()->GetPathCostUpdateCount();
 
-    // Remove the material representation of all doors of this guy's team so he can navigate through them (they'll open for him)
-    g_MovableMan.OverrideMaterialDoors(true, m_Team);
-    // Update the pathfinding with any changes to doors' material representations
-    g_SceneMan.GetScene()->UpdatePathFinding();
+        // Make sure the path starts from the ground and not somewhere up in the air if/when dropped out of ship
+        Vector pathStart = g_SceneMan.MovePointToGround(m_Pos, m_CharHeight*0.2, 10);
+        Vector pathTarget;
 
-    // If we're following someone/thing, then never advance waypoints until that thing disappears
-    if (g_MovableMan.ValidMO(m_pMOMoveTarget))
-        g_SceneMan.GetScene()->CalculatePath(g_SceneMan.MovePointToGround(m_Pos, m_CharHeight*0.2, 10), m_pMOMoveTarget->GetPos(), m_MovePath, m_DigStrength);
-    else
-    {
+        // If we're following someone/thing, then never advance waypoints until that thing disappears
+        if (g_MovableMan.ValidMO(m_pMOMoveTarget))
+            pathTarget = m_pMOMoveTarget->GetPos();
         // Do we currently have a path to a static target we would like to still pursue?
-        if (m_MovePath.empty())
+        else if (m_MovePath.empty())
         {
             // Ok no path going, so get a new path to the next waypoint, if there is a next waypoint
             if (!m_Waypoints.empty())
             {
-                // Make sure the path starts from the ground and not somewhere up in the air if/when dropped out of ship
-                g_SceneMan.GetScene()->CalculatePath(g_SceneMan.MovePointToGround(m_Pos, m_CharHeight*0.2, 10), m_Waypoints.front().first, m_MovePath, m_DigStrength);
+                pathTarget = m_Waypoints.front().first;
                 // If the waypoint was tied to an MO to pursue, then load it into the current MO target
                 if (g_MovableMan.ValidMO(m_Waypoints.front().second))
                     m_pMOMoveTarget = m_Waypoints.front().second;
@@ -1238,17 +1246,36 @@ bool Actor::UpdateMovePath()
             }
             // Just try to get to the last Move Target
             else
-                g_SceneMan.GetScene()->CalculatePath(g_SceneMan.MovePointToGround(m_Pos, m_CharHeight*0.2, 10), m_MoveTarget, m_MovePath, m_DigStrength);
+                pathTarget = m_MoveTarget;
         }
         // We had a path before trying to update, so use its last point as the final destination
         else
-            g_SceneMan.GetScene()->CalculatePath(g_SceneMan.MovePointToGround(m_Pos, m_CharHeight*0.2, 10), Vector(m_MovePath.back()), m_MovePath, m_DigStrength);
+            pathTarget = m_MovePath.back();
+
+        // Popular destinations get a flow field that everyone heading there shares, which gives the path right away
+        std::list<Vector> flowFieldPath;
+        if (g_SceneMan.GetScene()->GetFlowFieldPath(pathStart, pathTarget, flowFieldPath, m_DigStrength))
+        {
+            m_PathRequest = std::make_shared<PathRequest>();
+            m_PathRequest->Path = std::move(flowFieldPath);
+            m_PathRequest->Complete = true;
+        }
+        else
+        {
+            m_PathRequest = g_SceneMan.GetScene()->CalculatePathAsync(pathStart, pathTarget, m_DigStrength);
+            // If there are no worker threads the path was calculated right away, so there's no need to wait a frame for it
+            if (m_PathRequest && !m_PathRequest->Complete)
+                return false;
+        }
     }
 
-    // Place back the material representation of all doors of this guy's team so they are as we found them
-    g_MovableMan.OverrideMaterialDoors(false, m_Team);
-    // Update the pathfinding with any changes to doors' material representations
-    g_SceneMan.GetScene()->UpdatePathFinding();
+    // Take the path that was calculated for us, if any
+    m_MovePath.clear();
+    if (m_PathRequest)
+    {
+        m_MovePath = std::move(m_PathRequest->Path);
+        m_PathRequest.reset();
+    }
 
     // Process the new path we now have, if any
     if (!m_MovePath.empty())
@@ -1421,6 +1448,18 @@ void Actor::Update()
     if (m_pMOMoveTarget && !g_MovableMan.ValidMO(m_pMOMoveTarget))
 		m_pMOMoveTarget = 0;
 
+    // Take the move path calculated for us on the worker threads as soon as it's ready, even if whatever asked for it won't be asking again
+    if (m_PathRequest && m_PathRequest->Complete)
+        UpdateMovePath();
+
+    // Ask for a new move path if the terrain along the current one changed since it was found, it may not be the best way anymore or even passable
+    if (!m_MovePath.empty() && !m_PathRequest && m_MovePathCostUpdateCount != g_SceneMan.GetScene()->GetPathCostUpdateCount())
+    {
+        if (g_SceneMan.GetScene()->IsPathOutdated(m_MovePath, m_MovePathCostUpdateCount))
+            m_UpdateMovePath = true;
+        m_MovePathCostUpdateCount = g_SceneMan.GetScene()->GetPathCostUpdateCount();
+    }
+
     ///////////////////////////////////////////////////////////////////////////////
     // Check for manual player-made progress made toward the set AI goal
 
@@ -23,6 +23,7 @@ namespace RTE
 class AtomGroup;
 class HeldDevice;
 class PieMenuGUI;
+struct PathRequest;
 
 #define AILINEDOTSPACING 16
 
@@ -693,7 +694,7 @@ ClassInfoGetters;
 // Arguments:       None.
 // Return value:    None.
 
-	void ClearAIWaypoints() { m_pMOMoveTarget = 0; m_Waypoints.clear(); m_MovePath.clear(); m_MoveTarget = m_Pos; m_MoveVector.Reset(); }
+	void ClearAIWaypoints() { m_pMOMoveTarget = 0; m_Waypoints.clear(); m_MovePath.clear(); m_PathRequest.reset(); m_MoveTarget = m_Pos; m_MoveVector.Reset(); }
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -735,7 +736,7 @@ ClassInfoGetters;
 // Arguments:       None.
 // Return value:    None.
 
-	void ClearMovePath() { m_MovePath.clear(); m_MoveTarget = m_Pos; m_MoveVector.Reset(); }
+	void ClearMovePath() { m_MovePath.clear(); m_PathRequest.reset(); m_MoveTarget = m_Pos; m_MoveVector.Reset(); }
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1106,6 +1107,17 @@ ClassInfoGetters;
 	int GetMovePathSize() const { return m_MovePath.size(); }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          IsWaitingOnNewMovePath
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Tells whether this is waiting on a new move path that is being
+//                  calculated on the worker threads.
+// Arguments:       None.
+// Return value:    Whether a new move path is being calculated for this.
+
+	bool IsWaitingOnNewMovePath() const { return m_PathRequest != nullptr; }
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Virtual method:  UpdateMovePath
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1560,6 +1572,10 @@ protected:
     Vector m_MoveVector;
     /// The calculated path to get to that move-to target
     std::list<Vector> m_MovePath;
+    /// The request for a new move path that is being calculated on the worker threads, if any
+    std::shared_ptr<PathRequest> m_PathRequest;
+    /// The pathfinding cost update count the move path was last known to be up to date with
+    unsigned int m_MovePathCostUpdateCount;
     /// Whether it's time to update the path
     bool m_UpdateMovePath;
     /// The minimum range to consider having reached a move target is considered
@@ -1,6 +1,7 @@
 #include "MOSParticle.h"
 #include "Atom.h"
 #include "PostProcessMan.h"
+#include "PixelKernels.h"
 
 namespace RTE {
 
@@ -174,11 +175,11 @@ namespace RTE {
 				draw_character_ex(targetBitmap, m_aSprite[m_Frame], spritePos.GetFloorIntX(), spritePos.GetFloorIntY(), g_NoMOID, -1);
 				break;
 			case g_DrawTrans:
-				draw_trans_sprite(targetBitmap, m_aSprite[m_Frame], spritePos.GetFloorIntX(), spritePos.GetFloorIntY());
+				PixelKernels::DrawTransSprite(targetBitmap, m_aSprite[m_Frame], spritePos.GetFloorIntX(), spritePos.GetFloorIntY());
 				break;
 			case g_DrawAlpha:
 				set_alpha_blender();
-				draw_trans_sprite(targetBitmap, m_aSprite[m_Frame], spritePos.GetFloorIntX(), spritePos.GetFloorIntY());
+				PixelKernels::DrawTransSprite(targetBitmap, m_aSprite[m_Frame], spritePos.GetFloorIntX(), spritePos.GetFloorIntY());
 				break;
 			default:
 				draw_sprite(targetBitmap, m_aSprite[m_Frame], spritePos.GetFloorIntX(), spritePos.GetFloorIntY());
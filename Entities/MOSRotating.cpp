@@ -20,6 +20,8 @@
 #include "AEmitter.h"
 #include "Attachable.h"
 #include "HDFirearm.h"
+#include "RotatedSpriteCache.h"
+#include "PixelKernels.h"
 
 #include "RTEError.h"
 
@@ -1797,8 +1799,30 @@ void MOSRotating::Draw(BITMAP *pTargetBitmap,
     if (m_Recoiled)
         spritePos += m_RecoilOffset;
 
+    // Try to get a cached copy of the sprite already rotated to (about) the current angle, which turns all the flipping and rotating below into plain blits.
+    // Scaled objects tend to change scale continuously, so they would only churn the cache and are left to be rotated the regular way.
+    int silhouetteColor = -1;
+    if (mode == g_DrawMaterial)
+        silhouetteColor = m_SettleMaterialDisabled ? GetMaterial()->GetIndex() : GetMaterial()->GetSettleMaterial();
+    else if (mode == g_DrawAir)
+        silhouetteColor = g_MaterialAir;
+    else if (mode == g_DrawMask)
+        silhouetteColor = keyColor;
+    else if (mode == g_DrawWhite)
+        silhouetteColor = g_WhiteColor;
+    else if (mode == g_DrawMOID)
+        silhouetteColor = m_MOID;
+    else if (mode == g_DrawNoMOID)
+        silhouetteColor = g_NoMOID;
+    else if (mode == g_DrawDoor)
+        silhouetteColor = g_MaterialDoor;
+
+    std::shared_ptr<BITMAP> pRotatedSprite = nullptr;
+    if (m_Scale == 1.0F && (mode == g_DrawColor || mode == g_DrawTrans || silhouetteColor >= 0))
+        pRotatedSprite = RotatedSpriteCache::GetRotatedSprite(m_aSprite[m_Frame], -(m_SpriteOffset.m_X), -(m_SpriteOffset.m_Y), m_Rotation.GetAllegroAngle(), m_HFlipped && pFlipBitmap);
+
     // If we're drawing a material silhouette, then create an intermediate material bitmap as well
-    if (mode != g_DrawColor && mode != g_DrawTrans)
+    if (!pRotatedSprite && mode != g_DrawColor && mode != g_DrawTrans)
     {
         clear_to_color(pTempBitmap, keyColor);
 
@@ -1819,7 +1843,7 @@ void MOSRotating::Draw(BITMAP *pTargetBitmap,
 		else if (mode == g_DrawDoor)
 			draw_character_ex(pTempBitmap, m_aSprite[m_Frame], 0, 0, g_MaterialDoor, -1);
         else if (mode == g_DrawRedTrans)
-            draw_trans_sprite(pTempBitmap, m_aSprite[m_Frame], 0, 0);
+            PixelKernels::DrawTransSprite(pTempBitmap, m_aSprite[m_Frame], 0, 0);
         else
         {
 //            return;
@@ -1870,9 +1894,30 @@ void MOSRotating::Draw(BITMAP *pTargetBitmap,
         }
     }
 
+    //////////////////
+    // CACHED PRE-ROTATED
+    if (pRotatedSprite)
+    {
+        for (int i = 0; i < passes; ++i)
+        {
+            // The pivot point is at the center of the rotated sprite
+            int spriteX = aDrawPos[i].GetFloorIntX() - (pRotatedSprite->w / 2);
+            int spriteY = aDrawPos[i].GetFloorIntY() - (pRotatedSprite->h / 2);
+            if (mode == g_DrawColor)
+                draw_sprite(pTargetBitmap, pRotatedSprite.get(), spriteX, spriteY);
+            else if (mode == g_DrawTrans)
+                PixelKernels::DrawTransSprite(pTargetBitmap, pRotatedSprite.get(), spriteX, spriteY);
+            else
+                draw_character_ex(pTargetBitmap, pRotatedSprite.get(), spriteX, spriteY, silhouetteColor, -1);
+
+            // Register potential MOID drawing
+            if (mode == g_DrawMOID)
+                g_SceneMan.RegisterMOIDDrawing(aDrawPos[i].GetFloored(), m_SpriteRadius + 2);
+        }
+    }
     //////////////////
     // FLIPPED
-    if (m_HFlipped && pFlipBitmap)
+    else if (m_HFlipped && pFlipBitmap)
     {
         // Don't size the intermediate bitmaps to the m_Scale, because the scaling happens after they are done
         clear_to_color(pFlipBitmap, keyColor);
@@ -1902,7 +1947,7 @@ void MOSRotating::Draw(BITMAP *pTargetBitmap,
             // Draw the now rotated object's temporary bitmap onto the final drawing bitmap with transperency
             // Do the passes loop in here so the intermediate drawing doesn't get done multiple times
             for (int i = 0; i < passes; ++i)
-                draw_trans_sprite(pTargetBitmap, pTempBitmap, aDrawPos[i].GetFloorIntX() - (pTempBitmap->w / 2), aDrawPos[i].GetFloorIntY() - (pTempBitmap->h / 2));
+                PixelKernels::DrawTransSprite(pTargetBitmap, pTempBitmap, aDrawPos[i].GetFloorIntX() - (pTempBitmap->w / 2), aDrawPos[i].GetFloorIntY() - (pTempBitmap->h / 2));
         }
         // Non-transparent mode
         else
@@ -1952,7 +1997,7 @@ void MOSRotating::Draw(BITMAP *pTargetBitmap,
             // Draw the now rotated object's temporary bitmap onto the final drawing bitmap with transperency
             // Do the passes loop in here so the intermediate drawing doesn't get done multiple times
             for (int i = 0; i < passes; ++i)
-                draw_trans_sprite(pTargetBitmap, pTempBitmap, aDrawPos[i].GetFloorIntX() - (pTempBitmap->w / 2), aDrawPos[i].GetFloorIntY() - (pTempBitmap->h / 2));
+                PixelKernels::DrawTransSprite(pTargetBitmap, pTempBitmap, aDrawPos[i].GetFloorIntX() - (pTempBitmap->w / 2), aDrawPos[i].GetFloorIntY() - (pTempBitmap->h / 2));
         }
         // Non-transparent mode
         else
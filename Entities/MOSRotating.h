@@ -45,6 +45,7 @@ public:
 
 friend class AtomGroup;
 friend class SLTerrain;
+friend class NetworkServer;
 friend struct EntityLuaBindings;
 
 
@@ -14,6 +14,7 @@
 #include "MOSprite.h"
 #include "PresetMan.h"
 #include "AEmitter.h"
+#include "PixelKernels.h"
 
 namespace RTE {
 
@@ -592,11 +593,11 @@ void MOSprite::Draw(BITMAP *pTargetBitmap,
         else if (mode == g_DrawNoMOID)
             draw_character_ex(pTargetBitmap, m_aSprite[m_Frame], aDrawPos[i].GetFloorIntX(), aDrawPos[i].GetFloorIntY(), g_NoMOID, -1);
         else if (mode == g_DrawTrans)
-            draw_trans_sprite(pTargetBitmap, m_aSprite[m_Frame], aDrawPos[i].GetFloorIntX(), aDrawPos[i].GetFloorIntY());
+            PixelKernels::DrawTransSprite(pTargetBitmap, m_aSprite[m_Frame], aDrawPos[i].GetFloorIntX(), aDrawPos[i].GetFloorIntY());
         else if (mode == g_DrawAlpha)
         {
             set_alpha_blender();
-            draw_trans_sprite(pTargetBitmap, m_aSprite[m_Frame], aDrawPos[i].GetFloorIntX(), aDrawPos[i].GetFloorIntY());
+            PixelKernels::DrawTransSprite(pTargetBitmap, m_aSprite[m_Frame], aDrawPos[i].GetFloorIntX(), aDrawPos[i].GetFloorIntY());
         }
         else {
             if (!m_HFlipped)
@@ -43,6 +43,8 @@ void MovableObject::Clear()
     m_Vel.Reset();
     m_PrevPos.Reset();
     m_PrevVel.Reset();
+    m_InterpolationStartPos.Reset();
+    m_HasInterpolationStart = false;
     m_Scale = 1.0;
     m_GlobalAccScalar = 1.0;
     m_AirResistance = 0;
@@ -1024,6 +1026,29 @@ void MovableObject::PostTravel()
     m_CheckTerrIntersection = false;
 }
 
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetInterpolatedDrawOffset
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets how far from where it is now this should be drawn, to be drawn
+//                  somewhere between where it was at the start of the latest sim update
+//                  and where it is now.
+
+Vector MovableObject::GetInterpolatedDrawOffset(float interpolationAmount) const
+{
+    if (!m_HasInterpolationStart || interpolationAmount >= 1.0F)
+        return Vector();
+
+    // Take the short way across wrapping seams, and don't smooth out jumps much further than this could have traveled in one update, like teleports and respawns
+    Vector travel = g_SceneMan.ShortestDistance(m_InterpolationStartPos, m_Pos);
+    float maxTravel = std::max(m_Vel.GetMagnitude(), m_PrevVel.GetMagnitude()) * g_TimerMan.GetDeltaTimeSecs() * c_PPM * 2.0F + 2.0F;
+    if (travel.GetMagnitude() > maxTravel)
+        return Vector();
+
+    // The part of the travel that hasn't happened yet at this point between the updates
+    return travel * (interpolationAmount - 1.0F);
+}
+
 /*
 //////////////////////////////////////////////////////////////////////////////////////////
 // Pure v. method:  Update
@@ -1529,6 +1529,30 @@ enum MOType
     virtual void PostTravel();
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          SaveInterpolationStart
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Saves the current position of this as where drawing is interpolated
+//                  from over the coming sim update. Done at the start of every sim update.
+// Arguments:       None.
+// Return value:    None.
+
+    void SaveInterpolationStart() { m_InterpolationStartPos = m_Pos; m_HasInterpolationStart = true; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetInterpolatedDrawOffset
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets how far from where it is now this should be drawn, to be drawn
+//                  somewhere between where it was at the start of the latest sim update
+//                  and where it is now. This itself is left where it is.
+// Arguments:       How far between the two positions to draw this, 0 being the position at
+//                  the start of the latest sim update and 1 being the current position.
+// Return value:    The offset from the current position to draw this at.
+
+    Vector GetInterpolatedDrawOffset(float interpolationAmount) const;
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Virtual method:  Update
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1878,6 +1902,8 @@ protected:
     Vector m_Vel; // In meters per second (m/s).
     Vector m_PrevPos; // Previous frame's position.
     Vector m_PrevVel; // Previous frame's velocity.
+    Vector m_InterpolationStartPos; // Position at the start of the latest sim update, which drawing is interpolated from.
+    bool m_HasInterpolationStart; // Whether this has been through a sim update yet, so there is a start position to interpolate from.
     float m_Scale; // The scale that this MovableObject's representation will be drawn in. 1.0 being 1:1;
     // How this is affected by global effects, from +1.0 to -1.0. Something with a negative value will 'float' upward
     float m_GlobalAccScalar;
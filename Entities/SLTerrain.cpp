@@ -20,11 +20,18 @@
 #include "MOPixel.h"
 #include "MOSprite.h"
 #include "Atom.h"
+#include "SettingsMan.h"
+#include "ConsoleMan.h"
+#include "ThreadMan.h"
 
 namespace RTE {
 
 ConcreteClassInfo(SLTerrain, SceneLayer, 0);
 
+const uint32_t SLTerrain::m_sLayerCacheVersion = 2;
+const uint32_t SLTerrain::m_sLayerCacheAlignment = 4096;
+const int SLTerrain::m_sLoadBandHeight = 64;
+
 const string SLTerrain::TerrainFrosting::c_ClassName = "TerrainFrosting";
 BITMAP * SLTerrain::m_spTempBitmap16 = 0;
 BITMAP * SLTerrain::m_spTempBitmap32 = 0;
@@ -264,16 +271,15 @@ int SLTerrain::Create(const SLTerrain &reference)
 
 int SLTerrain::LoadData()
 {
-    // Load the materials bitmap into the main bitmap
-    if (SceneLayer::LoadData())
-        return -1;
-
     RTEAssert(m_pFGColor, "Terrain's foreground layer not instantiated before trying to load its data!");
     RTEAssert(m_pBGColor, "Terrain's background layer not instantiated before trying to load its data!");
 
     // Check if our color layers' BITMAP data is also to be loaded from disk, and not be generated from the material bitmap!
     if (m_pFGColor->IsFileData() && m_pBGColor->IsFileData())
     {
+        // Load the materials bitmap into the main bitmap
+        if (SceneLayer::LoadData())
+            return -1;
         if (m_pFGColor->LoadData() < 0)
         {
             RTEAbort("Could not load the Foreground Color SceneLayer data from file, when a path was specified for it!");
@@ -289,6 +295,23 @@ int SLTerrain::LoadData()
         return 0;
     }
 
+    // See if the fully generated layers were cached by an earlier load of this same terrain, so we can skip decoding and generating them altogether
+    bool useLayerCache = g_SettingsMan.SceneLayerCacheEnabled();
+    uint64_t layerCacheKey = useLayerCache ? GetLayerCacheKey() : 0;
+    if (useLayerCache && LoadLayerCache(layerCacheKey))
+    {
+        // The TerrainObjects are already drawn onto the cached layers, but their child objects still need to be placed
+        for (list<TerrainObject *>::iterator toItr = m_TerrainObjects.begin(); toItr != m_TerrainObjects.end(); ++toItr)
+            CommitTerrainObject(*toItr);
+
+        InitScrollRatios();
+        return 0;
+    }
+
+    // Load the materials bitmap into the main bitmap
+    if (SceneLayer::LoadData())
+        return -1;
+
     // Create blank foreground layer
     m_pFGColor->Destroy();
     BITMAP *pFGBitmap = create_bitmap_ex(8, m_pMainBitmap->w, m_pMainBitmap->h);
@@ -316,25 +339,12 @@ int SLTerrain::LoadData()
     ///////////////////////////////////////////////
     // Load and texturize the FG color bitmap, based on the materials defined in the recently loaded (main) material layer!
 
-    int xPos, yPos, matIndex, pixelColor;
-
-    // Temporary references for all the materials' textures and colors, since we'll access them a lot
-    BITMAP *apTexBitmaps[256];
-    int aColors[256];
-    // Null em out so we can tell which ones we've already got once so far
-    for (matIndex = 0; matIndex < 256; ++matIndex)
-    {
-        apTexBitmaps[matIndex] = 0;
-        aColors[matIndex] = 0;
-    }
-
     // Get the background texture
     BITMAP *m_pBGTexture = m_BGTextureFile.GetAsBitmap();
     // Get the material palette for quicker access
 	const std::array<Material *, c_PaletteEntriesNumber> &apMaterials = g_SceneMan.GetMaterialPalette();
     // Get the Material palette ID mappings local to the DataModule this SLTerrain is loaded from
 	const std::array<unsigned char, c_PaletteEntriesNumber> &materialMappings = g_PresetMan.GetDataModule(m_BitmapFile.GetDataModuleID())->GetAllMaterialMappings();
-    Material *pMaterial = 0;
 
     // Lock all involved bitmaps
     acquire_bitmap(m_pMainBitmap);
@@ -344,129 +354,139 @@ int SLTerrain::LoadData()
 
     // Go through each pixel on the main bitmap, which contains all the material pixels loaded from the bitmap
     // Place texture pixels on the FG layer corresponding to the materials on the main material bitmap
-    for (xPos = 0; xPos < m_pMainBitmap->w; ++xPos)
-    {
-        for (yPos = 0; yPos < m_pMainBitmap->h; ++yPos)
+    // Every pixel only depends on itself, so this is split up into bands of rows that are done in parallel
+    g_ThreadMan.ParallelFor(0, m_pMainBitmap->h, m_sLoadBandHeight, [&](int bandTop, int bandBottom) {
+        // Temporary references for all the materials' textures and colors, since we'll access them a lot
+        BITMAP *apTexBitmaps[256];
+        int aColors[256];
+        // Null em out so we can tell which ones we've already got once so far
+        for (int matIndex = 0; matIndex < 256; ++matIndex)
+        {
+            apTexBitmaps[matIndex] = 0;
+            aColors[matIndex] = 0;
+        }
+        Material *pMaterial = 0;
+        int matIndex, pixelColor;
+
+        for (int yPos = bandTop; yPos < bandBottom; ++yPos)
         {
-            // Read which material the current pixel represents
-            matIndex = _getpixel(m_pMainBitmap, xPos, yPos);
-            // Map any materials defined in this data module but initially collided with other material ID's and thus were displaced to other ID's
-            if (materialMappings.at(matIndex) != 0)
+            for (int xPos = 0; xPos < m_pMainBitmap->w; ++xPos)
             {
-                // Assign the mapping and put it onto the material bitmap too
-                matIndex = materialMappings.at(matIndex);
-                _putpixel(m_pMainBitmap, xPos, yPos, matIndex);
-            }
+                // Read which material the current pixel represents
+                matIndex = _getpixel(m_pMainBitmap, xPos, yPos);
+                // Map any materials defined in this data module but initially collided with other material ID's and thus were displaced to other ID's
+                if (materialMappings.at(matIndex) != 0)
+                {
+                    // Assign the mapping and put it onto the material bitmap too
+                    matIndex = materialMappings.at(matIndex);
+                    _putpixel(m_pMainBitmap, xPos, yPos, matIndex);
+                }
 
-            // Validate the material, or default to default material
-            if (matIndex >= 0 && matIndex < c_PaletteEntriesNumber && apMaterials.at(matIndex))
-                pMaterial = apMaterials.at(matIndex);
-            else
-                pMaterial = apMaterials.at(g_MaterialDefault);
+                // Validate the material, or default to default material
+                if (matIndex >= 0 && matIndex < c_PaletteEntriesNumber && apMaterials.at(matIndex))
+                    pMaterial = apMaterials.at(matIndex);
+                else
+                    pMaterial = apMaterials.at(g_MaterialDefault);
 
-            // If haven't read a pixel of this material before, then get its texture so we can quickly access it
-            if (!apTexBitmaps[matIndex])
-            {
-                // Get, and acquire the texture bitmap if material has any
-                if (apTexBitmaps[matIndex] = pMaterial->GetTexture())
-                    acquire_bitmap(apTexBitmaps[matIndex]);
-            }
+                // If haven't read a pixel of this material before, then get its texture so we can quickly access it
+                if (!apTexBitmaps[matIndex])
+                    apTexBitmaps[matIndex] = pMaterial->GetTexture();
 
-            // If actually no texture for the material, then use the material's solid color instead
-            if (!apTexBitmaps[matIndex])
-            {
-                // If the color hasn't been retrieved yet, then do so
-                if (!aColors[matIndex])
-                    aColors[matIndex] = pMaterial->GetColor().GetIndex();
-                // Use the color
-                pixelColor = aColors[matIndex];
-            }
-            // Use the texture's color
-            else
-            {
-//                acquire_bitmap(apTexBitmaps[matIndex]);
-                pixelColor = _getpixel(apTexBitmaps[matIndex], xPos % apTexBitmaps[matIndex]->w, yPos % apTexBitmaps[matIndex]->h);
-            }
+                // If actually no texture for the material, then use the material's solid color instead
+                if (!apTexBitmaps[matIndex])
+                {
+                    // If the color hasn't been retrieved yet, then do so
+                    if (!aColors[matIndex])
+                        aColors[matIndex] = pMaterial->GetColor().GetIndex();
+                    // Use the color
+                    pixelColor = aColors[matIndex];
+                }
+                // Use the texture's color
+                else
+                    pixelColor = _getpixel(apTexBitmaps[matIndex], xPos % apTexBitmaps[matIndex]->w, yPos % apTexBitmaps[matIndex]->h);
 
-            // Draw the correct color pixel on the foreground
-            _putpixel(pFGBitmap, xPos, yPos, pixelColor);
+                // Draw the correct color pixel on the foreground
+                _putpixel(pFGBitmap, xPos, yPos, pixelColor);
 
-            // Draw background texture on the background where this is stuff on the foreground
-            if (m_pBGTexture && pixelColor != g_MaskColor)
-            {
-                pixelColor = _getpixel(m_pBGTexture, xPos % m_pBGTexture->w, yPos % m_pBGTexture->h);
-                _putpixel(pBGBitmap, xPos, yPos, pixelColor);
+                // Draw background texture on the background where this is stuff on the foreground
+                if (m_pBGTexture && pixelColor != g_MaskColor)
+                {
+                    pixelColor = _getpixel(m_pBGTexture, xPos % m_pBGTexture->w, yPos % m_pBGTexture->h);
+                    _putpixel(pBGBitmap, xPos, yPos, pixelColor);
+                }
+                // Put a keycolor pixel in the bg otherwise
+                else
+                    _putpixel(pBGBitmap, xPos, yPos, g_MaskColor);
             }
-            // Put a keycolor pixel in the bg otherwise
-            else
-                _putpixel(pBGBitmap, xPos, yPos, g_MaskColor);
         }
-    }
+    });
 
     ///////////////////////////////////////
     // Material frostings application!
 
-    bool targetFound = false, applyingFrosting = false;
-    int targetId, frostingId, thickness, thicknessGoal;
-    BITMAP *pFrostingTex = 0;
+    std::vector<int> columnThicknessGoals(m_pMainBitmap->w);
     for (list<TerrainFrosting>::iterator tfItr = m_TerrainFrostings.begin(); tfItr != m_TerrainFrostings.end(); ++tfItr)
     {
-        targetId = (*tfItr).GetTargetMaterial().GetIndex();
-        frostingId = (*tfItr).GetFrostingMaterial().GetIndex();
+        int targetId = (*tfItr).GetTargetMaterial().GetIndex();
+        int frostingId = (*tfItr).GetFrostingMaterial().GetIndex();
         // Try to get the color texture of the frosting material. If fail, we'll use the color isntead
-        pFrostingTex = (*tfItr).GetFrostingMaterial().GetTexture();
-        if (pFrostingTex)
-            acquire_bitmap(pFrostingTex);
+        BITMAP *pFrostingTex = (*tfItr).GetFrostingMaterial().GetTexture();
 
-        // Loop through all columns
-        for (xPos = 0; xPos < m_pMainBitmap->w; ++xPos)
-        {
-            // Get the thickness for this column
+        // Roll the thickness for each column up front in column order, so the frosting comes out the same regardless of how the columns are split between threads
+        for (int &thicknessGoal : columnThicknessGoals)
             thicknessGoal = (*tfItr).GetThicknessSample();
 
-            // Work upward from the bottom of each column
-            for (yPos = m_pMainBitmap->h - 1; yPos >= 0; --yPos)
+        // Columns don't affect each other, so do bands of them in parallel
+        g_ThreadMan.ParallelFor(0, m_pMainBitmap->w, m_sLoadBandHeight, [&](int bandLeft, int bandRight) {
+            int matIndex, pixelColor;
+            for (int xPos = bandLeft; xPos < bandRight; ++xPos)
             {
-                // Read which material the current pixel represents
-                matIndex = _getpixel(m_pMainBitmap, xPos, yPos);
+                int thicknessGoal = columnThicknessGoals[xPos];
+                bool targetFound = false;
+                bool applyingFrosting = false;
+                int thickness = 0;
 
-                // We've encountered the target material! Prepare to apply frosting as soon as it ends!
-                if (!targetFound && matIndex == targetId)
+                // Work upward from the bottom of each column
+                for (int yPos = m_pMainBitmap->h - 1; yPos >= 0; --yPos)
                 {
-                    targetFound = true;
-                    thickness = 0;
-                }
-                // Target material has ended! See if we shuold start putting on the frosting
-                else if (targetFound && matIndex != targetId && thickness <= thicknessGoal)
-                {
-                    applyingFrosting = true;
-                    targetFound = false;
-                }
-
-                // If time to put down frosting pixels, then do so IF there is air, OR we're set to ignore what we're overwriting
-                if (applyingFrosting && (matIndex == g_MaterialAir || !(*tfItr).InAirOnly()) && thickness <= thicknessGoal)
-                {
-                    // Get the color either from the frosting material's texture or the solid color
-                    if (pFrostingTex)
-                        pixelColor = _getpixel(pFrostingTex, xPos % pFrostingTex->w, yPos % pFrostingTex->h);
+                    // Read which material the current pixel represents
+                    matIndex = _getpixel(m_pMainBitmap, xPos, yPos);
+
+                    // We've encountered the target material! Prepare to apply frosting as soon as it ends!
+                    if (!targetFound && matIndex == targetId)
+                    {
+                        targetFound = true;
+                        thickness = 0;
+                    }
+                    // Target material has ended! See if we shuold start putting on the frosting
+                    else if (targetFound && matIndex != targetId && thickness <= thicknessGoal)
+                    {
+                        applyingFrosting = true;
+                        targetFound = false;
+                    }
+
+                    // If time to put down frosting pixels, then do so IF there is air, OR we're set to ignore what we're overwriting
+                    if (applyingFrosting && (matIndex == g_MaterialAir || !(*tfItr).InAirOnly()) && thickness <= thicknessGoal)
+                    {
+                        // Get the color either from the frosting material's texture or the solid color
+                        if (pFrostingTex)
+                            pixelColor = _getpixel(pFrostingTex, xPos % pFrostingTex->w, yPos % pFrostingTex->h);
+                        else
+                            pixelColor = (*tfItr).GetFrostingMaterial().GetColor().GetIndex();
+
+                        // Put the frosting pixel color on the FG color layer
+                        _putpixel(pFGBitmap, xPos, yPos, pixelColor);
+                        // Put the material ID pixel on the material layer
+                        _putpixel(m_pMainBitmap, xPos, yPos, frostingId);
+
+                        // Keep track of the applied thickness
+                        thickness++;
+                    }
                     else
-                        pixelColor = (*tfItr).GetFrostingMaterial().GetColor().GetIndex();
-
-                    // Put the frosting pixel color on the FG color layer
-                    _putpixel(pFGBitmap, xPos, yPos, pixelColor);
-                    // Put the material ID pixel on the material layer
-                    _putpixel(m_pMainBitmap, xPos, yPos, frostingId);
-
-                    // Keep track of the applied thickness
-                    thickness++;
+                        applyingFrosting = false;
                 }
-                else
-                    applyingFrosting = false;
             }
-        }
-
-        if (pFrostingTex)
-            release_bitmap(pFrostingTex);
+        });
     }
 
     // Release all involved bitmaps
@@ -475,12 +495,6 @@ int SLTerrain::LoadData()
     release_bitmap(pBGBitmap);
     release_bitmap(m_pBGTexture);
 
-    for (matIndex = 0; matIndex < 256; ++matIndex)
-    {
-        if (apTexBitmaps[matIndex])
-            release_bitmap(apTexBitmaps[matIndex]);
-    }
-
     ///////////////////////////////////////////////
     // TerrainDebris application
 
@@ -492,42 +506,271 @@ int SLTerrain::LoadData()
     ///////////////////////////////////////////////
     // Now take care of the TerrainObjects
 
-    for (list<TerrainObject *>::iterator toItr = m_TerrainObjects.begin(); toItr != m_TerrainObjects.end(); ++toItr)
+    // Split the layers into bands of rows that each get all the TerrainObjects drawn onto them in order, so overlapping ones end up layered the same as when drawn one after the other
+    if (!m_TerrainObjects.empty())
     {
-        ApplyTerrainObject(*toItr);
+        std::vector<std::array<BITMAP *, 3>> bandBitmaps;
+        for (int bandTop = 0; bandTop < m_pMainBitmap->h; bandTop += m_sLoadBandHeight)
+        {
+            int bandHeight = std::min(m_sLoadBandHeight, m_pMainBitmap->h - bandTop);
+            bandBitmaps.push_back({ create_sub_bitmap(m_pMainBitmap, 0, bandTop, m_pMainBitmap->w, bandHeight), create_sub_bitmap(pFGBitmap, 0, bandTop, m_pMainBitmap->w, bandHeight), create_sub_bitmap(pBGBitmap, 0, bandTop, m_pMainBitmap->w, bandHeight) });
+        }
+        g_ThreadMan.ParallelFor(0, static_cast<int>(bandBitmaps.size()), 1, [&](int firstBand, int lastBand) {
+            for (int band = firstBand; band < lastBand; ++band)
+            {
+                for (list<TerrainObject *>::const_iterator toItr = m_TerrainObjects.begin(); toItr != m_TerrainObjects.end(); ++toItr)
+                    DrawTerrainObject(*toItr, bandBitmaps[band][0], bandBitmaps[band][1], bandBitmaps[band][2], band * m_sLoadBandHeight);
+            }
+        });
+        for (const std::array<BITMAP *, 3> &bandLayers : bandBitmaps)
+        {
+            for (BITMAP *pBandBitmap : bandLayers)
+                destroy_bitmap(pBandBitmap);
+        }
+
+        // Registering the changes and placing the child objects touches the rest of the game, so that stays serial
+        for (list<TerrainObject *>::iterator toItr = m_TerrainObjects.begin(); toItr != m_TerrainObjects.end(); ++toItr)
+            CommitTerrainObject(*toItr);
     }
     CleanAir();
 
+    if (useLayerCache && !SaveLayerCache(layerCacheKey))
+        g_ConsoleMan.PrintString("WARNING: Failed to write the layer cache file for terrain " + GetPresetName() + "!");
+
     InitScrollRatios();
 
     return 0;
 }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetLayerCacheKey
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Calculates a hash of everything that goes into generating the material
+//                  and color layers of this SLTerrain.
+
+uint64_t SLTerrain::GetLayerCacheKey() const
+{
+    uint64_t cacheKey = StableHash(&m_sLayerCacheVersion, sizeof(m_sLayerCacheVersion));
+    auto hashValue = [&cacheKey](const auto &value) { cacheKey = StableHash(&value, sizeof(value), cacheKey); };
+
+    // Hash the raw contents of the source files rather than the decoded bitmaps, reading a compressed file is far cheaper than decoding it
+    auto hashFileContents = [&cacheKey](const std::string &filePath) {
+        cacheKey = StableHash(filePath, cacheKey);
+        std::ifstream sourceFile(filePath, std::ios::binary);
+        std::array<char, 65536> readBuffer;
+        while (sourceFile.read(readBuffer.data(), readBuffer.size()) || sourceFile.gcount() > 0)
+            cacheKey = StableHash(readBuffer.data(), static_cast<size_t>(sourceFile.gcount()), cacheKey);
+    };
+    hashFileContents(m_BitmapFile.GetDataPath());
+    hashFileContents(m_BGTextureFile.GetDataPath());
+
+    const std::array<unsigned char, c_PaletteEntriesNumber> &materialMappings = g_PresetMan.GetDataModule(m_BitmapFile.GetDataModuleID())->GetAllMaterialMappings();
+    cacheKey = StableHash(materialMappings.data(), materialMappings.size(), cacheKey);
+
+    const std::array<Material *, c_PaletteEntriesNumber> &materialPalette = g_SceneMan.GetMaterialPalette();
+    for (const Material *material : materialPalette)
+    {
+        if (material)
+        {
+            hashValue(material->GetIndex());
+            hashValue(material->GetColor().GetIndex());
+            cacheKey = StableHashBitmap(material->GetTexture(), cacheKey);
+        }
+    }
+
+    for (list<TerrainFrosting>::const_iterator tfItr = m_TerrainFrostings.begin(); tfItr != m_TerrainFrostings.end(); ++tfItr)
+    {
+        // The Material getters of TerrainFrosting aren't const, but the frosting isn't changed here
+        TerrainFrosting &frosting = const_cast<TerrainFrosting &>(*tfItr);
+        hashValue(frosting.GetTargetMaterial().GetIndex());
+        hashValue(frosting.GetFrostingMaterial().GetIndex());
+        hashValue(frosting.GetMinThickness());
+        hashValue(frosting.GetMaxThickness());
+        hashValue(frosting.InAirOnly());
+    }
+
+    for (list<TerrainDebris *>::const_iterator tdItr = m_TerrainDebris.begin(); tdItr != m_TerrainDebris.end(); ++tdItr)
+        hashValue((*tdItr)->GetApplicationHash());
+
+    for (list<TerrainObject *>::const_iterator toItr = m_TerrainObjects.begin(); toItr != m_TerrainObjects.end(); ++toItr)
+    {
+        cacheKey = StableHash((*toItr)->GetModuleAndPresetName(), cacheKey);
+        Vector loc = (*toItr)->GetPos() + (*toItr)->GetBitmapOffset();
+        hashValue(loc.m_X);
+        hashValue(loc.m_Y);
+        cacheKey = StableHashBitmap((*toItr)->GetMaterialBitmap(), cacheKey);
+        cacheKey = StableHashBitmap((*toItr)->GetFGColorBitmap(), cacheKey);
+        cacheKey = StableHashBitmap((*toItr)->GetBGColorBitmap(), cacheKey);
+    }
+
+    return cacheKey;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetLayerCachePath
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the path of the layer cache file of this SLTerrain.
+
+std::string SLTerrain::GetLayerCachePath() const
+{
+    char fileName[32];
+    std::snprintf(fileName, sizeof(fileName), "%016llx.lcache", static_cast<unsigned long long>(StableHash(m_BitmapFile.GetDataPath())));
+    return System::GetWorkingDirectory() + System::GetSceneCacheDirectory() + "/" + fileName;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          LoadLayerCache
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Creates the material, foreground and background layers of this from
+//                  the layer cache file, if one exists and matches the passed in key.
+
+bool SLTerrain::LoadLayerCache(uint64_t cacheKey)
+{
+    std::ifstream cacheFile(GetLayerCachePath(), std::ios::binary);
+    if (!cacheFile.is_open())
+        return false;
+
+    // See SaveLayerCache for the layout
+    std::array<char, 4> fileMagic;
+    uint32_t fileVersion = 0;
+    uint64_t fileKey = 0;
+    int32_t width = 0;
+    int32_t height = 0;
+    std::array<uint64_t, 3> layerOffsets;
+
+    cacheFile.read(fileMagic.data(), fileMagic.size());
+    cacheFile.read(reinterpret_cast<char *>(&fileVersion), sizeof(fileVersion));
+    cacheFile.read(reinterpret_cast<char *>(&fileKey), sizeof(fileKey));
+    cacheFile.read(reinterpret_cast<char *>(&width), sizeof(width));
+    cacheFile.read(reinterpret_cast<char *>(&height), sizeof(height));
+    cacheFile.read(reinterpret_cast<char *>(layerOffsets.data()), sizeof(layerOffsets));
+
+    if (!cacheFile || std::memcmp(fileMagic.data(), "C4LC", fileMagic.size()) != 0 || fileVersion != m_sLayerCacheVersion || fileKey != cacheKey || width <= 0 || height <= 0)
+        return false;
+
+    // Material, foreground color and background color, in that order
+    std::array<BITMAP *, 3> layerBitmaps;
+    for (size_t layer = 0; layer < layerBitmaps.size(); ++layer)
+    {
+        layerBitmaps[layer] = create_bitmap_ex(8, width, height);
+        RTEAssert(layerBitmaps[layer], "Failed to allocate BITMAP in SLTerrain::LoadLayerCache");
+
+        cacheFile.seekg(layerOffsets[layer]);
+        for (int y = 0; y < height && cacheFile; ++y)
+            cacheFile.read(reinterpret_cast<char *>(layerBitmaps[layer]->line[y]), width);
+    }
+
+    if (!cacheFile)
+    {
+        for (BITMAP *layerBitmap : layerBitmaps)
+            destroy_bitmap(layerBitmap);
+        return false;
+    }
+
+    SceneLayer::Create(layerBitmaps[0], m_DrawTrans, m_Offset, m_WrapX, m_WrapY, m_ScrollInfo);
+
+    m_pFGColor->Destroy();
+    m_pFGColor->Create(layerBitmaps[1], true, m_Offset, m_WrapX, m_WrapY, m_ScrollRatio);
+
+    m_pBGColor->Destroy();
+    m_pBGColor->Create(layerBitmaps[2], true, m_Offset, m_WrapX, m_WrapY, m_ScrollRatio);
+
+    destroy_bitmap(m_pStructural);
+    m_pStructural = create_bitmap_ex(8, width, height);
+    RTEAssert(m_pStructural, "Failed to allocate BITMAP in SLTerrain::LoadLayerCache");
+    clear_bitmap(m_pStructural);
+
+    return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          SaveLayerCache
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Writes the fully processed material, foreground and background layers
+//                  of this to the layer cache file.
+
+bool SLTerrain::SaveLayerCache(uint64_t cacheKey) const
+{
+    const std::string cacheDirectory = System::GetWorkingDirectory() + System::GetSceneCacheDirectory();
+    if (!std::filesystem::exists(cacheDirectory) && !System::MakeDirectory(cacheDirectory))
+        return false;
+
+    // Write to a temporary file first and swap it in once complete, so an interrupted write can never leave a half written cache behind
+    const std::string cachePath = GetLayerCachePath();
+    const std::string tempCachePath = cachePath + ".tmp";
+    std::ofstream cacheFile(tempCachePath, std::ios::binary | std::ios::trunc);
+    if (!cacheFile.is_open())
+        return false;
+
+    // The header is followed by the raw 8 bit pixels of the material, foreground and background layers, row by row with no padding.
+    // Each layer starts on an alignment boundary so the file can be memory mapped and the layers used in place.
+    const std::array<BITMAP *, 3> layerBitmaps = { m_pMainBitmap, m_pFGColor->GetBitmap(), m_pBGColor->GetBitmap() };
+    const int32_t width = m_pMainBitmap->w;
+    const int32_t height = m_pMainBitmap->h;
+    const uint64_t layerSize = static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
+    const uint64_t alignedLayerSize = ((layerSize + m_sLayerCacheAlignment - 1) / m_sLayerCacheAlignment) * m_sLayerCacheAlignment;
+
+    std::array<uint64_t, 3> layerOffsets;
+    for (size_t layer = 0; layer < layerOffsets.size(); ++layer)
+        layerOffsets[layer] = m_sLayerCacheAlignment + layer * alignedLayerSize;
+
+    cacheFile.write("C4LC", 4);
+    cacheFile.write(reinterpret_cast<const char *>(&m_sLayerCacheVersion), sizeof(m_sLayerCacheVersion));
+    cacheFile.write(reinterpret_cast<const char *>(&cacheKey), sizeof(cacheKey));
+    cacheFile.write(reinterpret_cast<const char *>(&width), sizeof(width));
+    cacheFile.write(reinterpret_cast<const char *>(&height), sizeof(height));
+    cacheFile.write(reinterpret_cast<const char *>(layerOffsets.data()), sizeof(layerOffsets));
+
+    for (size_t layer = 0; layer < layerBitmaps.size(); ++layer)
+    {
+        cacheFile.seekp(layerOffsets[layer]);
+        for (int y = 0; y < height; ++y)
+            cacheFile.write(reinterpret_cast<const char *>(layerBitmaps[layer]->line[y]), width);
+    }
+    // Pad out the last layer so every layer in the file is the same aligned size
+    cacheFile.seekp(layerOffsets.back() + alignedLayerSize - 1);
+    cacheFile.put(0);
+    cacheFile.close();
+
+    if (cacheFile.fail())
+    {
+        std::remove(tempCachePath.c_str());
+        return false;
+    }
+    std::error_code renameError;
+    std::filesystem::rename(tempCachePath, cachePath, renameError);
+    return !renameError;
+}
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Virtual method:  SaveData
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Saves currently data in memory to disk.
 
-int SLTerrain::SaveData(string pathBase)
+int SLTerrain::SaveData(string pathBase, bool doAsyncSave, const std::function<void(bool)> &onSaved)
 {
     if (pathBase.empty())
         return -1;
 
     // Save the bitmap of the material bitmap
-    if (SceneLayer::SaveData(pathBase + " Mat.bmp") < 0)
+    if (SceneLayer::SaveData(pathBase + " Mat.bmp", doAsyncSave, onSaved) < 0)
     {
         RTEAbort("Failed to write the material bitmap data saving an SLTerrain!");
         return -1;
     }
     // Then the foreground color layer
-    if (m_pFGColor->SaveData(pathBase + " FG.bmp") < 0)
+    if (m_pFGColor->SaveData(pathBase + " FG.bmp", doAsyncSave, onSaved) < 0)
     {
         RTEAbort("Failed to write the FG color bitmap data saving an SLTerrain!");
         return -1;
     }
     // Then the background color layer
-    if (m_pBGColor->SaveData(pathBase + " BG.bmp") < 0)
+    if (m_pBGColor->SaveData(pathBase + " BG.bmp", doAsyncSave, onSaved) < 0)
     {
         RTEAbort("Failed to write the BG color bitmap data saving an SLTerrain!");
         return -1;
@@ -879,6 +1122,7 @@ void SLTerrain::SetBGColorPixel(const int pixelX, const int pixelY, const int co
 
 //    RTEAssert(m_pBGColor->GetBitmap()->m_LockCount > 0, "Trying to access unlocked terrain bitmap");
     _putpixel(m_pBGColor->GetBitmap(), posX, posY, color);
+    m_pBGColor->RegisterChange(posX, posY, 1, 1);
 }
 
 
@@ -1129,7 +1373,7 @@ void SLTerrain::ApplyMovableObject(MovableObject *pMObject)
         clear_to_color(pTempBitmap, g_MaskColor);
         // Draw the actor and then the scene foreground to temp bitmap
         pMOSprite->Draw(pTempBitmap, bitmapScroll, g_DrawColor, true);
-        m_pFGColor->Draw(pTempBitmap, notUsed, bitmapScroll);
+        m_pFGColor->Draw(pTempBitmap, notUsed, &bitmapScroll, false);
         // Finally draw temporary bitmap to the Scene
         masked_blit(pTempBitmap, GetFGColorBitmap(), 0, 0, bitmapScroll.m_X, bitmapScroll.m_Y, pTempBitmap->w, pTempBitmap->h);
 
@@ -1158,7 +1402,7 @@ void SLTerrain::ApplyMovableObject(MovableObject *pMObject)
         clear_to_color(pTempBitmap, g_MaterialAir);
         // Draw the actor and then the scene material layer to temp bitmap
         pMOSprite->Draw(pTempBitmap, bitmapScroll, g_DrawMaterial, true);
-        SceneLayer::Draw(pTempBitmap, notUsed, bitmapScroll);
+        SceneLayer::Draw(pTempBitmap, notUsed, &bitmapScroll, false);
         // Finally draw temporary bitmap to the Scene
         masked_blit(pTempBitmap, GetMaterialBitmap(), 0, 0, bitmapScroll.m_X, bitmapScroll.m_Y, pTempBitmap->w, pTempBitmap->h);
         // Add a box to the updated areas list to show there's been change to the materials layer
@@ -1202,6 +1446,7 @@ void SLTerrain::RegisterTerrainChange(TerrainObject *pTObject)
 
 	if (pTObject->HasBGColor())
 	{
+		m_pBGColor->RegisterChange(loc.GetFloorIntX(), loc.GetFloorIntY(), pTObject->GetBitmapWidth(), pTObject->GetBitmapHeight());
 		g_SceneMan.RegisterTerrainChange(loc.m_X, loc.m_Y, pTObject->GetBitmapWidth(), pTObject->GetBitmapHeight(), g_MaskColor, true);
 	}
 
@@ -1221,37 +1466,66 @@ void SLTerrain::ApplyTerrainObject(TerrainObject *pTObject)
     if (!pTObject)
         return;
 
+    DrawTerrainObject(pTObject, m_pMainBitmap, m_pFGColor->GetBitmap(), m_pBGColor->GetBitmap(), 0);
+
+    CommitTerrainObject(pTObject);
+
+//    CleanAir();
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          DrawTerrainObject
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Draws a passed in TerrainObject's graphical and material
+//                  representations onto the passed in layer bitmaps, which may be
+//                  full-width bands of this Terrain's respective layers.
+
+void SLTerrain::DrawTerrainObject(TerrainObject *pTObject, BITMAP *pMaterialTarget, BITMAP *pFGTarget, BITMAP *pBGTarget, int targetTop) const
+{
     Vector loc = pTObject->GetPos() + pTObject->GetBitmapOffset();
+    loc.m_Y -= targetTop;
 
     // Do duplicate drawing if the terrain object straddles a wrapping border
     if (loc.m_X < 0)
     {
-        draw_sprite(m_pMainBitmap, pTObject->GetMaterialBitmap(), loc.m_X + m_pMainBitmap->w, loc.m_Y);
-        draw_sprite(m_pFGColor->GetBitmap(), pTObject->GetFGColorBitmap(), loc.m_X + m_pFGColor->GetBitmap()->w, loc.m_Y);
+        draw_sprite(pMaterialTarget, pTObject->GetMaterialBitmap(), loc.m_X + pMaterialTarget->w, loc.m_Y);
+        draw_sprite(pFGTarget, pTObject->GetFGColorBitmap(), loc.m_X + pFGTarget->w, loc.m_Y);
         if (pTObject->HasBGColor())
-            draw_sprite(m_pBGColor->GetBitmap(), pTObject->GetBGColorBitmap(), loc.m_X + m_pBGColor->GetBitmap()->w, loc.m_Y);
+            draw_sprite(pBGTarget, pTObject->GetBGColorBitmap(), loc.m_X + pBGTarget->w, loc.m_Y);
     }
-    else if (loc.m_X >= m_pMainBitmap->w - pTObject->GetFGColorBitmap()->w)
+    else if (loc.m_X >= pMaterialTarget->w - pTObject->GetFGColorBitmap()->w)
     {
-        draw_sprite(m_pMainBitmap, pTObject->GetMaterialBitmap(), loc.m_X - m_pMainBitmap->w, loc.m_Y);
-        draw_sprite(m_pFGColor->GetBitmap(), pTObject->GetFGColorBitmap(), loc.m_X - m_pFGColor->GetBitmap()->w, loc.m_Y);
+        draw_sprite(pMaterialTarget, pTObject->GetMaterialBitmap(), loc.m_X - pMaterialTarget->w, loc.m_Y);
+        draw_sprite(pFGTarget, pTObject->GetFGColorBitmap(), loc.m_X - pFGTarget->w, loc.m_Y);
         if (pTObject->HasBGColor())
-            draw_sprite(m_pBGColor->GetBitmap(), pTObject->GetBGColorBitmap(), loc.m_X - m_pBGColor->GetBitmap()->w, loc.m_Y);
+            draw_sprite(pBGTarget, pTObject->GetBGColorBitmap(), loc.m_X - pBGTarget->w, loc.m_Y);
     }
 
     // Regular drawing
-    draw_sprite(m_pMainBitmap, pTObject->GetMaterialBitmap(), loc.m_X, loc.m_Y);
-    draw_sprite(m_pFGColor->GetBitmap(), pTObject->GetFGColorBitmap(), loc.m_X, loc.m_Y);
+    draw_sprite(pMaterialTarget, pTObject->GetMaterialBitmap(), loc.m_X, loc.m_Y);
+    draw_sprite(pFGTarget, pTObject->GetFGColorBitmap(), loc.m_X, loc.m_Y);
 	if (pTObject->HasBGColor())
-	{
-		draw_sprite(m_pBGColor->GetBitmap(), pTObject->GetBGColorBitmap(), loc.m_X, loc.m_Y);
-		g_SceneMan.RegisterTerrainChange(loc.m_X, loc.m_Y, pTObject->GetBitmapWidth(), pTObject->GetBitmapHeight(), g_MaskColor, true);
-	}
+		draw_sprite(pBGTarget, pTObject->GetBGColorBitmap(), loc.m_X, loc.m_Y);
+}
 
-	// Register terrain change
-	g_SceneMan.RegisterTerrainChange(loc.m_X, loc.m_Y, pTObject->GetBitmapWidth(), pTObject->GetBitmapHeight(), g_MaskColor, false);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          CommitTerrainObject
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Does everything ApplyTerrainObject does besides drawing the TerrainObject
+//                  onto the layers.
+
+void SLTerrain::CommitTerrainObject(TerrainObject *pTObject)
+{
+    if (!pTObject)
+        return;
+
+    // Register terrain change
+    RegisterTerrainChange(pTObject);
 
     // Add a box to the updated areas list to show there's been change to the materials layer
+    Vector loc = pTObject->GetPos() + pTObject->GetBitmapOffset();
     m_UpdatedMateralAreas.push_back(Box(loc, pTObject->GetMaterialBitmap()->w, pTObject->GetMaterialBitmap()->h));
 
     // Apply all the child objects of the TO, and first reapply the team so all its children are guaranteed to be on the same team!
@@ -1262,8 +1536,6 @@ void SLTerrain::ApplyTerrainObject(TerrainObject *pTObject)
         // Copy and apply, transferring ownership of the new copy into the application
         g_SceneMan.AddSceneObject((*itr).GetPlacedCopy(pTObject));
     }
-
-//    CleanAir();
 }
 
 
@@ -1302,45 +1574,48 @@ void SLTerrain::CleanAirBox(Box box, bool wrapsX, bool wrapsY)
 
     int width = m_pMainBitmap->w;
     int height = m_pMainBitmap->h;
-    unsigned char matPixel;
-
-	for (int y = box.m_Corner.m_Y; y < box.m_Corner.m_Y + box.m_Height; ++y) {
-		for (int x = box.m_Corner.m_X; x < box.m_Corner.m_X + box.m_Width; ++x) {
-			float wrapX = x;
-			float wrapY = y;
-
-			//Fix coords in case of seam
-			if (wrapsX)
-			{
-				if (wrapX < 0)
-					wrapX = wrapX + m_pMainBitmap->w;
-
-				if (wrapX >= m_pMainBitmap->w)
-					wrapX = wrapX - m_pMainBitmap->w;
-			}
-
-			if (wrapsY)
-			{
-				if (wrapY < 0)
-					wrapY = wrapY + m_pMainBitmap->h;
-
-				if (wrapY >= m_pMainBitmap->h)
-					wrapY = wrapY - m_pMainBitmap->h;
-			}
-
-			if (wrapX >= 0 && wrapY >=0 && wrapX < width && wrapY < height)
-			{
-				matPixel = _getpixel(m_pMainBitmap, wrapX, wrapY);
-				if (matPixel == g_MaterialCavity) {
-					_putpixel(m_pMainBitmap, wrapX, wrapY, g_MaterialAir);
-					matPixel = g_MaterialAir;
-				}
-				if (matPixel == g_MaterialAir)
-					_putpixel(m_pFGColor->GetBitmap(), wrapX, wrapY, g_MaskColor);
-			}
 
+    // Rows don't affect each other, so big boxes get split into bands of them that are cleaned in parallel
+    g_ThreadMan.ParallelFor(static_cast<int>(box.m_Corner.m_Y), static_cast<int>(std::ceil(box.m_Corner.m_Y + box.m_Height)), m_sLoadBandHeight, [&](int bandTop, int bandBottom) {
+        unsigned char matPixel;
+
+        for (int y = bandTop; y < bandBottom; ++y) {
+            for (int x = box.m_Corner.m_X; x < box.m_Corner.m_X + box.m_Width; ++x) {
+                float wrapX = x;
+                float wrapY = y;
+
+                //Fix coords in case of seam
+                if (wrapsX)
+                {
+                    if (wrapX < 0)
+                        wrapX = wrapX + m_pMainBitmap->w;
+
+                    if (wrapX >= m_pMainBitmap->w)
+                        wrapX = wrapX - m_pMainBitmap->w;
+                }
+
+                if (wrapsY)
+                {
+                    if (wrapY < 0)
+                        wrapY = wrapY + m_pMainBitmap->h;
+
+                    if (wrapY >= m_pMainBitmap->h)
+                        wrapY = wrapY - m_pMainBitmap->h;
+                }
+
+                if (wrapX >= 0 && wrapY >=0 && wrapX < width && wrapY < height)
+                {
+                    matPixel = _getpixel(m_pMainBitmap, wrapX, wrapY);
+                    if (matPixel == g_MaterialCavity) {
+                        _putpixel(m_pMainBitmap, wrapX, wrapY, g_MaterialAir);
+                        matPixel = g_MaterialAir;
+                    }
+                    if (matPixel == g_MaterialAir)
+                        _putpixel(m_pFGColor->GetBitmap(), wrapX, wrapY, g_MaskColor);
+                }
+            }
         }
-    }
+    });
 
     release_bitmap(m_pMainBitmap);
     release_bitmap(m_pFGColor->GetBitmap());
@@ -1360,19 +1635,21 @@ void SLTerrain::CleanAir()
 
     int width = m_pMainBitmap->w;
     int height = m_pMainBitmap->h;
-    unsigned char matPixel;
-
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            matPixel = _getpixel(m_pMainBitmap, x, y);
-            if (matPixel == g_MaterialCavity) {
-                _putpixel(m_pMainBitmap, x, y, g_MaterialAir);
-                matPixel = g_MaterialAir;
+
+    g_ThreadMan.ParallelFor(0, height, m_sLoadBandHeight, [this, width](int bandTop, int bandBottom) {
+        unsigned char matPixel;
+        for (int y = bandTop; y < bandBottom; ++y) {
+            for (int x = 0; x < width; ++x) {
+                matPixel = _getpixel(m_pMainBitmap, x, y);
+                if (matPixel == g_MaterialCavity) {
+                    _putpixel(m_pMainBitmap, x, y, g_MaterialAir);
+                    matPixel = g_MaterialAir;
+                }
+                if (matPixel == g_MaterialAir)
+                    _putpixel(m_pFGColor->GetBitmap(), x, y, g_MaskColor);
             }
-            if (matPixel == g_MaterialAir)
-                _putpixel(m_pFGColor->GetBitmap(), x, y, g_MaskColor);
         }
-    }
+    });
 
     release_bitmap(m_pMainBitmap);
     release_bitmap(m_pFGColor->GetBitmap());
@@ -1411,9 +1688,9 @@ void SLTerrain::Update()
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Draws this SLTerrain's current scrolled position to a bitmap.
 
-void SLTerrain::DrawBackground(BITMAP *pTargetBitmap, Box &targetBox, const Vector &scrollOverride)
+void SLTerrain::DrawBackground(BITMAP *pTargetBitmap, Box &targetBox, const Vector *scrollOverride, bool fitToScreen)
 {
-    m_pBGColor->Draw(pTargetBitmap, targetBox, scrollOverride);
+    m_pBGColor->Draw(pTargetBitmap, targetBox, scrollOverride, fitToScreen);
 }
 
 
@@ -1422,15 +1699,15 @@ void SLTerrain::DrawBackground(BITMAP *pTargetBitmap, Box &targetBox, const Vect
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Draws this SLTerrain's current scrolled position to a bitmap.
 
-void SLTerrain::Draw(BITMAP *pTargetBitmap, Box &targetBox, const Vector &scrollOverride) const
+void SLTerrain::Draw(BITMAP *pTargetBitmap, Box &targetBox, const Vector *scrollOverride, bool fitToScreen) const
 {
     if (m_DrawMaterial)
     {
-        SceneLayer::Draw(pTargetBitmap, targetBox, scrollOverride);
+        SceneLayer::Draw(pTargetBitmap, targetBox, scrollOverride, fitToScreen);
     }
     else
     {
-        m_pFGColor->Draw(pTargetBitmap, targetBox, scrollOverride);
+        m_pFGColor->Draw(pTargetBitmap, targetBox, scrollOverride, fitToScreen);
     }
 }
 
@@ -130,6 +130,26 @@ class SLTerrain : public SceneLayer {
 		int GetThicknessSample() { return m_MinThickness + RandomNum(0, m_MaxThickness - m_MinThickness); }
 
 
+    //////////////////////////////////////////////////////////////////////////////////////////
+    // Method:          GetMinThickness
+    //////////////////////////////////////////////////////////////////////////////////////////
+    // Description:     Gets the minimum thickness of this TerrainFrosting.
+    // Arguments:       None.
+    // Return value:    The minimum thickness, in pixels.
+
+		int GetMinThickness() const { return m_MinThickness; }
+
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    // Method:          GetMaxThickness
+    //////////////////////////////////////////////////////////////////////////////////////////
+    // Description:     Gets the maximum thickness of this TerrainFrosting.
+    // Arguments:       None.
+    // Return value:    The maximum thickness, in pixels.
+
+		int GetMaxThickness() const { return m_MaxThickness; }
+
+
     //////////////////////////////////////////////////////////////////////////////////////////
     // Virtual method:  InAirOnly
     //////////////////////////////////////////////////////////////////////////////////////////
@@ -282,10 +302,14 @@ ClassInfoGetters
 // Description:     Saves data currently in memory to disk.
 // Arguments:       The filepath base to the where to save the Bitmap data. This means
 //                  everything up to the extension. "FG" and "Mat" etc will be added.
+//                  Whether to copy the layers and write the copies to disk on ThreadMan
+//                  workers instead of blocking until they're written.
+//                  Callback run on the main thread once each layer of an async save is
+//                  written, with whether the write succeeded.
 // Return value:    An error return value signaling success or any particular failure.
 //                  Anything below 0 is an error signal.
 
-	int SaveData(std::string pathBase) override;
+	int SaveData(std::string pathBase, bool doAsyncSave = false, const std::function<void(bool)> &onSaved = nullptr) override;
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -377,6 +401,17 @@ ClassInfoGetters
     BITMAP * GetBGColorBitmap() { return m_pBGColor->GetBitmap(); }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetBGColorLayer
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the background color layer of this SLTerrain, to register changes
+//                  drawn directly onto its bitmap with.
+// Arguments:       None.
+// Return value:    A pointer to the background color layer. Ownership is NOT transferred!
+
+    SceneLayer * GetBGColorLayer() { return m_pBGColor; }
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetMaterialBitmap
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -664,11 +699,14 @@ ClassInfoGetters
 // Arguments:       The bitmap to draw to.
 //                  The box on the target bitmap to limit drawing to, with the corner of
 //                  box being where the scroll position lines up.
-//                  If a non-{-1,-1} vector is passed, the internal scroll offset of this
-//                  is overridder with it. It becomes the new source coordinates.
+//                  If a vector is passed, the internal scroll offset of this is overridden
+//                  with it. It becomes the new source coordinates, which aren't kept
+//                  within the layer's bounds.
+//                  Whether to center the layer on the target, or fill around it, where
+//                  the target is larger than the scene, as is done for player screens.
 // Return value:    None.
 
-	void DrawBackground(BITMAP *pTargetBitmap, Box& targetBox, const Vector &scrollOverride = Vector(-1, -1));
+	void DrawBackground(BITMAP *pTargetBitmap, Box& targetBox, const Vector *scrollOverride = nullptr, bool fitToScreen = true);
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -678,11 +716,14 @@ ClassInfoGetters
 // Arguments:       The bitmap to draw to.
 //                  The box on the target bitmap to limit drawing to, with the corner of
 //                  box being where the scroll position lines up.
-//                  If a non-{-1,-1} vector is passed, the internal scroll offset of this
-//                  is overridder with it. It becomes the new source coordinates.
+//                  If a vector is passed, the internal scroll offset of this is overridden
+//                  with it. It becomes the new source coordinates, which aren't kept
+//                  within the layer's bounds.
+//                  Whether to center the layer on the target, or fill around it, where
+//                  the target is larger than the scene, as is done for player screens.
 // Return value:    None.
 
-	void Draw(BITMAP *pTargetBitmap, Box& targetBox, const Vector &scrollOverride = Vector(-1, -1)) const override;
+	void Draw(BITMAP *pTargetBitmap, Box& targetBox, const Vector *scrollOverride = nullptr, bool fitToScreen = true) const override;
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Protected member variable and method declarations
@@ -692,6 +733,13 @@ protected:
     // Member variables
     static Entity::ClassInfo m_sClass;
 
+    // Version of the binary layer cache file layout. Bump whenever the layout or the terrain generation process changes, so old caches are discarded
+    static const uint32_t m_sLayerCacheVersion;
+    // Alignment of each layer's pixel data in the layer cache file, so the file can be memory mapped and the layers used in place
+    static const uint32_t m_sLayerCacheAlignment;
+    // Height of the bands of rows (or width of the bands of columns) the load time passes over the layers get split into to be run in parallel
+    static const int m_sLoadBandHeight;
+
     SceneLayer *m_pFGColor;
     SceneLayer *m_pBGColor;
     BITMAP *m_pStructural;
@@ -740,6 +788,79 @@ private:
     void Clear();
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetLayerCacheKey
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Calculates a hash of everything that goes into generating the material
+//                  and color layers of this SLTerrain: the contents of the source files,
+//                  the material palette and the DataModule's material mappings, and all
+//                  frostings, debris and TerrainObjects.
+// Arguments:       None.
+// Return value:    The layer cache key. Stable between runs and platforms.
+
+    uint64_t GetLayerCacheKey() const;
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetLayerCachePath
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the path of the layer cache file of this SLTerrain. There is only
+//                  one cache file per material bitmap, so stale caches get overwritten.
+// Arguments:       None.
+// Return value:    The path to the layer cache file.
+
+    std::string GetLayerCachePath() const;
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          LoadLayerCache
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Creates the material, foreground and background layers of this from
+//                  the layer cache file, if one exists and matches the passed in key.
+// Arguments:       The key the cache file must have been saved with to be used.
+// Return value:    Whether the layers were loaded from the cache. If false, nothing of
+//                  this SLTerrain was changed and the layers need to be generated.
+
+    bool LoadLayerCache(uint64_t cacheKey);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          SaveLayerCache
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Writes the fully processed material, foreground and background layers
+//                  of this to the layer cache file.
+// Arguments:       The key to save the cache file with.
+// Return value:    Whether the cache file was written successfully.
+
+    bool SaveLayerCache(uint64_t cacheKey) const;
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          CommitTerrainObject
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Does everything ApplyTerrainObject does besides drawing the TerrainObject
+//                  onto the layers: registers the terrain change and the updated material
+//                  area, and places copies of all the TerrainObject's child objects.
+// Arguments:       The TerrainObject that was drawn onto this. Ownership is NOT transferred!
+// Return value:    None.
+
+    void CommitTerrainObject(TerrainObject *pTObject);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          DrawTerrainObject
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Draws a TerrainObject's material and color representations onto the
+//                  passed in bitmaps, without registering anything.
+// Arguments:       The TerrainObject to draw. Ownership is NOT transferred!
+//                  The material, foreground and background bitmaps to draw onto. These
+//                  are either the layers themselves, or full-width bands of them.
+//                  The row of the layers the top of the passed in bitmaps is at.
+// Return value:    None.
+
+    void DrawTerrainObject(TerrainObject *pTObject, BITMAP *pMaterialTarget, BITMAP *pFGTarget, BITMAP *pBGTarget, int targetTop) const;
+
+
     // Disallow the use of some implicit methods.
 	SLTerrain(const SLTerrain &reference) = delete;
 	SLTerrain & operator=(const SLTerrain &rhs) = delete;
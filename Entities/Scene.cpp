@@ -461,6 +461,8 @@ void Scene::Clear()
     m_Locked = false;
     m_GlobalAcc.Reset();
     m_ScenePath.clear();
+    m_ScenePathRequests.clear();
+    m_LastScenePathRequestID = 0;
 	m_SelectedAssemblies.clear();
     m_AssembliesCounts.clear();
 	m_pPreviewBitmap = 0;
@@ -1018,7 +1020,7 @@ int Scene::ExpandAIPlanAssemblySchemes()
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Saves currently loaded bitmap data in memory to disk.
 
-int Scene::SaveData(string pathBase)
+int Scene::SaveData(string pathBase, bool doAsyncSave)
 {
     if (pathBase.empty())
         return -1;
@@ -1026,12 +1028,34 @@ int Scene::SaveData(string pathBase)
     if (!m_pTerrain)
         return 0;
 
+    long long saveStartTime = g_TimerMan.GetAbsoluteTime();
+    std::string sceneName = GetPresetName();
+
+    // Keep tally of the layers still being written by workers, so the whole Scene's save can be reported once the last one is done.
+    // The callbacks are only ever run on the main thread, after this has finished queuing up all the layers.
+    std::shared_ptr<int> layersLeftToSave = std::make_shared<int>(0);
+    std::shared_ptr<bool> anyLayerFailed = std::make_shared<bool>(false);
+    std::function<void(bool)> onLayerSaved = nullptr;
+    if (doAsyncSave)
+    {
+        onLayerSaved = [layersLeftToSave, anyLayerFailed, saveStartTime, sceneName](bool savedSuccessfully) {
+            *anyLayerFailed = *anyLayerFailed || !savedSuccessfully;
+            if (--(*layersLeftToSave) == 0 && !*anyLayerFailed)
+                g_ConsoleMan.PrintString("SYSTEM: Scene \"" + sceneName + "\" was saved in " + std::to_string((g_TimerMan.GetAbsoluteTime() - saveStartTime) / 1000) + "ms");
+        };
+    }
+
     // Save Terrain's data
-    if (m_pTerrain->SaveData(pathBase) < 0)
+    if (m_pTerrain->SaveData(pathBase, doAsyncSave, onLayerSaved) < 0)
     {
         RTEAbort("Saving Terrain " + m_pTerrain->GetPresetName() + "\'s data failed!");
         return -1;
     }
+    for (const BITMAP *pTerrainLayerBitmap : { m_pTerrain->GetMaterialBitmap(), m_pTerrain->GetFGColorBitmap(), m_pTerrain->GetBGColorBitmap() })
+    {
+        if (pTerrainLayerBitmap)
+            ++(*layersLeftToSave);
+    }
 
     // Don't bother saving background layers to disk, as they are never altered
 
@@ -1043,14 +1067,19 @@ int Scene::SaveData(string pathBase)
         {
             std::snprintf(str, sizeof(str), "T%d", team);
             // Save unseen layer data to disk
-            if (m_apUnseenLayer[team]->SaveData(pathBase + " US" + str + ".bmp") < 0)
+            if (m_apUnseenLayer[team]->SaveData(pathBase + " US" + str + ".bmp", doAsyncSave, onLayerSaved) < 0)
             {
                 g_ConsoleMan.PrintString("ERROR: Saving unseen layer " + m_apUnseenLayer[team]->GetPresetName() + "\'s data failed!");
                 return -1;
             }
+            if (m_apUnseenLayer[team]->GetBitmap())
+                ++(*layersLeftToSave);
         }
     }
 
+    if (!doAsyncSave)
+        g_ConsoleMan.PrintString("SYSTEM: Scene \"" + sceneName + "\" was saved in " + std::to_string((g_TimerMan.GetAbsoluteTime() - saveStartTime) / 1000) + "ms");
+
     return 0;
 }
 
@@ -1633,8 +1662,9 @@ int Scene::Save(Writer &writer) const
 
 void Scene::Destroy(bool notInherited)
 {
-    delete m_pTerrain;
+    // The pathfinder waits for any paths still being calculated, which look at the terrain's dimensions
     delete m_pPathFinder;
+    delete m_pTerrain;
 
     for (int player = Players::PlayerOne; player < Players::MaxPlayerCount; ++player)
         delete m_ResidentBrains[player];
@@ -2902,17 +2932,44 @@ void Scene::ResetPathFinding()
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
-// Method:          UpdatePathFinding
+// Method:          UpdateOutdatedPathFinding
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Recalculates only the areas of the pathfinding data that have been
 //                  marked as outdated.
 
-void Scene::UpdatePathFinding()
+bool Scene::UpdateOutdatedPathFinding(bool deferIfBusy)
 {
-    m_pPathFinder->RecalculateAreaCosts(m_pTerrain->GetUpdatedMaterialAreas());
+    if (!m_pPathFinder->RecalculateAreaCosts(m_pTerrain->GetUpdatedMaterialAreas(), deferIfBusy))
+        return false;
     m_pTerrain->ClearUpdatedAreas();
     m_PartialPathUpdateTimer.Reset();
     m_PathfindingUpdated = true;
+    return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetPathCostUpdateCount
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets how many pathfinding updates so far actually changed the cost of
+//                  getting anywhere. Used to tell whether paths may have become outdated.
+
+unsigned int Scene::GetPathCostUpdateCount() const
+{
+    return m_pPathFinder ? m_pPathFinder->GetCostUpdateCount() : 0;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          IsPathOutdated
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Tells whether the terrain along a path has changed since it was
+//                  calculated, so it may not be the least difficult way anymore, or may
+//                  not even be passable.
+
+bool Scene::IsPathOutdated(const std::list<Vector> &path, unsigned int costUpdateCount) const
+{
+    return m_pPathFinder && m_pPathFinder->IsPathChangedSince(path, costUpdateCount);
 }
 
 
@@ -2951,7 +3008,8 @@ int Scene::CalculateScenePath(const Vector start, const Vector end, bool movePat
     if (m_pPathFinder)
     {
         float notUsed;
-        m_pPathFinder->CalculatePath(start, end, m_ScenePath, notUsed, digStrength);
+        if (!m_pPathFinder->GetFlowFieldPath(start, end, m_ScenePath, notUsed, digStrength))
+            m_pPathFinder->CalculatePath(start, end, m_ScenePath, notUsed, digStrength);
 
         // Process the new path we now have, if any
         if (!m_ScenePath.empty())
@@ -2971,6 +3029,92 @@ int Scene::CalculateScenePath(const Vector start, const Vector end, bool movePat
 }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetFlowFieldPath
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the least difficult path between two points on the current scene
+//                  right away from a flow field shared by everything heading to the same
+//                  place, if paths are asked for to there often enough to have one.
+
+bool Scene::GetFlowFieldPath(const Vector &start, const Vector &end, std::list<Vector> &pathResult, float digStrength)
+{
+    float notUsed;
+    return m_pPathFinder && m_pPathFinder->GetFlowFieldPath(start, end, pathResult, notUsed, digStrength);
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          CalculatePathAsync
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Queues the least difficult path between two points on the current
+//                  scene to be calculated on the worker threads, without waiting for it.
+
+std::shared_ptr<PathRequest> Scene::CalculatePathAsync(const Vector &start, const Vector &end, float digStrength)
+{
+    return m_pPathFinder ? m_pPathFinder->CalculatePathAsync(start, end, digStrength) : nullptr;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          CalculateScenePathAsync
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Queues the least difficult path between two points on the current
+//                  scene to be calculated on the worker threads, without waiting for it.
+//                  For exposing CalculatePathAsync to Lua.
+
+int Scene::CalculateScenePathAsync(const Vector start, const Vector end, bool movePathToGround, float digStrength)
+{
+    std::shared_ptr<PathRequest> pathRequest = CalculatePathAsync(start, end, digStrength);
+    if (!pathRequest)
+        return -1;
+
+    m_ScenePathRequests.try_emplace(++m_LastScenePathRequestID, pathRequest, movePathToGround);
+    return m_LastScenePathRequestID;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          IsScenePathRequestComplete
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Tells whether a path requested with CalculateScenePathAsync is done
+//                  being calculated and can be collected.
+
+bool Scene::IsScenePathRequestComplete(int requestID) const
+{
+    std::map<int, std::pair<std::shared_ptr<PathRequest>, bool>>::const_iterator requestItr = m_ScenePathRequests.find(requestID);
+    return requestItr == m_ScenePathRequests.end() || requestItr->second.first->Complete;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetScenePathRequestResult
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Collects the path of a completed request made with
+//                  CalculateScenePathAsync into m_ScenePath, and forgets the request.
+
+int Scene::GetScenePathRequestResult(int requestID)
+{
+    std::map<int, std::pair<std::shared_ptr<PathRequest>, bool>>::iterator requestItr = m_ScenePathRequests.find(requestID);
+    if (requestItr == m_ScenePathRequests.end() || !requestItr->second.first->Complete)
+        return -1;
+
+    m_ScenePath = std::move(requestItr->second.first->Path);
+    bool movePathToGround = requestItr->second.second;
+    m_ScenePathRequests.erase(requestItr);
+
+    if (m_ScenePath.empty())
+        return -1;
+
+    if (movePathToGround)
+    {
+        // Smash all airborne waypoints down to just above the ground
+        for (Vector &pathPoint : m_ScenePath)
+            pathPoint = g_SceneMan.MovePointToGround(pathPoint, 20, 15);
+    }
+    return m_ScenePath.size();
+}
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          Lock
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -3043,9 +3187,9 @@ void Scene::Update()
         m_PathfindingUpdated = true;
     }
 
-    // Do partial update every 10 seconds
+    // Do partial update every 10 seconds, or as soon after as no paths are being solved
     if (m_PartialPathUpdateTimer.IsPastRealMS(10000))
-        UpdatePathFinding();
+        UpdatePathFindingIfIdle();
 }
 
 } // namespace RTE
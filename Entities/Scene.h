@@ -26,6 +26,7 @@ namespace RTE
 class ContentFile;
 class MovableObject;
 class PathFinder;
+struct PathRequest;
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -380,10 +381,15 @@ EntityAllocation(Scene)
 // Description:     Saves data currently in memory to disk.
 // Arguments:       The filepath base to the where to save the Bitmap data. This means
 //                  everything up to the extension. "FG" and "Mat" etc will be added.
+//                  Whether to snapshot the layers and write them to disk on ThreadMan
+//                  workers, so play can continue while saving. The time the save took
+//                  is reported in the console once all layers are written. Only opt in
+//                  where the files are read back through LoadData, which waits for the
+//                  writes to finish.
 // Return value:    An error return value signaling success or any particular failure.
 //                  Anything below 0 is an error signal.
 
-	int SaveData(std::string pathBase);
+	int SaveData(std::string pathBase, bool doAsyncSave = false);
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -589,6 +595,17 @@ EntityAllocation(Scene)
     SLTerrain * GetTerrain() { return m_pTerrain; }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetPathFinder
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the PathFinder of this Scene.
+// Arguments:       None.
+// Return value:    A pointer to the PathFinder, or 0 if pathfinding isn't set up.
+//                  Ownership is NOT transferred!
+
+    PathFinder * GetPathFinder() { return m_pPathFinder; }
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetBackLayers
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1175,11 +1192,25 @@ const SceneObject * PickPlacedActorInRange(int whichSet, Vector &scenePoint, int
 // Method:          UpdatePathFinding
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Recalculates only the areas of the pathfinding data that have been
-//                  marked as outdated.
+//                  marked as outdated. Waits for any paths being solved on the worker
+//                  threads first.
 // Arguments:       None.
 // Return value:    None.
 
-    void UpdatePathFinding();
+    void UpdatePathFinding() { UpdateOutdatedPathFinding(false); }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          UpdatePathFindingIfIdle
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Recalculates only the areas of the pathfinding data that have been
+//                  marked as outdated, unless paths are being solved on the worker threads
+//                  right now. The areas are then kept marked and updated on a later call,
+//                  rather than waiting for the paths on this thread.
+// Arguments:       None.
+// Return value:    Whether the pathfinding data was updated.
+
+    bool UpdatePathFindingIfIdle() { return UpdateOutdatedPathFinding(true); }
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1192,6 +1223,30 @@ const SceneObject * PickPlacedActorInRange(int whichSet, Vector &scenePoint, int
     bool PathFindingUpdated() { return m_PathfindingUpdated; }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetPathCostUpdateCount
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets how many pathfinding updates so far actually changed the cost of
+//                  getting anywhere. Used to tell whether paths may have become outdated.
+// Arguments:       None.
+// Return value:    The number of pathfinding updates that changed any costs.
+
+    unsigned int GetPathCostUpdateCount() const;
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          IsPathOutdated
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Tells whether the terrain along a path has changed since it was
+//                  calculated, so it may not be the least difficult way anymore, or may
+//                  not even be passable.
+// Arguments:       The waypoints of the path to check.
+//                  The path cost update count from when the path was calculated.
+// Return value:    Whether the costs along the path have changed since then.
+
+    bool IsPathOutdated(const std::list<Vector> &path, unsigned int costUpdateCount) const;
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          CalculatePath
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1221,6 +1276,78 @@ const SceneObject * PickPlacedActorInRange(int whichSet, Vector &scenePoint, int
     int CalculateScenePath(const Vector start, const Vector end, bool movePathToGround, float digStrength = 1);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetFlowFieldPath
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the least difficult path between two points on the current scene
+//                  right away from a flow field shared by everything heading to the same
+//                  place, if paths are asked for to there often enough to have one.
+// Arguments:       Start and end positions on the scene to find the path between.
+//                  A list which will be filled out with waypoints between the start and end.
+//                  The maximum material strength any actor traveling along the path can
+//                  dig through.
+// Return value:    Whether the path was gotten from a flow field. If not, the path list is
+//                  left untouched and the path should be calculated normally instead.
+
+    bool GetFlowFieldPath(const Vector &start, const Vector &end, std::list<Vector> &pathResult, float digStrength = 1);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          CalculatePathAsync
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Queues the least difficult path between two points on the current
+//                  scene to be calculated on the worker threads, without waiting for it.
+//                  Takes both distance and materials into account.
+// Arguments:       Start and end positions on the scene to find the path between.
+//                  The maximum material strength any actor traveling along the path can
+//                  dig through.
+// Return value:    The request, which will be marked complete once the path has been
+//                  calculated. Null if this Scene has no pathfinding set up.
+
+    std::shared_ptr<PathRequest> CalculatePathAsync(const Vector &start, const Vector &end, float digStrength = 1);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          CalculateScenePathAsync
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Queues the least difficult path between two points on the current
+//                  scene to be calculated on the worker threads, without waiting for it.
+//                  Poll IsScenePathRequestComplete and then collect the path into
+//                  Scene.ScenePath with GetScenePathRequestResult.
+//                  For exposing CalculatePathAsync to Lua.
+// Arguments:       Start and end positions on the scene to find the path between.
+//                  If the path should be moved to the ground or not, once collected.
+//                  The maximum material strength any actor traveling along the path can
+//                  dig through.
+// Return value:    The ID of the request, or -1 if this Scene has no pathfinding set up.
+
+    int CalculateScenePathAsync(const Vector start, const Vector end, bool movePathToGround, float digStrength = 1);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          IsScenePathRequestComplete
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Tells whether a path requested with CalculateScenePathAsync is done
+//                  being calculated and can be collected.
+// Arguments:       The ID of the request.
+// Return value:    Whether the path is ready. Also true for unknown IDs, so nothing waits
+//                  on them forever.
+
+    bool IsScenePathRequestComplete(int requestID) const;
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetScenePathRequestResult
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Collects the path of a completed request made with
+//                  CalculateScenePathAsync into Scene.ScenePath, and forgets the request.
+// Arguments:       The ID of the request.
+// Return value:    The number of waypoints from start to goal, or -1 if no path or the
+//                  request is unknown or not complete yet.
+
+    int GetScenePathRequestResult(int requestID);
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetScenePathSize
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1312,6 +1439,10 @@ const SceneObject * PickPlacedActorInRange(int whichSet, Vector &scenePoint, int
 
     // Holds the path calculated by CalculateScenePath
     std::list<Vector> m_ScenePath;
+    // The path requests made through CalculateScenePathAsync that haven't been collected yet, by ID, along with whether to move their paths to the ground
+    std::map<int, std::pair<std::shared_ptr<PathRequest>, bool>> m_ScenePathRequests;
+    // The ID of the last path request made through CalculateScenePathAsync
+    int m_LastScenePathRequestID;
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Protected member variable and method declarations
@@ -1407,6 +1538,18 @@ private:
     void Clear();
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          UpdateOutdatedPathFinding
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Recalculates only the areas of the pathfinding data that have been
+//                  marked as outdated.
+// Arguments:       Whether to put the update off if paths are being solved on the worker
+//                  threads right now, rather than wait for them on this thread.
+// Return value:    Whether the pathfinding data was updated.
+
+    bool UpdateOutdatedPathFinding(bool deferIfBusy);
+
+
     // Disallow the use of some implicit methods.
     Scene(const Scene &reference) = delete;
     void operator=(const Scene &rhs) = delete;
@@ -13,11 +13,17 @@
 
 #include "SceneLayer.h"
 #include "ContentFile.h"
+#include "ConsoleMan.h"
+#include "ThreadMan.h"
 
 namespace RTE {
 
 ConcreteClassInfo(SceneLayer, Entity, 0);
 
+std::list<std::future<void>> SceneLayer::m_sPendingSaves;
+std::unordered_map<std::string, std::string> SceneLayer::m_sFailedSavePaths;
+std::mutex SceneLayer::m_sFailedSavePathsMutex;
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          Clear
@@ -43,6 +49,7 @@ void SceneLayer::Clear()
     m_FillRightColor = g_MaskColor;
     m_FillUpColor = g_MaskColor;
     m_FillDownColor = g_MaskColor;
+    m_ChangeCount = 0;
 }
 
 
@@ -104,6 +111,7 @@ int SceneLayer::Create(BITMAP *pBitmap,
     m_pMainBitmap = pBitmap;
     RTEAssert(m_pMainBitmap, "Null bitmap passed in when creating SceneLayer");
     m_MainBitmapOwned = true;
+    RegisterChange(0, 0, m_pMainBitmap->w, m_pMainBitmap->h);
 
     m_DrawTrans = drawTrans;
     m_Offset = offset;
@@ -175,6 +183,7 @@ int SceneLayer::Create(const SceneLayer &reference)
 
         // Copy!
         blit(pCopyFrom, m_pMainBitmap, 0, 0, 0, 0, pCopyFrom->w, pCopyFrom->h);
+        RegisterChange(0, 0, m_pMainBitmap->w, m_pMainBitmap->h);
 
         InitScrollRatios();
 
@@ -223,8 +232,13 @@ int SceneLayer::LoadData()
     // Copy!
     blit(pCopyFrom, m_pMainBitmap, 0, 0, 0, 0, pCopyFrom->w, pCopyFrom->h);
 */
+    // The file may still be getting written by an async save
+    WaitForPendingSaves();
+    // Fall back to the previous file if the save that was supposed to write the current one failed
+    m_BitmapFile.SetDataPath(GetSavedDataPath(m_BitmapFile.GetDataPath()));
     // Re-load directly from disk each time; don't do any caching of these bitmaps
     m_pMainBitmap = m_BitmapFile.GetAsBitmap(COLORCONV_NONE, false);
+    RegisterChange(0, 0, m_pMainBitmap->w, m_pMainBitmap->h);
 
     m_MainBitmapOwned = true;
 
@@ -245,7 +259,7 @@ int SceneLayer::LoadData()
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Saves current data in memory to disk.
 
-int SceneLayer::SaveData(string bitmapPath)
+int SceneLayer::SaveData(string bitmapPath, bool doAsyncSave, const std::function<void(bool)> &onSaved)
 {
     if (bitmapPath.empty())
         return -1;
@@ -255,10 +269,51 @@ int SceneLayer::SaveData(string bitmapPath)
     {
         PALETTE palette;
         get_palette(palette);
-        if (save_bmp(bitmapPath.c_str(), m_pMainBitmap, palette) != 0)
+
+        if (doAsyncSave)
+        {
+            // Take a copy of the layer as it is right now, so the sim can keep on modifying the original while the copy is encoded and written on a worker thread
+            BITMAP *pSnapshot = create_bitmap_ex(bitmap_color_depth(m_pMainBitmap), m_pMainBitmap->w, m_pMainBitmap->h);
+            if (!pSnapshot)
+                return -1;
+            blit(m_pMainBitmap, pSnapshot, 0, 0, 0, 0, m_pMainBitmap->w, m_pMainBitmap->h);
+
+            // Let go of the saves that have already finished
+            m_sPendingSaves.remove_if([](const std::future<void> &pendingSave) { return pendingSave.wait_for(std::chrono::seconds(0)) == std::future_status::ready; });
+
+            // A failed save is recorded on the worker itself, so anything that waits for pending saves sees it even before the completion callback has run
+            std::string previousPath = m_BitmapFile.GetDataPath();
+            {
+                std::lock_guard<std::mutex> failedSavePathsLock(m_sFailedSavePathsMutex);
+                m_sFailedSavePaths.erase(bitmapPath);
+            }
+            std::shared_ptr<bool> savedSuccessfully = std::make_shared<bool>(false);
+            m_sPendingSaves.emplace_back(g_ThreadMan.QueueTask(
+                [pSnapshot, palette, bitmapPath, previousPath, savedSuccessfully]() {
+                    *savedSuccessfully = save_bmp(bitmapPath.c_str(), pSnapshot, palette) == 0;
+                    if (!*savedSuccessfully && previousPath != bitmapPath)
+                    {
+                        std::lock_guard<std::mutex> failedSavePathsLock(m_sFailedSavePathsMutex);
+                        // If the previous file was itself never written, go all the way back to the one before it
+                        std::unordered_map<std::string, std::string>::const_iterator previousFailedItr = m_sFailedSavePaths.find(previousPath);
+                        m_sFailedSavePaths[bitmapPath] = previousFailedItr != m_sFailedSavePaths.end() ? previousFailedItr->second : previousPath;
+                    }
+                },
+                [pSnapshot, bitmapPath, savedSuccessfully, onSaved]() {
+                    destroy_bitmap(pSnapshot);
+                    if (!*savedSuccessfully)
+                        g_ConsoleMan.PrintString("ERROR: Failed to write scene layer data to " + bitmapPath + "!");
+                    if (onSaved)
+                        onSaved(*savedSuccessfully);
+                }
+            ));
+        }
+        else if (save_bmp(bitmapPath.c_str(), m_pMainBitmap, palette) != 0)
             return -1;
 
-        // Set the new path to point to the new file location - only if there was a successful save of the bitmap
+        // Set the new path to point to the new file location - only if there was a successful save of the bitmap, or one is underway.
+        // Copies of this layer need the new path right away. Anything reading the file back waits for pending saves to finish first and
+        // falls back to the previous file if the async save failed, see WaitForPendingSaves and GetSavedDataPath.
         m_BitmapFile.SetDataPath(bitmapPath);
     }
 
@@ -266,6 +321,32 @@ int SceneLayer::SaveData(string bitmapPath)
 }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Static method:   WaitForPendingSaves
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Blocks until all async layer saves queued so far are written to disk.
+
+void SceneLayer::WaitForPendingSaves()
+{
+    for (const std::future<void> &pendingSave : m_sPendingSaves)
+        pendingSave.wait();
+    m_sPendingSaves.clear();
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Static method:   GetSavedDataPath
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the file a layer pointed at a given path should actually use.
+
+std::string SceneLayer::GetSavedDataPath(const std::string &dataPath)
+{
+    std::lock_guard<std::mutex> failedSavePathsLock(m_sFailedSavePathsMutex);
+    std::unordered_map<std::string, std::string>::const_iterator failedItr = m_sFailedSavePaths.find(dataPath);
+    return failedItr != m_sFailedSavePaths.end() ? failedItr->second : dataPath;
+}
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Virtual method:  ClearData
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -330,7 +411,11 @@ int SceneLayer::Save(Writer &writer) const
     Entity::Save(writer);
 
     writer.NewProperty("BitmapFile");
-    writer << m_BitmapFile;
+    // Don't point the saved layer at a file a failed async save never wrote
+    ContentFile bitmapFile;
+    bitmapFile.Create(m_BitmapFile);
+    bitmapFile.SetDataPath(GetSavedDataPath(m_BitmapFile.GetDataPath()));
+    writer << bitmapFile;
     writer.NewProperty("DrawTransparent");
     writer << m_DrawTrans;
     writer.NewProperty("Offset");
@@ -416,6 +501,39 @@ void SceneLayer::SetPixel(const int pixelX, const int pixelY, const unsigned cha
 //    RTEAssert(is_inside_bitmap(m_pMainBitmap, pixelX, pixelY, 0), "Trying to access pixel outside of SceneLayer's bitmap's boundaries!");
 //    _putpixel(m_pMainBitmap, pixelX, pixelY, value);
     putpixel(m_pMainBitmap, pixelX, pixelY, value);
+    RegisterChange(pixelX, pixelY, 1, 1);
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          RegisterChange
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Registers a change to an area of the main bitmap of this SceneLayer,
+//                  so whatever keeps something drawn from it knows to redraw that area.
+
+void SceneLayer::RegisterChange(int x, int y, int w, int h)
+{
+    m_LatestChanges[m_ChangeCount % m_LatestChanges.size()] = IntRect(x, y, x + w, y + h);
+    ++m_ChangeCount;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetChangesSince
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the areas of the main bitmap of this SceneLayer changed since
+//                  GetChangeCount returned some count.
+
+bool SceneLayer::GetChangesSince(unsigned long changeCount, std::vector<IntRect> &changes) const
+{
+    // The count can only go backwards if this was recreated since, and the oldest changes get overwritten by newer ones
+    if (changeCount > m_ChangeCount || m_ChangeCount - changeCount > m_LatestChanges.size())
+        return false;
+
+    for (unsigned long change = changeCount; change < m_ChangeCount; ++change)
+        changes.push_back(m_LatestChanges[change % m_LatestChanges.size()]);
+
+    return true;
 }
 
 
@@ -581,12 +699,27 @@ struct SLDrawBox
 };
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetDrawOffset
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the whole-pixel position in this SceneLayer that Draw would line
+//                  up with the corner of the target box if this had a specific offset.
+
+void SceneLayer::GetDrawOffset(const Vector &offset, int &offsetX, int &offsetY) const
+{
+    offsetX = std::floor(offset.m_X * m_ScrollRatio.m_X);
+    offsetY = std::floor(offset.m_Y * m_ScrollRatio.m_Y);
+//    ForceBounds(offsetX, offsetY);
+    WrapPosition(offsetX, offsetY);
+}
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Virtual method:  Draw
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Draws this SceneLayer's current scrolled position to a bitmap.
 
-void SceneLayer::Draw(BITMAP *pTargetBitmap, Box& targetBox, const Vector &scrollOverride) const
+void SceneLayer::Draw(BITMAP *pTargetBitmap, Box &targetBox, const Vector *scrollOverride, bool fitToScreen) const
 {
     RTEAssert(m_pMainBitmap, "Data of this SceneLayer has not been loaded before trying to draw!");
 
@@ -600,22 +733,18 @@ void SceneLayer::Draw(BITMAP *pTargetBitmap, Box& targetBox, const Vector &scrol
 
     int offsetX;
     int offsetY;
-    bool scrollOverridden = !(scrollOverride.m_X == -1 && scrollOverride.m_Y == -1);
 
     // Overridden scroll position
-    if (scrollOverridden)
+    if (scrollOverride)
     {
-        offsetX = scrollOverride.GetFloorIntX();
-        offsetY = scrollOverride.GetFloorIntY();
+        offsetX = scrollOverride->GetFloorIntX();
+        offsetY = scrollOverride->GetFloorIntY();
     }
     // Regular scroll
     else
     {
-        offsetX = std::floor(m_Offset.m_X * m_ScrollRatio.m_X);
-        offsetY = std::floor(m_Offset.m_Y * m_ScrollRatio.m_Y);
         // Only force bounds when doing regular scroll offset because the override is used to do terrain object application tricks and sometimes needs the offsets to be < 0
-//        ForceBounds(offsetX, offsetY);
-        WrapPosition(offsetX, offsetY);
+        GetDrawOffset(offsetX, offsetY);
     }
 
     // Make target box valid size if it's empty
@@ -626,8 +755,13 @@ void SceneLayer::Draw(BITMAP *pTargetBitmap, Box& targetBox, const Vector &scrol
         targetBox.SetHeight(pTargetBitmap->h);
     }
 
-    // Set the clipping rectangle of the target bitmap to match the specified target box
-    set_clip_rect(pTargetBitmap, targetBox.GetCorner().m_X, targetBox.GetCorner().m_Y, targetBox.GetCorner().m_X + targetBox.GetWidth() - 1, targetBox.GetCorner().m_Y + targetBox.GetHeight() - 1);
+    // Narrow the clipping rectangle of the target bitmap down to the specified target box, keeping any clipping that was already set on it
+    int prevClipLeft;
+    int prevClipTop;
+    int prevClipRight;
+    int prevClipBottom;
+    get_clip_rect(pTargetBitmap, &prevClipLeft, &prevClipTop, &prevClipRight, &prevClipBottom);
+    add_clip_rect(pTargetBitmap, targetBox.GetCorner().m_X, targetBox.GetCorner().m_Y, targetBox.GetCorner().m_X + targetBox.GetWidth() - 1, targetBox.GetCorner().m_Y + targetBox.GetHeight() - 1);
 
     // Choose the correct blitting function based on transparency setting
     void (*pfBlit)(BITMAP *source, BITMAP *dest, int source_x, int source_y, int dest_x, int dest_y, int width, int height) = m_DrawTrans ? &masked_blit : &blit;
@@ -681,7 +815,7 @@ void SceneLayer::Draw(BITMAP *pTargetBitmap, Box& targetBox, const Vector &scrol
         // Check for special case adjustment when the screen is larger than the scene
         bool screenLargerThanSceneX = false;
         bool screenLargerThanSceneY = false;
-        if (!scrollOverridden && g_SceneMan.GetSceneWidth() > 0)
+        if (fitToScreen && g_SceneMan.GetSceneWidth() > 0)
         {
             screenLargerThanSceneX = pTargetBitmap->w > g_SceneMan.GetSceneWidth();
             screenLargerThanSceneY = pTargetBitmap->h > g_SceneMan.GetSceneHeight();
@@ -731,8 +865,8 @@ void SceneLayer::Draw(BITMAP *pTargetBitmap, Box& targetBox, const Vector &scrol
         }
     }
 
-    // Reset the clip rect back to the entire target bitmap
-    set_clip_rect(pTargetBitmap, 0, 0, pTargetBitmap->w - 1, pTargetBitmap->h - 1);
+    // Restore the clip rect to what it was before
+    set_clip_rect(pTargetBitmap, prevClipLeft, prevClipTop, prevClipRight, prevClipBottom);
 }
 
 
@@ -742,11 +876,11 @@ void SceneLayer::Draw(BITMAP *pTargetBitmap, Box& targetBox, const Vector &scrol
 // Description:     Draws this SceneLayer's current scrolled position to a bitmap, but also
 //                  scaled according to what has been set with SetScaleFactor.
 
-void SceneLayer::DrawScaled(BITMAP *pTargetBitmap, Box &targetBox, const Vector &scrollOverride) const
+void SceneLayer::DrawScaled(BITMAP *pTargetBitmap, Box &targetBox, const Vector *scrollOverride, bool fitToScreen) const
 {
     // If no scaling, use the regular scaling routine
     if (m_ScaleFactor.m_X == 1.0 && m_ScaleFactor.m_Y == 1.0)
-        return Draw(pTargetBitmap, targetBox, scrollOverride);
+        return Draw(pTargetBitmap, targetBox, scrollOverride, fitToScreen);
 
     RTEAssert(m_pMainBitmap, "Data of this SceneLayer has not been loaded before trying to draw!");
 
@@ -786,22 +920,18 @@ void SceneLayer::DrawScaled(BITMAP *pTargetBitmap, Box &targetBox, const Vector
 
     int offsetX;
     int offsetY;
-    bool scrollOverridden = !(scrollOverride.m_X == -1 && scrollOverride.m_Y == -1);
 
     // Overridden scroll position
-    if (scrollOverridden)
+    if (scrollOverride)
     {
-        offsetX = scrollOverride.GetFloorIntX();
-        offsetY = scrollOverride.GetFloorIntY();
+        offsetX = scrollOverride->GetFloorIntX();
+        offsetY = scrollOverride->GetFloorIntY();
     }
     // Regular scroll
     else
     {
-        offsetX = std::floor(m_Offset.m_X * m_ScrollRatio.m_X);
-        offsetY = std::floor(m_Offset.m_Y * m_ScrollRatio.m_Y);
         // Only force bounds when doing regular scroll offset because the override is used to do terrain object application tricks and sometimes needs the offsets to be < 0
-//        ForceBounds(offsetX, offsetY);
-        WrapPosition(offsetX, offsetY);
+        GetDrawOffset(offsetX, offsetY);
     }
 
     // Make target box valid size if it's empty
@@ -883,7 +1013,7 @@ void SceneLayer::DrawScaled(BITMAP *pTargetBitmap, Box &targetBox, const Vector
         // Check for special case adjustment when the screen is larger than the scene
         bool screenLargerThanSceneX = false;
         bool screenLargerThanSceneY = false;
-        if (!scrollOverridden && g_SceneMan.GetSceneWidth() > 0)
+        if (fitToScreen && g_SceneMan.GetSceneWidth() > 0)
         {
             screenLargerThanSceneX = pTargetBitmap->w > g_SceneMan.GetSceneWidth();
             screenLargerThanSceneY = pTargetBitmap->h > g_SceneMan.GetSceneHeight();
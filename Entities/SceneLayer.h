@@ -160,10 +160,36 @@ ClassInfoGetters;
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Saves data currently in memory to disk.
 // Arguments:       The filepath to the where to save the Bitmap data.
+//                  Whether to copy the bitmap and write the copy to disk on a ThreadMan
+//                  worker instead of blocking until it's written.
+//                  Callback run on the main thread once an async save is written, with
+//                  whether the write succeeded. Not used when saving synchronously.
 // Return value:    An error return value signaling success or any particular failure.
 //                  Anything below 0 is an error signal.
 
-    virtual int SaveData(std::string bitmapPath);
+    virtual int SaveData(std::string bitmapPath, bool doAsyncSave = false, const std::function<void(bool)> &onSaved = nullptr);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Static method:   WaitForPendingSaves
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Blocks until all async layer saves queued so far are written to disk.
+//                  Needed before reading back any layer files that may still be in flight.
+// Arguments:       None.
+// Return value:    None.
+
+    static void WaitForPendingSaves();
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Static method:   GetSavedDataPath
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the file a layer pointed at a given path should actually use. If an
+//                  async save to that path failed, this is the file the layer had before.
+// Arguments:       The path the layer's bitmap file currently points at.
+// Return value:    The path to use in place of the given one.
+
+    static std::string GetSavedDataPath(const std::string &dataPath);
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -241,6 +267,32 @@ ClassInfoGetters;
     Vector GetScrollRatio() const { return m_ScrollRatio; }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetDrawOffset
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the whole-pixel position in this SceneLayer that Draw will line
+//                  up with the corner of the target box, when not overriding the scroll.
+//                  This is the offset modified by the scroll ratio, floored and wrapped.
+// Arguments:       References to where the X and Y of the draw offset will be put.
+// Return value:    None.
+
+    void GetDrawOffset(int &offsetX, int &offsetY) const { GetDrawOffset(m_Offset, offsetX, offsetY); }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetDrawOffset
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the whole-pixel position in this SceneLayer that Draw would line
+//                  up with the corner of the target box if this had a specific offset.
+//                  Used to draw the same layer for several screens without setting its
+//                  offset for each of them in turn.
+// Arguments:       The offset to get the draw offset for.
+//                  References to where the X and Y of the draw offset will be put.
+// Return value:    None.
+
+    void GetDrawOffset(const Vector &offset, int &offsetX, int &offsetY) const;
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetScaleFactor
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -367,6 +419,46 @@ ClassInfoGetters;
     void SetPixel(const int pixelX, const int pixelY, const unsigned char value);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          RegisterChange
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Registers a change to an area of the main bitmap of this SceneLayer,
+//                  so whatever keeps something drawn from it, like the cached terrain
+//                  views of SceneMan, knows to redraw that area. SetPixel and loading
+//                  register their changes already, anything drawn onto GetBitmap()
+//                  directly has to be registered with this.
+// Arguments:       x,y - bitmap coordinates of the change, w,h - size of the changed
+//                  region. It may reach past the edges of a wrapping bitmap.
+// Return value:    None.
+
+    void RegisterChange(int x, int y, int w, int h);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetChangeCount
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets how many changes have been registered on the main bitmap of this
+//                  SceneLayer, to later get the changes made since with GetChangesSince.
+// Arguments:       None.
+// Return value:    The number of changes registered so far.
+
+    unsigned long GetChangeCount() const { return m_ChangeCount; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetChangesSince
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the areas of the main bitmap of this SceneLayer changed since
+//                  GetChangeCount returned some count. Only the latest
+//                  MAXTERRAINVIEWCHANGES changes are remembered.
+// Arguments:       The change count to get the changes made since.
+//                  The vector to add the changed areas to, in bitmap coordinates.
+// Return value:    Whether all the changes were still remembered and added. If not,
+//                  none are added and all of the bitmap should be taken as changed.
+
+    bool GetChangesSince(unsigned long changeCount, std::vector<IntRect> &changes) const;
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          IsWithinBounds
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -448,14 +540,18 @@ ClassInfoGetters;
 // Virtual method:  Draw
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Draws this SceneLayer's current scrolled position to a bitmap.
+//                  Drawing stays within any clipping rectangle already set on the target.
 // Arguments:       The bitmap to draw to.
 //                  The box on the target bitmap to limit drawing to, with the corner of
 //                  box being where the scroll position lines up.
-//                  If a non-{-1,-1} vector is passed, the internal scroll offset of this
-//                  is overridder with it. It becomes the new source coordinates.
+//                  If a vector is passed, the internal scroll offset of this is overridden
+//                  with it. It becomes the new source coordinates, which aren't kept
+//                  within the layer's bounds.
+//                  Whether to center the layer on the target, or fill around it, where
+//                  the target is larger than the scene, as is done for player screens.
 // Return value:    None.
 
-    virtual void Draw(BITMAP *pTargetBitmap, Box &targetBox, const Vector &scrollOverride = Vector(-1, -1)) const;
+    virtual void Draw(BITMAP *pTargetBitmap, Box &targetBox, const Vector *scrollOverride = nullptr, bool fitToScreen = true) const;
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -466,11 +562,14 @@ ClassInfoGetters;
 // Arguments:       The bitmap to draw to.
 //                  The box on the target bitmap to limit drawing to, with the corner of
 //                  box being where the scroll position lines up.
-//                  If a non-{-1,-1} vector is passed, the internal scroll offset of this
-//                  is overridder with it. It becomes the new source coordinates.
+//                  If a vector is passed, the internal scroll offset of this is overridden
+//                  with it. It becomes the new source coordinates, which aren't kept
+//                  within the layer's bounds.
+//                  Whether to center the layer on the target, or fill around it, where
+//                  the target is larger than the scene, as is done for player screens.
 // Return value:    None.
 
-    virtual void DrawScaled(BITMAP *pTargetBitmap, Box &targetBox, const Vector &scrollOverride = Vector(-1, -1)) const;
+    virtual void DrawScaled(BITMAP *pTargetBitmap, Box &targetBox, const Vector *scrollOverride = nullptr, bool fitToScreen = true) const;
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -494,6 +593,12 @@ protected:
 
     // Member variables
     static Entity::ClassInfo m_sClass;
+    // Async layer saves that may not have been written to disk yet
+    static std::list<std::future<void>> m_sPendingSaves;
+    // Paths that async layer saves failed to write, mapped to the files the layers had before, so they can be pointed back at something that exists
+    static std::unordered_map<std::string, std::string> m_sFailedSavePaths;
+    // Guards m_sFailedSavePaths, which is written from the ThreadMan workers doing the saves
+    static std::mutex m_sFailedSavePathsMutex;
 
     ContentFile m_BitmapFile;
 
@@ -515,6 +620,10 @@ protected:
     int m_FillRightColor;
     int m_FillUpColor;
     int m_FillDownColor;
+    // How many changes have been registered on the main bitmap
+    unsigned long m_ChangeCount;
+    // The areas of the latest changes registered on the main bitmap, in bitmap coordinates, each at its change count modulo the array size
+    std::array<IntRect, MAXTERRAINVIEWCHANGES> m_LatestChanges;
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1,5 +1,6 @@
 #include "TerrainDebris.h"
 #include "SLTerrain.h"
+#include "ThreadMan.h"
 
 namespace RTE {
 
@@ -106,6 +107,26 @@ namespace RTE {
 		return 0;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	uint64_t TerrainDebris::GetApplicationHash() const {
+		uint64_t hash = StableHash(m_DebrisFile.GetDataPath());
+		auto hashValue = [&hash](const auto &value) { hash = StableHash(&value, sizeof(value), hash); };
+
+		hashValue(m_Material.GetIndex());
+		hashValue(m_TargetMaterial.GetIndex());
+		hashValue(m_OnlyOnSurface);
+		hashValue(m_OnlyBuried);
+		hashValue(m_MinDepth);
+		hashValue(m_MaxDepth);
+		hashValue(m_Density);
+
+		for (BITMAP *bitmap : m_Bitmaps) {
+			hash = StableHashBitmap(bitmap, hash);
+		}
+		return hash;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void TerrainDebris::ApplyDebris(SLTerrain *terrain) {
@@ -118,65 +139,83 @@ namespace RTE {
 		unsigned int terrainWidth = terrBitmap->w;
 		unsigned int pieceCount = static_cast<int>((static_cast<float>(terrainWidth) * c_MPP) * m_Density);
 
-		// First is index in the bitmap array, Second is blit location
-		std::list<std::pair<int, Vector>> piecesToPlace;
-		Vector location;
-		Box pieceBox;
+		// Roll all the random numbers up front in the same order as if the pieces were placed one by one, so where the debris ends up only depends on the RNG seed and not on how the searching is split between threads.
+		std::vector<int> pieceBitmapIndices(pieceCount);
+		std::vector<int> pieceXPositions(pieceCount);
+		std::vector<int> pieceDepths(pieceCount);
+		for (unsigned int piece = 0; piece < pieceCount; ++piece) {
+			pieceBitmapIndices.at(piece) = RandomNum<int>(0, m_BitmapCount - 1);
+			RTEAssert(pieceBitmapIndices.at(piece) >= 0 && pieceBitmapIndices.at(piece) < m_BitmapCount, "Bitmap index is out of bounds!");
+			pieceXPositions.at(piece) = RandomNum<int>(0, terrainWidth);
+			pieceDepths.at(piece) = RandomNum(m_MinDepth, m_MaxDepth);
+		}
 
-		unsigned char checkPixel;
+		// Blit location of each piece. Only read from if the piece is to be placed.
+		std::vector<Vector> piecePositions(pieceCount);
+		std::vector<unsigned char> piecePlaced(pieceCount, 0);
 
 		acquire_bitmap(terrBitmap);
 		acquire_bitmap(matBitmap);
 
-		for (unsigned int piece = 0; piece < pieceCount; ++piece) {
-			bool place = false;
-			unsigned int currentBitmap = RandomNum<int>(0, m_BitmapCount - 1);
-			RTEAssert(currentBitmap >= 0 && currentBitmap < m_BitmapCount, "Bitmap index is out of bounds!");
-
-			pieceBox.SetWidth(static_cast<float>(m_Bitmaps.at(currentBitmap)->w));
-			pieceBox.SetHeight(static_cast<float>(m_Bitmaps.at(currentBitmap)->h));
-
-			int x = RandomNum<int>(0, terrainWidth);
-			int y = 0;
-			int depth = RandomNum(m_MinDepth, m_MaxDepth);
-
-			while (y < terrBitmap->h) {
-				// Find the air-terrain boundary
-				for (; y < terrBitmap->h; ++y) {
-					checkPixel = _getpixel(matBitmap, x, y);
-					// Check for terrain hit
-					if (checkPixel != g_MaterialAir) {
-						if (checkPixel == m_TargetMaterial.GetIndex()) {
-							place = true;
-							break;
-						// If we didn't hit target material, but are specified to, then don't place
-						} else if (m_OnlyOnSurface) {
-							place = false;
-							break;
+		// The search for where each piece goes only reads the terrain, so the pieces can be searched for in parallel.
+		g_ThreadMan.ParallelFor(0, static_cast<int>(pieceCount), c_PiecesPerSearchChunk, [&](int firstPiece, int lastPiece) {
+			Box pieceBox;
+			unsigned char checkPixel;
+
+			for (int piece = firstPiece; piece < lastPiece; ++piece) {
+				bool place = false;
+				const BITMAP *pieceBitmap = m_Bitmaps.at(pieceBitmapIndices.at(piece));
+
+				pieceBox.SetWidth(static_cast<float>(pieceBitmap->w));
+				pieceBox.SetHeight(static_cast<float>(pieceBitmap->h));
+
+				int x = pieceXPositions.at(piece);
+				int y = 0;
+				int depth = pieceDepths.at(piece);
+
+				while (y < terrBitmap->h) {
+					// Find the air-terrain boundary
+					for (; y < terrBitmap->h; ++y) {
+						checkPixel = _getpixel(matBitmap, x, y);
+						// Check for terrain hit
+						if (checkPixel != g_MaterialAir) {
+							if (checkPixel == m_TargetMaterial.GetIndex()) {
+								place = true;
+								break;
+							// If we didn't hit target material, but are specified to, then don't place
+							} else if (m_OnlyOnSurface) {
+								place = false;
+								break;
+							}
 						}
 					}
-				}
-				if (!place) {
-					break;
-				}
-				// The target locations are on the center of the objects; if supposed to be buried, move down so it is
-				y += depth + static_cast<int>(m_OnlyBuried ? pieceBox.GetHeight() * 0.6F : 0);
-				pieceBox.SetCenter(Vector(static_cast<float>(x), static_cast<float>(y)));
-
-				// Make sure we're not trying to place something into a cave or other air pocket
-				if (!g_SceneMan.GetTerrain()->IsAirPixel(x, y) && (!m_OnlyBuried || g_SceneMan.GetTerrain()->IsBoxBuried(pieceBox))) {
-					// Do delayed drawing so that we don't end up placing things on top of each other
-					piecesToPlace.emplace_back(currentBitmap, pieceBox.GetCorner());
-					break;
+					if (!place) {
+						break;
+					}
+					// The target locations are on the center of the objects; if supposed to be buried, move down so it is
+					y += depth + static_cast<int>(m_OnlyBuried ? pieceBox.GetHeight() * 0.6F : 0);
+					pieceBox.SetCenter(Vector(static_cast<float>(x), static_cast<float>(y)));
+
+					// Make sure we're not trying to place something into a cave or other air pocket
+					if (!terrain->IsAirPixel(x, y) && (!m_OnlyBuried || terrain->IsBoxBuried(pieceBox))) {
+						// Do delayed drawing so that we don't end up placing things on top of each other
+						piecePositions.at(piece) = pieceBox.GetCorner();
+						piecePlaced.at(piece) = 1;
+						break;
+					}
 				}
 			}
-		}
+		});
 
-		for (const auto &[pieceFrameNum, piecePos] : piecesToPlace) {
-			// Draw the color sprite onto the terrain color layer.
-			draw_sprite(terrBitmap, m_Bitmaps.at(pieceFrameNum), piecePos.GetFloorIntX(), piecePos.GetFloorIntY());
-			// Draw the material representation onto the terrain's material layer
-			draw_character_ex(matBitmap, m_Bitmaps.at(pieceFrameNum), piecePos.GetFloorIntX(), piecePos.GetFloorIntY(), m_Material.GetIndex(), -1);
+		for (unsigned int piece = 0; piece < pieceCount; ++piece) {
+			if (piecePlaced.at(piece)) {
+				BITMAP *pieceBitmap = m_Bitmaps.at(pieceBitmapIndices.at(piece));
+				const Vector &piecePos = piecePositions.at(piece);
+				// Draw the color sprite onto the terrain color layer.
+				draw_sprite(terrBitmap, pieceBitmap, piecePos.GetFloorIntX(), piecePos.GetFloorIntY());
+				// Draw the material representation onto the terrain's material layer
+				draw_character_ex(matBitmap, pieceBitmap, piecePos.GetFloorIntX(), piecePos.GetFloorIntY(), m_Material.GetIndex(), -1);
+			}
 		}
 
 		release_bitmap(terrBitmap);
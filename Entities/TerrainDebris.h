@@ -76,6 +76,12 @@ namespace RTE {
 		/// </summary>
 		/// <returns>The number of BITMAPs this TerrainDebris has.</returns>
 		int GetBitmapCount() const { return m_BitmapCount; }
+
+		/// <summary>
+		/// Gets a hash of all the properties that affect how this TerrainDebris is applied to a terrain, including the pixels of its BITMAPs. Used to validate cached terrain layers.
+		/// </summary>
+		/// <returns>A hash of this TerrainDebris' application properties. Stable between runs and platforms.</returns>
+		uint64_t GetApplicationHash() const;
 #pragma endregion
 
 #pragma region Concrete Methods
@@ -89,6 +95,7 @@ namespace RTE {
 	protected:
 
 		static Entity::ClassInfo m_sClass; //!< ClassInfo for this class.
+		static constexpr int c_PiecesPerSearchChunk = 32; //!< How many pieces each thread searches for a spot for at a time when applying the debris.
 
 		ContentFile m_DebrisFile; //!< Shows where the bitmaps are.
 		std::vector<BITMAP *> m_Bitmaps; //!< All the different bitmaps for each chunk of debris. Not owned.
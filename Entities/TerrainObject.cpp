@@ -14,6 +14,7 @@
 #include "TerrainObject.h"
 #include "PresetMan.h"
 #include "ContentFile.h"
+#include "PixelKernels.h"
 
 namespace RTE {
 
@@ -436,8 +437,8 @@ void TerrainObject::Draw(BITMAP *pTargetBitmap, const Vector &targetPos, DrawMod
         }
         else if (mode == g_DrawTrans)
         {
-            draw_trans_sprite(pTargetBitmap, m_pFGColor, aDrawPos[i].GetFloorIntX(), aDrawPos[i].GetFloorIntY());
-            draw_trans_sprite(pTargetBitmap, m_pBGColor, aDrawPos[i].GetFloorIntX(), aDrawPos[i].GetFloorIntY());
+            PixelKernels::DrawTransSprite(pTargetBitmap, m_pFGColor, aDrawPos[i].GetFloorIntX(), aDrawPos[i].GetFloorIntY());
+            PixelKernels::DrawTransSprite(pTargetBitmap, m_pBGColor, aDrawPos[i].GetFloorIntX(), aDrawPos[i].GetFloorIntY());
         }
     }
 }
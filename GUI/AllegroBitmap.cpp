@@ -10,6 +10,8 @@ namespace RTE {
 		m_Bitmap = nullptr;
 		m_BitmapFile.Reset();
 		m_SelfCreated = false;
+		m_DrawOffsetX = 0;
+		m_DrawOffsetY = 0;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -60,17 +62,23 @@ namespace RTE {
 		return m_Bitmap ? bitmap_color_depth(m_Bitmap) : 8;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	unsigned long AllegroBitmap::GetMaskColor() const {
+		return m_Bitmap ? bitmap_mask_color(m_Bitmap) : 0;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	unsigned long AllegroBitmap::GetPixel(int posX, int posY) const {
-		return m_Bitmap ? getpixel(m_Bitmap, posX, posY) : 0;
+		return m_Bitmap ? getpixel(m_Bitmap, posX - m_DrawOffsetX, posY - m_DrawOffsetY) : 0;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void AllegroBitmap::SetPixel(int posX, int posY, unsigned long pixelColor) {
 		RTEAssert(m_Bitmap, "Trying to set a pixel on a null bitmap!");
-		putpixel(m_Bitmap, posX, posY, pixelColor);
+		putpixel(m_Bitmap, posX - m_DrawOffsetX, posY - m_DrawOffsetY, pixelColor);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -82,10 +90,10 @@ namespace RTE {
 			int x2;
 			int y2;
 			get_clip_rect(m_Bitmap, &x1, &y1, &x2, &y2);
-			clippingRect->left = x1;
-			clippingRect->top = y1;
-			clippingRect->right = x2;
-			clippingRect->bottom = y2;
+			clippingRect->left = x1 + m_DrawOffsetX;
+			clippingRect->top = y1 + m_DrawOffsetY;
+			clippingRect->right = x2 + m_DrawOffsetX;
+			clippingRect->bottom = y2 + m_DrawOffsetY;
 		}
 	}
 
@@ -100,7 +108,7 @@ namespace RTE {
 		if (!clippingRect) {
 			set_clip_rect(m_Bitmap, 0, 0, m_Bitmap->w - 1, m_Bitmap->h - 1);
 		} else {
-			set_clip_rect(m_Bitmap, clippingRect->left, clippingRect->top, clippingRect->right, clippingRect->bottom);
+			set_clip_rect(m_Bitmap, clippingRect->left - m_DrawOffsetX, clippingRect->top - m_DrawOffsetY, clippingRect->right - m_DrawOffsetX, clippingRect->bottom - m_DrawOffsetY);
 		}
 	}
 
@@ -115,7 +123,7 @@ namespace RTE {
 		if (!clippingRect) {
 			set_clip_rect(m_Bitmap, 0, 0, m_Bitmap->w - 1, m_Bitmap->h - 1);
 		} else {
-			add_clip_rect(m_Bitmap, clippingRect->left, clippingRect->top, clippingRect->right, clippingRect->bottom);
+			add_clip_rect(m_Bitmap, clippingRect->left - m_DrawOffsetX, clippingRect->top - m_DrawOffsetY, clippingRect->right - m_DrawOffsetX, clippingRect->bottom - m_DrawOffsetY);
 		}
 	}
 
@@ -125,12 +133,15 @@ namespace RTE {
 		if (!m_Bitmap) {
 			return;
 		}
-		RTEAssert(destBitmap && dynamic_cast<AllegroBitmap *>(destBitmap)->GetBitmap(), "Null destination bitmap passed when trying to draw AllegroBitmap");
+		const AllegroBitmap *destAllegroBitmap = dynamic_cast<AllegroBitmap *>(destBitmap);
+		RTEAssert(destAllegroBitmap && destAllegroBitmap->GetBitmap(), "Null destination bitmap passed when trying to draw AllegroBitmap");
+		destX -= destAllegroBitmap->GetDrawOffsetX();
+		destY -= destAllegroBitmap->GetDrawOffsetY();
 
 		if (srcPosAndSizeRect) {
-			blit(m_Bitmap, dynamic_cast<AllegroBitmap *>(destBitmap)->GetBitmap(), srcPosAndSizeRect->left, srcPosAndSizeRect->top, destX, destY, srcPosAndSizeRect->right - srcPosAndSizeRect->left, srcPosAndSizeRect->bottom - srcPosAndSizeRect->top);
+			blit(m_Bitmap, destAllegroBitmap->GetBitmap(), srcPosAndSizeRect->left, srcPosAndSizeRect->top, destX, destY, srcPosAndSizeRect->right - srcPosAndSizeRect->left, srcPosAndSizeRect->bottom - srcPosAndSizeRect->top);
 		} else {
-			blit(m_Bitmap, dynamic_cast<AllegroBitmap *>(destBitmap)->GetBitmap(), 0, 0, destX, destY, destBitmap->GetWidth(), destBitmap->GetHeight());
+			blit(m_Bitmap, destAllegroBitmap->GetBitmap(), 0, 0, destX, destY, destBitmap->GetWidth(), destBitmap->GetHeight());
 		}
 	}
 
@@ -140,12 +151,15 @@ namespace RTE {
 		if (!m_Bitmap) {
 			return;
 		}
-		RTEAssert(destBitmap && dynamic_cast<AllegroBitmap *>(destBitmap)->GetBitmap(), "Null destination bitmap passed when trying to draw AllegroBitmap");
+		const AllegroBitmap *destAllegroBitmap = dynamic_cast<AllegroBitmap *>(destBitmap);
+		RTEAssert(destAllegroBitmap && destAllegroBitmap->GetBitmap(), "Null destination bitmap passed when trying to draw AllegroBitmap");
+		destX -= destAllegroBitmap->GetDrawOffsetX();
+		destY -= destAllegroBitmap->GetDrawOffsetY();
 
 		if (srcPosAndSizeRect) {
-			masked_blit(m_Bitmap, dynamic_cast<AllegroBitmap *>(destBitmap)->GetBitmap(), srcPosAndSizeRect->left, srcPosAndSizeRect->top, destX, destY, srcPosAndSizeRect->right - srcPosAndSizeRect->left, srcPosAndSizeRect->bottom - srcPosAndSizeRect->top);
+			masked_blit(m_Bitmap, destAllegroBitmap->GetBitmap(), srcPosAndSizeRect->left, srcPosAndSizeRect->top, destX, destY, srcPosAndSizeRect->right - srcPosAndSizeRect->left, srcPosAndSizeRect->bottom - srcPosAndSizeRect->top);
 		} else {
-			masked_blit(m_Bitmap, dynamic_cast<AllegroBitmap *>(destBitmap)->GetBitmap(), 0, 0, destX, destY, destBitmap->GetWidth(), destBitmap->GetHeight());
+			masked_blit(m_Bitmap, destAllegroBitmap->GetBitmap(), 0, 0, destX, destY, destBitmap->GetWidth(), destBitmap->GetHeight());
 		}
 	}
 
@@ -155,9 +169,12 @@ namespace RTE {
 		if (!m_Bitmap) {
 			return;
 		}
-		RTEAssert(destBitmap && dynamic_cast<AllegroBitmap *>(destBitmap)->GetBitmap(), "Null destination bitmap passed when trying to draw AllegroBitmap");
+		const AllegroBitmap *destAllegroBitmap = dynamic_cast<AllegroBitmap *>(destBitmap);
+		RTEAssert(destAllegroBitmap && destAllegroBitmap->GetBitmap(), "Null destination bitmap passed when trying to draw AllegroBitmap");
+		destX -= destAllegroBitmap->GetDrawOffsetX();
+		destY -= destAllegroBitmap->GetDrawOffsetY();
 
-		stretch_sprite(dynamic_cast<AllegroBitmap *>(destBitmap)->GetBitmap(), m_Bitmap, destX, destY, width, height);
+		stretch_sprite(destAllegroBitmap->GetBitmap(), m_Bitmap, destX, destY, width, height);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -166,7 +183,7 @@ namespace RTE {
 		if (!m_Bitmap) {
 			return;
 		}
-		line(m_Bitmap, x1, y1, x2, y2, color);
+		line(m_Bitmap, x1 - m_DrawOffsetX, y1 - m_DrawOffsetY, x2 - m_DrawOffsetX, y2 - m_DrawOffsetY, color);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -175,6 +192,9 @@ namespace RTE {
 		if (!m_Bitmap) {
 			return;
 		}
+		posX -= m_DrawOffsetX;
+		posY -= m_DrawOffsetY;
+
 		if (filled) {
 			rectfill(m_Bitmap, posX, posY, posX + width - 1, posY + height - 1, color);
 		} else {
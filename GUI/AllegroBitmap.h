@@ -71,6 +71,25 @@ namespace RTE {
 		/// <param name="newBitmap">A pointer to the new BITMAP for this AllegroBitmap.</param>
 		void SetBitmap(BITMAP *newBitmap) override { Destroy(); m_Bitmap = newBitmap; }
 
+		/// <summary>
+		/// Gets the offset subtracted from every position on the X axis drawn onto or read from this AllegroBitmap.
+		/// </summary>
+		/// <returns>The draw offset on the X axis.</returns>
+		int GetDrawOffsetX() const { return m_DrawOffsetX; }
+
+		/// <summary>
+		/// Gets the offset subtracted from every position on the Y axis drawn onto or read from this AllegroBitmap.
+		/// </summary>
+		/// <returns>The draw offset on the Y axis.</returns>
+		int GetDrawOffsetY() const { return m_DrawOffsetY; }
+
+		/// <summary>
+		/// Sets the offset subtracted from every position drawn onto or read from this AllegroBitmap, including clipping rectangles, so what is positioned on the screen can be drawn onto a bitmap that covers only part of it.
+		/// </summary>
+		/// <param name="offsetX">The offset on the X axis.</param>
+		/// <param name="offsetY">The offset on the Y axis.</param>
+		void SetDrawOffset(int offsetX, int offsetY) override { m_DrawOffsetX = offsetX; m_DrawOffsetY = offsetY; }
+
 		/// <summary>
 		/// Gets the width of the bitmap.
 		/// </summary>
@@ -89,6 +108,12 @@ namespace RTE {
 		/// <returns>The color depth of the bitmap.</returns>
 		int GetColorDepth() const override;
 
+		/// <summary>
+		/// Gets the color that is skipped when this bitmap is drawn with DrawTrans.
+		/// </summary>
+		/// <returns>The mask color for the color depth of the bitmap.</returns>
+		unsigned long GetMaskColor() const override;
+
 		/// <summary>
 		/// Gets the color of a pixel at a specific point on the bitmap.
 		/// </summary>
@@ -184,6 +209,8 @@ namespace RTE {
 		BITMAP *m_Bitmap; //!< The underlaying BITMAP.
 		ContentFile m_BitmapFile; //!< The ContentFile the underlaying BITMAP was created from, if created from a file.
 		bool m_SelfCreated; //!< Whether the underlaying BITMAP was created by this and is owned.
+		int m_DrawOffsetX; //!< The offset subtracted from every position on the X axis drawn onto or read from this.
+		int m_DrawOffsetY; //!< The offset subtracted from every position on the Y axis drawn onto or read from this.
 
 		/// <summary>
 		/// Clears all the member variables of this AllegroBitmap, effectively resetting the members of this abstraction level only.
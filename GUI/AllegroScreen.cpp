@@ -32,6 +32,9 @@ namespace RTE {
 			return;
 		}
 		if (BITMAP *sourceBitmap = dynamic_cast<AllegroBitmap *>(guiBitmap)->GetBitmap()) {
+			destX -= m_BackBufferBitmap->GetDrawOffsetX();
+			destY -= m_BackBufferBitmap->GetDrawOffsetY();
+
 			if (srcPosAndSizeRect) {
 				blit(sourceBitmap, m_BackBufferBitmap->GetBitmap(), srcPosAndSizeRect->left, srcPosAndSizeRect->top, destX, destY, srcPosAndSizeRect->right - srcPosAndSizeRect->left, srcPosAndSizeRect->bottom - srcPosAndSizeRect->top);
 			} else {
@@ -47,6 +50,9 @@ namespace RTE {
 			return;
 		}
 		if (BITMAP *sourceBitmap = dynamic_cast<AllegroBitmap *>(guiBitmap)->GetBitmap()) {
+			destX -= m_BackBufferBitmap->GetDrawOffsetX();
+			destY -= m_BackBufferBitmap->GetDrawOffsetY();
+
 			if (srcPosAndSizeRect) {
 				masked_blit(sourceBitmap, m_BackBufferBitmap->GetBitmap(), srcPosAndSizeRect->left, srcPosAndSizeRect->top, destX, destY, srcPosAndSizeRect->right - srcPosAndSizeRect->left, srcPosAndSizeRect->bottom - srcPosAndSizeRect->top);
 			} else {
@@ -124,6 +124,8 @@ void GUIButton::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIButton::BuildBitmap() {
+	Invalidate();
+
 	// Free any old bitmap
 	if (m_DrawBitmap) {
 		m_DrawBitmap->Destroy();
@@ -372,6 +374,7 @@ void GUIButton::Resize(int Width, int Height) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIButton::SetPushed(bool pushed) {
+	if (pushed != m_Pushed) { Invalidate(); }
 	m_Pushed = pushed;
 	if (pushed) {
 		m_Text->ActivateDeactivateOverflowScroll(true);
@@ -89,6 +89,8 @@ void GUICheckbox::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICheckbox::BuildBitmap() {
+	Invalidate();
+
 	std::string Filename;
 	unsigned long ColorIndex = 0;
 	int Values[4];
@@ -268,6 +270,7 @@ void GUICheckbox::StoreProperties() {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICheckbox::SetText(const std::string &Text) {
+	if (Text != m_Text) { Invalidate(); }
 	m_Text = Text;
 }
 
@@ -280,6 +283,7 @@ std::string GUICheckbox::GetText() const {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICheckbox::SetCheck(int Check) {
+	if (Check != m_Check) { Invalidate(); }
 	m_Check = Check;
 }
 
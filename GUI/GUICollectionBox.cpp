@@ -97,6 +97,8 @@ void GUICollectionBox::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICollectionBox::BuildBitmap() {
+	Invalidate();
+
 	// Free any old bitmap
 	delete m_DrawBitmap;
 
@@ -238,24 +240,28 @@ void GUICollectionBox::SetDrawImage(GUIBitmap *Bitmap) {
 	delete m_DrawBitmap;
 
 	m_DrawBitmap = Bitmap;
+	Invalidate();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICollectionBox::SetDrawBackground(bool DrawBack) {
 	m_DrawBackground = DrawBack;
+	Invalidate();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICollectionBox::SetDrawType(int Type) {
 	m_DrawType = Type;
+	Invalidate();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICollectionBox::SetDrawColor(unsigned long Color) {
 	m_DrawColor = Color;
+	Invalidate();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
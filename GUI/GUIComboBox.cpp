@@ -610,6 +610,7 @@ void GUIComboBoxButton::OnMouseUp(int X, int Y, int Buttons, int Modifier) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIComboBoxButton::SetPushed(bool Pushed) {
+	if (Pushed != m_Pushed) { Invalidate(); }
 	m_Pushed = Pushed;
 }
 
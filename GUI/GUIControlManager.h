@@ -133,6 +133,16 @@ public:
     void EnableMouse(bool enable = true) { m_GUIManager->EnableMouse(enable); }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          EnableSurfaceCaching
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Enables and disables drawing the controls from cached surfaces that are
+//                  only redrawn when something about the controls changed.
+// Arguments:       Enable?
+
+    void EnableSurfaceCaching(bool enable = true) { m_GUIManager->EnableSurfaceCaching(enable); }
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          SetPosOnScreen
 //////////////////////////////////////////////////////////////////////////////////////////
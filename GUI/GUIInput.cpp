@@ -133,6 +133,15 @@ void GUIInput::SetNetworkMouseMovement(int whichPlayer, int x, int y) {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void GUIInput::GetNetworkMousePosition(int whichPlayer, int *X, int *Y) {
+	if (whichPlayer >= 0 && whichPlayer < 4) {
+		if (X) { *X = m_NetworkMouseX[whichPlayer]; }
+		if (Y) { *Y = m_NetworkMouseY[whichPlayer]; }
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void GUIInput::Update() {
 	// Do nothing
 }
@@ -145,6 +145,15 @@ public:
 	static void SetNetworkMouseMovement(int whichPlayer, int x, int y);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetNetworkMousePosition
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the mouse position of a network player, as moved by the input received from their client
+// Arguments:       Which player to get for, pointers to store the X and Y coordinates in
+
+	static void GetNetworkMousePosition(int whichPlayer, int *X, int *Y);
+
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetModifier
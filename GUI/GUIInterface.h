@@ -53,6 +53,13 @@ namespace RTE {
 		/// <param name="newBitmap">A pointer to the new BITMAP for this GUIBitmap.</param>
 		virtual void SetBitmap(BITMAP *newBitmap) = 0;
 
+		/// <summary>
+		/// Sets the offset subtracted from every position drawn onto or read from this GUIBitmap, including clipping rectangles, so what is positioned on the screen can be drawn onto a bitmap that covers only part of it.
+		/// </summary>
+		/// <param name="offsetX">The offset on the X axis.</param>
+		/// <param name="offsetY">The offset on the Y axis.</param>
+		virtual void SetDrawOffset(int offsetX, int offsetY) = 0;
+
 		/// <summary>
 		/// Gets the width of the bitmap.
 		/// </summary>
@@ -71,6 +78,12 @@ namespace RTE {
 		/// <returns>The color depth of the bitmap.</returns>
 		virtual int GetColorDepth() const = 0;
 
+		/// <summary>
+		/// Gets the color that is skipped when this bitmap is drawn with DrawTrans.
+		/// </summary>
+		/// <returns>The mask color for the color depth of the bitmap.</returns>
+		virtual unsigned long GetMaskColor() const = 0;
+
 		/// <summary>
 		/// Gets the color of a pixel at a specific point on the bitmap.
 		/// </summary>
@@ -106,6 +106,9 @@ void GUILabel::ChangeSkin(GUISkin *Skin) {
 void GUILabel::Draw(GUIScreen *Screen) {
 	Draw(Screen->GetBitmap());
 	GUIPanel::Draw(Screen);
+
+	// The scrolling text changes every frame, so it can't be drawn from a cached surface
+	if (OverflowScrollIsActivated()) { Invalidate(); }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -260,6 +263,7 @@ int GUILabel::GetTextHeight() {
 
 void GUILabel::SetHorizontalOverflowScroll(bool newOverflowScroll) {
 	m_HorizontalOverflowScroll = newOverflowScroll;
+	Invalidate();
 	if (m_HorizontalOverflowScroll) {
 		m_VerticalOverflowScroll = false;
 	} else if (!m_VerticalOverflowScroll) {
@@ -271,6 +275,7 @@ void GUILabel::SetHorizontalOverflowScroll(bool newOverflowScroll) {
 
 void GUILabel::SetVerticalOverflowScroll(bool newOverflowScroll) {
 	m_VerticalOverflowScroll = newOverflowScroll;
+	Invalidate();
 	if (m_VerticalOverflowScroll) {
 		m_HorizontalOverflowScroll = false;
 	} else if (!m_HorizontalOverflowScroll) {
@@ -284,6 +289,7 @@ void GUILabel::ActivateDeactivateOverflowScroll(bool activateScroll) {
 	if (OverflowScrollIsEnabled() && activateScroll != OverflowScrollIsActivated()) {
 		m_OverflowScrollState = activateScroll ? OverflowScrollState::WaitAtStart : OverflowScrollState::Deactivated;
 		m_OverflowScrollTimer.SetRealTimeLimitMS(-1);
+		Invalidate();
 	}
 }
 
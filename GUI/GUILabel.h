@@ -161,7 +161,7 @@ public:
 // Description:     Sets the text of the label.
 // Arguments:       text.
 
-    void SetText(const std::string_view &text) { m_Text = text; }
+    void SetText(const std::string_view &text) { if (m_Text != text) { m_Text = text; Invalidate(); } }
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -189,7 +189,7 @@ public:
 // Description:     Sets the horizontal alignment of the text of this label.
 // Arguments:       The desired alignment.
 
-    void SetHAlignment(int HAlignment = GUIFont::Left) { m_HAlignment = HAlignment; }
+    void SetHAlignment(int HAlignment = GUIFont::Left) { if (m_HAlignment != HAlignment) { m_HAlignment = HAlignment; Invalidate(); } }
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -198,7 +198,7 @@ public:
 // Description:     Sets the vertical alignment of the text of this label.
 // Arguments:       The desired alignment.
 
-    void SetVAlignment(int VAlignment = GUIFont::Top) { m_VAlignment = VAlignment; }
+    void SetVAlignment(int VAlignment = GUIFont::Top) { if (m_VAlignment != VAlignment) { m_VAlignment = VAlignment; Invalidate(); } }
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
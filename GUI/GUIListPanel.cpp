@@ -214,6 +214,8 @@ void GUIListPanel::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIListPanel::BuildBitmap(bool UpdateBase, bool UpdateText) {
+	Invalidate();
+
 	// Gotta update the text if updating the base
 	if (UpdateBase)
 		UpdateText = true;
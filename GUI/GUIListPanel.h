@@ -401,7 +401,7 @@ public:
 //                  rectangles, etc
 // Arguments:       The new mode setting.
 
-    void SetAlternateDrawMode(bool enableAltDrawMode = true) { m_AlternateDrawMode = enableAltDrawMode; }
+    void SetAlternateDrawMode(bool enableAltDrawMode = true) { if (m_AlternateDrawMode != enableAltDrawMode) { m_AlternateDrawMode = enableAltDrawMode; Invalidate(); } }
 
 
 
@@ -131,6 +131,10 @@ void GUIManager::Update(bool ignoreKeyboardEvents) {
 				Buttons |= 1 << i;
 		}
 
+		// Presses, releases and wheel turns can change how the panel looks (pushed buttons, checked boxes, etc.), so it has to be redrawn.
+		// Plain mouse motion doesn't, the controls it changes the state of (dragged knobs, hot-tracked lists, etc.) invalidate themselves
+		if (CurPanel && (Released != GUIPanel::MOUSE_NONE || Pushed != GUIPanel::MOUSE_NONE || MouseWheelChange != 0)) { CurPanel->Invalidate(); }
+
 		// Mouse Up
 		if (Released != GUIPanel::MOUSE_NONE && CurPanel) {
 			CurPanel->OnMouseUp(MouseX, MouseY, Released, Mod);
@@ -197,10 +201,16 @@ void GUIManager::Update(bool ignoreKeyboardEvents) {
 		}
 
 		// OnMouseEnter
-		if (Enter && CurPanel) { CurPanel->OnMouseEnter(MouseX, MouseY, Buttons, Mod); }
+		if (Enter && CurPanel) {
+			CurPanel->OnMouseEnter(MouseX, MouseY, Buttons, Mod);
+			CurPanel->Invalidate();
+		}
 
 		// OnMouseLeave
-		if (Leave &&m_MouseOverPanel) { m_MouseOverPanel->OnMouseLeave(MouseX, MouseY, Buttons, Mod); }
+		if (Leave &&m_MouseOverPanel) {
+			m_MouseOverPanel->OnMouseLeave(MouseX, MouseY, Buttons, Mod);
+			m_MouseOverPanel->Invalidate();
+		}
 
 		if (MouseWheelChange &&CurPanel) { CurPanel->OnMouseWheelChange(MouseX, MouseY, Mod, MouseWheelChange); }
 
@@ -223,6 +233,8 @@ void GUIManager::Update(bool ignoreKeyboardEvents) {
 
 
 		for (i = 1; i < 256; i++) {
+			if (KeyboardBuffer[i] != GUIInput::None) { m_FocusPanel->Invalidate(); }
+
 			switch (KeyboardBuffer[i]) {
 				// KeyDown & KeyPress
 				case GUIInput::Pushed:
@@ -249,14 +261,19 @@ void GUIManager::Update(bool ignoreKeyboardEvents) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIManager::Draw(GUIScreen *Screen) {
-	// Go through drawing panels that are invalid
 	std::vector<GUIPanel *>::iterator it;
 
 	for (it = m_PanelList.begin(); it != m_PanelList.end(); it++) {
 		GUIPanel *p = *it;
 
-		// Draw the panel
-		if ((!p->IsValid() || !m_UseValidation) && p->_GetVisible()) { p->Draw(Screen); }
+		// Draw the panel. With validation, only panel trees that have been invalidated get redrawn onto their cached surfaces, the rest are just blitted from theirs
+		if (p->_GetVisible()) {
+			if (m_UseValidation) {
+				p->DrawCached(Screen);
+			} else {
+				p->Draw(Screen);
+			}
+		}
 	}
 }
 
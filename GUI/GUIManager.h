@@ -77,6 +77,16 @@ public:
     void EnableMouse(bool enable = true) { m_MouseEnabled = enable; }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          EnableSurfaceCaching
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Enables and disables drawing the panels from cached surfaces that are
+//                  only redrawn when something in them was invalidated.
+// Arguments:       Enable?
+
+    void EnableSurfaceCaching(bool enable = true) { m_UseValidation = enable; }
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          CaptureMouse
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -39,6 +39,7 @@ void GUIPanel::Clear() {
 	m_ValidRegion = false;
 	m_SignalTarget = this;
 	m_ZPos = 0;
+	m_DrawCache.reset();
 
 	m_Font = nullptr;
 	m_FontColor = 0;
@@ -96,6 +97,8 @@ void GUIPanel::AddChild(GUIPanel *child, bool convertToAbsolutePos) {
 
 		// Add the child to the list
 		m_Children.push_back(child);
+
+		Invalidate();
 	}
 }
 
@@ -109,6 +112,7 @@ void GUIPanel::RemoveChild(const GUIPanel *pChild) {
 		const GUIPanel *pPanel = *itr;
 		if (pPanel && pPanel == pChild) {
 			m_Children.erase(itr);
+			Invalidate();
 			break;
 		}
 	}
@@ -126,12 +130,17 @@ void GUIPanel::LoadProperties(GUIProperties *Props) {
 
 	Props->GetValue("Visible", &m_Visible);
 	Props->GetValue("Enabled", &m_Enabled);
+
+	Invalidate();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIPanel::Invalidate() {
 	m_ValidRegion = false;
+
+	// The parent's cached surface has this drawn on it, so it's out of date too
+	if (m_Parent) { m_Parent->Invalidate(); }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -171,6 +180,38 @@ void GUIPanel::Draw(GUIScreen *Screen) {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void GUIPanel::DrawCached(GUIScreen *Screen) {
+	GUIBitmap *screenBitmap = Screen->GetBitmap();
+
+	// The cache only covers this panel, children outside of it are clipped away when drawing anyway
+	int cacheWidth = m_Width + 1;
+	int cacheHeight = m_Height + 1;
+
+	if (!m_DrawCache || m_DrawCache->GetWidth() != cacheWidth || m_DrawCache->GetHeight() != cacheHeight || m_DrawCache->GetColorDepth() != screenBitmap->GetColorDepth()) {
+		m_DrawCache.reset(Screen->CreateBitmap(cacheWidth, cacheHeight));
+		m_ValidRegion = false;
+	}
+
+	if (!m_ValidRegion) {
+		m_DrawCache->SetClipRect(nullptr);
+		m_DrawCache->DrawRectangle(0, 0, cacheWidth, cacheHeight, m_DrawCache->GetMaskColor(), true);
+
+		// Point the screen at the cache while drawing, offset so this and all its children land on it where they would on the screen relative to this
+		BITMAP *screenTarget = screenBitmap->GetBitmap();
+		screenBitmap->SetBitmap(m_DrawCache->GetBitmap());
+		screenBitmap->SetDrawOffset(m_X, m_Y);
+		Draw(Screen);
+		screenBitmap->SetDrawOffset(0, 0);
+		screenBitmap->SetBitmap(screenTarget);
+	}
+
+	GUIRect cacheRect;
+	SetRect(&cacheRect, 0, 0, cacheWidth, cacheHeight);
+	m_DrawCache->DrawTrans(screenBitmap, m_X, m_Y, &cacheRect);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void GUIPanel::OnMouseDown(int X, int Y, int Buttons, int Modifier) {}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -213,12 +254,14 @@ void GUIPanel::OnKeyPress(int KeyCode, int Modifier) {}
 
 void GUIPanel::OnGainFocus() {
 	m_GotFocus = true;
+	Invalidate();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIPanel::OnLoseFocus() {
 	m_GotFocus = false;
+	Invalidate();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -308,6 +351,8 @@ bool GUIPanel::PointInside(int X, int Y) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIPanel::SetSize(int Width, int Height) {
+	if (Width != m_Width || Height != m_Height) { Invalidate(); }
+
 	m_Width = Width;
 	m_Height = Height;
 }
@@ -317,6 +362,7 @@ void GUIPanel::SetSize(int Width, int Height) {
 void GUIPanel::SetPositionAbs(int X, int Y, bool moveChildren) {
 	int DX = X - m_X;
 	int DY = Y - m_Y;
+	if (DX != 0 || DY != 0) { Invalidate(); }
 
 	m_X = X;
 	m_Y = Y;
@@ -339,6 +385,7 @@ void GUIPanel::SetPositionRel(int X, int Y) {
 
 	int DX = X - m_X;
 	int DY = Y - m_Y;
+	if (DX != 0 || DY != 0) { Invalidate(); }
 
 	m_X = X;
 	m_Y = Y;
@@ -354,6 +401,8 @@ void GUIPanel::SetPositionRel(int X, int Y) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIPanel::MoveRelative(int dX, int dY) {
+	if (dX != 0 || dY != 0) { Invalidate(); }
+
 	m_X += dX;
 	m_Y += dY;
 
@@ -380,7 +429,11 @@ void GUIPanel::CenterInParent(bool centerX, bool centerY) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIPanel::_SetVisible(bool Visible) {
-	m_Visible = Visible;
+	if (Visible != m_Visible) {
+		m_Visible = Visible;
+		// Hidden panels aren't drawn, so the parent has to be redrawn without it
+		Invalidate();
+	}
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -392,7 +445,10 @@ bool GUIPanel::_GetVisible() const {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIPanel::_SetEnabled(bool Enabled) {
-	m_Enabled = Enabled;
+	if (Enabled != m_Enabled) {
+		m_Enabled = Enabled;
+		Invalidate();
+	}
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -564,6 +620,8 @@ void GUIPanel::_ChangeZ(GUIPanel *Child, int Type) {
 		GUIPanel *P = *it;
 		if (P) { P->SetZPos(Count); }
 	}
+
+	Invalidate();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -645,4 +703,6 @@ void GUIPanel::_ApplyProperties(GUIProperties *Props) {
 
 	Props->GetValue("Visible", &m_Visible);
 	Props->GetValue("Enabled", &m_Enabled);
+
+	Invalidate();
 }
\ No newline at end of file
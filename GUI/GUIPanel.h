@@ -125,7 +125,9 @@ public:
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          Invalidate
 //////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Invalidates the panel
+// Description:     Invalidates the panel, and all the panels it's in, so they get redrawn
+//                  instead of drawn from a cached surface. Must be called whenever
+//                  anything that affects how the panel looks changes.
 // Arguments:       None.
 
     void Invalidate();
@@ -149,6 +151,17 @@ public:
     virtual void Draw(GUIScreen *Screen);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          DrawCached
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Draws the panel from a surface cached from the last time it was drawn,
+//                  only redrawing the surface first if the panel has been invalidated
+//                  since then.
+// Arguments:       Screen class
+
+    void DrawCached(GUIScreen *Screen);
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Virtual Method:  OnMouseDown
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -345,7 +358,7 @@ public:
 // Description:     Sets the font this panel will be using
 // Arguments:       The new font, ownership is NOT transferred!
 
-    virtual void SetFont(GUIFont *pFont) { m_Font = pFont; m_ValidRegion = false; }
+    virtual void SetFont(GUIFont *pFont) { m_Font = pFont; Invalidate(); }
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -666,6 +679,8 @@ protected:
 		int m_ZPos;
 
 		GUIPanel *m_SignalTarget;
+
+		std::unique_ptr<GUIBitmap> m_DrawCache; // Surface the size of this panel that it and its children were last drawn to by DrawCached
 };
 };
 #endif
\ No newline at end of file
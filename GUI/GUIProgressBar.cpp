@@ -102,6 +102,8 @@ void GUIProgressBar::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIProgressBar::BuildBitmap() {
+	Invalidate();
+
 	// Free any old bitmaps
 	if (m_DrawBitmap) {
 		m_DrawBitmap->Destroy();
@@ -261,7 +263,10 @@ void GUIProgressBar::SetValue(int Value) {
 	m_Value = std::max(m_Value, m_Minimum);
 
 	// Changed?
-	if (m_Value != OldValue) { AddEvent(GUIEvent::Notification, Changed, 0); }
+	if (m_Value != OldValue) {
+		Invalidate();
+		AddEvent(GUIEvent::Notification, Changed, 0);
+	}
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -273,6 +278,7 @@ int GUIProgressBar::GetValue() const {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIProgressBar::SetMinimum(int Minimum) {
+	if (Minimum != m_Minimum) { Invalidate(); }
 	m_Minimum = Minimum;
 }
 
@@ -285,6 +291,7 @@ int GUIProgressBar::GetMinimum() const {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIProgressBar::SetMaximum(int Maximum) {
+	if (Maximum != m_Maximum) { Invalidate(); }
 	m_Maximum = Maximum;
 }
 
@@ -150,6 +150,8 @@ void GUIPropertyPage::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIPropertyPage::BuildBitmap() {
+	Invalidate();
+
 	// Free any old bitmap
 	if (m_DrawBitmap) {
 		m_DrawBitmap->Destroy();
@@ -290,6 +292,7 @@ void GUIPropertyPage::StoreProperties() {
 void GUIPropertyPage::SetPropertyValues(GUIProperties *Props) {
 	m_PageValues.Clear();
 	m_PageValues.Update(Props, true);
+	Invalidate();
 
 	// Update the text panels
 	for (int i = 0; i < m_TextPanelList.size(); i++) {
@@ -370,6 +373,7 @@ bool GUIPropertyPage::InvokeUpdate() {
 
 void GUIPropertyPage::ClearValues() {
 	m_PageValues.Clear();
+	Invalidate();
 
 	// Hide the text panels
 	std::vector<GUITextPanel *>::iterator it;
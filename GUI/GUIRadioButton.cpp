@@ -80,6 +80,8 @@ void GUIRadioButton::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIRadioButton::BuildBitmap() {
+	Invalidate();
+
 	std::string Filename;
 	unsigned long ColorIndex = 0;
 	int Values[4];
@@ -254,6 +256,7 @@ void GUIRadioButton::SetCheck(bool Check) {
 	}
 
 	m_Checked = Check;
+	Invalidate();
 
 	AddEvent(GUIEvent::Notification, Changed, Check);
 
@@ -294,6 +297,7 @@ bool GUIRadioButton::GetCheck() const {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIRadioButton::SetText(const std::string &Text) {
+	if (Text != m_Text) { Invalidate(); }
 	m_Text = Text;
 }
 
@@ -256,6 +256,7 @@ void GUIScrollPanel::SetMinimum(int Min) {
 
 	// Rebuild the knob bitmap
 	m_RebuildKnob = true;
+	Invalidate();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -266,13 +267,17 @@ void GUIScrollPanel::SetMaximum(int Max) {
 
 	// Rebuild the knob bitmap
 	m_RebuildKnob = true;
+	Invalidate();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIScrollPanel::SetValue(int Value) {
+	int OldValue = m_Value;
 	m_Value = std::clamp(Value, m_Minimum, m_Maximum);
 	CalculateKnob();
+
+	if (m_Value != OldValue) { Invalidate(); }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -283,6 +288,7 @@ void GUIScrollPanel::SetPageSize(int PageSize) {
 
 	// Rebuild the knob bitmap
 	m_RebuildKnob = true;
+	Invalidate();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -293,6 +299,7 @@ void GUIScrollPanel::SetOrientation(int Orientation) {
 	// Rebuild the whole bitmap
 	m_RebuildKnob = true;
 	m_RebuildSize = true;
+	Invalidate();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -511,12 +518,15 @@ void GUIScrollPanel::OnMouseMove(int X, int Y, int Buttons, int Modifier) {
 	if (m_GrabbedKnob) {
 		int Delta = m_GrabbedPos - (MousePos - KnobTop);
 		int OldValue = m_Value;
+		int OldKnobPosition = m_KnobPosition;
 		m_KnobPosition -= Delta;
 
 		// Clamp the knob
 		m_KnobPosition = std::max(m_KnobPosition, 0);
 		m_KnobPosition = std::min(m_KnobPosition, MoveLength - m_KnobLength);
 
+		if (m_KnobPosition != OldKnobPosition) { Invalidate(); }
+
 		// Calculate the value
 		int Area = MoveLength - m_KnobLength;
 		if (Area > 0) {
@@ -681,7 +691,10 @@ void GUIScrollPanel::AdjustValue(int Delta) {
 	// Calculate the new knob position
 	CalculateKnob();
 
-	if (OldValue != m_Value) { SendSignal(ChangeValue, 0); }
+	if (OldValue != m_Value) {
+		Invalidate();
+		SendSignal(ChangeValue, 0);
+	}
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
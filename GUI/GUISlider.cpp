@@ -125,6 +125,8 @@ void GUISlider::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUISlider::BuildBitmap() {
+	Invalidate();
+
 	// Free any old bitmaps
 	if (m_DrawBitmap) {
 		m_DrawBitmap->Destroy();
@@ -348,6 +350,7 @@ void GUISlider::OnMouseMove(int X, int Y, int Buttons, int Modifier) {
 	// Move the knob if it is grabbed
 	if (m_KnobGrabbed) {
 		int Delta = m_KnobGrabPos - (MousePos - KnobTop);
+		int OldKnobPosition = m_KnobPosition;
 		m_KnobPosition -= Delta;
 
 		// Clamp the knob position
@@ -370,6 +373,8 @@ void GUISlider::OnMouseMove(int X, int Y, int Buttons, int Modifier) {
 		m_KnobPosition = std::max(m_KnobPosition, m_EndThickness);
 		m_KnobPosition = std::min(m_KnobPosition, Size - m_KnobSize - m_EndThickness);
 
+		if (m_KnobPosition != OldKnobPosition) { Invalidate(); }
+
 		// If the value has changed, add the "Changed" notification
 		if (m_Value != m_OldValue) { AddEvent(GUIEvent::Notification, Changed, 0); }
 
@@ -403,6 +408,8 @@ GUIPanel * GUISlider::GetPanel() {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUISlider::CalculateKnob() {
+	Invalidate();
+
 	if (!m_KnobImage) {
 		return;
 	}
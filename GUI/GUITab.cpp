@@ -80,6 +80,8 @@ void GUITab::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUITab::BuildBitmap() {
+	Invalidate();
+
 	std::string Filename;
 	unsigned long ColorIndex = 0;
 	int Values[4];
@@ -259,6 +261,7 @@ void GUITab::SetCheck(bool Check) {
 		return;
 	}
 	m_Selected = Check;
+	Invalidate();
 
 	AddEvent(GUIEvent::Notification, Changed, Check);
 
@@ -298,6 +301,7 @@ bool GUITab::GetCheck() const {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUITab::SetText(const std::string &Text) {
+	if (Text != m_Text) { Invalidate(); }
 	m_Text = Text;
 }
 
@@ -136,6 +136,8 @@ void GUITextPanel::Draw(GUIScreen *Screen) {
 
 	// If we have focus, draw the cursor with hacky blink
 	if (m_GotFocus && (m_CursorBlinkCount++ % 30 > 15)) { Screen->GetBitmap()->DrawRectangle(m_X + m_CursorX + 2, m_Y + hSpacer + m_CursorY + 2, 1, FontHeight - 3, m_CursorColor, true); }
+	// The blinking cursor needs a redraw every frame while focused
+	if (m_GotFocus) { Invalidate(); }
 
 	// Restore normal clipping
 	Screen->GetBitmap()->SetClipRect(nullptr);
@@ -387,6 +389,8 @@ void GUITextPanel::OnMouseUp(int X, int Y, int Buttons, int Modifier) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUITextPanel::UpdateText(bool Typing, bool DoIncrement) {
+	Invalidate();
+
 	if (!m_Font) {
 		return;
 	}
@@ -576,6 +580,7 @@ void GUITextPanel::SetText(const std::string &Text) {
 
 void GUITextPanel::SetRightText(const std::string &rightText) {
 	m_RightText = rightText;
+	Invalidate();
 	SendSignal(Changed, 0);
 }
 
@@ -616,6 +621,7 @@ int GUITextPanel::GetSelectionEnd() const {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUITextPanel::ClearSelection() {
+	if (m_GotSelection) { Invalidate(); }
 	m_GotSelection = false;
 }
 
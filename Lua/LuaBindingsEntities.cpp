@@ -236,6 +236,7 @@ namespace RTE {
 		.property("InventorySize", &Actor::GetInventorySize)
 		.property("MaxInventoryMass", &Actor::GetMaxInventoryMass)
 		.property("MovePathSize", &Actor::GetMovePathSize)
+		.property("IsWaitingOnNewMovePath", &Actor::IsWaitingOnNewMovePath)
 		.property("AimDistance", &Actor::GetAimDistance, &Actor::SetAimDistance)
 		.property("SightDistance", &Actor::GetSightDistance, &Actor::SetSightDistance)
 		.property("Mechanical", &Actor::GetMechanical, &Actor::SetMechanical)
@@ -1086,6 +1087,9 @@ namespace RTE {
 		.def("UpdatePathFinding", &Scene::UpdatePathFinding)
 		.def("PathFindingUpdated", &Scene::PathFindingUpdated)
 		.def("CalculatePath", &Scene::CalculateScenePath)
+		.def("CalculatePathAsync", &Scene::CalculateScenePathAsync)
+		.def("IsPathRequestComplete", &Scene::IsScenePathRequestComplete)
+		.def("GetPathRequestResult", &Scene::GetScenePathRequestResult)
 
 		.enum_("PlacedObjectSets")[
 			luabind::value("PLACEONLOAD", Scene::PlacedObjectSets::PLACEONLOAD),
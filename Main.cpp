@@ -20,6 +20,8 @@
 #include "PresetMan.h"
 #include "UInputMan.h"
 #include "PerformanceMan.h"
+#include "ThreadMan.h"
+#include "RotatedSpriteCache.h"
 #include "MetaMan.h"
 #include "NetworkServer.h"
 
@@ -36,6 +38,7 @@ namespace RTE {
 	/// </summary>
 	void InitializeManagers() {
 		g_SettingsMan.Initialize();
+		g_ThreadMan.Initialize();
 
 		g_LuaMan.Initialize();
 		g_NetworkServer.Initialize();
@@ -66,6 +69,7 @@ namespace RTE {
 	/// Destroys all the managers and frees all loaded data before termination.
 	/// </summary>
 	void DestroyManagers() {
+		g_ThreadMan.Destroy();
 		g_NetworkClient.Destroy();
 		g_NetworkServer.Destroy();
 		g_MetaMan.Destroy();
@@ -79,6 +83,7 @@ namespace RTE {
 		g_FrameMan.Destroy();
 		g_TimerMan.Destroy();
 		g_LuaMan.Destroy();
+		RotatedSpriteCache::Clear();
 		ContentFile::FreeAllLoaded();
 		g_ConsoleMan.Destroy();
 
@@ -146,6 +151,7 @@ namespace RTE {
 			g_UInputMan.Update();
 			g_TimerMan.Update();
 			g_TimerMan.UpdateSim();
+			g_ThreadMan.Update();
 			g_AudioMan.Update();
 
 			if (g_FrameMan.ResolutionChanged()) {
@@ -185,6 +191,7 @@ namespace RTE {
 			g_FrameMan.ClearBackBuffer8();
 
 			g_TimerMan.Update();
+			g_ThreadMan.Update();
 
 			bool serverUpdated = false;
 
@@ -197,6 +204,12 @@ namespace RTE {
 
 				g_PerformanceMan.StartPerformanceMeasurement(PerformanceMan::SimTotal);
 
+				// Remember where every MO and scroll target is before anything in this sim update gets to move them, so drawing can interpolate from there
+				if (g_FrameMan.IsRenderInterpolationEnabled()) {
+					g_MovableMan.SaveInterpolationStarts();
+					g_SceneMan.SaveScrollTargetInterpolationStarts();
+				}
+
 				g_UInputMan.Update();
 
 				// It is vital that server is updated after input manager but before activity because input manager will clear received pressed and released events on next update.
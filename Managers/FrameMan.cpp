@@ -3,9 +3,13 @@
 #include "PrimitiveMan.h"
 #include "PerformanceMan.h"
 #include "ActivityMan.h"
+#include "MovableMan.h"
+#include "TimerMan.h"
 #include "ConsoleMan.h"
 #include "SettingsMan.h"
 #include "UInputMan.h"
+#include "ThreadMan.h"
+#include "NetworkServer.h"
 
 #include "SLTerrain.h"
 #include "Scene.h"
@@ -66,6 +70,11 @@ namespace RTE {
 		m_VSplit = false;
 		m_TwoPlayerVSplit = false;
 		m_PlayerScreen = nullptr;
+		for (BITMAP *&extraPlayerScreen : m_ExtraPlayerScreens) {
+			extraPlayerScreen = nullptr;
+		}
+		m_ParallelScreenDrawing = true;
+		m_RenderInterpolation = false;
 		m_PlayerScreenWidth = 0;
 		m_PlayerScreenHeight = 0;
 		m_ScreenDumpBuffer = nullptr;
@@ -383,6 +392,9 @@ namespace RTE {
 		destroy_bitmap(m_BackBuffer32);
 		destroy_bitmap(m_OverlayBitmap32);
 		destroy_bitmap(m_PlayerScreen);
+		for (BITMAP *extraPlayerScreen : m_ExtraPlayerScreens) {
+			if (extraPlayerScreen) { destroy_bitmap(extraPlayerScreen); }
+		}
 		destroy_bitmap(m_ScreenDumpBuffer);
 		destroy_bitmap(m_WorldDumpBuffer);
 		destroy_bitmap(m_ScenePreviewDumpGradient);
@@ -969,25 +981,37 @@ namespace RTE {
 
 		g_PostProcessMan.ClearScreenPostEffects();
 
+		// Draw the MOs somewhere between where they were before and after the latest sim update, depending on how far the real time is towards the next one, so their motion doesn't stutter when the frame rate and sim rate don't line up.
+		// Their HUDs are drawn there too, further down
+		float moInterpolationAmount = 1.0F;
+		if (m_RenderInterpolation && g_ActivityMan.IsInActivity()) {
+			moInterpolationAmount = g_TimerMan.GetSimInterpolationAmount();
+			g_SceneMan.RedrawMOColorLayerTrails();
+			// The post effects the MOs register while being drawn replace the ones from the last frame, instead of piling up over frames drawn without a sim update
+			g_PostProcessMan.StartInterpolatedPostEffects();
+			g_MovableMan.Draw(g_SceneMan.GetMOColorBitmap(), Vector(), moInterpolationAmount);
+			g_PostProcessMan.StopInterpolatedPostEffects();
+		}
+
 		// These accumulate the effects for each player's screen area, and are then transferred to the post-processing lists with the player screen offset applied
-		list<PostEffect> screenRelativeEffects;
-		list<Box> screenRelativeGlowBoxes;
+		std::vector<PostEffect> screenRelativeEffects;
+		std::vector<Box> screenRelativeGlowBoxes;
 
 		const Activity *pActivity = g_ActivityMan.GetActivity();
 
-		for (int playerScreen = 0; playerScreen < screenCount; ++playerScreen) {
-			screenRelativeEffects.clear();
-			screenRelativeGlowBoxes.clear();
+		BITMAP *drawScreens[c_MaxScreenCount];
+		BITMAP *drawScreenGUIs[c_MaxScreenCount];
+		Vector targetPositions[c_MaxScreenCount];
 
-			BITMAP *drawScreen = (screenCount == 1) ? m_BackBuffer8 : m_PlayerScreen;
-			BITMAP *drawScreenGUI = drawScreen;
+		for (int playerScreen = 0; playerScreen < screenCount; ++playerScreen) {
+			drawScreens[playerScreen] = (screenCount == 1) ? m_BackBuffer8 : GetPlayerScreenBitmap(playerScreen);
+			drawScreenGUIs[playerScreen] = drawScreens[playerScreen];
 			if (IsInMultiplayerMode()) {
-				drawScreen = m_NetworkBackBufferIntermediate8[m_NetworkFrameCurrent][playerScreen];
-				drawScreenGUI = m_NetworkBackBufferIntermediateGUI8[m_NetworkFrameCurrent][playerScreen];
+				drawScreens[playerScreen] = m_NetworkBackBufferIntermediate8[m_NetworkFrameCurrent][playerScreen];
+				drawScreenGUIs[playerScreen] = m_NetworkBackBufferIntermediateGUI8[m_NetworkFrameCurrent][playerScreen];
 			}
-			AllegroBitmap playerGUIBitmap(drawScreenGUI);
 
-			// Update the scene view to line up with a specific screen and then draw it onto the intermediate screen
+			// Update the scene view to line up with a specific screen. This sets state shared between the screens, so it's done for all of them before any are drawn
 			g_SceneMan.Update(playerScreen);
 
 			// Save scene layer's offsets for each screen, server will pick them to build the frame state and send to client
@@ -1003,24 +1027,48 @@ namespace RTE {
 					}
 				}
 			}
-			Vector targetPos = g_SceneMan.GetOffset(playerScreen);
+			Vector &targetPos = targetPositions[playerScreen];
+			targetPos = g_SceneMan.GetOffset(playerScreen);
 
 			// Adjust the drawing position on the target screen for if the target screen is larger than the scene in non-wrapping dimension.
 			// Scene needs to be displayed centered on the target bitmap then, and that has to be adjusted for when drawing to the screen
-			if (!g_SceneMan.SceneWrapsX() && drawScreen->w > g_SceneMan.GetSceneWidth()) { targetPos.m_X += (drawScreen->w - g_SceneMan.GetSceneWidth()) / 2; }
-			if (!g_SceneMan.SceneWrapsY() && drawScreen->h > g_SceneMan.GetSceneHeight()) { targetPos.m_Y += (drawScreen->h - g_SceneMan.GetSceneHeight()) / 2; }
+			if (!g_SceneMan.SceneWrapsX() && drawScreens[playerScreen]->w > g_SceneMan.GetSceneWidth()) { targetPos.m_X += (drawScreens[playerScreen]->w - g_SceneMan.GetSceneWidth()) / 2; }
+			if (!g_SceneMan.SceneWrapsY() && drawScreens[playerScreen]->h > g_SceneMan.GetSceneHeight()) { targetPos.m_Y += (drawScreens[playerScreen]->h - g_SceneMan.GetSceneHeight()) / 2; }
 
 			// Try to move at the frame buffer copy time to maybe prevent wonkyness
 			m_TargetPos[m_NetworkFrameCurrent][playerScreen] = targetPos;
+		}
 
-			// Draw the scene
-			if (!IsInMultiplayerMode()) {
-				g_SceneMan.Draw(drawScreen, drawScreenGUI, targetPos);
-			} else {
-				clear_to_color(drawScreen, g_MaskColor);
-				clear_to_color(drawScreenGUI, g_MaskColor);
-				g_SceneMan.Draw(drawScreen, drawScreenGUI, targetPos, true, true);
+		// Draw the scene layers onto each intermediate screen. Each screen only touches its own bitmaps here, so they can all be drawn at the same time
+		auto drawScreenLayers = [this, &drawScreens, &drawScreenGUIs](int firstScreen, int endScreen) {
+			for (int playerScreen = firstScreen; playerScreen < endScreen; ++playerScreen) {
+				if (!IsInMultiplayerMode()) {
+					g_SceneMan.DrawScreenLayers(playerScreen, drawScreens[playerScreen]);
+				} else {
+					clear_to_color(drawScreens[playerScreen], g_MaskColor);
+					clear_to_color(drawScreenGUIs[playerScreen], g_MaskColor);
+					// Clients that have entities replicated to them draw them on their own
+					g_SceneMan.DrawScreenLayers(playerScreen, drawScreens[playerScreen], true, true, g_NetworkServer.UseEntityReplication());
+				}
 			}
+		};
+		if (m_ParallelScreenDrawing) {
+			g_ThreadMan.ParallelFor(0, screenCount, 1, drawScreenLayers);
+		} else {
+			drawScreenLayers(0, screenCount);
+		}
+
+		// Everything drawn over the scene layers uses GUI, Lua and post-processing state shared between the screens, so the rest is done one screen at a time
+		for (int playerScreen = 0; playerScreen < screenCount; ++playerScreen) {
+			screenRelativeEffects.clear();
+			screenRelativeGlowBoxes.clear();
+
+			BITMAP *drawScreen = drawScreens[playerScreen];
+			BITMAP *drawScreenGUI = drawScreenGUIs[playerScreen];
+			const Vector &targetPos = targetPositions[playerScreen];
+			AllegroBitmap playerGUIBitmap(drawScreenGUI);
+
+			g_SceneMan.DrawScreenOverlays(playerScreen, drawScreen, drawScreenGUI, targetPos, moInterpolationAmount);
 
 			// Get only the scene-relative post effects that affect this player's screen
 			if (pActivity) {
@@ -1095,6 +1143,22 @@ namespace RTE {
 		g_PerformanceMan.ResetFrameTimer();
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	BITMAP * FrameMan::GetPlayerScreenBitmap(int playerScreen) {
+		if (playerScreen == 0) {
+			return m_PlayerScreen;
+		}
+		BITMAP *&extraPlayerScreen = m_ExtraPlayerScreens[playerScreen];
+		if (!extraPlayerScreen || extraPlayerScreen->w != m_PlayerScreen->w || extraPlayerScreen->h != m_PlayerScreen->h) {
+			if (extraPlayerScreen) { destroy_bitmap(extraPlayerScreen); }
+			extraPlayerScreen = create_bitmap_ex(8, m_PlayerScreen->w, m_PlayerScreen->h);
+			clear_to_color(extraPlayerScreen, m_BlackColor);
+			set_clip_state(extraPlayerScreen, 1);
+		}
+		return extraPlayerScreen;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void FrameMan::DrawScreenText(int playerScreen, AllegroBitmap playerGUIBitmap) {
@@ -1183,7 +1247,7 @@ namespace RTE {
 
 		// If we're not dumping a scene preview, draw objects and post-effects.
 		if (!drawForScenePreview) {
-			std::list<PostEffect> postEffectsList;
+			std::vector<PostEffect> postEffectsList;
 			BITMAP *effectBitmap = nullptr;
 			int effectPosX = 0;
 			int effectPosY = 0;
@@ -1220,30 +1284,37 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void FrameMan::PrepareFrameForNetwork() {
+		// Copy all four internal player screens to their final buffers. Each player has their own buffers and lock, so they can all be copied at the same time
+		auto copyPlayerScreens = [this](int firstPlayer, int endPlayer) {
+			for (int i = firstPlayer; i < endPlayer; i++) {
+				m_NetworkBitmapLock[i].lock();
+				blit(m_NetworkBackBufferIntermediate8[m_NetworkFrameCurrent][i], m_NetworkBackBufferFinal8[m_NetworkFrameCurrent][i], 0, 0, 0, 0, m_NetworkBackBufferFinal8[m_NetworkFrameCurrent][i]->w, m_NetworkBackBufferFinal8[m_NetworkFrameCurrent][i]->h);
+				blit(m_NetworkBackBufferIntermediateGUI8[m_NetworkFrameCurrent][i], m_NetworkBackBufferFinalGUI8[m_NetworkFrameCurrent][i], 0, 0, 0, 0, m_NetworkBackBufferFinalGUI8[m_NetworkFrameCurrent][i]->w, m_NetworkBackBufferFinalGUI8[m_NetworkFrameCurrent][i]->h);
+				m_NetworkBitmapLock[i].unlock();
+			}
+		};
+		if (m_ParallelScreenDrawing) {
+			g_ThreadMan.ParallelFor(0, c_MaxScreenCount, 1, copyPlayerScreens);
+		} else {
+			copyPlayerScreens(0, c_MaxScreenCount);
+		}
+
+#ifndef RELEASE_BUILD
 		int dx = 0;
 		int dy = 0;
 		int dw = m_BackBuffer8->w / 2;
 		int dh = m_BackBuffer8->h / 2;
 
-		// Blit all four internal player screens onto the backbuffer
 		for (int i = 0; i < c_MaxScreenCount; i++) {
 			dx = (i == 1 || i == 3) ? dw : dx;
 			dy = (i == 2 || i == 3) ? dh : dy;
 
-			m_NetworkBitmapLock[i].lock();
-			blit(m_NetworkBackBufferIntermediate8[m_NetworkFrameCurrent][i], m_NetworkBackBufferFinal8[m_NetworkFrameCurrent][i], 0, 0, 0, 0, m_NetworkBackBufferFinal8[m_NetworkFrameCurrent][i]->w, m_NetworkBackBufferFinal8[m_NetworkFrameCurrent][i]->h);
-			blit(m_NetworkBackBufferIntermediateGUI8[m_NetworkFrameCurrent][i], m_NetworkBackBufferFinalGUI8[m_NetworkFrameCurrent][i], 0, 0, 0, 0, m_NetworkBackBufferFinalGUI8[m_NetworkFrameCurrent][i]->w, m_NetworkBackBufferFinalGUI8[m_NetworkFrameCurrent][i]->h);
-			m_NetworkBitmapLock[i].unlock();
-
-#ifndef RELEASE_BUILD
 			// Draw all player's screen into one
 			if (g_UInputMan.KeyHeld(KEY_5)) {
 				stretch_blit(m_NetworkBackBufferFinal8[m_NetworkFrameCurrent][i], m_BackBuffer8, 0, 0, m_NetworkBackBufferFinal8[m_NetworkFrameReady][i]->w, m_NetworkBackBufferFinal8[m_NetworkFrameReady][i]->h, dx, dy, dw, dh);
 			}
-#endif
 		}
 
-#ifndef RELEASE_BUILD
 		if (g_UInputMan.KeyHeld(KEY_1)) {
 			stretch_blit(m_NetworkBackBufferFinal8[0][0], m_BackBuffer8, 0, 0, m_NetworkBackBufferFinal8[m_NetworkFrameReady][0]->w, m_NetworkBackBufferFinal8[m_NetworkFrameReady][0]->h, 0, 0, m_BackBuffer8->w, m_BackBuffer8->h);
 		}
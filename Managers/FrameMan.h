@@ -294,6 +294,12 @@ namespace RTE {
 #pragma endregion
 
 #pragma region Drawing
+		/// <summary>
+		/// Gets whether movable objects are drawn somewhere between where they were before and after the latest sim update, depending on how much time is left over until the next one, instead of where the sim left them.
+		/// </summary>
+		/// <returns>Whether movable objects are drawn interpolated between sim updates.</returns>
+		bool IsRenderInterpolationEnabled() const { return m_RenderInterpolation; }
+
 		/// <summary>
 		/// Flips the frame buffers, showing the backbuffer on the current display.
 		/// </summary>
@@ -473,6 +479,12 @@ namespace RTE {
 		/// <returns>An reference to a ContentFile which described the palette location.</returns>
 		const ContentFile & GetPaletteFile() const { return m_PaletteFile; }
 
+		/// <summary>
+		/// Gets the palette index of the color black.
+		/// </summary>
+		/// <returns>The palette index of the color black.</returns>
+		int GetBlackIndex() const { return m_BlackColor; }
+
 		/// <summary>
 		/// Fades the palette in from black at a specified speed.
 		/// </summary>
@@ -555,6 +567,9 @@ namespace RTE {
 		COLOR_MAP m_MoreTransTable; //!< Color table for high transparency.
 
 		BITMAP *m_PlayerScreen; //!< Intermediary split screen bitmap.
+		BITMAP *m_ExtraPlayerScreens[c_MaxScreenCount]; //!< Intermediary split screen bitmaps of the player screens after the first, so every screen can be drawn before any of them is blitted to the backbuffer. Created when first needed.
+		bool m_ParallelScreenDrawing; //!< Whether the scene layers of the player screens are drawn at the same time on the worker threads.
+		bool m_RenderInterpolation; //!< Whether movable objects are drawn interpolated between their states before and after the latest sim update.
 		int m_PlayerScreenWidth; //!< Width of the screen of each player. Will be smaller than resolution only if the screen is split.
 		int m_PlayerScreenHeight; //!< Height of the screen of each player. Will be smaller than resolution only if the screen is split.
 
@@ -672,6 +687,13 @@ namespace RTE {
 #pragma endregion
 
 #pragma region Draw Breakdown
+		/// <summary>
+		/// Gets the intermediary split screen bitmap a player screen is drawn to, creating it if needed. This is called during Draw().
+		/// </summary>
+		/// <param name="playerScreen">The player screen to get the bitmap for.</param>
+		/// <returns>The intermediary bitmap the player screen is drawn to.</returns>
+		BITMAP * GetPlayerScreenBitmap(int playerScreen);
+
 		/// <summary>
 		/// Updates the drawing position of each player screen on the backbuffer when split screen is active. This is called during Draw().
 		/// </summary>
@@ -402,8 +402,9 @@ int MetaMan::SaveSceneData(string pathBase)
         // Only save the data of revealed scenes that have already had their layers built and saved into files
         if ((*sItr)->IsRevealed() && (*sItr)->GetTerrain() && (*sItr)->GetTerrain()->IsFileData())
         {
-            // Save the scene data to a good unique prefix for the Scene's layers' bitmap files as they are saved
-            if ((*sItr)->SaveData(pathBase + " - " + (*sItr)->GetPresetName()) < 0)
+            // Save the scene data to a good unique prefix for the Scene's layers' bitmap files as they are saved.
+            // Written in the background, the layers are only read back through LoadData, which waits for the writes to finish.
+            if ((*sItr)->SaveData(pathBase + " - " + (*sItr)->GetPresetName(), true) < 0)
                 return -1;
         }
     }
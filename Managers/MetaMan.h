@@ -152,7 +152,8 @@ friend class MetaSave;
 // Method:          SaveSceneData
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Saves the bitmap data of all Scenes of this Metagame that are currently
-//                  loaded.
+//                  loaded. The layers are snapshotted and written to disk in the
+//                  background, see Scene::SaveData.
 // Arguments:       The filepath base to the where to save the Bitmap data. This means
 //                  everything up to and including the unique name of the game.
 // Return value:    An error return value signaling success or any particular failure.
@@ -14,6 +14,7 @@
 #include "MovableMan.h"
 #include "PostProcessMan.h"
 #include "PerformanceMan.h"
+#include "FrameMan.h"
 #include "PresetMan.h"
 #include "AHuman.h"
 #include "MOPixel.h"
@@ -2001,8 +2002,9 @@ void MovableMan::Update()
 
     ////////////////////////////////////////////////////////////////////
     // Draw the MO colors ONLY if this is a drawn update!
+    // When interpolating, FrameMan draws them itself at their interpolated states instead.
 
-    if (g_TimerMan.DrawnSimUpdate())
+    if (g_TimerMan.DrawnSimUpdate() && !g_FrameMan.IsRenderInterpolationEnabled())
         Draw(g_SceneMan.GetMOColorBitmap());
 
     // Sort team rosters if necessary
@@ -2134,17 +2136,51 @@ void MovableMan::UpdateDrawMOIDs(BITMAP *pTargetBitmap)
 // Description:     Draws this MovableMan's current graphical representation to a
 //                  BITMAP of choice.
 
-void MovableMan::Draw(BITMAP *pTargetBitmap, const Vector &targetPos)
+void MovableMan::Draw(BITMAP *pTargetBitmap, const Vector &targetPos, float interpolationAmount)
 {
     // Draw objects to accumulation bitmap, in reverse order so actors appear on top.
+    // Interpolated ones are drawn offset by moving the target position the opposite way, so nothing about them has to change. Any post effects they register are moved by the same offset
+    Vector drawOffset;
     for (deque<MovableObject *>::iterator parIt = m_Particles.begin(); parIt != m_Particles.end(); ++parIt)
-        (*parIt)->Draw(pTargetBitmap, targetPos);
+    {
+        drawOffset = (*parIt)->GetInterpolatedDrawOffset(interpolationAmount);
+        g_PostProcessMan.SetInterpolatedPostEffectOffset(drawOffset);
+        (*parIt)->Draw(pTargetBitmap, targetPos - drawOffset);
+    }
 
 	for (deque<MovableObject *>::reverse_iterator itmIt = m_Items.rbegin(); itmIt != m_Items.rend(); ++itmIt)
-        (*itmIt)->Draw(pTargetBitmap, targetPos);
+    {
+        drawOffset = (*itmIt)->GetInterpolatedDrawOffset(interpolationAmount);
+        g_PostProcessMan.SetInterpolatedPostEffectOffset(drawOffset);
+        (*itmIt)->Draw(pTargetBitmap, targetPos - drawOffset);
+    }
 
     for (deque<Actor *>::reverse_iterator aIt = m_Actors.rbegin(); aIt != m_Actors.rend(); ++aIt)
-        (*aIt)->Draw(pTargetBitmap, targetPos);
+    {
+        drawOffset = (*aIt)->GetInterpolatedDrawOffset(interpolationAmount);
+        g_PostProcessMan.SetInterpolatedPostEffectOffset(drawOffset);
+        (*aIt)->Draw(pTargetBitmap, targetPos - drawOffset);
+    }
+    g_PostProcessMan.SetInterpolatedPostEffectOffset(Vector());
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          SaveInterpolationStarts
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Has all MO's remember their current position as the start of what drawing
+//                  interpolates from, before they get moved by the coming sim update.
+
+void MovableMan::SaveInterpolationStarts()
+{
+    for (deque<MovableObject *>::iterator parIt = m_Particles.begin(); parIt != m_Particles.end(); ++parIt)
+        (*parIt)->SaveInterpolationStart();
+
+    for (deque<MovableObject *>::iterator itmIt = m_Items.begin(); itmIt != m_Items.end(); ++itmIt)
+        (*itmIt)->SaveInterpolationStart();
+
+    for (deque<Actor *>::iterator aIt = m_Actors.begin(); aIt != m_Actors.end(); ++aIt)
+        (*aIt)->SaveInterpolationStart();
 }
 
 
@@ -2154,14 +2190,14 @@ void MovableMan::Draw(BITMAP *pTargetBitmap, const Vector &targetPos)
 // Description:     Draws this MovableMan's current graphical representation to a
 //                  BITMAP of choice.
 
-void MovableMan::DrawHUD(BITMAP *pTargetBitmap, const Vector &targetPos, int which, bool playerControlled)
+void MovableMan::DrawHUD(BITMAP *pTargetBitmap, const Vector &targetPos, int which, bool playerControlled, float interpolationAmount)
 {
-    // Draw HUD elements
+    // Draw HUD elements, offset along with their interpolated MO's
 	for (deque<MovableObject *>::reverse_iterator itmIt = m_Items.rbegin(); itmIt != m_Items.rend(); ++itmIt)
-        (*itmIt)->DrawHUD(pTargetBitmap, targetPos, which);
+        (*itmIt)->DrawHUD(pTargetBitmap, targetPos - (*itmIt)->GetInterpolatedDrawOffset(interpolationAmount), which);
 
     for (deque<Actor *>::reverse_iterator aIt = m_Actors.rbegin(); aIt != m_Actors.rend(); ++aIt)
-        (*aIt)->DrawHUD(pTargetBitmap, targetPos, which);
+        (*aIt)->DrawHUD(pTargetBitmap, targetPos - (*aIt)->GetInterpolatedDrawOffset(interpolationAmount), which);
 }
 
 } // namespace RTE
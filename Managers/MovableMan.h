@@ -63,6 +63,7 @@ struct AlarmEvent {
 
 class MovableMan : public Singleton<MovableMan>, public Serializable {
 	friend class SettingsMan;
+	friend class NetworkServer;
     friend struct ManagerLuaBindings;
 
 
@@ -827,9 +828,22 @@ public:
 //                  BITMAP of choice.
 // Arguments:       A pointer to a BITMAP to draw on.
 //                  The absolute position of the target bitmap's upper left corner in the scene.
+//                  How far between their positions at the start of the latest sim update
+//                  and their current ones to draw the MO's, 1 being their current ones.
 // Return value:    None.
 
-    void Draw(BITMAP *pTargetBitmap, const Vector &targetPos = Vector());
+    void Draw(BITMAP *pTargetBitmap, const Vector &targetPos = Vector(), float interpolationAmount = 1.0F);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          SaveInterpolationStarts
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Has all MO's remember their current position as the start of what drawing
+//                  interpolates from, before they get moved by the coming sim update.
+// Arguments:       None.
+// Return value:    None.
+
+    void SaveInterpolationStarts();
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -841,9 +855,12 @@ public:
 //                  The absolute position of the target bitmap's upper left corner in the scene.
 //                  Which player's screen is being drawn. Tis affects which actor's HUDs
 //                  get drawn.
+//                  Whether only player controlled actors' HUDs should be drawn. Unused.
+//                  How far between their positions at the start of the latest sim update
+//                  and their current ones to draw the HUDs, 1 being their current ones.
 // Return value:    None.
 
-    void DrawHUD(BITMAP *pTargetBitmap, const Vector &targetPos = Vector(), int which = 0, bool playerControlled = false);
+    void DrawHUD(BITMAP *pTargetBitmap, const Vector &targetPos = Vector(), int which = 0, bool playerControlled = false, float interpolationAmount = 1.0F);
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -5,11 +5,14 @@
 #include "SettingsMan.h"
 #include "PerformanceMan.h"
 #include "UInputMan.h"
+#include "ThreadMan.h"
+#include "PresetMan.h"
+#include "MOSprite.h"
+#include "RotatedSpriteCache.h"
 
 #include "RakSleep.h"
 
 #include "NetworkClient.h"
-#include <lz4.h>
 
 namespace RTE {
 
@@ -32,8 +35,10 @@ namespace RTE {
 		m_IsConnected = false;
 		m_IsRegistered = false;
 		m_ClientInputFps = 120;
-		m_SceneBackgroundBitmap = 0;
-		m_SceneForegroundBitmap = 0;
+		m_PredictLocalInput = true;
+		m_InputSequence = 0;
+		m_UnacknowledgedInputs.clear();
+		m_FrameDecoder.Destroy();
 		m_CurrentSceneLayerReceived = -1;
 		m_CurrentFrame = 0;
 		m_UseNATPunchThroughService = false;
@@ -43,10 +48,17 @@ namespace RTE {
 		m_IsNATPunched = false;
 		m_ActiveBackgroundLayers = 0;
 		m_SceneWrapsX = false;
+		m_CachedBackgrounds = 0;
+		m_CachedBackgroundLayerCount = -1;
 
 		for (int f = 0; f < c_FramesToRemember; f++) {
 			m_TargetPos[f].Reset();
+			m_FrameInputSequence[f] = 0;
+			m_FramePointer[f] = MsgFrameSetup::NoPointer;
+			m_FramePointerPos[f].Reset();
+			m_FrameAim[f].Reset();
 		}
+		m_EntityPresets.clear();
 		for (int i = 0; i < c_MaxLayersStoredForNetwork; i++) {
 			m_BackgroundBitmaps[i] = 0;
 		}
@@ -188,6 +200,11 @@ namespace RTE {
 	void NetworkClient::ReceiveAcceptedMsg() {
 		g_ConsoleMan.PrintString("CLIENT: Registration accepted.");
 		m_IsRegistered = true;
+		// The server counts input messages from registration on
+		m_InputSequence = 0;
+		m_UnacknowledgedInputs.clear();
+		// The server starts counting frame box versions over for every registration, so none of the ones from an earlier connection can be trusted
+		m_FrameDecoder.ClearFrameBoxVersions();
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -272,6 +289,13 @@ namespace RTE {
 		}
 
 		g_UInputMan.ClearNetworkAccumulatedStates();
+
+		msg.InputSequence = ++m_InputSequence;
+		if (m_PredictLocalInput) {
+			m_UnacknowledgedInputs.emplace_back(msg.InputSequence, Vector(static_cast<float>(msg.MouseX), static_cast<float>(msg.MouseY)));
+			if (m_UnacknowledgedInputs.size() > c_MaxUnacknowledgedInputs) { m_UnacknowledgedInputs.pop_front(); }
+		}
+
 		m_Client->Send((const char *)&msg, sizeof(msg), IMMEDIATE_PRIORITY, RELIABLE_ORDERED, 0, m_ServerID, false);
 	}
 
@@ -279,14 +303,14 @@ namespace RTE {
 
 	void NetworkClient::ReceiveFrameSetupMsg(RakNet::Packet *packet) {
 		const MsgFrameSetup *frameData = (MsgFrameSetup *)packet->data;
-		if (frameData->FrameNumber < 0 || frameData->FrameNumber >= c_FramesToRemember) {
+		if (packet->length < sizeof(MsgFrameSetup) || frameData->FrameNumber >= c_FramesToRemember) {
 			return;
 		}
 
 		if (!g_SettingsMan.UseExperimentalMultiplayerSpeedBoosts()) { DrawFrame(); }
 
 		m_PostEffects[m_CurrentFrame].clear();
-		m_CurrentFrame = frameData->FrameNumber;
+		m_CurrentFrame = m_FrameDecoder.DecodeFrameSetupMsg(packet->data, packet->length);
 
 		m_TargetPos[m_CurrentFrame].m_X = frameData->TargetPosX;
 		m_TargetPos[m_CurrentFrame].m_Y = frameData->TargetPosY;
@@ -295,110 +319,43 @@ namespace RTE {
 			m_BackgroundLayers[m_CurrentFrame][i].OffsetX = frameData->OffsetX[i];
 			m_BackgroundLayers[m_CurrentFrame][i].OffsetY = frameData->OffsetY[i];
 		}
+
+		m_FrameInputSequence[m_CurrentFrame] = frameData->InputSequence;
+		m_FramePointer[m_CurrentFrame] = frameData->Pointer;
+		if (frameData->Pointer == MsgFrameSetup::GUICursor) {
+			m_FramePointerPos[m_CurrentFrame].SetXY(frameData->CursorPosX, frameData->CursorPosY);
+		} else {
+			m_FramePointerPos[m_CurrentFrame].SetXY(frameData->AimOriginX, frameData->AimOriginY);
+		}
+		m_FrameAim[m_CurrentFrame].SetXY(frameData->AimX, frameData->AimY);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkClient::ReceiveFrameLineMsg(RakNet::Packet *packet) {
 		const MsgFrameLine *frameData = (MsgFrameLine *)packet->data;
-		int lineNumber = frameData->LineNumber;
 		m_CurrentSceneLayerReceived = -1;
-
-		BITMAP *bmp = 0;
-
-		if (frameData->Layer == 0) {
-			bmp = g_FrameMan.GetNetworkBackBufferIntermediate8Ready(0);
-		} else if (frameData->Layer == 1) {
-			bmp = g_FrameMan.GetNetworkBackBufferIntermediateGUI8Ready(0);
+		if (frameData->Layer > 1) {
+			return;
 		}
-
-		acquire_bitmap(bmp);
-
-		int width = frameData->DataSize;
-		int pixels = std::min(bmp->w, width);
-
 		m_ReceivedData += frameData->DataSize;
 		m_CompressedData += frameData->UncompressedSize;
 
-		if (lineNumber < bmp->h) {
-			if (frameData->DataSize == 0) {
-				memset(bmp->line[lineNumber], g_MaskColor, bmp->w);
-			} else {
-				if (frameData->DataSize == frameData->UncompressedSize) {
-#ifdef _WIN32
-					memcpy_s(bmp->line[lineNumber], bmp->w, packet->data + sizeof(MsgFrameLine), pixels);
-#else
-					//Fallback to non safe memcpy
-					memcpy(bmp->line[lineNumber], packet->data + sizeof(MsgFrameLine), pixels);
-#endif
-				} else {
-					LZ4_decompress_safe((char *)(packet->data + sizeof(MsgFrameLine)), (char *)(bmp->line[lineNumber]), frameData->DataSize, bmp->w);
-				}
-			}
-		}
-		release_bitmap(bmp);
+		m_FrameDecoder.QueueFrameMsg(packet->data, packet->length);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkClient::ReceiveFrameBoxMsg(RakNet::Packet *packet) {
 		const MsgFrameBox *frameData = (MsgFrameBox *)packet->data;
-		int bpx = frameData->BoxX;
-		int bpy = frameData->BoxY;
 		m_CurrentSceneLayerReceived = -1;
-
-		BITMAP *bmp = 0;
-
-		if (frameData->Layer == 0) {
-			bmp = g_FrameMan.GetNetworkBackBufferIntermediate8Ready(0);
-		} else if (frameData->Layer == 1) {
-			bmp = g_FrameMan.GetNetworkBackBufferIntermediateGUI8Ready(0);
+		if (frameData->Layer > 1) {
+			return;
 		}
-
-		acquire_bitmap(bmp);
-
-		int maxWidth = frameData->BoxWidth;
-		int maxHeight = frameData->BoxHeight;
-		int size = frameData->DataSize;
-
 		m_ReceivedData += frameData->DataSize;
 		m_CompressedData += frameData->UncompressedSize;
 
-		if (bpx + maxWidth - 1 < bmp->w && bpy + maxHeight - 1 < bmp->h && bpx >= 0 && bpy >= 0) {
-			// Unpack box
-			if (frameData->DataSize == 0) {
-				//memset(bmp->line[lineNumber], g_MaskColor, bmp->w);
-				rectfill(bmp, bpx, bpy, bpx + maxWidth - 1, bpy + maxHeight - 1, g_MaskColor);
-			} else {
-				if (frameData->DataSize == frameData->UncompressedSize) {
-#ifdef _WIN32
-					memcpy_s(m_PixelLineBuffer, size, packet->data + sizeof(MsgFrameBox), size);
-#else
-					// Fallback to unsafe memcpy
-					memcpy(m_PixelLineBuffer, packet->data + sizeof(MsgFrameBox), size);
-#endif
-
-				} else {
-					LZ4_decompress_safe((char *)(packet->data + sizeof(MsgFrameBox)), (char *)(m_PixelLineBuffer), size, frameData->UncompressedSize);
-				}
-				// Copy box to bitmap line by line
-				const unsigned char *lineAddr = m_PixelLineBuffer;
-				for (int y = 0; y < maxHeight; y++) {
-#ifdef _WIN32
-					memcpy_s(bmp->line[bpy + y] + bpx, maxWidth, lineAddr, maxWidth);
-#else
-					memcpy(bmp->line[bpy + y] + bpx, lineAddr, maxWidth);
-#endif
-
-					lineAddr += maxWidth;
-				}
-
-#ifndef RELEASE_BUILD
-				if (g_UInputMan.KeyHeld(KEY_0)) { rect(bmp, bpx, bpy, bpx + maxWidth - 1, bpy + maxHeight - 1, g_BlackColor); }
-#endif
-			}
-		}
-		release_bitmap(bmp);
+		m_FrameDecoder.QueueFrameMsg(packet->data, packet->length);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -413,42 +370,8 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkClient::ReceiveSceneMsg(RakNet::Packet *packet) {
-		const MsgSceneLine *frameData = (MsgSceneLine *)packet->data;
-		if (frameData->SceneId != m_SceneID) {
-			return;
-		}
-
-		int linex = frameData->X;
-		int liney = frameData->Y;
-
-		const BITMAP *bmp = 0;
-
-		if (frameData->Layer == 0) {
-			bmp = m_SceneBackgroundBitmap;
-		} else if (frameData->Layer == 1) {
-			bmp = m_SceneForegroundBitmap;
-		}
-
-		int width = frameData->UncompressedSize;
-		int pixels = bmp ? std::min(bmp->w, width) : 0;
-
-		m_CurrentSceneLayerReceived = frameData->Layer;
-
-		if (bmp && liney < bmp->h) {
-			if (frameData->DataSize == 0) {
-				memset(bmp->line[liney] + linex, g_MaskColor, width);
-			} else {
-				if (frameData->DataSize == frameData->UncompressedSize) {
-#ifdef _WIN32
-					memcpy_s(bmp->line[liney] + linex, width, packet->data + sizeof(MsgSceneLine), pixels);
-#else
-					memcpy(bmp->line[liney] + linex, packet->data + sizeof(MsgSceneLine), pixels);
-#endif
-				} else {
-					LZ4_decompress_safe((char *)(packet->data + sizeof(MsgSceneLine)), (char *)(bmp->line[liney] + linex), frameData->DataSize, width);
-				}
-			}
-		}
+		int layer = m_FrameDecoder.DecodeSceneMsg(packet->data, packet->length);
+		if (layer >= 0) { m_CurrentSceneLayerReceived = layer; }
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -461,21 +384,16 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkClient::ReceiveSceneSetupMsg(RakNet::Packet *packet) {
-		clear_to_color(g_FrameMan.GetNetworkBackBufferIntermediateGUI8Ready(0), g_MaskColor);
 		clear_to_color(g_FrameMan.GetNetworkBackBufferGUI8Ready(0), g_MaskColor);
 
 		const MsgSceneSetup *frameData = (MsgSceneSetup *)packet->data;
 
-		m_SceneID = frameData->SceneId;
-
-		if (m_SceneBackgroundBitmap) { destroy_bitmap(m_SceneBackgroundBitmap); }
-		if (m_SceneForegroundBitmap) { destroy_bitmap(m_SceneForegroundBitmap); }
-
-		m_SceneBackgroundBitmap = create_bitmap_ex(8, frameData->Width, frameData->Height);
-		m_SceneForegroundBitmap = create_bitmap_ex(8, frameData->Width, frameData->Height);
+		// Clears the frame layers and whatever was decoded for the previous scene, including the frame box versions the server stops compressing against
+		m_FrameDecoder.Create(g_FrameMan.GetNetworkBackBufferIntermediate8Ready(0), g_FrameMan.GetNetworkBackBufferIntermediateGUI8Ready(0));
+		m_FrameDecoder.DecodeSceneSetupMsg(frameData);
 
-		// This is purely for aesthetic reasons to draw bitmap during level loading
-		clear_to_color(m_SceneForegroundBitmap, g_MaskColor);
+		// What's left of the previous scene's backgrounds is of no use anymore
+		m_CachedBackgroundLayerCount = -1;
 
 		m_SceneWrapsX = frameData->SceneWrapsX;
 		m_SceneWidth = frameData->Width;
@@ -533,40 +451,7 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void NetworkClient::ReceiveTerrainChangeMsg(RakNet::Packet *packet) {
-		const MsgTerrainChange *frameData = (MsgTerrainChange *)packet->data;
-		if (frameData->SceneId != m_SceneID) {
-			return;
-		}
-
-		if (frameData->W == 1 && frameData->H == 1) {
-			BITMAP *bmp = 0;
-			bmp = frameData->Back ? m_SceneBackgroundBitmap : m_SceneForegroundBitmap;
-			putpixel(bmp, frameData->X, frameData->Y, frameData->Color);
-		} else {
-			int size = frameData->UncompressedSize;
-
-			if (frameData->DataSize == frameData->UncompressedSize) {
-#ifdef _WIN32
-				memcpy_s(m_PixelLineBuffer, size, packet->data + sizeof(MsgTerrainChange), size);
-#else
-				memcpy(m_PixelLineBuffer, packet->data + sizeof(MsgTerrainChange), size);
-#endif
-			} else {
-				LZ4_decompress_safe((char *)(packet->data + sizeof(MsgTerrainChange)), (char *)m_PixelLineBuffer, frameData->DataSize, size);
-			}
-
-			// Copy bitmap data to scene bitmap
-			const BITMAP *bmp = 0;
-			bmp = (frameData->Back) ? m_SceneBackgroundBitmap : m_SceneForegroundBitmap;
-
-			const unsigned char *src = m_PixelLineBuffer;
-			for (int y = 0; y < frameData->H && frameData->Y + y < bmp->h; y++) {
-				memcpy(bmp->line[frameData->Y + y] + frameData->X, src, frameData->W);
-				src += frameData->W;
-			}
-		}
-	}
+	void NetworkClient::ReceiveTerrainChangeMsg(RakNet::Packet *packet) { m_FrameDecoder.DecodeTerrainChangeMsg(packet->data, packet->length); }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -692,6 +577,20 @@ namespace RTE {
 		}
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkClient::ReceiveEntityPresetsMsg(RakNet::Packet *packet) {
+		m_FrameDecoder.DecodeEntityPresetsMsg(packet->data, packet->length, [this](int presetIndex, const std::string &className, const std::string &moduleName, const std::string &presetName) {
+			if (m_EntityPresets.size() <= static_cast<size_t>(presetIndex)) { m_EntityPresets.resize(presetIndex + 1, nullptr); }
+			const Entity *preset = moduleName.empty() ? g_PresetMan.GetEntityPreset(className, presetName) : g_PresetMan.GetEntityPreset(className, presetName, moduleName);
+			m_EntityPresets[presetIndex] = dynamic_cast<const MOSprite *>(preset);
+		});
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkClient::ReceiveEntityStatesMsg(RakNet::Packet *packet) { m_FrameDecoder.DecodeEntityStatesMsg(packet->data, packet->length); }
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkClient::DrawBackgrounds(BITMAP *targetBitmap) {
@@ -875,10 +774,130 @@ namespace RTE {
 		}
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkClient::DrawCachedBackgrounds(BITMAP *targetBitmap) {
+		// The backgrounds only change when the frame target scrolls any of them, which it mostly doesn't, so they're kept drawn and only drawn again when their offsets change
+		bool backgroundsChanged = m_CachedBackgroundLayerCount != m_ActiveBackgroundLayers || !m_CachedBackgrounds || m_CachedBackgrounds->w != targetBitmap->w || m_CachedBackgrounds->h != targetBitmap->h;
+		for (int i = 0; i < m_ActiveBackgroundLayers; i++) {
+			int offsetX = static_cast<int>(std::floor(m_BackgroundLayers[m_CurrentFrame][i].OffsetX * m_BackgroundLayers[m_CurrentFrame][i].ScrollRatioX));
+			int offsetY = static_cast<int>(std::floor(m_BackgroundLayers[m_CurrentFrame][i].OffsetY * m_BackgroundLayers[m_CurrentFrame][i].ScrollRatioY));
+			if (offsetX != m_CachedBackgroundOffsets[i][0] || offsetY != m_CachedBackgroundOffsets[i][1]) {
+				m_CachedBackgroundOffsets[i][0] = offsetX;
+				m_CachedBackgroundOffsets[i][1] = offsetY;
+				backgroundsChanged = true;
+			}
+		}
+
+		if (backgroundsChanged) {
+			if (m_CachedBackgrounds && (m_CachedBackgrounds->w != targetBitmap->w || m_CachedBackgrounds->h != targetBitmap->h)) {
+				destroy_bitmap(m_CachedBackgrounds);
+				m_CachedBackgrounds = 0;
+			}
+			if (!m_CachedBackgrounds) { m_CachedBackgrounds = create_bitmap_ex(8, targetBitmap->w, targetBitmap->h); }
+
+			// Have to clear to color to fallback if there's no skybox on client
+			clear_to_color(m_CachedBackgrounds, g_BlackColor);
+			DrawBackgrounds(m_CachedBackgrounds);
+			m_CachedBackgroundLayerCount = m_ActiveBackgroundLayers;
+		}
+		blit(m_CachedBackgrounds, targetBitmap, 0, 0, 0, 0, targetBitmap->w, targetBitmap->h);
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkClient::DrawPostEffects(int frame) { g_PostProcessMan.SetNetworkPostEffectsList(0, m_PostEffects[frame]); }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkClient::DrawEntityStates(BITMAP *targetBitmap, int frame) {
+		int targetX = m_TargetPos[frame].GetFloorIntX();
+		int targetY = m_TargetPos[frame].GetFloorIntY();
+
+		for (const EntityStateNetworkData &entityState : m_FrameDecoder.GetEntityStates(frame)) {
+			int drawX = entityState.X - targetX;
+			int drawY = entityState.Y - targetY;
+			// Entities near the seam may be on the other side of it from where the frame is
+			if (m_SceneWrapsX && m_SceneWidth > 0) {
+				if (drawX < -m_SceneWidth / 2) {
+					drawX += m_SceneWidth;
+				} else if (drawX > targetBitmap->w + m_SceneWidth / 2) {
+					drawX -= m_SceneWidth;
+				}
+			}
+
+			if (entityState.PresetIndex == EntityStateNetworkData::c_PixelPresetIndex) {
+				putpixel(targetBitmap, drawX, drawY, entityState.Frame);
+				continue;
+			}
+			const MOSprite *preset = (entityState.PresetIndex < m_EntityPresets.size()) ? m_EntityPresets[entityState.PresetIndex] : nullptr;
+			BITMAP *sprite = preset ? preset->GetSpriteFrame(entityState.Frame) : nullptr;
+			if (!sprite) {
+				continue;
+			}
+			bool hFlipped = entityState.DrawFlags & EntityStateNetworkData::HFlipped;
+
+			// Scaled sprites are rare enough to be drawn the way MOSRotating::Draw does it, without caching
+			if (entityState.Scale != 1.0F) {
+				if (hFlipped) {
+					BITMAP *flippedSprite = create_bitmap_ex(8, sprite->w, sprite->h);
+					clear_to_color(flippedSprite, g_MaskColor);
+					draw_sprite_h_flip(flippedSprite, sprite, 0, 0);
+					pivot_scaled_sprite(targetBitmap, flippedSprite, drawX, drawY, flippedSprite->w + entityState.SpriteOffsetX, -entityState.SpriteOffsetY, itofix(entityState.Angle), ftofix(entityState.Scale));
+					destroy_bitmap(flippedSprite);
+				} else {
+					pivot_scaled_sprite(targetBitmap, sprite, drawX, drawY, -entityState.SpriteOffsetX, -entityState.SpriteOffsetY, itofix(entityState.Angle), ftofix(entityState.Scale));
+				}
+			} else if (std::shared_ptr<BITMAP> rotatedSprite = RotatedSpriteCache::GetRotatedSprite(sprite, -entityState.SpriteOffsetX, -entityState.SpriteOffsetY, static_cast<float>(entityState.Angle), hFlipped)) {
+				draw_sprite(targetBitmap, rotatedSprite.get(), drawX - (rotatedSprite->w / 2), drawY - (rotatedSprite->h / 2));
+			} else if (hFlipped) {
+				// Without the cache flipped sprites are drawn unrotated, which is still close for the small angles most of them are at
+				draw_sprite_h_flip(targetBitmap, sprite, drawX - sprite->w - entityState.SpriteOffsetX + 1, drawY + entityState.SpriteOffsetY);
+			} else {
+				pivot_sprite(targetBitmap, sprite, drawX, drawY, -entityState.SpriteOffsetX, -entityState.SpriteOffsetY, itofix(entityState.Angle));
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkClient::DrawPredictedPointer(BITMAP *targetBitmap, int frame) {
+		// Sequences wrap around, so they're compared by their difference
+		while (!m_UnacknowledgedInputs.empty() && static_cast<int>(m_UnacknowledgedInputs.front().first - m_FrameInputSequence[frame]) <= 0) {
+			m_UnacknowledgedInputs.pop_front();
+		}
+		if (!m_PredictLocalInput || m_FramePointer[frame] == MsgFrameSetup::NoPointer) {
+			return;
+		}
+		Vector unacknowledgedMovement;
+		for (const std::pair<unsigned int, Vector> &unacknowledgedInput : m_UnacknowledgedInputs) {
+			unacknowledgedMovement += unacknowledgedInput.second;
+		}
+
+		if (m_FramePointer[frame] == MsgFrameSetup::GUICursor) {
+			// Menus move their cursor by the raw mouse movement and keep it on the frame
+			int cursorX = std::clamp((m_FramePointerPos[frame] + unacknowledgedMovement).GetFloorIntX(), 1, targetBitmap->w - 2);
+			int cursorY = std::clamp((m_FramePointerPos[frame] + unacknowledgedMovement).GetFloorIntY(), 1, targetBitmap->h - 2);
+			hline(targetBitmap, cursorX - 4, cursorY, cursorX + 4, g_WhiteColor);
+			vline(targetBitmap, cursorX, cursorY - 4, cursorY + 4, g_WhiteColor);
+			return;
+		}
+
+		// Actors aim in the direction of the mouse's analog data, which moves like UInputMan moves it for network players
+		Vector predictedAim = m_FrameAim[frame] + (unacknowledgedMovement * UInputMan::c_NetworkMouseMovementScale);
+		predictedAim.CapMagnitude(g_UInputMan.GetMouseTrapRadius());
+		// Same as the least analog aim that makes Controller aim sharply
+		if (predictedAim.GetMagnitude() <= g_UInputMan.GetMouseTrapRadius() * 0.1F) {
+			return;
+		}
+		bool isPieMenu = m_FramePointer[frame] == MsgFrameSetup::PieMenu;
+		predictedAim.SetMagnitude(static_cast<float>(isPieMenu ? c_PredictedPieCursorDistance : c_PredictedAimDistance));
+		int reticleX = (m_FramePointerPos[frame] + predictedAim).GetFloorIntX();
+		int reticleY = (m_FramePointerPos[frame] + predictedAim).GetFloorIntY();
+		circle(targetBitmap, reticleX, reticleY, 3, isPieMenu ? g_WhiteColor : g_YellowGlowColor);
+		putpixel(targetBitmap, reticleX, reticleY, isPieMenu ? g_WhiteColor : g_YellowGlowColor);
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkClient::DrawFrame() {
@@ -888,8 +907,15 @@ namespace RTE {
 		BITMAP *src_gui_bmp = g_FrameMan.GetNetworkBackBufferIntermediateGUI8Ready(0);
 		BITMAP *dst_gui_bmp = g_FrameMan.GetNetworkBackBufferGUI8Ready(0);
 
-		// Have to clear to color to fallback if there's no skybox on client
-		clear_to_color(dst_bmp, g_BlackColor);
+		BITMAP *sceneBackground = m_FrameDecoder.GetSceneBackgroundBitmap();
+		BITMAP *sceneForeground = m_FrameDecoder.GetSceneForegroundBitmap();
+
+		bool outlineFrameBoxes = false;
+#ifndef RELEASE_BUILD
+		outlineFrameBoxes = g_UInputMan.KeyHeld(KEY_0);
+#endif
+		m_FrameDecoder.DecodePendingFrameMsgs(outlineFrameBoxes);
+
 		clear_to_color(dst_gui_bmp, g_MaskColor);
 
 		// Draw Scene background
@@ -898,41 +924,45 @@ namespace RTE {
 		int destX = 0;
 		int destY = 0;
 
-		DrawBackgrounds(dst_bmp);
-		masked_blit(m_SceneBackgroundBitmap, dst_bmp, sourceX, sourceY, destX, destY, src_bmp->w, src_bmp->h);
+		DrawCachedBackgrounds(dst_bmp);
+		masked_blit(sceneBackground, dst_bmp, sourceX, sourceY, destX, destY, src_bmp->w, src_bmp->h);
 		
 		if (sourceX < 0) {
 			// Draw if the out of seam portion is to the left
-			int newSourceX = m_SceneBackgroundBitmap->w + sourceX;
+			int newSourceX = sceneBackground->w + sourceX;
 
-			masked_blit(m_SceneBackgroundBitmap, dst_bmp, newSourceX, sourceY, destX, destY, src_bmp->w, src_bmp->h);
-		} else if (sourceX + g_FrameMan.GetResX() >= m_SceneBackgroundBitmap->w) {
+			masked_blit(sceneBackground, dst_bmp, newSourceX, sourceY, destX, destY, src_bmp->w, src_bmp->h);
+		} else if (sourceX + g_FrameMan.GetResX() >= sceneBackground->w) {
 			// Draw if the out of seam portion is to the right
-			int newDestX = m_SceneBackgroundBitmap->w - sourceX;
+			int newDestX = sceneBackground->w - sourceX;
 			int width = g_FrameMan.GetResX() - newDestX;
 
-			masked_blit(m_SceneBackgroundBitmap, dst_bmp, 0, sourceY, newDestX, destY, width, src_bmp->h);
+			masked_blit(sceneBackground, dst_bmp, 0, sourceY, newDestX, destY, width, src_bmp->h);
 		}
 
+		// Replicated entities go where the server would have drawn them, under the unseen layer in the frame
+		DrawEntityStates(dst_bmp, m_CurrentFrame);
+
 		//draw_sprite(src_bmp, dst_bmp, 0, 0);
 		masked_blit(src_bmp, dst_bmp, 0, 0, 0, 0, src_bmp->w, src_bmp->h);
 		masked_blit(src_gui_bmp, dst_gui_bmp, 0, 0, 0, 0, src_bmp->w, src_bmp->h);
-		masked_blit(m_SceneForegroundBitmap, dst_bmp, sourceX, sourceY, destX, destY, src_bmp->w, src_bmp->h);
+		masked_blit(sceneForeground, dst_bmp, sourceX, sourceY, destX, destY, src_bmp->w, src_bmp->h);
 
 		if (sourceX < 0) {
 			// Draw if the out of seam portion is to the left
-			int newSourceX = m_SceneForegroundBitmap->w + sourceX;
+			int newSourceX = sceneForeground->w + sourceX;
 
-			masked_blit(m_SceneForegroundBitmap, dst_bmp, newSourceX, sourceY, destX, destY, src_bmp->w, src_bmp->h);
-		} else if (sourceX + g_FrameMan.GetResX() >= m_SceneForegroundBitmap->w) {
+			masked_blit(sceneForeground, dst_bmp, newSourceX, sourceY, destX, destY, src_bmp->w, src_bmp->h);
+		} else if (sourceX + g_FrameMan.GetResX() >= sceneForeground->w) {
 			// Draw if the out of seam portion is to the right
-			int newDestX = m_SceneForegroundBitmap->w - sourceX;
+			int newDestX = sceneForeground->w - sourceX;
 			int width = g_FrameMan.GetResX() - newDestX;
 
-			masked_blit(m_SceneForegroundBitmap, dst_bmp, 0, sourceY, newDestX, destY, width, src_bmp->h);
+			masked_blit(sceneForeground, dst_bmp, 0, sourceY, newDestX, destY, width, src_bmp->h);
 		}
 
 		DrawPostEffects(m_CurrentFrame);
+		DrawPredictedPointer(dst_gui_bmp, m_CurrentFrame);
 
 		g_PerformanceMan.SetCurrentPing(GetPing());
 	}
@@ -944,14 +974,16 @@ namespace RTE {
 
 		// Draw level loading animation
 		if (m_CurrentSceneLayerReceived != -1) {
+			BITMAP *sceneBackground = m_FrameDecoder.GetSceneBackgroundBitmap();
+			BITMAP *sceneForeground = m_FrameDecoder.GetSceneForegroundBitmap();
 			BITMAP * bmp = 0;
 
 			if (m_CurrentSceneLayerReceived == -1) {
-				bmp = m_SceneBackgroundBitmap;
+				bmp = sceneBackground;
 			} else if (m_CurrentSceneLayerReceived == 0) {
-				bmp = m_SceneBackgroundBitmap;
+				bmp = sceneBackground;
 			} else if (m_CurrentSceneLayerReceived == 1) {
-				bmp = m_SceneForegroundBitmap;
+				bmp = sceneForeground;
 			}
 
 			BITMAP *dst_bmp = g_FrameMan.GetNetworkBackBuffer8Ready(0);
@@ -978,7 +1010,7 @@ namespace RTE {
 			}
 
 			// Draw previous layer
-			if (m_CurrentSceneLayerReceived == 1) { masked_stretch_blit(m_SceneBackgroundBitmap, dst_bmp, 0, 0, bmp->w, bmp->h, x, y, w, h); }
+			if (m_CurrentSceneLayerReceived == 1) { masked_stretch_blit(sceneBackground, dst_bmp, 0, 0, bmp->w, bmp->h, x, y, w, h); }
 
 			masked_stretch_blit(bmp, dst_bmp, 0, 0, bmp->w, bmp->h, x, y, w, h);
 		}
@@ -1143,6 +1175,12 @@ namespace RTE {
 				case ID_SRV_MUSIC_EVENTS:
 					ReceiveMusicEventsMsg(packet);
 					break;
+				case ID_SRV_ENTITY_PRESETS:
+					ReceiveEntityPresetsMsg(packet);
+					break;
+				case ID_SRV_ENTITY_STATES:
+					ReceiveEntityStatesMsg(packet);
+					break;
 				case ID_NAT_TARGET_NOT_CONNECTED:
 					g_ConsoleMan.PrintString("Failed: ID_NAT_TARGET_NOT_CONNECTED");
 					m_IsConnected = false;
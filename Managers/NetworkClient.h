@@ -5,6 +5,7 @@
 #include "SoundContainer.h"
 
 #include "NetworkMessages.h"
+#include "NetworkFrameDecoder.h"
 
 // TODO: Figure out how to deal with anything that is defined by these and include them in implementation only to remove Windows.h macro pollution from our headers.
 #include "RakPeerInterface.h"
@@ -22,6 +23,7 @@
 namespace RTE {
 
 	struct PostEffect;
+	class MOSprite;
 
 	/// <summary>
 	/// The centralized singleton manager of the network multiplayer client.
@@ -157,7 +159,7 @@ namespace RTE {
 		bool m_IsRegistered; //!< Is client registered at server.
 		bool m_IsNATPunched; //!< Is client connected through NAT service.
 
-		unsigned char m_PixelLineBuffer[c_MaxPixelLineBufferSize]; //!<
+		NetworkFrameDecoder m_FrameDecoder; //!< Decodes the scene, terrain changes, frames and entity states received from the server.
 
 		long int m_ReceivedData; //!<
 		long int m_CompressedData; //!<
@@ -165,20 +167,35 @@ namespace RTE {
 		int m_ClientInputFps; //!< The rate (in FPS) the client input is sent to the server.
 		long long m_LastInputSentTime; //!< The last time input was sent in real time ticks.
 
+		/// <summary>
+		/// The mouse cursor, aim and pie menu cursor come back from the server a round trip late, so the client draws its own ahead of each frame from the input the frame doesn't include yet.
+		/// </summary>
+		static constexpr int c_MaxUnacknowledgedInputs = 256; //!< How many sent input messages to keep predicting from at most, in case the server stops acknowledging them.
+		static constexpr int c_PredictedAimDistance = 40; //!< How far from the actor the predicted aim reticle is drawn, in pixels.
+		static constexpr int c_PredictedPieCursorDistance = 58; //!< How far from the actor the predicted pie menu cursor is drawn, in pixels. Same as the full radius of PieMenuGUI.
+		bool m_PredictLocalInput; //!< Whether to draw the predicted mouse cursor, aim and pie menu cursor over the frames.
+		unsigned int m_InputSequence; //!< The InputSequence of the last input message sent.
+		std::deque<std::pair<unsigned int, Vector>> m_UnacknowledgedInputs; //!< The sequence and mouse movement of each input message sent that the server hadn't applied as of the last frame drawn.
+		unsigned int m_FrameInputSequence[c_FramesToRemember]; //!< The InputSequence of the last input message each frame includes.
+		unsigned char m_FramePointer[c_FramesToRemember]; //!< What the mouse was moving on each frame, as MsgFrameSetup::PointerMode.
+		Vector m_FramePointerPos[c_FramesToRemember]; //!< The position of the menu cursor, or the position the actor aims from, on each frame.
+		Vector m_FrameAim[c_FramesToRemember]; //!< The offset of the mouse aim from the middle of the mouse trap circle on each frame.
+
 		int m_CurrentFrame; //!<
 
 		Vector m_TargetPos[c_FramesToRemember]; //!<
-		std::list<PostEffect> m_PostEffects[c_FramesToRemember]; //!< List of post-effects received from server.
+		std::vector<PostEffect> m_PostEffects[c_FramesToRemember]; //!< List of post-effects received from server.
+
+		std::vector<const MOSprite *> m_EntityPresets; //!< The presets replicated entities are drawn from, by the index the server refers to them with. Null for ones that aren't loaded here. Not owned.
 
 		std::unordered_map<int, SoundContainer *> m_ServerSounds; //!< Unordered map of SoundContainers received from server. OWNED!!!
 
-		unsigned char m_SceneID; //!< 
 		int m_CurrentSceneLayerReceived; //!<
 
-		BITMAP *m_SceneBackgroundBitmap; //!<
-		BITMAP *m_SceneForegroundBitmap; //!<
-
 		BITMAP *m_BackgroundBitmaps[c_MaxLayersStoredForNetwork]; //!<
+		BITMAP *m_CachedBackgrounds; //!< The background layers as last drawn, drawn again only when the offset of any of them changes. Owned.
+		int m_CachedBackgroundOffsets[c_MaxLayersStoredForNetwork][2]; //!< The X and Y offsets each background layer was last drawn at.
+		int m_CachedBackgroundLayerCount; //!< How many background layers the cached backgrounds were drawn with, or -1 if they have to be drawn again.
 		LightweightSceneLayer m_BackgroundLayers[c_FramesToRemember][c_MaxLayersStoredForNetwork]; //!<
 		int m_ActiveBackgroundLayers; //!<
 		bool m_SceneWrapsX; //!<
@@ -308,6 +325,18 @@ namespace RTE {
 		/// </summary>
 		/// <param name="packet">The packet to handle.</param>
 		void ReceiveMusicEventsMsg(RakNet::Packet *packet);
+
+		/// <summary>
+		/// Receive and handle a packet of presets the server will refer to in entity states.
+		/// </summary>
+		/// <param name="packet">The packet to handle.</param>
+		void ReceiveEntityPresetsMsg(RakNet::Packet *packet);
+
+		/// <summary>
+		/// Receive and handle a packet of entity states for the next frame.
+		/// </summary>
+		/// <param name="packet">The packet to handle.</param>
+		void ReceiveEntityStatesMsg(RakNet::Packet *packet);
 #pragma endregion
 
 #pragma region Drawing
@@ -317,12 +346,32 @@ namespace RTE {
 		/// <param name="targetBitmap"></param>
 		void DrawBackgrounds(BITMAP *targetBitmap);
 
+		/// <summary>
+		/// Draws the background layers onto a bitmap through a cache of them, which is only drawn again when any of them scrolled.
+		/// </summary>
+		/// <param name="targetBitmap">The bitmap to draw the backgrounds onto, replacing what's on it.</param>
+		void DrawCachedBackgrounds(BITMAP *targetBitmap);
+
 		/// <summary>
 		/// 
 		/// </summary>
 		/// <param name="frame"></param>
 		void DrawPostEffects(int frame);
 
+		/// <summary>
+		/// Draws the entities the server replicated for a frame.
+		/// </summary>
+		/// <param name="targetBitmap">The bitmap to draw the entities on, lined up with the frame.</param>
+		/// <param name="frame">The frame to draw the entities of.</param>
+		void DrawEntityStates(BITMAP *targetBitmap, int frame);
+
+		/// <summary>
+		/// Draws the mouse cursor, aim reticle or pie menu cursor where the mouse movement the server hadn't applied yet when drawing a frame will take it.
+		/// </summary>
+		/// <param name="targetBitmap">The bitmap to draw on, lined up with the frame.</param>
+		/// <param name="frame">The frame to draw the prediction for.</param>
+		void DrawPredictedPointer(BITMAP *targetBitmap, int frame);
+
 		/// <summary>
 		/// 
 		/// </summary>
@@ -7,12 +7,20 @@
 #include "Scene.h"
 #include "SLTerrain.h"
 #include "GameActivity.h"
+#include "MOPixel.h"
+#include "AEmitter.h"
 
 #include "SettingsMan.h"
 #include "ConsoleMan.h"
 #include "UInputMan.h"
 #include "TimerMan.h"
+#include "PerformanceMan.h"
 #include "AudioMan.h"
+#include "ThreadMan.h"
+#include "MovableMan.h"
+#include "PresetMan.h"
+#include "DataModule.h"
+#include "FrameBoxCodec.h"
 
 #include "RakNetStatistics.h"
 #include "RakSleep.h"
@@ -24,24 +32,15 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void NetworkServer::BackgroundSendThreadFunction(NetworkServer *server, short player) {
-		const int sleepTime = 1000000 / server->m_EncodingFps;
-		while (server->IsServerModeEnabled() && server->IsPlayerConnected(player)) {
-			if (server->NeedToSendSceneSetupData(player) && server->IsSceneAvailable(player)) {
-				server->SendSceneSetupData(player);
-			}
-			if (server->NeedToSendSceneData(player) && server->IsSceneAvailable(player)) {
-				server->ClearTerrainChangeQueue(player);
-				server->SendSceneData(player);
-			}
-			if (server->SendFrameData(player)) {
-				server->SendFrame(player);
-				std::this_thread::sleep_for(std::chrono::microseconds(sleepTime));
-			}
-			server->UpdateStats(player);
+	void NetworkServer::SendToClient(short player) {
+		if (NeedToSendSceneSetupData(player) && IsSceneAvailable(player)) {
+			SendSceneSetupData(player);
 		}
-		server->SetThreadExitReason(player, NetworkServer::THREAD_FINISH);
+		if (NeedToSendSceneData(player) && IsSceneAvailable(player)) { SendSceneData(player); }
+		if (SendFrameData(player)) { SendFrame(player); }
+		UpdateStats(player);
 
+		m_SendToClientInProgress[player] = false;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -51,8 +50,21 @@ namespace RTE {
 		m_SimSleepWhenIdle = false;
 
 		for (short i = 0; i < c_MaxClients; i++) {
-			m_BackBuffer8[i] = 0;
-			m_BackBufferGUI8[i] = 0;
+			m_SentBackBuffer8[i] = 0;
+			m_SentBackBufferGUI8[i] = 0;
+
+			m_FrameBoxRefreshPhase[i] = 0;
+			m_ResendAllFrameBoxes[i] = c_FramesToResendAllBoxes;
+
+			m_EntityPresetsSent[i] = 0;
+			m_EntityPresetsMsg[i].clear();
+			m_EntityStates[i].clear();
+			m_FrameSetups[i] = MsgFrameSetup();
+
+			m_DirtyTerrainTileCount[i] = 0;
+			m_TerrainTileColumns[i] = 0;
+			m_TerrainTileRows[i] = 0;
+			m_NextTerrainTileRow[i] = 0;
 
 			m_LastFrameSentTime[i] = 0;
 			m_LastStatResetTime[i] = 0;
@@ -76,17 +88,21 @@ namespace RTE {
 
 			m_ThreadExitReason[i] = 0;
 			m_MSecsToSleep[i] = 0;
+			m_SendToClientInProgress[i] = false;
 
 			// Set to send scene setup data by default
 			m_SendSceneSetupData[i] = false;
 			m_SendSceneData[i] = false;
 			m_SceneAvailable[i] = false;
 			m_SendFrameData[i] = false;
+			m_SceneDataSnapshots[i].reset();
+			m_SceneLinesSent[i] = 0;
 
 			m_EndActivityVotes[i] = false;
 			m_RestartActivityVotes[i] = false;
 
 			m_FrameNumbers[i] = 0;
+			m_LastInputSequence[i] = 0;
 
 			m_Ping[i] = 0;
 			m_PingTimer[i].Reset();
@@ -121,6 +137,7 @@ namespace RTE {
 
 			m_EmptyBlocks[i] = 0;
 			m_FullBlocks[i] = 0;
+			m_UnchangedBlocks[i] = 0;
 		}
 
 		m_UseHighCompression = true;
@@ -129,14 +146,41 @@ namespace RTE {
 		m_FastAccelerationFactor = 10;
 		m_UseInterlacing = false;
 		m_EncodingFps = 60;
+		m_UseAdaptiveEncoding = true;
+		m_AdaptiveTargetLatency = 100;
 		m_ShowInput = false;
 		m_ShowStats = false;
 		m_TransmitAsBoxes = true;
 		m_BoxWidth = 64;
 		m_BoxHeight = 88;
+		m_UseDeltaCompression = true;
+		m_UseFrameBoxPrediction = true;
+		m_TerrainChangeBytesPerFrame = 8192;
+		m_UseEntityReplication = false;
+		m_EntityStateBytesPerFrame = 16384;
+		m_EntityPresetIndices.clear();
+		m_EntityPresetNames.clear();
+
+		m_SceneSnapshot.reset();
+		for (int layer = 0; layer < 2; layer++) {
+			m_SceneSnapshotChangedTiles[layer].clear();
+			m_SceneSnapshotChangedTileRowCounts[layer].clear();
+		}
+		m_SceneSnapshotChangedTileCount = 0;
+		m_SceneSnapshotTileColumns = 0;
+		m_SceneSnapshotTileRows = 0;
+		m_StatsLogPath.clear();
+		if (m_StatsLog.is_open()) { m_StatsLog.close(); }
+		m_StatsLogStartTime = 0;
+		m_LastStatsLogTime = 0;
 		m_UseNATService = false;
 		m_NatServerConnected = false;
 		m_LastPackedReceived.Reset();
+
+		for (short i = 0; i < c_MaxClients; i++) {
+			ResetClientEncoding(i);
+			m_ClientBaselinePing[i] = 0;
+		}
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -150,7 +194,6 @@ namespace RTE {
 			m_ClientConnections[i].InternalId = RakNet::UNASSIGNED_SYSTEM_ADDRESS;
 			m_ClientConnections[i].ClientId = RakNet::UNASSIGNED_SYSTEM_ADDRESS;
 			m_ClientConnections[i].IsActive = false;
-			m_ClientConnections[i].SendThread = 0;
 
 			m_LZ4CompressionState[i] = malloc(LZ4_sizeofStateHC());
 			m_LZ4FastCompressionState[i] = malloc(LZ4_sizeofState());
@@ -164,8 +207,12 @@ namespace RTE {
 	void NetworkServer::Destroy() {
 		//Send a signal that server is going to shutdown
 		m_IsInServerMode = false;
-		// Wait for thread to shut down
-		RakSleep(250);
+		// Sends to clients still queued or running on the worker threads use the connection and buffers torn down below, so let them finish first
+		for (short player = 0; player < c_MaxClients; player++) {
+			while (m_SendToClientInProgress[player]) {
+				RakSleep(1);
+			}
+		}
 		m_Server->Shutdown(300);
 		// We're done with the network
 		RakNet::RakPeerInterface::DestroyInstance(m_Server);
@@ -255,6 +302,18 @@ namespace RTE {
 		}
 		m_Server->SetOccasionalPing(true);
 		m_Server->SetUnreliableTimeout(50);
+
+		if (!m_StatsLogPath.empty()) {
+			m_StatsLog.open(m_StatsLogPath, std::ios::out | std::ios::trunc);
+			if (m_StatsLog.is_open()) {
+				m_StatsLogStartTime = g_TimerMan.GetRealTickCount();
+				m_LastStatsLogTime = m_StatsLogStartTime;
+				m_StatsLog << "Seconds,Player,Ping,EncodingFps,Interlacing,CompressionLevel,FramesPerSecond,MsecPerSendCall,BytesSent,BytesUncompressed,FrameBytes,PostEffectBytes,SoundBytes,TerrainBytes,OtherBytes,SendBufferBytes,SendBufferMessages,FramesSent,FramesSkipped,FullBlocks,EmptyBlocks,UnchangedBlocks,ServerMsecPerFrame\n";
+				g_ConsoleMan.PrintString("SERVER: Logging stats to " + m_StatsLogPath);
+			} else {
+				g_ConsoleMan.PrintString("ERROR: SERVER: Failed to open stats log " + m_StatsLogPath);
+			}
+		}
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -292,6 +351,9 @@ namespace RTE {
 					m_Mutex[player].unlock();
 				}
 			}
+			m_SceneSnapshotChangesMutex.lock();
+			MarkDirtyTerrainTiles(terrainChange, m_SceneSnapshotTileColumns, m_SceneSnapshotTileRows, m_SceneSnapshotChangedTiles, m_SceneSnapshotChangedTileRowCounts, m_SceneSnapshotChangedTileCount);
+			m_SceneSnapshotChangesMutex.unlock();
 		}
 	}
 
@@ -376,9 +438,6 @@ namespace RTE {
 				m_ClientConnections[index].ClientId = RakNet::UNASSIGNED_SYSTEM_ADDRESS;
 				m_ClientConnections[index].InternalId = RakNet::UNASSIGNED_SYSTEM_ADDRESS;
 
-				//delete m_ClientConnections[index].SendThread;
-				m_ClientConnections[index].SendThread = 0;
-
 				m_SendSceneSetupData[index] = true;
 				m_SendSceneData[index] = false;
 				m_SendFrameData[index] = false;
@@ -406,10 +465,13 @@ namespace RTE {
 				m_ClientConnections[index].IsActive = true;
 				m_ClientConnections[index].PlayerName = msgReg->Name;
 				g_FrameMan.CreateNewNetworkPlayerBackBuffer(index, msgReg->ResolutionX, msgReg->ResolutionY);
+				ResetClientEncoding(index);
+				m_ClientBaselinePing[index] = 0;
+				m_EntityPresetsSent[index] = 0;
+				m_EntityPresetsMsg[index].clear();
+				m_LastInputSequence[index] = 0;
 
 				m_Server->SetTimeoutTime(5000, m_ClientConnections[index].ClientId);
-
-				m_ClientConnections[index].SendThread = new std::thread(BackgroundSendThreadFunction, this, index);
 				SendAcceptedMsg(index);
 
 				m_SendSceneSetupData[index] = true;
@@ -468,6 +530,8 @@ namespace RTE {
 			msg.InputElementReleased = m->InputElementReleased;
 			msg.InputElementHeld = m->InputElementHeld;
 
+			msg.InputSequence = m->InputSequence;
+
 			bool skip = true;
 
 			if (!m_InputMessages[player].empty()) {
@@ -493,7 +557,12 @@ namespace RTE {
 				skip = false;
 			}
 
-			if (!skip) { m_InputMessages[player].push(msg); }
+			if (!skip) {
+				m_InputMessages[player].push(msg);
+			} else {
+				// The skipped message is as good as applied, so the client shouldn't keep predicting from it
+				m_InputMessages[player].back().InputSequence = msg.InputSequence;
+			}
 		}
 	}
 
@@ -542,6 +611,8 @@ namespace RTE {
 
 			// We need to replace mouse input obtained from the allegro with mouse input obtained from network clients
 			GUIInput::SetNetworkMouseMovement(player, msg.MouseX, msg.MouseY);
+
+			m_LastInputSequence[player] = msg.InputSequence;
 		} else {
 			//g_ConsoleMan.PrintString("SERVER: Input for unknown client. Ignored.");
 		}
@@ -732,6 +803,13 @@ namespace RTE {
 		m_SendSceneData[player] = false;
 		m_SendFrameData[player] = false;
 
+		// Scene data sent so far was for the old scene, the client gets all of it again
+		m_SceneDataSnapshots[player].reset();
+		m_SceneLinesSent[player] = 0;
+
+		// The client clears its copy of the frame GUI when it receives the scene setup, so it needs everything again
+		m_ResendAllFrameBoxes[player] = c_FramesToResendAllBoxes;
+
 		// While we're on the same thread with freshly connected player, send current music being played
 		if (g_AudioMan.IsMusicPlaying()) {
 			std::string currentMusic = g_AudioMan.GetMusicPath();
@@ -758,18 +836,6 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkServer::SendSceneData(short player) {
-		// Check for congestion
-		RakNet::RakNetStatistics rns;
-
-		MsgSceneLine *sceneData = (MsgSceneLine *)m_PixelLineBuffer[player];
-
-		// Save message ID
-		sceneData->Id = ID_SRV_SCENE;
-
-		int lineX = 0;
-		int lineY = 0;
-		int lineWidth = 1280;
-
 		Scene *scene = g_SceneMan.GetScene();
 		SLTerrain *terrain = 0;
 
@@ -782,92 +848,159 @@ namespace RTE {
 			return;
 		}
 
-		// Lock the scene until current bitmap is fully transfered
+		// Lock the scene while lines are sent so it can't be swapped out underneath
 		m_SceneLock[player].lock();
 
-		for (int layer = 0; layer < 2; layer++) {
-			BITMAP *bmp = 0;
-			if (layer == 0) {
-				bmp = terrain->GetBGColorBitmap();
-			} else if (layer == 1) {
-				bmp = terrain->GetFGColorBitmap();
-			}
+		if (!m_SceneDataSnapshots[player]) {
+			ClearTerrainChangeQueue(player);
+			m_SceneDataSnapshots[player] = AcquireSceneSnapshot(player, terrain);
+			m_SceneLinesSent[player] = 0;
+		}
+		const std::vector<std::vector<unsigned char>> &lineMessages = m_SceneDataSnapshots[player]->LineMessages;
 
-			lock_bitmap(bmp);
+		// Only top up the send buffer instead of waiting for it to drain, the rest of the lines are sent on the next updates so the worker is free for other work meanwhile
+		RakNet::RakNetStatistics rns;
+		m_Server->GetStatistics(m_ClientConnections[player].ClientId, &rns);
+		m_SendBufferBytes[player] = (int)rns.bytesInSendBuffer[MEDIUM_PRIORITY] + (int)rns.bytesInSendBuffer[HIGH_PRIORITY];
+		m_SendBufferMessages[player] = (int)rns.messageInSendBuffer[MEDIUM_PRIORITY] + (int)rns.messageInSendBuffer[HIGH_PRIORITY];
 
-			for (lineX = 0; ; lineX += lineWidth) {
-				int width = lineWidth;
-				if (lineX + width >= g_SceneMan.GetSceneWidth()) { width = g_SceneMan.GetSceneWidth() - lineX; }
+		size_t linesToSend = static_cast<size_t>(std::max(c_MaxSceneLinesInSendBuffer - static_cast<int>(rns.messageInSendBuffer[HIGH_PRIORITY]), 0));
+		size_t endLine = std::min(lineMessages.size(), m_SceneLinesSent[player] + linesToSend);
 
-				for (lineY = 0; lineY < g_SceneMan.GetSceneHeight(); lineY++) {
-					// Save scene fragment data
-					sceneData->DataSize = width;
-					sceneData->UncompressedSize = width;
-					sceneData->Layer = layer;
-					sceneData->X = lineX;
-					sceneData->Y = lineY;
-					sceneData->SceneId = m_SceneID;
+		for (size_t lineIndex = m_SceneLinesSent[player]; lineIndex < endLine; lineIndex++) {
+			const std::vector<unsigned char> &lineMessage = lineMessages[lineIndex];
+			const MsgSceneLine *sceneData = reinterpret_cast<const MsgSceneLine *>(lineMessage.data());
+			int payloadSize = static_cast<int>(lineMessage.size());
 
-					// Compression section
-					int result = 0;
-					//bool lineIsEmpty = false;
+			m_Server->Send((const char *)sceneData, payloadSize, HIGH_PRIORITY, RELIABLE, 0, m_ClientConnections[player].ClientId, false);
 
-					result = LZ4_compress_HC_extStateHC(m_LZ4CompressionState[player], (char *)bmp->line[lineY] + lineX, (char *)(m_PixelLineBuffer[player] + sizeof(MsgSceneLine)), width, width, LZ4HC_CLEVEL_MAX);
+			m_DataSentCurrent[player][STAT_CURRENT] += payloadSize;
+			m_DataSentTotal[player] += payloadSize;
 
-					// Compression failed or ineffective, send as is
-					if (result == 0 || result == width) {
-#ifdef _WIN32
-						memcpy_s(m_PixelLineBuffer[player] + sizeof(MsgSceneLine), c_MaxPixelLineBufferSize, bmp->line[lineY] + lineX, width);
-#else
-						memcpy(m_PixelLineBuffer[player] + sizeof(MsgSceneLine), bmp->line[lineY] + lineX, width);
-#endif
-					} else {
-						sceneData->DataSize = result;
-					}
+			m_TerrainDataSentCurrent[player][STAT_CURRENT] += payloadSize;
+			m_TerrainDataSentTotal[player] += payloadSize;
 
-					int payloadSize = sceneData->DataSize + sizeof(MsgSceneLine);
+			m_DataUncompressedCurrent[player][STAT_CURRENT] += sceneData->UncompressedSize;
+			m_DataUncompressedTotal[player] += sceneData->UncompressedSize;
+		}
+		m_SceneLinesSent[player] = endLine;
 
-					m_Server->Send((const char *)sceneData, payloadSize, HIGH_PRIORITY, RELIABLE, 0, m_ClientConnections[player].ClientId, false);
+		if (m_SceneLinesSent[player] < lineMessages.size()) {
+			m_SceneLock[player].unlock();
+			return;
+		}
+		m_SceneDataSnapshots[player].reset();
+		m_SceneLinesSent[player] = 0;
 
-					m_DataSentCurrent[player][STAT_CURRENT] += payloadSize;
-					m_DataSentTotal[player] += payloadSize;
+		m_SceneLock[player].unlock();
 
-					m_TerrainDataSentCurrent[player][STAT_CURRENT] += payloadSize;
-					m_TerrainDataSentTotal[player] += payloadSize;
+		m_SendSceneSetupData[player] = false;
+		m_SendSceneData[player] = false;
+		m_SendFrameData[player] = false;
 
-					m_DataUncompressedCurrent[player][STAT_CURRENT] += sceneData->UncompressedSize;
-					m_DataUncompressedTotal[player] += sceneData->UncompressedSize;
+		SendSceneEndMsg(player);
+	}
 
-					// Wait for the  messages to leave to avoid congestion
-					if (lineY % 250 == 0) {
-						do {
-							m_Server->GetStatistics(m_ClientConnections[player].ClientId, &rns);
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-							m_SendBufferBytes[player] = (int)rns.bytesInSendBuffer[MEDIUM_PRIORITY] + (int)rns.bytesInSendBuffer[HIGH_PRIORITY];
-							m_SendBufferMessages[player] = (int)rns.messageInSendBuffer[MEDIUM_PRIORITY] + (int)rns.messageInSendBuffer[HIGH_PRIORITY];
+	std::shared_ptr<const NetworkServer::SceneSnapshot> NetworkServer::AcquireSceneSnapshot(short player, SLTerrain *terrain) {
+		std::lock_guard<std::mutex> sceneSnapshotLock(m_SceneSnapshotMutex);
 
-							RakSleep(25);
-						} while (rns.messageInSendBuffer[HIGH_PRIORITY] > 1000 && IsPlayerConnected(player));
+		int sceneWidth = g_SceneMan.GetSceneWidth();
+		int sceneHeight = g_SceneMan.GetSceneHeight();
+		int tileColumns = (sceneWidth + c_TerrainChangeTileSize - 1) / c_TerrainChangeTileSize;
+		int tileRows = (sceneHeight + c_TerrainChangeTileSize - 1) / c_TerrainChangeTileSize;
 
-						if (!IsPlayerConnected(player)) {
-							break;
-						}
-					}
-				}
-				if (lineX + lineWidth >= g_SceneMan.GetSceneWidth()) {
-					break;
-				}
+		bool makeSceneSnapshot = !m_SceneSnapshot || m_SceneSnapshot->SceneId != m_SceneID || m_SceneSnapshot->Width != sceneWidth || m_SceneSnapshot->Height != sceneHeight;
+		if (!makeSceneSnapshot) {
+			std::lock_guard<std::mutex> changesLock(m_SceneSnapshotChangesMutex);
+			makeSceneSnapshot = m_SceneSnapshotChangedTileCount > (2 * tileColumns * tileRows) / c_SceneSnapshotChangedTilesDivisor;
+		}
+
+		if (makeSceneSnapshot) {
+			// Changes made while the terrain is being read are marked from here on, so whatever the snapshot caught of them halfway is sent again afterwards
+			m_SceneSnapshotChangesMutex.lock();
+			for (int layer = 0; layer < 2; layer++) {
+				m_SceneSnapshotChangedTiles[layer].assign(static_cast<size_t>(tileColumns) * static_cast<size_t>(tileRows), 0);
+				m_SceneSnapshotChangedTileRowCounts[layer].assign(tileRows, 0);
 			}
-			release_bitmap(bmp);
+			m_SceneSnapshotChangedTileCount = 0;
+			m_SceneSnapshotTileColumns = tileColumns;
+			m_SceneSnapshotTileRows = tileRows;
+			m_SceneSnapshotChangesMutex.unlock();
+
+			m_SceneSnapshot = MakeSceneSnapshot(terrain);
 		}
 
-		m_SceneLock[player].unlock();
+		m_SceneSnapshotChangesMutex.lock();
+		ResetDirtyTerrainTiles(player, m_SceneSnapshotTileColumns, m_SceneSnapshotTileRows);
+		for (int layer = 0; layer < 2; layer++) {
+			m_DirtyTerrainTiles[player][layer] = m_SceneSnapshotChangedTiles[layer];
+			m_DirtyTerrainTileRowCounts[player][layer] = m_SceneSnapshotChangedTileRowCounts[layer];
+		}
+		m_DirtyTerrainTileCount[player] = m_SceneSnapshotChangedTileCount;
+		m_SceneSnapshotChangesMutex.unlock();
 
-		m_SendSceneSetupData[player] = false;
-		m_SendSceneData[player] = false;
-		m_SendFrameData[player] = false;
+		return m_SceneSnapshot;
+	}
 
-		SendSceneEndMsg(player);
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::shared_ptr<const NetworkServer::SceneSnapshot> NetworkServer::MakeSceneSnapshot(SLTerrain *terrain) const {
+		std::shared_ptr<SceneSnapshot> sceneSnapshot = std::make_shared<SceneSnapshot>();
+		sceneSnapshot->SceneId = m_SceneID;
+		sceneSnapshot->Width = g_SceneMan.GetSceneWidth();
+		sceneSnapshot->Height = g_SceneMan.GetSceneHeight();
+
+		// Each layer is sent in blocks of lines up to this wide, each line of a block after the other
+		const int lineWidth = 1280;
+		int blockCount = (sceneSnapshot->Width + lineWidth - 1) / lineWidth;
+		int linesPerLayer = blockCount * sceneSnapshot->Height;
+		sceneSnapshot->LineMessages.resize(static_cast<size_t>(2 * linesPerLayer));
+
+		std::array<const BITMAP *, 2> layerBitmaps = { terrain->GetBGColorBitmap(), terrain->GetFGColorBitmap() };
+
+		g_ThreadMan.ParallelFor(0, 2 * linesPerLayer, 64, [&](int beginLine, int endLine) {
+			for (int lineIndex = beginLine; lineIndex < endLine; lineIndex++) {
+				int layer = lineIndex / linesPerLayer;
+				int lineX = ((lineIndex % linesPerLayer) / sceneSnapshot->Height) * lineWidth;
+				int lineY = (lineIndex % linesPerLayer) % sceneSnapshot->Height;
+				int width = std::min(lineWidth, sceneSnapshot->Width - lineX);
+				const unsigned char *line = layerBitmaps[layer]->line[lineY] + lineX;
+
+				std::vector<unsigned char> &lineMessage = sceneSnapshot->LineMessages[lineIndex];
+				lineMessage.resize(sizeof(MsgSceneLine) + width);
+
+				MsgSceneLine sceneData;
+				sceneData.Id = ID_SRV_SCENE;
+				sceneData.SceneId = sceneSnapshot->SceneId;
+				sceneData.X = lineX;
+				sceneData.Y = lineY;
+				sceneData.Width = width;
+				sceneData.Layer = layer;
+				sceneData.UncompressedSize = width;
+
+				// Lines of nothing but air, like most of the sky, are sent without any data
+				if (std::all_of(line, line + width, [](unsigned char pixel) { return pixel == g_MaskColor; })) {
+					sceneData.DataSize = 0;
+				} else {
+					unsigned char encoding = FrameBoxCodec::Plain;
+					int result = FrameBoxCodec::Compress(line, width, 1, nullptr, FrameBoxCodec::Plain, LZ4HC_CLEVEL_MAX, 1, lineMessage.data() + sizeof(MsgSceneLine), width, encoding);
+
+					// Compression failed or ineffective, send as is
+					if (result == 0) {
+						std::memcpy(lineMessage.data() + sizeof(MsgSceneLine), line, width);
+						sceneData.DataSize = width;
+					} else {
+						sceneData.DataSize = result;
+					}
+				}
+				std::memcpy(lineMessage.data(), &sceneData, sizeof(MsgSceneLine));
+				lineMessage.resize(sizeof(MsgSceneLine) + sceneData.DataSize);
+				lineMessage.shrink_to_fit();
+			}
+		});
+		return sceneSnapshot;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -877,10 +1010,17 @@ namespace RTE {
 		while (!m_PendingTerrainChanges[player].empty()) {
 			m_PendingTerrainChanges[player].pop();
 		}
-		while (!m_CurrentTerrainChanges[player].empty()) {
-			m_CurrentTerrainChanges[player].pop();
-		}
 		m_Mutex[player].unlock();
+
+		// The grid is made anew for the next scene
+		for (int layer = 0; layer < 2; layer++) {
+			m_DirtyTerrainTiles[player][layer].clear();
+			m_DirtyTerrainTileRowCounts[player][layer].clear();
+		}
+		m_DirtyTerrainTileCount[player] = 0;
+		m_TerrainTileColumns[player] = 0;
+		m_TerrainTileRows[player] = 0;
+		m_NextTerrainTileRow[player] = 0;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -898,55 +1038,114 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkServer::ProcessTerrainChanges(short player) {
+		std::queue<SceneMan::TerrainChange> pendingTerrainChanges;
 		m_Mutex[player].lock();
-		while (!m_PendingTerrainChanges[player].empty()) {
-			m_CurrentTerrainChanges[player].push(m_PendingTerrainChanges[player].front());
-			m_PendingTerrainChanges[player].pop();
-		}
+		std::swap(pendingTerrainChanges, m_PendingTerrainChanges[player]);
 		m_Mutex[player].unlock();
 
-		while (!m_CurrentTerrainChanges[player].empty()) {
-			int maxSize = 1280;
-
-			SceneMan::TerrainChange terrainChange = m_CurrentTerrainChanges[player].front();
-			m_CurrentTerrainChanges[player].pop();
-
-			// Fragment region if it does not fit one packet
-			if (terrainChange.w * terrainChange.h > maxSize) {
-				int size = 0;
-				int height = 1;
-				int heightStart = 0;
-
-				for (int y = 0; y < terrainChange.h; y++) {
-					height++;
-					size += terrainChange.w;
-
-					// Store changed block if the size is over the MTU or if it's the last block.
-					if (size + terrainChange.w >= maxSize || y == terrainChange.h - 1) {
-						SceneMan::TerrainChange tcf;
-						tcf.x = terrainChange.x;
-						tcf.y = terrainChange.y + heightStart;
-						tcf.w = terrainChange.w;
-						tcf.h = height;
-						tcf.back = terrainChange.back;
-						tcf.color = terrainChange.color;
-
-						SendTerrainChangeMsg(player, tcf);
-
-						size = 0;
-						heightStart = y;
-						height = 1;
+		Scene *scene = g_SceneMan.GetScene();
+		SLTerrain *terrain = scene ? scene->GetTerrain() : nullptr;
+		if (!terrain) {
+			return;
+		}
+		int sceneWidth = g_SceneMan.GetSceneWidth();
+		int sceneHeight = g_SceneMan.GetSceneHeight();
+
+		int tileColumns = (sceneWidth + c_TerrainChangeTileSize - 1) / c_TerrainChangeTileSize;
+		int tileRows = (sceneHeight + c_TerrainChangeTileSize - 1) / c_TerrainChangeTileSize;
+		if (tileColumns != m_TerrainTileColumns[player] || tileRows != m_TerrainTileRows[player]) { ResetDirtyTerrainTiles(player, tileColumns, tileRows); }
+
+		while (!pendingTerrainChanges.empty()) {
+			MarkDirtyTerrainTiles(pendingTerrainChanges.front(), tileColumns, tileRows, m_DirtyTerrainTiles[player], m_DirtyTerrainTileRowCounts[player], m_DirtyTerrainTileCount[player]);
+			pendingTerrainChanges.pop();
+		}
+
+		int bytesSent = 0;
+		for (int rowsChecked = 0; rowsChecked < tileRows && m_DirtyTerrainTileCount[player] > 0; rowsChecked++) {
+			int tileRow = m_NextTerrainTileRow[player];
+
+			for (int layer = 0; layer < 2; layer++) {
+				if (m_DirtyTerrainTileRowCounts[player][layer][tileRow] == 0) {
+					continue;
+				}
+				const BITMAP *terrainBitmap = (layer == 1) ? terrain->GetBGColorBitmap() : terrain->GetFGColorBitmap();
+				unsigned char *rowTiles = &m_DirtyTerrainTiles[player][layer][static_cast<size_t>(tileRow) * static_cast<size_t>(tileColumns)];
+
+				for (int tileColumn = 0; tileColumn < tileColumns;) {
+					if (!rowTiles[tileColumn]) {
+						tileColumn++;
+						continue;
+					}
+					// Carry on with this row next frame if the budget's used up
+					if (m_TerrainChangeBytesPerFrame > 0 && bytesSent >= m_TerrainChangeBytesPerFrame) {
+						return;
 					}
+
+					// Send each run of adjacent dirty tiles as one change
+					int runLength = 1;
+					while (runLength < c_MaxTerrainChangeTilesPerMessage && tileColumn + runLength < tileColumns && rowTiles[tileColumn + runLength]) {
+						runLength++;
+					}
+
+					SceneMan::TerrainChange terrainChange;
+					terrainChange.x = tileColumn * c_TerrainChangeTileSize;
+					terrainChange.y = tileRow * c_TerrainChangeTileSize;
+					terrainChange.w = std::min(runLength * c_TerrainChangeTileSize, sceneWidth - terrainChange.x);
+					terrainChange.h = std::min(c_TerrainChangeTileSize, sceneHeight - terrainChange.y);
+					terrainChange.back = layer == 1;
+					terrainChange.color = (terrainChange.w == 1 && terrainChange.h == 1) ? terrainBitmap->line[terrainChange.y][terrainChange.x] : g_MaskColor;
+					bytesSent += SendTerrainChangeMsg(player, terrainChange);
+
+					std::fill(rowTiles + tileColumn, rowTiles + tileColumn + runLength, 0);
+					m_DirtyTerrainTileRowCounts[player][layer][tileRow] -= runLength;
+					m_DirtyTerrainTileCount[player] -= runLength;
+					tileColumn += runLength;
 				}
-			} else {
-				SendTerrainChangeMsg(player, terrainChange);
 			}
+			m_NextTerrainTileRow[player] = (tileRow + 1) % tileRows;
 		}
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void NetworkServer::SendTerrainChangeMsg(short player, SceneMan::TerrainChange terrainChange) {
+	void NetworkServer::ResetDirtyTerrainTiles(short player, int tileColumns, int tileRows) {
+		for (int layer = 0; layer < 2; layer++) {
+			m_DirtyTerrainTiles[player][layer].assign(static_cast<size_t>(tileColumns) * static_cast<size_t>(tileRows), 0);
+			m_DirtyTerrainTileRowCounts[player][layer].assign(tileRows, 0);
+		}
+		m_DirtyTerrainTileCount[player] = 0;
+		m_TerrainTileColumns[player] = tileColumns;
+		m_TerrainTileRows[player] = tileRows;
+		m_NextTerrainTileRow[player] = 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkServer::MarkDirtyTerrainTiles(const SceneMan::TerrainChange &terrainChange, int tileColumns, int tileRows, std::vector<unsigned char> (&dirtyTiles)[2], std::vector<int> (&dirtyTileRowCounts)[2], int &dirtyTileCount) {
+		if (tileColumns <= 0 || tileRows <= 0 || terrainChange.w <= 0 || terrainChange.h <= 0 || terrainChange.x + terrainChange.w <= 0 || terrainChange.y + terrainChange.h <= 0) {
+			return;
+		}
+		int firstColumn = std::max(terrainChange.x, 0) / c_TerrainChangeTileSize;
+		int lastColumn = std::min((terrainChange.x + terrainChange.w - 1) / c_TerrainChangeTileSize, tileColumns - 1);
+		int firstRow = std::max(terrainChange.y, 0) / c_TerrainChangeTileSize;
+		int lastRow = std::min((terrainChange.y + terrainChange.h - 1) / c_TerrainChangeTileSize, tileRows - 1);
+
+		int layer = terrainChange.back ? 1 : 0;
+		for (int tileRow = firstRow; tileRow <= lastRow; tileRow++) {
+			unsigned char *rowTiles = &dirtyTiles[layer][static_cast<size_t>(tileRow) * static_cast<size_t>(tileColumns)];
+			for (int tileColumn = firstColumn; tileColumn <= lastColumn; tileColumn++) {
+				if (!rowTiles[tileColumn]) {
+					rowTiles[tileColumn] = 1;
+					dirtyTileRowCounts[layer][tileRow]++;
+					dirtyTileCount++;
+				}
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int NetworkServer::SendTerrainChangeMsg(short player, SceneMan::TerrainChange terrainChange) {
 		if (terrainChange.w == 1 && terrainChange.h == 1) {
 			MsgTerrainChange msg;
 			msg.Id = ID_SRV_TERRAIN;
@@ -972,6 +1171,8 @@ namespace RTE {
 
 			m_DataUncompressedCurrent[player][STAT_CURRENT] += payloadSize;
 			m_DataUncompressedTotal[player] += payloadSize;
+
+			return payloadSize;
 		} else {
 			MsgTerrainChange *msg = (MsgTerrainChange *)m_PixelLineBuffer[player];
 			msg->Id = ID_SRV_TERRAIN;
@@ -1027,6 +1228,8 @@ namespace RTE {
 
 			m_DataUncompressedCurrent[player][STAT_CURRENT] += msg->UncompressedSize;
 			m_DataUncompressedTotal[player] += msg->UncompressedSize;
+
+			return payloadSize;
 		}
 	}
 
@@ -1049,35 +1252,36 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkServer::CreateBackBuffer(short player, int w, int h) {
-		m_BackBuffer8[player] = create_bitmap_ex(8, w, h);
-		m_BackBufferGUI8[player] = create_bitmap_ex(8, w, h);
+		m_SentBackBuffer8[player] = create_bitmap_ex(8, w, h);
+		m_SentBackBufferGUI8[player] = create_bitmap_ex(8, w, h);
+		clear_to_color(m_SentBackBuffer8[player], g_MaskColor);
+		clear_to_color(m_SentBackBufferGUI8[player], g_MaskColor);
+
+		for (std::vector<unsigned char> &sentFrameBoxVersions : m_SentFrameBoxVersions[player]) {
+			sentFrameBoxVersions.assign(static_cast<size_t>(w / m_BoxWidth + 1) * static_cast<size_t>(h / m_BoxHeight + 1), 0);
+		}
+
+		// Nothing's been sent out of these yet
+		m_ResendAllFrameBoxes[player] = c_FramesToResendAllBoxes;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkServer::DestroyBackBuffer(short player) {
-		if (m_BackBuffer8) { destroy_bitmap(m_BackBuffer8[player]); }
-		m_BackBuffer8[player] = 0;
+		if (m_SentBackBuffer8[player]) { destroy_bitmap(m_SentBackBuffer8[player]); }
+		m_SentBackBuffer8[player] = 0;
 
-		if (m_BackBufferGUI8) { destroy_bitmap(m_BackBufferGUI8[player]); }
-		m_BackBufferGUI8[player] = 0;
+		if (m_SentBackBufferGUI8[player]) { destroy_bitmap(m_SentBackBufferGUI8[player]); }
+		m_SentBackBufferGUI8[player] = 0;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkServer::SendFrameSetupMsg(short player) {
-		MsgFrameSetup msgFrameSetup;
-		msgFrameSetup.Id = ID_SRV_FRAME_SETUP;
+		MsgFrameSetup msgFrameSetup = m_FrameSetups[player];
 		msgFrameSetup.FrameNumber = m_FrameNumbers[player];
-		msgFrameSetup.TargetPosX = g_FrameMan.GetTargetPos(player).m_X;
-		msgFrameSetup.TargetPosY = g_FrameMan.GetTargetPos(player).m_Y;
 
-		for (int i = 0; i < c_MaxLayersStoredForNetwork; i++) {
-			msgFrameSetup.OffsetX[i] = g_FrameMan.SLOffset[player][i].m_X;
-			msgFrameSetup.OffsetY[i] = g_FrameMan.SLOffset[player][i].m_Y;
-		}
-
-		int payloadSize = sizeof(MsgSceneSetup);
+		int payloadSize = sizeof(MsgFrameSetup);
 
 		m_Server->Send((const char *)&msgFrameSetup, payloadSize, MEDIUM_PRIORITY, RELIABLE_ORDERED, 0, m_ClientConnections[player].ClientId, false);
 
@@ -1093,10 +1297,63 @@ namespace RTE {
 		m_SendSceneData[player] = false;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkServer::GatherFrameSetup(short player) {
+		MsgFrameSetup &msgFrameSetup = m_FrameSetups[player];
+		msgFrameSetup.Id = ID_SRV_FRAME_SETUP;
+		msgFrameSetup.TargetPosX = g_FrameMan.GetTargetPos(player).m_X;
+		msgFrameSetup.TargetPosY = g_FrameMan.GetTargetPos(player).m_Y;
+
+		for (int i = 0; i < c_MaxLayersStoredForNetwork; i++) {
+			msgFrameSetup.OffsetX[i] = g_FrameMan.SLOffset[player][i].m_X;
+			msgFrameSetup.OffsetY[i] = g_FrameMan.SLOffset[player][i].m_Y;
+		}
+
+		msgFrameSetup.InputSequence = m_LastInputSequence[player];
+		msgFrameSetup.Pointer = MsgFrameSetup::NoPointer;
+		msgFrameSetup.CursorPosX = 0;
+		msgFrameSetup.CursorPosY = 0;
+		msgFrameSetup.AimOriginX = 0;
+		msgFrameSetup.AimOriginY = 0;
+		msgFrameSetup.AimX = static_cast<short>(g_UInputMan.GetNetworkAnalogMoveData(player).m_X);
+		msgFrameSetup.AimY = static_cast<short>(g_UInputMan.GetNetworkAnalogMoveData(player).m_Y);
+
+		if (!g_ActivityMan.IsInActivity()) {
+			return;
+		}
+		GameActivity *gameActivity = dynamic_cast<GameActivity *>(g_ActivityMan.GetActivity());
+		if (!gameActivity) {
+			return;
+		}
+
+		if (gameActivity->GetPresetName() == "Multiplayer Lobby" || gameActivity->IsBuyGUIVisible(player)) {
+			int cursorX = 0;
+			int cursorY = 0;
+			GUIInput::GetNetworkMousePosition(player, &cursorX, &cursorY);
+			msgFrameSetup.Pointer = MsgFrameSetup::GUICursor;
+			msgFrameSetup.CursorPosX = static_cast<short>(cursorX);
+			msgFrameSetup.CursorPosY = static_cast<short>(cursorY);
+		} else if (Actor *controlledActor = gameActivity->GetControlledActor(player); controlledActor && controlledActor->GetController()->IsMouseControlled()) {
+			// The frame is drawn from the target position, so that's where the actor is on it, give or take a scene width if the scene wraps
+			Vector aimOrigin = controlledActor->GetCPUPos() - g_FrameMan.GetTargetPos(player);
+			if (g_SceneMan.SceneWrapsX()) {
+				if (aimOrigin.m_X < 0) {
+					aimOrigin.m_X += static_cast<float>(g_SceneMan.GetSceneWidth());
+				} else if (aimOrigin.m_X >= static_cast<float>(g_SceneMan.GetSceneWidth())) {
+					aimOrigin.m_X -= static_cast<float>(g_SceneMan.GetSceneWidth());
+				}
+			}
+			msgFrameSetup.Pointer = controlledActor->GetController()->IsState(PIE_MENU_ACTIVE) ? MsgFrameSetup::PieMenu : MsgFrameSetup::Aim;
+			msgFrameSetup.AimOriginX = static_cast<short>(aimOrigin.m_X);
+			msgFrameSetup.AimOriginY = static_cast<short>(aimOrigin.m_Y);
+		}
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkServer::SendPostEffectData(short player) {
-		std::list<PostEffect> effects;
+		std::vector<PostEffect> effects;
 		g_PostProcessMan.GetNetworkPostEffectsList(player, effects);
 
 		if (effects.empty()) {
@@ -1151,36 +1408,267 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	int NetworkServer::SendFrame(short player) {
-		long long currentTicks = g_TimerMan.GetRealTickCount();
-		double fps = static_cast<double>(m_EncodingFps);
-		if (g_SettingsMan.UseExperimentalMultiplayerSpeedBoosts()) {
-			RakSleep(1000 / fps);
-		} else {
-			double secsPerFrame = 1.0 / fps;
-			double secsSinceLastFrame = static_cast<double>(currentTicks - m_LastFrameSentTime[player]) / static_cast<double>(g_TimerMan.GetTicksPerSecond());
+	void NetworkServer::GatherEntityStates(short player) {
+		std::vector<EntityStateNetworkData> &entityStates = m_EntityStates[player];
+		entityStates.clear();
 
-			// Fix for an overflow which may happen if server lags for a few seconds when loading activities
-			if (secsSinceLastFrame < 0) { secsSinceLastFrame = secsPerFrame; }
+		const Activity *activity = g_ActivityMan.GetActivity();
+		const BITMAP *frameBitmap = g_FrameMan.GetNetworkBackBuffer8Ready(player);
+		if (!activity || !frameBitmap || !g_SceneMan.GetScene()) {
+			return;
+		}
+		int team = activity->GetTeamOfPlayer(player);
+		Vector targetPos = g_FrameMan.GetTargetPos(player);
+		float sceneWidth = static_cast<float>(g_SceneMan.GetSceneWidth());
+		float sceneHeight = static_cast<float>(g_SceneMan.GetSceneHeight());
+
+		auto gatherVisibleEntity = [&](const MovableObject *movableObject) {
+			const Vector &entityPos = movableObject->GetPos();
+			float radius = movableObject->GetRadius();
+
+			// Wrap the entity to the side of the scene the player is looking at
+			float relativeX = entityPos.m_X - targetPos.m_X;
+			float relativeY = entityPos.m_Y - targetPos.m_Y;
+			if (g_SceneMan.SceneWrapsX()) {
+				if (relativeX < -radius) {
+					relativeX += sceneWidth;
+				} else if (relativeX > frameBitmap->w + radius) {
+					relativeX -= sceneWidth;
+				}
+			}
+			if (g_SceneMan.SceneWrapsY()) {
+				if (relativeY < -radius) {
+					relativeY += sceneHeight;
+				} else if (relativeY > frameBitmap->h + radius) {
+					relativeY -= sceneHeight;
+				}
+			}
+			if (relativeX < -radius || relativeX > frameBitmap->w + radius || relativeY < -radius || relativeY > frameBitmap->h + radius) {
+				return;
+			}
+			// The frames sent to the client would have them hidden under the unseen layer, so don't give them away
+			if (team != Activity::NoTeam && g_SceneMan.IsUnseen(entityPos.GetFloorIntX(), entityPos.GetFloorIntY(), team)) {
+				return;
+			}
+			AddEntityStates(movableObject, entityStates);
+		};
+
+		// Same order as MovableMan::Draw, so actors end up on top
+		for (const MovableObject *particle : g_MovableMan.m_Particles) {
+			gatherVisibleEntity(particle);
+		}
+		for (std::deque<MovableObject *>::const_reverse_iterator itemItr = g_MovableMan.m_Items.crbegin(); itemItr != g_MovableMan.m_Items.crend(); ++itemItr) {
+			gatherVisibleEntity(*itemItr);
+		}
+		for (std::deque<Actor *>::const_reverse_iterator actorItr = g_MovableMan.m_Actors.crbegin(); actorItr != g_MovableMan.m_Actors.crend(); ++actorItr) {
+			gatherVisibleEntity(*actorItr);
+		}
+
+		// Presets first used by these states go out with them
+		if (m_EntityPresetsSent[player] < m_EntityPresetNames.size()) {
+			std::vector<unsigned char> &presetsMsg = m_EntityPresetsMsg[player];
+			if (presetsMsg.empty()) {
+				presetsMsg.resize(sizeof(MsgEntityPresets));
+				MsgEntityPresets *msg = reinterpret_cast<MsgEntityPresets *>(presetsMsg.data());
+				msg->Id = ID_SRV_ENTITY_PRESETS;
+				msg->FirstPresetIndex = static_cast<unsigned short>(m_EntityPresetsSent[player]);
+				msg->PresetCount = 0;
+			}
+			for (size_t presetIndex = m_EntityPresetsSent[player]; presetIndex < m_EntityPresetNames.size(); ++presetIndex) {
+				presetsMsg.insert(presetsMsg.end(), m_EntityPresetNames[presetIndex].begin(), m_EntityPresetNames[presetIndex].end());
+				reinterpret_cast<MsgEntityPresets *>(presetsMsg.data())->PresetCount++;
+			}
+			m_EntityPresetsSent[player] = m_EntityPresetNames.size();
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkServer::AddEntityStates(const MovableObject *movableObject, std::vector<EntityStateNetworkData> &entityStates) {
+		if (!movableObject || movableObject->IsSetToDelete()) {
+			return;
+		}
+		EntityStateNetworkData entityState;
+		entityState.X = static_cast<short>(movableObject->GetPos().GetFloorIntX());
+		entityState.Y = static_cast<short>(movableObject->GetPos().GetFloorIntY());
+		entityState.Angle = 0;
+		entityState.SpriteOffsetX = 0;
+		entityState.SpriteOffsetY = 0;
+		entityState.Scale = 1.0F;
+		entityState.DrawFlags = 0;
+
+		if (const MOPixel *pixelObject = dynamic_cast<const MOPixel *>(movableObject)) {
+			entityState.PresetIndex = EntityStateNetworkData::c_PixelPresetIndex;
+			entityState.Frame = static_cast<unsigned short>(pixelObject->GetColor().GetIndex());
+			entityStates.emplace_back(entityState);
+			return;
+		}
+		const MOSprite *spriteObject = dynamic_cast<const MOSprite *>(movableObject);
+		if (!spriteObject) {
+			return;
+		}
+		entityState.PresetIndex = GetEntityPresetIndex(spriteObject);
+		entityState.Frame = static_cast<unsigned short>(spriteObject->GetFrame());
+		entityState.Angle = static_cast<unsigned char>(static_cast<int>(std::round(spriteObject->GetRotMatrix().GetAllegroAngle())) & 0xFF);
+		entityState.SpriteOffsetX = static_cast<short>(spriteObject->GetSpriteOffset().GetFloorIntX());
+		entityState.SpriteOffsetY = static_cast<short>(spriteObject->GetSpriteOffset().GetFloorIntY());
+		entityState.Scale = spriteObject->GetScale();
+		entityState.DrawFlags = spriteObject->IsHFlipped() ? EntityStateNetworkData::HFlipped : 0;
+
+		// Attachables and wounds are drawn by their parent around its own sprite, so they're added in the same order as MOSRotating::Draw has them
+		const MOSRotating *rotatingObject = dynamic_cast<const MOSRotating *>(movableObject);
+		if (rotatingObject) {
+			if (rotatingObject->m_Recoiled) {
+				entityState.X += static_cast<short>(rotatingObject->m_RecoilOffset.GetFloorIntX());
+				entityState.Y += static_cast<short>(rotatingObject->m_RecoilOffset.GetFloorIntY());
+			}
+			for (const AEmitter *wound : rotatingObject->m_Wounds) {
+				if (!wound->IsDrawnAfterParent()) { AddEntityStates(wound, entityStates); }
+			}
+			for (const Attachable *attachable : rotatingObject->m_Attachables) {
+				if (!attachable->IsDrawnAfterParent() && attachable->IsDrawnNormallyByParent()) { AddEntityStates(attachable, entityStates); }
+			}
+		}
+		if (entityState.PresetIndex != EntityStateNetworkData::c_PixelPresetIndex) { entityStates.emplace_back(entityState); }
+
+		if (rotatingObject) {
+			for (const AEmitter *wound : rotatingObject->m_Wounds) {
+				if (wound->IsDrawnAfterParent()) { AddEntityStates(wound, entityStates); }
+			}
+			for (const Attachable *attachable : rotatingObject->m_Attachables) {
+				if (attachable->IsDrawnAfterParent() && attachable->IsDrawnNormallyByParent()) { AddEntityStates(attachable, entityStates); }
+			}
+			// The ones the parent draws itself, like an AHuman's arms, go on top
+			for (const Attachable *attachable : rotatingObject->m_Attachables) {
+				if (!attachable->IsDrawnNormallyByParent()) { AddEntityStates(attachable, entityStates); }
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	unsigned short NetworkServer::GetEntityPresetIndex(const MOSprite *spriteObject) {
+		const BITMAP *firstFrame = spriteObject->GetSpriteFrame(0);
+		if (!firstFrame) {
+			return EntityStateNetworkData::c_PixelPresetIndex;
+		}
+		std::unordered_map<const BITMAP *, unsigned short>::const_iterator presetIndexEntry = m_EntityPresetIndices.find(firstFrame);
+		if (presetIndexEntry != m_EntityPresetIndices.end()) {
+			return presetIndexEntry->second;
+		}
+		if (m_EntityPresetNames.size() >= EntityStateNetworkData::c_PixelPresetIndex) {
+			return EntityStateNetworkData::c_PixelPresetIndex;
+		}
+
+		const DataModule *dataModule = (spriteObject->GetModuleID() >= 0) ? g_PresetMan.GetDataModule(spriteObject->GetModuleID()) : nullptr;
+		std::string presetNames = spriteObject->GetClassName();
+		presetNames.push_back('\0');
+		if (dataModule) { presetNames += dataModule->GetFileName(); }
+		presetNames.push_back('\0');
+		presetNames += spriteObject->GetPresetName();
+		presetNames.push_back('\0');
+
+		unsigned short presetIndex = static_cast<unsigned short>(m_EntityPresetNames.size());
+		m_EntityPresetNames.emplace_back(presetNames);
+		m_EntityPresetIndices.try_emplace(firstFrame, presetIndex);
+		return presetIndex;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkServer::SendEntityStates(short player) {
+		if (!m_EntityPresetsMsg[player].empty()) {
+			int payloadSize = static_cast<int>(m_EntityPresetsMsg[player].size());
+			m_Server->Send((const char *)m_EntityPresetsMsg[player].data(), payloadSize, MEDIUM_PRIORITY, RELIABLE_ORDERED, 0, m_ClientConnections[player].ClientId, false);
+			m_EntityPresetsMsg[player].clear();
+
+			m_OtherDataSentCurrent[player][STAT_CURRENT] += payloadSize;
+			m_OtherDataSentTotal[player] += payloadSize;
+			m_DataSentTotal[player] += payloadSize;
+		}
 
-			m_MsecPerFrame[player] = static_cast<int>(secsSinceLastFrame * 1000.0);
+		// Split into messages that fit in a packet, compressed like the scene data. They're put together from the last drawn back,
+		// so if they don't all fit the budget it's the first drawn, mostly particles underneath everything else, that are left out.
+		const std::vector<EntityStateNetworkData> &entityStates = m_EntityStates[player];
+		std::vector<std::vector<unsigned char>> &entityStatesMsgs = m_EntityStatesMsgs[player];
+		size_t msgCount = 0;
+		int bytesToSend = 0;
+		size_t endState = entityStates.size();
+
+		while (endState > 0) {
+			size_t entityCount = std::min(endState, static_cast<size_t>(c_MaxEntityStatesPerMsg));
+			const unsigned char *rawStates = reinterpret_cast<const unsigned char *>(&entityStates[endState - entityCount]);
+			int rawSize = static_cast<int>(sizeof(EntityStateNetworkData) * entityCount);
+
+			if (msgCount == entityStatesMsgs.size()) { entityStatesMsgs.emplace_back(); }
+			std::vector<unsigned char> &entityStatesMsg = entityStatesMsgs[msgCount];
+			entityStatesMsg.resize(sizeof(MsgEntityStates) + rawSize);
+
+			MsgEntityStates msg;
+			msg.Id = ID_SRV_ENTITY_STATES;
+			msg.FrameNumber = m_FrameNumbers[player];
+			msg.EntityCount = static_cast<unsigned short>(entityCount);
+
+			unsigned char encoding = FrameBoxCodec::Plain;
+			int result = FrameBoxCodec::Compress(rawStates, rawSize, 1, nullptr, FrameBoxCodec::Plain, 0, m_ClientFastAccelerationFactor[player], entityStatesMsg.data() + sizeof(MsgEntityStates), rawSize, encoding);
+			// Compression failed or ineffective, send as is
+			if (result == 0) {
+				std::memcpy(entityStatesMsg.data() + sizeof(MsgEntityStates), rawStates, rawSize);
+				msg.DataSize = static_cast<unsigned short>(rawSize);
+			} else {
+				msg.DataSize = static_cast<unsigned short>(result);
+			}
+			std::memcpy(entityStatesMsg.data(), &msg, sizeof(MsgEntityStates));
+			entityStatesMsg.resize(sizeof(MsgEntityStates) + msg.DataSize);
 
-			m_LastFrameSentTime[player] = g_TimerMan.GetRealTickCount();
+			// The last drawn states always go out, even if they alone are over the budget
+			if (m_EntityStateBytesPerFrame > 0 && msgCount > 0 && bytesToSend + static_cast<int>(entityStatesMsg.size()) > m_EntityStateBytesPerFrame) {
+				break;
+			}
+			bytesToSend += static_cast<int>(entityStatesMsg.size());
+			msgCount++;
+			endState -= entityCount;
 		}
 
-		// Wait till FrameMan releases bitmap
-		SetThreadExitReason(player, NetworkServer::LOCKED);
+		// Sent in drawing order, since the client draws them in the order they arrive
+		for (size_t msgIndex = msgCount; msgIndex-- > 0;) {
+			const std::vector<unsigned char> &entityStatesMsg = entityStatesMsgs[msgIndex];
+			int payloadSize = static_cast<int>(entityStatesMsg.size());
+			int uncompressedSize = static_cast<int>(sizeof(MsgEntityStates) + sizeof(EntityStateNetworkData) * reinterpret_cast<const MsgEntityStates *>(entityStatesMsg.data())->EntityCount);
+
+			m_Server->Send((const char *)entityStatesMsg.data(), payloadSize, MEDIUM_PRIORITY, UNRELIABLE_SEQUENCED, c_EntityStatesChannel, m_ClientConnections[player].ClientId, false);
+
+			m_FrameDataSentCurrent[player][STAT_CURRENT] += payloadSize;
+			m_FrameDataSentTotal[player] += payloadSize;
+			m_DataSentCurrent[player][STAT_CURRENT] += payloadSize;
+			m_DataSentTotal[player] += payloadSize;
+			m_DataUncompressedCurrent[player][STAT_CURRENT] += uncompressedSize;
+			m_DataUncompressedTotal[player] += uncompressedSize;
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int NetworkServer::SendFrame(short player) {
+		long long currentTicks = g_TimerMan.GetRealTickCount();
+
+		double secsSinceLastFrame = static_cast<double>(currentTicks - m_LastFrameSentTime[player]) / static_cast<double>(g_TimerMan.GetTicksPerSecond());
+		// Fix for an overflow which may happen if server lags for a few seconds when loading activities
+		if (secsSinceLastFrame < 0) { secsSinceLastFrame = 1.0 / static_cast<double>(m_ClientEncodingFps[player]); }
+		m_MsecPerFrame[player] = static_cast<int>(secsSinceLastFrame * 1000.0);
+		m_LastFrameSentTime[player] = currentTicks;
+
 		SetThreadExitReason(player, NetworkServer::NORMAL);
 
-		// Get backbuffer bitmap for this player
-		BITMAP *frameManBmp = g_FrameMan.GetNetworkBackBuffer8Ready(player);
-		BITMAP *frameManGUIBmp = g_FrameMan.GetNetworkBackBufferGUI8Ready(player);
+		// Get backbuffer bitmap for this player. These are read directly instead of being copied first, a box that was drawn over while being read is resent with the next frame anyway.
+		const BITMAP *frameManBmp = g_FrameMan.GetNetworkBackBuffer8Ready(player);
+		const BITMAP *frameManGUIBmp = g_FrameMan.GetNetworkBackBufferGUI8Ready(player);
 
-		if (!m_BackBuffer8[player]) {
+		if (!m_SentBackBuffer8[player]) {
 			CreateBackBuffer(player, frameManBmp->w, frameManBmp->h);
 		} else {
 			// If for whatever reasons frameMans back buffer changed dimensions, recreate our internal backbuffer
-			if (m_BackBuffer8[player]->w != frameManBmp->w || m_BackBuffer8[player]->h != frameManBmp->h) {
+			if (m_SentBackBuffer8[player]->w != frameManBmp->w || m_SentBackBuffer8[player]->h != frameManBmp->h) {
 				DestroyBackBuffer(player);
 				CreateBackBuffer(player, frameManBmp->w, frameManBmp->h);
 				//g_ConsoleMan.PrintString("SERVER: Backbuffer recreated");
@@ -1190,10 +1678,8 @@ namespace RTE {
 		m_FrameNumbers[player]++;
 		if (m_FrameNumbers[player] >= c_FramesToRemember) { m_FrameNumbers[player] = 0; }
 
-		// Save a copy of buffer to avoid tearing when the original is updated by frame man
-		blit(frameManBmp, m_BackBuffer8[player], 0, 0, 0, 0, frameManBmp->w, frameManBmp->h);
-		blit(frameManGUIBmp, m_BackBufferGUI8[player], 0, 0, 0, 0, frameManGUIBmp->w, frameManGUIBmp->h);
-
+		// The client draws the entities of a frame once its setup arrives, so they have to be there before it
+		if (m_UseEntityReplication) { SendEntityStates(player); }
 		SendFrameSetupMsg(player);
 		SendPostEffectData(player);
 		SendSoundData(player);
@@ -1202,151 +1688,194 @@ namespace RTE {
 		m_FramesSent[player]++;
 
 		// Compression section
-		int compressionMethod = m_HighCompressionLevel;
-		int accelerationFactor = m_FastAccelerationFactor;
+		int compressionMethod = m_ClientHighCompressionLevel[player];
+		int accelerationFactor = m_ClientFastAccelerationFactor[player];
+		bool useInterlacing = m_ClientUseInterlacing[player];
 
 		m_SendEven[player] = !m_SendEven[player];
 
 		if (m_TransmitAsBoxes) {
-			MsgFrameBox *frameData = (MsgFrameBox *)m_PixelLineBuffer[player];
-			frameData->FrameNumber = m_FrameNumbers[player];
-
-			// Save message ID
-			frameData->Id = ID_SRV_FRAME_BOX;
-			frameData->BoxWidth = m_BoxWidth;
-			frameData->BoxHeight = m_BoxHeight;
-
-			int bw = m_BackBuffer8[player]->w / m_BoxWidth;
-			int bh = m_BackBuffer8[player]->h / m_BoxHeight;
-
-			for (int by = 0; by <= bh; by++) {
-				int step = 1;
-				int startLine = 0;
-
-				if (m_UseInterlacing) {
-					step = 2;
-					if (m_SendEven[player]) {
-						startLine = (by % 2 == 0) ? 1 : 0;
-					} else {
-						startLine = (by % 2 == 0) ? 0 : 1;
+			int bw = frameManBmp->w / m_BoxWidth;
+			int bh = frameManBmp->h / m_BoxHeight;
+
+			std::mutex statsMutex;
+
+			// Each row of boxes is compressed and sent as a separate task on the worker threads. RakNet's Send is thread safe, and the boxes don't depend on each other.
+			g_ThreadMan.ParallelFor(0, bh + 1, 1, [&](int firstRow, int lastRow) {
+				unsigned char boxBuffer[c_MaxPixelLineBufferSize];
+				unsigned char previousBoxBuffer[c_MaxPixelLineBufferSize];
+				unsigned char packetBuffer[c_MaxPixelLineBufferSize];
+
+				int fullBlocks = 0;
+				int emptyBlocks = 0;
+				int unchangedBlocks = 0;
+				unsigned long dataSent = 0;
+				unsigned long dataUncompressed = 0;
+
+				MsgFrameBox *frameData = (MsgFrameBox *)packetBuffer;
+				frameData->Id = ID_SRV_FRAME_BOX;
+				frameData->FrameNumber = m_FrameNumbers[player];
+
+				for (int by = firstRow; by < lastRow; by++) {
+					int step = 1;
+					int startLine = 0;
+
+					if (useInterlacing) {
+						step = 2;
+						if (m_SendEven[player]) {
+							startLine = (by % 2 == 0) ? 1 : 0;
+						} else {
+							startLine = (by % 2 == 0) ? 0 : 1;
+						}
 					}
-				}
 
-				for (int bx = startLine; bx <= bw; bx += step) {
-					int bpx = bx * m_BoxWidth;
-					int bpy = by * m_BoxHeight;
+					for (int bx = startLine; bx <= bw; bx += step) {
+						int bpx = bx * m_BoxWidth;
+						int bpy = by * m_BoxHeight;
 
-					if (bpx >= m_BackBuffer8[player]->w || bpy >= m_BackBuffer8[player]->h) {
-						break;
-					}
+						if (bpx >= frameManBmp->w || bpy >= frameManBmp->h) {
+							break;
+						}
 
-					frameData->BoxX = bpx;
-					frameData->BoxY = bpy;
+						// Unchanged boxes are left alone unless it's their turn to be refreshed, in case the client lost them
+						bool resendBox = !m_UseDeltaCompression || m_ResendAllFrameBoxes[player] > 0 || ((by * (bw + 1) + bx) % c_FrameBoxRefreshInterval == m_FrameBoxRefreshPhase[player]);
 
-					int maxWidth = m_BoxWidth;
-					if (bpx + m_BoxWidth >= m_BackBuffer8[player]->w) {
-						maxWidth = m_BackBuffer8[player]->w - bpx;
-						frameData->BoxWidth = maxWidth;
-					}
+						frameData->BoxX = bpx;
+						frameData->BoxY = bpy;
 
-					int maxHeight = m_BoxHeight;
-					if (bpy + m_BoxHeight >= m_BackBuffer8[player]->h) {
-						maxHeight = m_BackBuffer8[player]->h - bpy;
+						int maxWidth = std::min(m_BoxWidth, frameManBmp->w - bpx);
+						int maxHeight = std::min(m_BoxHeight, frameManBmp->h - bpy);
+						frameData->BoxWidth = maxWidth;
 						frameData->BoxHeight = maxHeight;
-					}
-
-					int size = maxWidth * maxHeight;
-					frameData->UncompressedSize = size;
-					frameData->DataSize = size;
-
-					for (int layer = 0; layer < 2; layer++) {
-						bool boxIsEmpty = true;
-						int line = 0;
 
-						const BITMAP *backBuffer = 0;
-						if (layer == 0) {
-							backBuffer = m_BackBuffer8[player];
-						} else if (layer == 1) {
-							backBuffer = m_BackBufferGUI8[player];
-						}
+						int size = maxWidth * maxHeight;
+						frameData->UncompressedSize = size;
+						frameData->DataSize = size;
+
+						for (int layer = 0; layer < 2; layer++) {
+							bool boxIsEmpty = true;
+							int line = 0;
+
+							const BITMAP *backBuffer = 0;
+							const BITMAP *sentBackBuffer = 0;
+							if (layer == 0) {
+								backBuffer = frameManBmp;
+								sentBackBuffer = m_SentBackBuffer8[player];
+							} else if (layer == 1) {
+								backBuffer = frameManGUIBmp;
+								sentBackBuffer = m_SentBackBufferGUI8[player];
+							}
 
-						frameData->Layer = layer;
+							frameData->Layer = layer;
 
-						unsigned char *dest = (unsigned char *)(m_TerrainChangeBuffer[player]);
+							unsigned char *dest = boxBuffer;
 
-						// Copy block to line buffer and also check if block is empty
-						for (line = 0; line < maxHeight; line++) {
-							// Copy bitmap data
-							memcpy(dest, backBuffer->line[bpy + line] + bpx, maxWidth);
-							dest += maxWidth;
-						}
+							// Copy block to box buffer, so what's compared, compressed and remembered as sent is all the same even if the back buffer is drawn over meanwhile
+							for (line = 0; line < maxHeight; line++) {
+								memcpy(dest, backBuffer->line[bpy + line] + bpx, maxWidth);
+								dest += maxWidth;
+							}
 
-						// Check if block is empty
-						unsigned long *pixelInt = (unsigned long *)m_TerrainChangeBuffer[player];
-						int counter = 0;
+							if (!resendBox) {
+								// Laid out the same as the box buffer so it can also be compressed against
+								dest = previousBoxBuffer;
+								for (line = 0; line < maxHeight; line++) {
+									memcpy(dest, sentBackBuffer->line[bpy + line] + bpx, maxWidth);
+									dest += maxWidth;
+								}
+								if (memcmp(boxBuffer, previousBoxBuffer, size) == 0) {
+									unchangedBlocks++;
+									continue;
+								}
+							}
 
-						for (counter = 0; counter < size; counter += sizeof(unsigned long)) {
-							if (*pixelInt > 0) {
-								boxIsEmpty = false;
-								break;
+							// Remember what the client has of the frame now
+							for (line = 0; line < maxHeight; line++) {
+								memcpy(sentBackBuffer->line[bpy + line] + bpx, boxBuffer + line * maxWidth, maxWidth);
 							}
-							pixelInt++;
-						}
-						if (boxIsEmpty && counter > size) {
-							pixelInt--;
-							counter -= sizeof(unsigned long);
+							unsigned char &boxVersion = m_SentFrameBoxVersions[player][layer][by * (bw + 1) + bx];
+							boxVersion++;
+							frameData->Version = boxVersion;
+							frameData->Encoding = FrameBoxCodec::Plain;
 
-							const unsigned char *pixelChr = (unsigned char *)pixelInt;
-							for (; counter < size; counter++) {
-								if (*pixelChr > 0) {
+							// Check if block is empty
+							unsigned long *pixelInt = (unsigned long *)boxBuffer;
+							int counter = 0;
+
+							for (counter = 0; counter < size; counter += sizeof(unsigned long)) {
+								if (*pixelInt > 0) {
 									boxIsEmpty = false;
 									break;
 								}
-								pixelChr++;
+								pixelInt++;
+							}
+							if (boxIsEmpty && counter > size) {
+								pixelInt--;
+								counter -= sizeof(unsigned long);
+
+								const unsigned char *pixelChr = (unsigned char *)pixelInt;
+								for (; counter < size; counter++) {
+									if (*pixelChr > 0) {
+										boxIsEmpty = false;
+										break;
+									}
+									pixelChr++;
+								}
 							}
-						}
 
-						if (!boxIsEmpty) {
-							int result = 0;
+							if (!boxIsEmpty) {
+								int result = 0;
 
-							if (m_UseHighCompression) {
-								result = LZ4_compress_HC_extStateHC(m_LZ4CompressionState[player], (char *)m_TerrainChangeBuffer[player], (char *)(m_PixelLineBuffer[player] + sizeof(MsgFrameBox)), size, size, compressionMethod);
-							} else if (m_UseFastCompression) {
-								result = LZ4_compress_fast_extState(m_LZ4FastCompressionState[player], (char *)m_TerrainChangeBuffer[player], (char *)(m_PixelLineBuffer[player] + sizeof(MsgFrameBox)), size, size, accelerationFactor);
-							}
+								if (m_UseHighCompression || m_UseFastCompression) {
+									// Refreshed boxes are compressed on their own, so they get the client back on track even if it lost their previous versions
+									const unsigned char *previousBox = resendBox ? nullptr : previousBoxBuffer;
+									unsigned char allowedEncodings = m_UseFrameBoxPrediction ? (FrameBoxCodec::UpFiltered | FrameBoxCodec::PreviousAsDictionary) : FrameBoxCodec::Plain;
+									unsigned char encoding = FrameBoxCodec::Plain;
+									result = FrameBoxCodec::Compress(boxBuffer, maxWidth, maxHeight, previousBox, allowedEncodings, m_UseHighCompression ? std::max(compressionMethod, 1) : 0, accelerationFactor, packetBuffer + sizeof(MsgFrameBox), size, encoding);
+									frameData->Encoding = encoding;
+								}
 
-							// Compression failed or ineffective, send as is
-							if (result == 0 || result == backBuffer->w) {
-#ifdef _WIN32
-								memcpy_s(m_PixelLineBuffer[player] + sizeof(MsgFrameBox), c_MaxPixelLineBufferSize, m_TerrainChangeBuffer[player], size);
-#else
-								memcpy(m_PixelLineBuffer[player] + sizeof(MsgFrameBox), m_TerrainChangeBuffer[player], size);
-#endif
+								// Compression failed or ineffective, send as is
+								if (result == 0 || result == size) {
+									memcpy(packetBuffer + sizeof(MsgFrameBox), boxBuffer, size);
+									frameData->DataSize = size;
+								} else {
+									frameData->DataSize = result;
+								}
+
+								fullBlocks++;
 							} else {
-								frameData->DataSize = result;
+								frameData->DataSize = 0;
+								emptyBlocks++;
 							}
 
-							m_FullBlocks[player]++;
-						} else {
-							frameData->DataSize = 0;
-							m_EmptyBlocks[player]++;
-						}
+							int payloadSize = frameData->DataSize + sizeof(MsgFrameBox);
 
-						int payloadSize = frameData->DataSize + sizeof(MsgFrameBox);
+							m_Server->Send((const char *)frameData, payloadSize, MEDIUM_PRIORITY, UNRELIABLE_SEQUENCED, 0, m_ClientConnections[player].ClientId, false);
 
-						m_Server->Send((const char *)frameData, payloadSize, MEDIUM_PRIORITY, UNRELIABLE_SEQUENCED, 0, m_ClientConnections[player].ClientId, false);
+							dataSent += payloadSize;
+							dataUncompressed += frameData->UncompressedSize;
+						}
+					}
+				}
 
-						m_DataSentCurrent[player][STAT_CURRENT] += payloadSize;
-						m_DataSentTotal[player] += payloadSize;
+				std::lock_guard<std::mutex> statsLock(statsMutex);
+				m_FullBlocks[player] += fullBlocks;
+				m_EmptyBlocks[player] += emptyBlocks;
+				m_UnchangedBlocks[player] += unchangedBlocks;
 
-						m_FrameDataSentCurrent[player][STAT_CURRENT] += payloadSize;
-						m_FrameDataSentTotal[player] += payloadSize;
+				m_DataSentCurrent[player][STAT_CURRENT] += dataSent;
+				m_DataSentTotal[player] += dataSent;
 
-						m_DataUncompressedCurrent[player][STAT_CURRENT] += frameData->UncompressedSize;
-						m_DataUncompressedTotal[player] += frameData->UncompressedSize;
-					}
-				}
-			}
+				m_FrameDataSentCurrent[player][STAT_CURRENT] += dataSent;
+				m_FrameDataSentTotal[player] += dataSent;
+
+				m_DataUncompressedCurrent[player][STAT_CURRENT] += dataUncompressed;
+				m_DataUncompressedTotal[player] += dataUncompressed;
+			});
+			// Interlaced frames only sent every other box, so the rest still have to be sent next frame
+			m_ResendAllFrameBoxes[player] = useInterlacing ? std::max(m_ResendAllFrameBoxes[player] - 1, 0) : 0;
+			m_FrameBoxRefreshPhase[player] = (m_FrameBoxRefreshPhase[player] + 1) % c_FrameBoxRefreshInterval;
 		} else {
 			MsgFrameLine *frameData = (MsgFrameLine *)m_PixelLineBuffer[player];
 			frameData->FrameNumber = m_FrameNumbers[player];
@@ -1357,20 +1886,20 @@ namespace RTE {
 			int startLine = 0;
 			int step = 1;
 
-			if (m_UseInterlacing) {
+			if (useInterlacing) {
 				step = 2;
 				m_SendEven[player] = !m_SendEven[player];
 				startLine = m_SendEven[player] ? 0 : 1;
 			}
 
-			for (int m_CurrentFrameLine = startLine; m_CurrentFrameLine < m_BackBuffer8[player]->h; m_CurrentFrameLine += step) {
+			for (int m_CurrentFrameLine = startLine; m_CurrentFrameLine < frameManBmp->h; m_CurrentFrameLine += step) {
 				for (int layer = 0; layer < 2; layer++) {
 					const BITMAP *backBuffer = 0;
 
 					if (layer == 0) {
-						backBuffer = m_BackBuffer8[player];
+						backBuffer = frameManBmp;
 					} else if (layer == 1) {
-						backBuffer = m_BackBufferGUI8[player];
+						backBuffer = frameManGUIBmp;
 					}
 
 					// Save line number
@@ -1419,7 +1948,7 @@ namespace RTE {
 						}
 
 						// Compression failed or ineffective, send as is
-						if (result == 0 || result == m_BackBuffer8[player]->w) {
+						if (result == 0 || result == frameManBmp->w) {
 #ifdef _WIN32
 							memcpy_s(m_PixelLineBuffer[player] + sizeof(MsgFrameLine), c_MaxPixelLineBufferSize, backBuffer->line[m_CurrentFrameLine], backBuffer->w);
 #else
@@ -1452,10 +1981,9 @@ namespace RTE {
 		}
 		ProcessTerrainChanges(player);
 
-		if (!g_SettingsMan.UseExperimentalMultiplayerSpeedBoosts()) {
-			double secsSinceSendStart = static_cast<double>(g_TimerMan.GetRealTickCount() - currentTicks) / static_cast<double>(g_TimerMan.GetTicksPerSecond());
-			m_MsecPerSendCall[player] = static_cast<int>(secsSinceSendStart * 1000.0);
-		}
+		// Always measured because adaptive encoding relies on it
+		double secsSinceSendStart = static_cast<double>(g_TimerMan.GetRealTickCount() - currentTicks) / static_cast<double>(g_TimerMan.GetTicksPerSecond());
+		m_MsecPerSendCall[player] = static_cast<int>(secsSinceSendStart * 1000.0);
 
 		SetThreadExitReason(player, NetworkServer::NORMAL);
 		return 0;
@@ -1484,14 +2012,145 @@ namespace RTE {
 			m_SoundDataSentCurrent[player][STAT_CURRENT] = 0;
 			m_TerrainDataSentCurrent[player][STAT_CURRENT] = 0;
 			m_OtherDataSentCurrent[player][STAT_CURRENT] = 0;
+
+			RakNet::RakNetStatistics rns;
+			int bytesSentPerSecond = 0;
+			if (m_Server->GetStatistics(m_ClientConnections[player].ClientId, &rns)) {
+				m_SendBufferBytes[player] = static_cast<int>(rns.bytesInSendBuffer[MEDIUM_PRIORITY] + rns.bytesInSendBuffer[HIGH_PRIORITY]);
+				m_SendBufferMessages[player] = static_cast<int>(rns.messageInSendBuffer[MEDIUM_PRIORITY] + rns.messageInSendBuffer[HIGH_PRIORITY]);
+				bytesSentPerSecond = static_cast<int>(rns.valueOverLastSecond[RakNet::ACTUAL_BYTES_SENT]);
+			}
+
+			// While scene data is being sent the send buffer is kept full on purpose, so only adapt to how frames are getting through
+			if (m_UseAdaptiveEncoding && SendFrameData(player)) {
+				AdaptClientEncoding(player, bytesSentPerSecond);
+			} else if (!m_UseAdaptiveEncoding) {
+				ResetClientEncoding(player);
+			}
 		}
 
 		if (m_PingTimer[player].IsPastRealMS(500)) {
 			m_Ping[player] = m_Server->GetLastPing(m_ClientConnections[player].ClientId);
 			m_PingTimer[player].Reset();
+
+			if (m_Ping[player] > 0) {
+				int &baselinePing = m_ClientBaselinePing[player];
+				baselinePing = (baselinePing == 0) ? m_Ping[player] : std::min(baselinePing + c_BaselinePingDriftPerUpdate, static_cast<int>(m_Ping[player]));
+			}
 		}
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkServer::ResetClientEncoding(short player) {
+		m_ClientEncodingFps[player] = m_EncodingFps;
+		m_ClientUseInterlacing[player] = m_UseInterlacing;
+		m_ClientHighCompressionLevel[player] = m_HighCompressionLevel;
+		m_ClientFastAccelerationFactor[player] = m_FastAccelerationFactor;
+		m_ClientStableSeconds[player] = 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkServer::AdaptClientEncoding(short player, int bytesSentPerSecond) {
+		// How long what's waiting in the send buffer will take to go out at the rate the link has been managing. A link that can't keep up shows here well before the ping goes up.
+		// Nothing going out at all while there's data waiting means the link is stalled, so count that as over the target.
+		int queueDelay = 0;
+		if (m_SendBufferBytes[player] > 0) {
+			queueDelay = (bytesSentPerSecond > 0) ? static_cast<int>(static_cast<long long>(m_SendBufferBytes[player]) * 1000 / bytesSentPerSecond) : m_AdaptiveTargetLatency * 2;
+		}
+		// The ping rising over what the link manages when uncongested means data is queueing up somewhere along the way. The ping itself is left out, a client far away isn't any less able to take frames.
+		int pingRise = (m_ClientBaselinePing[player] > 0) ? std::max(static_cast<int>(m_Ping[player]) - m_ClientBaselinePing[player], 0) : 0;
+		int addedLatency = queueDelay + pingRise;
+
+		// Encoding taking up most of the time between frames means the server can't keep up with this client regardless of the link
+		int msecsPerFrame = 1000 / std::max(m_ClientEncodingFps[player], 1);
+		bool encodingTooSlow = m_MsecPerSendCall[player] > msecsPerFrame * 3 / 4;
+		bool encodingHasHeadroom = m_MsecPerSendCall[player] < msecsPerFrame / 4;
+
+		int &encodingFps = m_ClientEncodingFps[player];
+		int &highCompressionLevel = m_ClientHighCompressionLevel[player];
+		int &fastAccelerationFactor = m_ClientFastAccelerationFactor[player];
+		int minEncodingFps = std::min(c_MinAdaptiveEncodingFps, m_EncodingFps);
+
+		if (encodingTooSlow) {
+			m_ClientStableSeconds[player] = 0;
+			// Spend less CPU on each frame first, then send fewer of them
+			if (m_UseHighCompression && highCompressionLevel > LZ4HC_CLEVEL_MIN) {
+				highCompressionLevel = std::max(highCompressionLevel - 2, LZ4HC_CLEVEL_MIN);
+			} else if (!m_UseHighCompression && m_UseFastCompression && fastAccelerationFactor < c_MaxAdaptiveAccelerationFactor) {
+				fastAccelerationFactor = std::min(fastAccelerationFactor * 2, c_MaxAdaptiveAccelerationFactor);
+			} else {
+				encodingFps = std::max(encodingFps * 3 / 4, minEncodingFps);
+			}
+		} else if (addedLatency > m_AdaptiveTargetLatency) {
+			m_ClientStableSeconds[player] = 0;
+			// Trade CPU for bandwidth first since it's the least noticeable, then send fewer frames, and only interlace as a last resort since it's the most visible
+			if (m_UseHighCompression && highCompressionLevel < LZ4HC_CLEVEL_MAX && encodingHasHeadroom) {
+				highCompressionLevel++;
+			} else if (!m_UseHighCompression && m_UseFastCompression && fastAccelerationFactor > 1 && encodingHasHeadroom) {
+				fastAccelerationFactor = std::max(fastAccelerationFactor / 2, 1);
+			} else if (encodingFps > minEncodingFps) {
+				encodingFps = std::max(encodingFps * 3 / 4, minEncodingFps);
+			} else if (!m_ClientUseInterlacing[player]) {
+				m_ClientUseInterlacing[player] = true;
+			}
+		} else if (addedLatency < m_AdaptiveTargetLatency / 2) {
+			m_ClientStableSeconds[player]++;
+			if (m_ClientStableSeconds[player] >= c_AdaptiveRecoverySeconds) {
+				m_ClientStableSeconds[player] = 0;
+				// Undo the steps in the reverse order they were taken in
+				if (m_ClientUseInterlacing[player] && !m_UseInterlacing) {
+					m_ClientUseInterlacing[player] = false;
+				} else if (encodingFps < m_EncodingFps) {
+					encodingFps = std::min(encodingFps + 5, m_EncodingFps);
+				} else if (highCompressionLevel > m_HighCompressionLevel) {
+					highCompressionLevel--;
+				} else if (highCompressionLevel < m_HighCompressionLevel && encodingHasHeadroom) {
+					highCompressionLevel++;
+				} else if (fastAccelerationFactor < m_FastAccelerationFactor) {
+					fastAccelerationFactor = std::min(fastAccelerationFactor * 2, m_FastAccelerationFactor);
+				} else if (fastAccelerationFactor > m_FastAccelerationFactor && encodingHasHeadroom) {
+					fastAccelerationFactor = std::max(fastAccelerationFactor / 2, m_FastAccelerationFactor);
+				}
+			}
+		} else {
+			m_ClientStableSeconds[player] = 0;
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkServer::WriteStatsLog() {
+		long long currentTicks = g_TimerMan.GetRealTickCount();
+		if (!m_StatsLog.is_open() || (currentTicks - m_LastStatsLogTime < g_TimerMan.GetTicksPerSecond() && currentTicks >= m_LastStatsLogTime)) {
+			return;
+		}
+		m_LastStatsLogTime = currentTicks;
+		double secondsSinceStart = static_cast<double>(currentTicks - m_StatsLogStartTime) / static_cast<double>(g_TimerMan.GetTicksPerSecond());
+
+		// The per second byte counts are the ones UpdateStats last moved to STAT_SHOWN, the rest are running totals
+		char buf[512];
+		for (short player = 0; player < c_MaxClients; player++) {
+			if (!IsPlayerConnected(player)) {
+				continue;
+			}
+			std::snprintf(buf, sizeof(buf), "%.1f,%d,%u,%d,%d,%d,%d,%d,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%d,%d,%u,%u,%d,%d,%d,%d\n",
+				secondsSinceStart, player, m_Ping[player],
+				m_ClientEncodingFps[player], m_ClientUseInterlacing[player] ? 1 : 0, m_UseHighCompression ? m_ClientHighCompressionLevel[player] : m_ClientFastAccelerationFactor[player],
+				m_MsecPerFrame[player] > 0 ? 1000 / m_MsecPerFrame[player] : 0, m_MsecPerSendCall[player],
+				m_DataSentCurrent[player][STAT_SHOWN], m_DataUncompressedCurrent[player][STAT_SHOWN],
+				m_FrameDataSentCurrent[player][STAT_SHOWN], m_PostEffectDataSentCurrent[player][STAT_SHOWN], m_SoundDataSentCurrent[player][STAT_SHOWN], m_TerrainDataSentCurrent[player][STAT_SHOWN], m_OtherDataSentCurrent[player][STAT_SHOWN],
+				m_SendBufferBytes[player], m_SendBufferMessages[player],
+				m_FramesSent[player], m_FramesSkipped[player],
+				m_FullBlocks[player], m_EmptyBlocks[player], m_UnchangedBlocks[player],
+				g_PerformanceMan.GetMSPFAverage()
+			);
+			m_StatsLog << buf;
+		}
+		m_StatsLog.flush();
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkServer::DrawStatisticsData() {
@@ -1546,6 +2205,7 @@ namespace RTE {
 
 		m_FullBlocks[c_MaxClients] = 0;
 		m_EmptyBlocks[c_MaxClients] = 0;
+		m_UnchangedBlocks[c_MaxClients] = 0;
 
 
 		for (short i = 0; i < MAX_STAT_RECORDS; i++) {
@@ -1572,6 +2232,7 @@ namespace RTE {
 
 				m_FullBlocks[c_MaxClients] += m_FullBlocks[i];
 				m_EmptyBlocks[c_MaxClients] += m_EmptyBlocks[i];
+				m_UnchangedBlocks[c_MaxClients] += m_UnchangedBlocks[i];
 			}
 
 			// Update compression ratio
@@ -1584,7 +2245,7 @@ namespace RTE {
 
 			// Jesus christ
 			std::snprintf(buf, sizeof(buf),
-					  "%s\nPing %u\nCmp Mbit: %.1f\nUnc Mbit: %.1f\nR: %.2f\nFrame Kbit: %lu\nGlow Kbit: %lu\nSound Kbit: %lu\nScene Kbit: %lu\nFrames sent: %uK\nFrame skipped: %uK\nBlocks full: %uK\nBlocks empty: %uK\nBlk Ratio: %.2f\nFPS: %d\nSend Ms %d\nTotal Data %lu MB",
+					  "%s\nPing %u\nCmp Mbit: %.1f\nUnc Mbit: %.1f\nR: %.2f\nFrame Kbit: %lu\nGlow Kbit: %lu\nSound Kbit: %lu\nScene Kbit: %lu\nFrames sent: %uK\nFrame skipped: %uK\nBlocks full: %uK\nBlocks empty: %uK\nBlocks same: %uK\nBlk Ratio: %.2f\nFPS: %d\nSend Ms %d\nTotal Data %lu MB",
 					  (i == c_MaxClients) ? "- TOTALS - " : playerName.c_str(),
 					  (i < c_MaxClients) ? m_Ping[i] : 0,
 					  static_cast<double>(m_DataSentCurrent[i][STAT_SHOWN]) / 125000,
@@ -1598,6 +2259,7 @@ namespace RTE {
 					  m_FramesSkipped[i] / 1000,
 					  m_FullBlocks[i] / 1000,
 					  m_EmptyBlocks[i] / 1000,
+					  m_UnchangedBlocks[i] / 1000,
 					  emptyRatio,
 					  (i < c_MaxClients) ? fps : 0,
 					  (i < c_MaxClients) ? m_MsecPerSendCall[i] : 0,
@@ -1607,8 +2269,8 @@ namespace RTE {
 			g_FrameMan.GetLargeFont()->DrawAligned(&guiBMP, 10 + i * g_FrameMan.GetResX() / 5, 75, buf, GUIFont::Left);
 
 			if (i < c_MaxClients) {
-				int lines = 2;
-				std::snprintf(buf, sizeof(buf), "Thread: %d\nBuffer: %d / %d", m_ThreadExitReason[i], m_SendBufferMessages[i], m_SendBufferBytes[i] / 1024);
+				int lines = 3;
+				std::snprintf(buf, sizeof(buf), "Thread: %d\nBuffer: %d / %d\nEnc: %d fps%s L%d", m_ThreadExitReason[i], m_SendBufferMessages[i], m_SendBufferBytes[i] / 1024, m_ClientEncodingFps[i], m_ClientUseInterlacing[i] ? " int" : "", m_UseHighCompression ? m_ClientHighCompressionLevel[i] : m_ClientFastAccelerationFactor[i]);
 				g_FrameMan.GetLargeFont()->DrawAligned(&guiBMP, 10 + i * g_FrameMan.GetResX() / 5, g_FrameMan.GetResY() - lines * 15, buf, GUIFont::Left);
 			}
 		}
@@ -1709,6 +2371,9 @@ namespace RTE {
 			}
 		}
 
+		QueueSendsToClients();
+
+		WriteStatsLog();
 		DrawStatisticsData();
 
 		// Clear sound events for unconnected players because AudioMan does not know about their state and stores broadcast sounds to their event lists
@@ -1731,6 +2396,33 @@ namespace RTE {
 		}
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkServer::QueueSendsToClients() {
+		long long currentTicks = g_TimerMan.GetRealTickCount();
+
+		for (short player = 0; player < c_MaxClients; player++) {
+			// Only one send per client at a time, so everything for a client still goes out in order and its buffers aren't shared between tasks
+			if (!IsPlayerConnected(player) || m_SendToClientInProgress[player]) {
+				continue;
+			}
+			long long ticksPerFrame = g_TimerMan.GetTicksPerSecond() / static_cast<long long>(std::max(m_ClientEncodingFps[player], 1));
+			bool sceneDataWaiting = IsSceneAvailable(player) && (NeedToSendSceneSetupData(player) || NeedToSendSceneData(player));
+			// A negative difference means the tick count overflowed, don't wait for it to catch up
+			bool frameDue = SendFrameData(player) && (currentTicks - m_LastFrameSentTime[player] >= ticksPerFrame || currentTicks < m_LastFrameSentTime[player]);
+
+			if (sceneDataWaiting || frameDue) {
+				// Entities can only be looked at from the main thread, so what the send needs of them is gathered here
+				GatherFrameSetup(player);
+				if (frameDue && m_UseEntityReplication) { GatherEntityStates(player); }
+				m_SendToClientInProgress[player] = true;
+				g_ThreadMan.QueueTask([this, player]() { SendToClient(player); });
+			} else {
+				UpdateStats(player);
+			}
+		}
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkServer::HandleNetworkPackets() {
@@ -14,6 +14,9 @@
 
 namespace RTE {
 
+	class MovableObject;
+	class MOSprite;
+
 	/// <summary>
 	/// The centralized singleton manager of the network multiplayer server.
 	/// </summary>
@@ -137,6 +140,12 @@ namespace RTE {
 		/// </summary>
 		/// <returns>Whether threads will be put to sleep if server completed frame faster than it normally should or not.</returns>
 		bool GetServerSimSleepWhenIdle() const { return m_SimSleepWhenIdle; }
+
+		/// <summary>
+		/// Gets whether entities are sent to clients as states for them to draw themselves, instead of drawn into the frames sent to them.
+		/// </summary>
+		/// <returns>Whether entities are replicated to clients.</returns>
+		bool UseEntityReplication() const { return m_UseEntityReplication; }
 #pragma endregion
 
 #pragma region Concrete Methods
@@ -182,16 +191,27 @@ namespace RTE {
 			RakNet::SystemAddress InternalId; //!<
 			int ResX; //!<
 			int ResY; //!<
-			std::thread *SendThread; //!<
 			std::string PlayerName; //!<
 		};
 
+		/// <summary>
+		/// The scene data compressed once into the messages sent to every client that joins while the scene stays the same, instead of being compressed again for each of them.
+		/// Made read-only and shared, so clients can be sent it while a newer one is made.
+		/// </summary>
+		struct SceneSnapshot {
+			unsigned char SceneId; //!< The ID of the scene the snapshot was made of.
+			int Width; //!< The width of the scene the snapshot was made of.
+			int Height; //!< The height of the scene the snapshot was made of.
+			std::vector<std::vector<unsigned char>> LineMessages; //!< The MsgSceneLine messages with their compressed data, in the order they're sent in.
+		};
+
 		bool m_IsInServerMode = false; //!<
 
 		bool m_SleepWhenIdle; //!< If true puts thread to sleep if it didn't receive anything for 10 seconds to avoid melting the CPU at 100% even if there are no connections.
 		bool m_SimSleepWhenIdle; //!< If true the server will try to put the thread to sleep to reduce CPU load if the sim frame took less time to complete than it should at 30 fps.
 
 		int m_ThreadExitReason[c_MaxClients]; //!<
+		std::atomic<bool> m_SendToClientInProgress[c_MaxClients]; //!< Whether a task sending data to each client is queued or running on the worker threads.
 
 		long m_MSecsSinceLastUpdate[c_MaxClients]; //!<
 		long m_MSecsToSleep[c_MaxClients]; //!<
@@ -209,8 +229,8 @@ namespace RTE {
 
 		unsigned char m_PixelLineBuffer[c_MaxClients][c_MaxPixelLineBufferSize]; //!<
 
-		BITMAP *m_BackBuffer8[c_MaxClients]; //!<
-		BITMAP *m_BackBufferGUI8[c_MaxClients]; //!<
+		BITMAP *m_SentBackBuffer8[c_MaxClients]; //!< What each client was last sent of the frame, so boxes it already has can be skipped.
+		BITMAP *m_SentBackBufferGUI8[c_MaxClients]; //!< What each client was last sent of the frame GUI, so boxes it already has can be skipped.
 
 		void *m_LZ4CompressionState[c_MaxClients]; //!<
 		void *m_LZ4FastCompressionState[c_MaxClients]; //!<
@@ -237,6 +257,24 @@ namespace RTE {
 		bool m_UseInterlacing; //!< Use interlacing to heavily reduce bandwidth usage at the cost of visual degradation (unusable at 30 fps, but may be suitable at 60 fps).
 		int m_EncodingFps; //!< Frame transmission rate. Higher value equals more CPU and bandwidth consumption.
 
+		/// <summary>
+		/// Adapt the frame rate, interlacing and compression of each client on its own to keep the latency its link adds under m_AdaptiveTargetLatency, instead of sending every client frames with the settings above.
+		/// The settings above are then the best a client gets sent. Clients on poor links get fewer or more compressed frames instead of lagging behind, and clients the server can't encode fast enough for get cheaper ones.
+		/// </summary>
+		bool m_UseAdaptiveEncoding;
+		int m_AdaptiveTargetLatency; //!< The added latency in milliseconds adaptive encoding tries to keep each client under. Counts how long the data waiting in the send buffer will take to go out and how far the ping rose over the client's baseline, so clients far away aren't degraded for their distance alone.
+		static constexpr int c_MinAdaptiveEncodingFps = 15; //!< The lowest frame rate adaptive encoding will bring a client down to.
+		static constexpr int c_MaxAdaptiveAccelerationFactor = 40; //!< The highest fast compression acceleration factor adaptive encoding will use to save CPU.
+		static constexpr int c_AdaptiveRecoverySeconds = 3; //!< How many seconds in a row a client's added latency has to be well under the target before its encoding is improved a step.
+		static constexpr int c_BaselinePingDriftPerUpdate = 1; //!< How many milliseconds a client's baseline ping rises each time the ping is updated, so a lasting route change is eventually taken as the new normal.
+
+		int m_ClientEncodingFps[c_MaxClients]; //!< The frame rate each client is currently sent at.
+		bool m_ClientUseInterlacing[c_MaxClients]; //!< Whether each client is currently sent interlaced frames.
+		int m_ClientHighCompressionLevel[c_MaxClients]; //!< The high compression level each client's frames are currently compressed with.
+		int m_ClientFastAccelerationFactor[c_MaxClients]; //!< The fast compression acceleration factor each client's frames are currently compressed with.
+		int m_ClientStableSeconds[c_MaxClients]; //!< How many seconds in a row each client's added latency has been well under the target.
+		int m_ClientBaselinePing[c_MaxClients]; //!< The lowest ping seen from each client lately, what its link manages when uncongested. 0 if no ping was measured yet.
+
 		bool m_SendEven[c_MaxClients]; //!<
 
 		bool m_ShowStats; //!<
@@ -247,10 +285,39 @@ namespace RTE {
 		bool m_SceneAvailable[c_MaxClients]; //!<
 		bool m_SendFrameData[c_MaxClients]; //!<
 		std::mutex m_SceneLock[c_MaxClients]; //!<
+		static constexpr int c_MaxSceneLinesInSendBuffer = 1000; //!< How many scene data messages can wait in a client's send buffer before no more are sent to it until the next update.
+		std::shared_ptr<const SceneSnapshot> m_SceneDataSnapshots[c_MaxClients]; //!< The scene snapshot each client is being sent, kept until all its lines are sent. nullptr if the client isn't being sent scene data.
+		size_t m_SceneLinesSent[c_MaxClients]; //!< How many lines of its scene snapshot each client was sent so far.
 
 		unsigned char m_TerrainChangeBuffer[c_MaxClients][c_MaxPixelLineBufferSize]; //!<
 		std::queue<SceneMan::TerrainChange> m_PendingTerrainChanges[c_MaxClients]; //!<
-		std::queue<SceneMan::TerrainChange> m_CurrentTerrainChanges[c_MaxClients]; //!<
+
+		/// <summary>
+		/// Pending terrain changes are coalesced into a grid of dirty tiles per client, so overlapping changes like the thousands from an explosion are only sent once.
+		/// Runs of dirty tiles are then sent with whatever pixels the terrain has at the time, up to m_TerrainChangeBytesPerFrame per frame. The rest stays dirty for the following frames.
+		/// </summary>
+		static constexpr int c_TerrainChangeTileSize = 8;
+		static constexpr int c_MaxTerrainChangeTilesPerMessage = 20; //!< How many tiles a terrain change message can span at most, so it fits in one packet.
+		int m_TerrainChangeBytesPerFrame; //!< How many bytes of terrain changes can be sent to each client per frame. 0 or less means no limit.
+		std::vector<unsigned char> m_DirtyTerrainTiles[c_MaxClients][2]; //!< Which tiles of the foreground and background terrain changed since they were last sent to each client.
+		std::vector<int> m_DirtyTerrainTileRowCounts[c_MaxClients][2]; //!< How many tiles of each row of the foreground and background terrain are dirty for each client, so clean rows can be skipped.
+		int m_DirtyTerrainTileCount[c_MaxClients]; //!< How many tiles of either terrain layer are dirty for each client.
+		int m_TerrainTileColumns[c_MaxClients]; //!< How many columns of tiles the dirty terrain tiles of each client are for.
+		int m_TerrainTileRows[c_MaxClients]; //!< How many rows of tiles the dirty terrain tiles of each client are for.
+		int m_NextTerrainTileRow[c_MaxClients]; //!< The row of tiles to continue sending terrain changes to each client from, so what doesn't fit the budget isn't always the same part of the scene.
+
+		/// <summary>
+		/// Joining clients are sent the shared scene snapshot, then the tiles of the terrain that changed since it was made as terrain changes. The snapshot is made again once too much of it changed.
+		/// </summary>
+		static constexpr int c_SceneSnapshotChangedTilesDivisor = 8; //!< The snapshot is made again once more than 1 in this many of its tiles changed.
+		std::mutex m_SceneSnapshotMutex; //!< Mutex guarding the scene snapshot pointer. Held while the snapshot is made, so clients joining at the same time wait for it instead of making their own.
+		std::shared_ptr<const SceneSnapshot> m_SceneSnapshot; //!< The scene snapshot sent to joining clients, or nullptr if none was made yet.
+		std::mutex m_SceneSnapshotChangesMutex; //!< Mutex guarding the tiles that changed since the scene snapshot was made, which are marked from the main thread.
+		std::vector<unsigned char> m_SceneSnapshotChangedTiles[2]; //!< Which tiles of the foreground and background terrain changed since the scene snapshot was made.
+		std::vector<int> m_SceneSnapshotChangedTileRowCounts[2]; //!< How many tiles of each row of the foreground and background terrain changed since the scene snapshot was made.
+		int m_SceneSnapshotChangedTileCount; //!< How many tiles of either terrain layer changed since the scene snapshot was made.
+		int m_SceneSnapshotTileColumns; //!< How many columns of tiles the scene snapshot's changed tiles are for. 0 if there is no snapshot.
+		int m_SceneSnapshotTileRows; //!< How many rows of tiles the scene snapshot's changed tiles are for. 0 if there is no snapshot.
 
 		std::mutex m_Mutex[c_MaxClients]; //!<
 
@@ -265,6 +332,7 @@ namespace RTE {
 		long long m_LatestRestartTime; //!< The time, in ticks, that the last activity restart took place on the server.
 
 		int m_FrameNumbers[c_MaxClients]; //!<
+		unsigned int m_LastInputSequence[c_MaxClients]; //!< The InputSequence of the last input message applied for each player. Only used from the main thread.
 
 		unsigned short m_Ping[c_MaxClients]; //!< 
 		Timer m_PingTimer[c_MaxClients]; //!<
@@ -279,8 +347,42 @@ namespace RTE {
 		int m_BoxWidth; //!< Width of the transmitted CPU block. Different values may improve bandwidth usage.
 		int m_BoxHeight; //!< Height of the transmitted CPU block. Different values may improve bandwidth usage.
 
+		/// <summary>
+		/// Only transmit the boxes that changed since they were last sent to the client, instead of all boxes every frame. Mostly static scenes then use a fraction of the bandwidth and compression CPU.
+		/// Since boxes are sent unreliably, unchanged boxes are still resent every c_FrameBoxRefreshInterval frames so ones that got lost on the way don't stay wrong on the client.
+		/// </summary>
+		bool m_UseDeltaCompression;
+		static constexpr int c_FrameBoxRefreshInterval = 31; //!< How many frames an unchanged box can go without being resent. Odd so it doesn't keep lining up with the boxes skipped by interlacing.
+		int m_FrameBoxRefreshPhase[c_MaxClients]; //!< Which of every c_FrameBoxRefreshInterval boxes get resent this frame even if unchanged.
+		static constexpr int c_FramesToResendAllBoxes = 2; //!< How many frames all boxes are sent in when the client's copy of the frame can't be relied on. Interlaced frames only cover every other box, so it takes two.
+		int m_ResendAllFrameBoxes[c_MaxClients]; //!< How many more frames all boxes have to be sent in because the client's copy of the frame can't be relied on, like after a new scene or back buffer.
+
+		/// <summary>
+		/// Predict changed boxes from the previous version the client has, or from the pixels above, before compressing them. See FrameBoxCodec.
+		/// A client that lost a box can't decode the versions compressed against it, so it keeps showing what it had until the box's next refresh, which is always compressed on its own.
+		/// </summary>
+		bool m_UseFrameBoxPrediction;
+		std::vector<unsigned char> m_SentFrameBoxVersions[c_MaxClients][2]; //!< The version each box of each layer was last sent to each client as, counting up every time it's sent.
+
+		/// <summary>
+		/// Experimental. Send the entities visible to each client as the preset, position, rotation, frame and flipping of their sprites, for the client to draw from the presets it has loaded, instead of drawing them into the frames sent to it.
+		/// The frames then only have the unseen layer and HUD in them, which mostly don't change and so are mostly skipped by delta compression. Entities are drawn by the client without effects like glows or flashing white.
+		/// </summary>
+		bool m_UseEntityReplication;
+		std::unordered_map<const BITMAP *, unsigned short> m_EntityPresetIndices; //!< The index of the preset replicated entities are drawn from, by the first frame of its sprite, which all entities of the preset share.
+		std::vector<std::string> m_EntityPresetNames; //!< The class, data module and preset names of each preset replicated entities are drawn from, each followed by a null character, as they're sent to clients.
+		size_t m_EntityPresetsSent[c_MaxClients]; //!< How many of the presets each client was sent, or will be with the next entity states.
+		std::vector<unsigned char> m_EntityPresetsMsg[c_MaxClients]; //!< The message with the presets each client needs for the next entity states, or empty if it has them all.
+		std::vector<EntityStateNetworkData> m_EntityStates[c_MaxClients]; //!< The entities visible to each client, gathered on the main thread for the next frame sent to it.
+		std::vector<std::vector<unsigned char>> m_EntityStatesMsgs[c_MaxClients]; //!< The compressed entity state messages being put together for each client's next frame. Kept around so their buffers are reused.
+		int m_EntityStateBytesPerFrame; //!< How many bytes of entity states can be sent to each client per frame. The entities drawn first, underneath the rest, are left out of frames that go over. 0 or less means no limit.
+		static constexpr int c_MaxEntityStatesPerMsg = 64; //!< How many entity states a message can hold at most, so it fits in one packet even if it doesn't compress.
+		static constexpr char c_EntityStatesChannel = 1; //!< The ordering channel entity states are sent on, so they're only sequenced against each other and not held up by the reliable messages on channel 0.
+		MsgFrameSetup m_FrameSetups[c_MaxClients]; //!< The frame setup message of the next frame sent to each client, gathered on the main thread so its target position, pointer and acknowledged input are all from the same sim update.
+
 		int m_EmptyBlocks[MAX_STAT_RECORDS]; //!<
 		int m_FullBlocks[MAX_STAT_RECORDS]; //!<
+		int m_UnchangedBlocks[MAX_STAT_RECORDS]; //!< Number of blocks that weren't sent because the client already had them.
 		int m_SendBufferBytes[MAX_STAT_RECORDS]; //!<
 		int m_SendBufferMessages[MAX_STAT_RECORDS]; //!<
 		int m_DelayedFrames[c_MaxClients]; //!<
@@ -314,15 +416,27 @@ namespace RTE {
 		unsigned long m_OtherDataSentCurrent[MAX_STAT_RECORDS][2]; //!<
 		unsigned long m_OtherDataSentTotal[MAX_STAT_RECORDS]; //!<
 
+		/// <summary>
+		/// Once a second, the stats of each connected client over the last second are appended to this CSV file, so what a server can handle can be measured under real or synthetic load. Empty to not log stats.
+		/// </summary>
+		std::string m_StatsLogPath;
+		std::ofstream m_StatsLog; //!< The stats log file, opened when the server is started.
+		long long m_StatsLogStartTime; //!< The time the stats log was opened in real time ticks.
+		long long m_LastStatsLogTime; //!< The last time the stats were written to the stats log in real time ticks.
+
 	private:
 
 #pragma region Thread Handling
 		/// <summary>
-		/// 
+		/// Sends whatever a client needs next, be it scene setup, scene data or a frame, and updates its stats. Runs on the worker threads, one at a time per client.
 		/// </summary>
-		/// <param name="server"></param>
-		/// <param name="player"></param>
-		static void BackgroundSendThreadFunction(NetworkServer *server, short player);
+		/// <param name="player">The player to send to.</param>
+		void SendToClient(short player);
+
+		/// <summary>
+		/// Queues a SendToClient task on the worker threads for every connected client that has scene data waiting or is due for a frame at the encoding frame rate, unless one is already queued or running for it.
+		/// </summary>
+		void QueueSendsToClients();
 
 		/// <summary>
 		/// 
@@ -461,12 +575,48 @@ namespace RTE {
 		/// <param name="player"></param>
 		void ProcessTerrainChanges(short player);
 
+		/// <summary>
+		/// Clears the dirty terrain tiles of a player and sizes them for a scene of a certain number of tiles.
+		/// </summary>
+		/// <param name="player">The player to clear the dirty tiles of.</param>
+		/// <param name="tileColumns">The number of columns of tiles of the scene.</param>
+		/// <param name="tileRows">The number of rows of tiles of the scene.</param>
+		void ResetDirtyTerrainTiles(short player, int tileColumns, int tileRows);
+
+		/// <summary>
+		/// Marks the tiles a terrain change touches as dirty in a grid of dirty terrain tiles.
+		/// </summary>
+		/// <param name="terrainChange">The terrain change to mark the tiles of.</param>
+		/// <param name="tileColumns">The number of columns of tiles of the grid. Nothing is marked if 0.</param>
+		/// <param name="tileRows">The number of rows of tiles of the grid.</param>
+		/// <param name="dirtyTiles">The dirty tiles of the foreground and background terrain.</param>
+		/// <param name="dirtyTileRowCounts">How many tiles of each row of the foreground and background terrain are dirty.</param>
+		/// <param name="dirtyTileCount">How many tiles of either terrain layer are dirty.</param>
+		static void MarkDirtyTerrainTiles(const SceneMan::TerrainChange &terrainChange, int tileColumns, int tileRows, std::vector<unsigned char> (&dirtyTiles)[2], std::vector<int> (&dirtyTileRowCounts)[2], int &dirtyTileCount);
+
+		/// <summary>
+		/// Gets the scene snapshot to send to a joining player, making it first if there is none of the current scene or too much of the terrain changed since it was made.
+		/// Marks the tiles that changed since the snapshot was made as dirty for the player, so they're sent to it as terrain changes after the snapshot.
+		/// </summary>
+		/// <param name="player">The player that's joining.</param>
+		/// <param name="terrain">The terrain of the current scene.</param>
+		/// <returns>The scene snapshot to send to the player.</returns>
+		std::shared_ptr<const SceneSnapshot> AcquireSceneSnapshot(short player, SLTerrain *terrain);
+
+		/// <summary>
+		/// Compresses the terrain of the current scene into a new scene snapshot, spread over the worker threads.
+		/// </summary>
+		/// <param name="terrain">The terrain of the current scene.</param>
+		/// <returns>The new scene snapshot.</returns>
+		std::shared_ptr<const SceneSnapshot> MakeSceneSnapshot(SLTerrain *terrain) const;
+
 		/// <summary>
 		/// 
 		/// </summary>
 		/// <param name="player"></param>
 		/// <param name="terrainChange"></param>
-		void SendTerrainChangeMsg(short player, SceneMan::TerrainChange terrainChange);
+		/// <returns>The number of bytes that were sent.</returns>
+		int SendTerrainChangeMsg(short player, SceneMan::TerrainChange terrainChange);
 
 		/// <summary>
 		/// 
@@ -502,6 +652,12 @@ namespace RTE {
 		/// <param name="player"></param>
 		void SendFrameSetupMsg(short player);
 
+		/// <summary>
+		/// Gathers the frame setup message for the next frame sent to a player, with what their mouse was moving on it and which of their input messages it includes, so their client can draw it ahead of the frame. Must be called from the main thread.
+		/// </summary>
+		/// <param name="player">The player to gather the frame setup for.</param>
+		void GatherFrameSetup(short player);
+
 		/// <summary>
 		/// 
 		/// </summary>
@@ -515,6 +671,32 @@ namespace RTE {
 		/// <param name="player"></param>
 		void SendPostEffectData(short player);
 
+		/// <summary>
+		/// Gathers the states of the entities visible to a player for the next frame sent to it, along with any presets it wasn't sent yet. Must be called from the main thread.
+		/// </summary>
+		/// <param name="player">The player to gather the entity states for.</param>
+		void GatherEntityStates(short player);
+
+		/// <summary>
+		/// Adds the states of an entity and everything it has attached, in the order they're drawn in.
+		/// </summary>
+		/// <param name="movableObject">The entity to add the states of.</param>
+		/// <param name="entityStates">The entity states to add to.</param>
+		void AddEntityStates(const MovableObject *movableObject, std::vector<EntityStateNetworkData> &entityStates);
+
+		/// <summary>
+		/// Gets the index of the preset a sprite entity is drawn from by clients, adding the preset if it wasn't replicated yet.
+		/// </summary>
+		/// <param name="spriteObject">The entity to get the preset index of.</param>
+		/// <returns>The index of the preset, or EntityStateNetworkData::c_PixelPresetIndex if the entity has no sprite or there are too many presets.</returns>
+		unsigned short GetEntityPresetIndex(const MOSprite *spriteObject);
+
+		/// <summary>
+		/// Sends a player the presets and entity states gathered for it.
+		/// </summary>
+		/// <param name="player">The player to send to.</param>
+		void SendEntityStates(short player);
+
 		/// <summary>
 		/// 
 		/// </summary>
@@ -530,6 +712,24 @@ namespace RTE {
 		/// <param name="player"></param>
 		void UpdateStats(short player);
 
+		/// <summary>
+		/// Resets the frame rate, interlacing and compression a client is sent with to the configured settings.
+		/// </summary>
+		/// <param name="player">The player to reset for.</param>
+		void ResetClientEncoding(short player);
+
+		/// <summary>
+		/// Moves the frame rate, interlacing and compression a client is sent with one step towards what its link and the server's encoding time can keep up with. Called once a second by UpdateStats.
+		/// </summary>
+		/// <param name="player">The player to adapt for.</param>
+		/// <param name="bytesSentPerSecond">How many bytes actually went out to the player over the last second.</param>
+		void AdaptClientEncoding(short player, int bytesSentPerSecond);
+
+		/// <summary>
+		/// Writes the stats of each connected client over the last second to the stats log, if it's open and a second passed since they were last written.
+		/// </summary>
+		void WriteStatsLog();
+
 		/// <summary>
 		/// 
 		/// </summary>
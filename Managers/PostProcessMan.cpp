@@ -3,6 +3,8 @@
 #include "Scene.h"
 #include "ContentFile.h"
 #include "Matrix.h"
+#include "ThreadMan.h"
+#include "PixelKernels.h"
 
 namespace RTE {
 
@@ -11,6 +13,9 @@ namespace RTE {
 	void PostProcessMan::Clear() {
 		m_PostScreenEffects.clear();
 		m_PostSceneEffects.clear();
+		m_InterpolatedPostSceneEffects.clear();
+		m_RegisteringInterpolatedPostEffects = false;
+		m_InterpolatedPostEffectOffset.Reset();
 		m_YellowGlow = nullptr;
 		m_YellowGlowHash = 0;
 		m_RedGlow = nullptr;
@@ -18,6 +23,9 @@ namespace RTE {
 		m_BlueGlow = nullptr;
 		m_BlueGlowHash = 0;
 		m_TempEffectBitmaps.clear();
+		m_RotatedEffectBitmaps.clear();
+		m_BinnedEffects.clear();
+		m_EffectTileBins.clear();
 		for (int i = 0; i < c_MaxScreenCount; ++i) {
 			m_ScreenRelativeEffects.at(i).clear();
 		}
@@ -56,6 +64,11 @@ namespace RTE {
 		for (std::pair<int, BITMAP *> tempBitmapEntry : m_TempEffectBitmaps) {
 			destroy_bitmap(tempBitmapEntry.second);
 		}
+		for (const auto &[rotatedBitmapSize, rotatedBitmaps] : m_RotatedEffectBitmaps) {
+			for (BITMAP *rotatedBitmap : rotatedBitmaps) {
+				destroy_bitmap(rotatedBitmap);
+			}
+		}
 		ClearScreenPostEffects();
 		ClearScenePostEffects();
 		Clear();
@@ -63,7 +76,7 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void PostProcessMan::AdjustEffectsPosToPlayerScreen(int playerScreen, BITMAP *targetBitmap, const Vector &targetBitmapOffset, std::list<PostEffect> &screenRelativeEffectsList, std::list<Box> &screenRelativeGlowBoxesList) const {
+	void PostProcessMan::AdjustEffectsPosToPlayerScreen(int playerScreen, BITMAP *targetBitmap, const Vector &targetBitmapOffset, std::vector<PostEffect> &screenRelativeEffectsList, std::vector<Box> &screenRelativeGlowBoxesList) const {
 		int screenOcclusionOffsetX = g_SceneMan.GetScreenOcclusion(playerScreen).GetFloorIntX();
 		int screenOcclusionOffsetY = g_SceneMan.GetScreenOcclusion(playerScreen).GetFloorIntY();
 		int occludedOffsetX = targetBitmap->w + screenOcclusionOffsetX;
@@ -72,6 +85,9 @@ namespace RTE {
 		// Copy post effects received by client if in network mode
 		if (g_FrameMan.GetDrawNetworkBackBuffer()) { g_PostProcessMan.GetNetworkPostEffectsList(0, screenRelativeEffectsList); }
 
+		g_PostProcessMan.GetPostScreenEffectsList()->reserve(g_PostProcessMan.GetPostScreenEffectsList()->size() + screenRelativeEffectsList.size());
+		g_PostProcessMan.GetPostScreenGlowBoxesList()->reserve(g_PostProcessMan.GetPostScreenGlowBoxesList()->size() + screenRelativeGlowBoxesList.size());
+
 		// Adjust for the player screen's position on the final buffer
 		for (const PostEffect &postEffect : screenRelativeEffectsList) {
 			// Make sure we won't be adding any effects to a part of the screen that is occluded by menus and such
@@ -90,14 +106,22 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void PostProcessMan::RegisterPostEffect(const Vector &effectPos, BITMAP *effect, size_t hash, int strength, float angle) {
-		// These effects get applied when there's a drawn frame that followed one or more sim updates.
-		// They are not only registered on drawn sim updates; flashes and stuff could be missed otherwise if they occur on undrawn sim updates.
-		if (effect && g_TimerMan.SimUpdatesSinceDrawn() >= 0) { m_PostSceneEffects.push_back(PostEffect(effectPos, effect, hash, strength, angle)); }
+		if (!effect) {
+			return;
+		}
+		if (m_RegisteringInterpolatedPostEffects) {
+			// These are registered anew every drawn frame, whether or not a sim update happened since the last one, since the MOs registering them get drawn every frame
+			m_InterpolatedPostSceneEffects.push_back(PostEffect(effectPos + m_InterpolatedPostEffectOffset, effect, hash, strength, angle));
+		} else if (g_TimerMan.SimUpdatesSinceDrawn() >= 0) {
+			// These effects get applied when there's a drawn frame that followed one or more sim updates.
+			// They are not only registered on drawn sim updates; flashes and stuff could be missed otherwise if they occur on undrawn sim updates.
+			m_PostSceneEffects.push_back(PostEffect(effectPos, effect, hash, strength, angle));
+		}
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	bool PostProcessMan::GetPostScreenEffectsWrapped(const Vector &boxPos, int boxWidth, int boxHeight, std::list<PostEffect> &effectsList, int team) {
+	bool PostProcessMan::GetPostScreenEffectsWrapped(const Vector &boxPos, int boxWidth, int boxHeight, std::vector<PostEffect> &effectsList, int team) {
 		bool found = false;
 
 		// Do the first unwrapped rect
@@ -145,7 +169,7 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	bool PostProcessMan::GetGlowAreasWrapped(const Vector &boxPos, int boxWidth, int boxHeight, std::list<Box> &areaList) const {
+	bool PostProcessMan::GetGlowAreasWrapped(const Vector &boxPos, int boxWidth, int boxHeight, std::vector<Box> &areaList) const {
 		bool foundAny = false;
 		Vector intRectPosRelativeToBox;
 
@@ -175,7 +199,7 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void PostProcessMan::GetNetworkPostEffectsList(int whichScreen, std::list<PostEffect> & outputList) {
+	void PostProcessMan::GetNetworkPostEffectsList(int whichScreen, std::vector<PostEffect> & outputList) {
 		ScreenRelativeEffectsMutex.at(whichScreen).lock();
 		outputList.clear();
 		for (const PostEffect &postEffect : m_ScreenRelativeEffects.at(whichScreen)) {
@@ -186,7 +210,7 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void PostProcessMan::SetNetworkPostEffectsList(int whichScreen, std::list<PostEffect> & inputList) {
+	void PostProcessMan::SetNetworkPostEffectsList(int whichScreen, std::vector<PostEffect> & inputList) {
 		ScreenRelativeEffectsMutex.at(whichScreen).lock();
 		m_ScreenRelativeEffects.at(whichScreen).clear();
 		for (const PostEffect &postEffect : inputList) {
@@ -197,18 +221,24 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	bool PostProcessMan::GetPostScreenEffects(Vector boxPos, int boxWidth, int boxHeight, std::list<PostEffect> &effectsList, int team) {
+	bool PostProcessMan::GetPostScreenEffects(Vector boxPos, int boxWidth, int boxHeight, std::vector<PostEffect> &effectsList, int team) {
 		bool found = false;
 		bool unseen = false;
 		Vector postEffectPosRelativeToBox;
 
-		for (PostEffect &scenePostEffect : m_PostSceneEffects) {
-			if (team != Activity::NoTeam) { unseen = g_SceneMan.IsUnseen(scenePostEffect.m_Pos.GetFloorIntX(), scenePostEffect.m_Pos.GetFloorIntY(), team); }
+		for (std::vector<PostEffect> *scenePostEffects : { &m_PostSceneEffects, &m_InterpolatedPostSceneEffects }) {
+			for (PostEffect &scenePostEffect : *scenePostEffects) {
+				// Cull by the box first, looking up whether the effect is unseen is a lot more expensive
+				if (!WithinBox(scenePostEffect.m_Pos, boxPos, static_cast<float>(boxWidth), static_cast<float>(boxHeight))) {
+					continue;
+				}
+				if (team != Activity::NoTeam) { unseen = g_SceneMan.IsUnseen(scenePostEffect.m_Pos.GetFloorIntX(), scenePostEffect.m_Pos.GetFloorIntY(), team); }
 
-			if (WithinBox(scenePostEffect.m_Pos, boxPos, static_cast<float>(boxWidth), static_cast<float>(boxHeight)) && !unseen) {
-				found = true;
-				postEffectPosRelativeToBox = scenePostEffect.m_Pos - boxPos;
-				effectsList.push_back(PostEffect(postEffectPosRelativeToBox, scenePostEffect.m_Bitmap, scenePostEffect.m_BitmapHash, scenePostEffect.m_Strength, scenePostEffect.m_Angle));
+				if (!unseen) {
+					found = true;
+					postEffectPosRelativeToBox = scenePostEffect.m_Pos - boxPos;
+					effectsList.push_back(PostEffect(postEffectPosRelativeToBox, scenePostEffect.m_Bitmap, scenePostEffect.m_BitmapHash, scenePostEffect.m_Strength, scenePostEffect.m_Angle));
+				}
 			}
 		}
 		return found;
@@ -216,18 +246,24 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	bool PostProcessMan::GetPostScreenEffects(int left, int top, int right, int bottom, std::list<PostEffect> &effectsList, int team) {
+	bool PostProcessMan::GetPostScreenEffects(int left, int top, int right, int bottom, std::vector<PostEffect> &effectsList, int team) {
 		bool found = false;
 		bool unseen = false;
 		Vector postEffectPosRelativeToBox;
 
-		for (PostEffect &scenePostEffect : m_PostSceneEffects) {
-			if (team != Activity::NoTeam) { unseen = g_SceneMan.IsUnseen(scenePostEffect.m_Pos.GetFloorIntX(), scenePostEffect.m_Pos.GetFloorIntY(), team); }
+		for (std::vector<PostEffect> *scenePostEffects : { &m_PostSceneEffects, &m_InterpolatedPostSceneEffects }) {
+			for (PostEffect &scenePostEffect : *scenePostEffects) {
+				// Cull by the box first, looking up whether the effect is unseen is a lot more expensive
+				if (!WithinBox(scenePostEffect.m_Pos, static_cast<float>(left), static_cast<float>(top), static_cast<float>(right), static_cast<float>(bottom))) {
+					continue;
+				}
+				if (team != Activity::NoTeam) { unseen = g_SceneMan.IsUnseen(scenePostEffect.m_Pos.GetFloorIntX(), scenePostEffect.m_Pos.GetFloorIntY(), team); }
 
-			if (WithinBox(scenePostEffect.m_Pos, static_cast<float>(left), static_cast<float>(top), static_cast<float>(right), static_cast<float>(bottom)) && !unseen) {
-				found = true;
-				postEffectPosRelativeToBox = Vector(scenePostEffect.m_Pos.m_X - static_cast<float>(left), scenePostEffect.m_Pos.m_Y - static_cast<float>(top));
-				effectsList.push_back(PostEffect(postEffectPosRelativeToBox, scenePostEffect.m_Bitmap, scenePostEffect.m_BitmapHash, scenePostEffect.m_Strength, scenePostEffect.m_Angle));
+				if (!unseen) {
+					found = true;
+					postEffectPosRelativeToBox = Vector(scenePostEffect.m_Pos.m_X - static_cast<float>(left), scenePostEffect.m_Pos.m_Y - static_cast<float>(top));
+					effectsList.push_back(PostEffect(postEffectPosRelativeToBox, scenePostEffect.m_Bitmap, scenePostEffect.m_BitmapHash, scenePostEffect.m_Strength, scenePostEffect.m_Angle));
+				}
 			}
 		}
 		return found;
@@ -273,7 +309,7 @@ namespace RTE {
 
 	void PostProcessMan::PostProcess() {
 		// First copy the current 8bpp backbuffer to the 32bpp buffer; we'll add effects to it
-		blit(g_FrameMan.GetBackBuffer8(), g_FrameMan.GetBackBuffer32(), 0, 0, 0, 0, g_FrameMan.GetBackBuffer8()->w, g_FrameMan.GetBackBuffer8()->h);
+		PixelKernels::ExpandIndexedBitmap(g_FrameMan.GetBackBuffer8(), g_FrameMan.GetBackBuffer32());
 
 		// Set the screen blender mode for glows
 		set_screen_blender(128, 128, 128, 128);
@@ -282,8 +318,9 @@ namespace RTE {
 		//acquire_bitmap(m_BackBuffer8);
 		//acquire_bitmap(m_BackBuffer32);
 
-		DrawDotGlowEffects();
-		DrawPostScreenEffects();
+		GatherDotGlowEffects();
+		GatherPostScreenEffects();
+		DrawBinnedEffects();
 
 		// Reference. Do not remove.
 		//release_bitmap(m_BackBuffer32);
@@ -297,7 +334,7 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void PostProcessMan::DrawDotGlowEffects() {
+	void PostProcessMan::GatherDotGlowEffects() {
 		int startX = 0;
 		int startY = 0;
 		int endX = 0;
@@ -305,7 +342,7 @@ namespace RTE {
 		int testpixel = 0;
 
 		// Randomly sample the entire backbuffer, looking for pixels to put a glow on.
-		// NOTE THIS IS SLOW, especially on higher resolutions!
+		// Rows are scanned for the glowing colors with vectorized compares, so only the matching pixels are looked at individually.
 		for (const Box &glowBox : m_PostScreenGlowBoxes) {
 			startX = glowBox.m_Corner.GetFloorIntX();
 			startY = glowBox.m_Corner.GetFloorIntY();
@@ -324,22 +361,25 @@ namespace RTE {
 #endif
 
 			for (int y = startY; y < endY; ++y) {
-				for (int x = startX; x < endX; ++x) {
-					testpixel = _getpixel(g_FrameMan.GetBackBuffer8(), x, y);
+				const unsigned char *row = g_FrameMan.GetBackBuffer8()->line[y];
+				const unsigned char *rowEnd = row + endX;
+				for (const unsigned char *pixel = PixelKernels::FindAnyOf(row + startX, rowEnd, g_YellowGlowColor, 98, 120); pixel != rowEnd; pixel = PixelKernels::FindAnyOf(pixel + 1, rowEnd, g_YellowGlowColor, 98, 120)) {
+					testpixel = *pixel;
+					int x = static_cast<int>(pixel - row);
 
 					// YELLOW
 					if ((testpixel == g_YellowGlowColor && RandomNum() < 0.9F) || testpixel == 98 || (testpixel == 120 && RandomNum() < 0.7F)) {
-						draw_trans_sprite(g_FrameMan.GetBackBuffer32(), m_YellowGlow, x - 2, y - 2);
+						m_BinnedEffects.push_back({ m_YellowGlow, m_YellowGlowHash, x - 2, y - 2, 128 });
 					}
-					// TODO: Enable and add more colors once we actually have something that needs these.
+					// TODO: Enable and add more colors once we actually have something that needs these. They'll also need to be looked for by FindAnyOf above.
 					// RED
 					/*
 					if (testpixel == 13) {
-						draw_trans_sprite(m_BackBuffer32, m_RedGlow, x - 2, y - 2);
+						m_BinnedEffects.push_back({ m_RedGlow, m_RedGlowHash, x - 2, y - 2, 128 });
 					}
 					// BLUE
 					if (testpixel == 166) {
-						draw_trans_sprite(g_FrameMan.GetBackBuffer32(), m_BlueGlow, x - 2, y - 2);
+						m_BinnedEffects.push_back({ m_BlueGlow, m_BlueGlowHash, x - 2, y - 2, 128 });
 					}
 					*/
 				}
@@ -349,32 +389,112 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void PostProcessMan::DrawPostScreenEffects() const {
-		BITMAP *effectBitmap = nullptr;
-		int effectPosX = 0;
-		int effectPosY = 0;
-		int effectStrength = 0;
+	void PostProcessMan::GatherPostScreenEffects() {
+		std::unordered_map<int, size_t> rotatedEffectBitmapsUsed;
+		std::vector<std::pair<const PostEffect *, BITMAP *>> effectsToRotate;
 
 		for (const PostEffect &postEffect : m_PostScreenEffects) {
 			if (postEffect.m_Bitmap) {
-				effectBitmap = postEffect.m_Bitmap;
-				effectStrength = postEffect.m_Strength;
-				effectPosX = postEffect.m_Pos.GetFloorIntX() - (effectBitmap->w / 2);
-				effectPosY = postEffect.m_Pos.GetFloorIntY() - (effectBitmap->h / 2);
-				set_screen_blender(effectStrength, effectStrength, effectStrength, effectStrength);
-
-				// Draw all the scene screen effects accumulated this frame
-				if (postEffect.m_Angle == 0) {
-					draw_trans_sprite(g_FrameMan.GetBackBuffer32(), effectBitmap, effectPosX, effectPosY);
-				} else {
-					BITMAP *targetBitmap = GetTempEffectBitmap(effectBitmap);
-					clear_to_color(targetBitmap, 0);
-
-					Matrix newAngle(postEffect.m_Angle);
-					rotate_sprite(targetBitmap, effectBitmap, 0, 0, ftofix(newAngle.GetAllegroAngle()));
-					draw_trans_sprite(g_FrameMan.GetBackBuffer32(), targetBitmap, effectPosX, effectPosY);
+				BITMAP *effectBitmap = postEffect.m_Bitmap;
+				int effectPosX = postEffect.m_Pos.GetFloorIntX() - (effectBitmap->w / 2);
+				int effectPosY = postEffect.m_Pos.GetFloorIntY() - (effectBitmap->h / 2);
+
+				if (postEffect.m_Angle != 0) {
+					// All the effects are drawn after being rotated, so each rotated effect needs its own bitmap just big enough to rotate it in
+					int rotatedBitmapSize = static_cast<int>(std::ceil(static_cast<float>(std::max(effectBitmap->w, effectBitmap->h)) / 16.0F)) * 16;
+					std::vector<BITMAP *> &rotatedBitmaps = m_RotatedEffectBitmaps[rotatedBitmapSize];
+					size_t &rotatedBitmapsUsed = rotatedEffectBitmapsUsed[rotatedBitmapSize];
+					if (rotatedBitmapsUsed == rotatedBitmaps.size()) { rotatedBitmaps.push_back(create_bitmap(rotatedBitmapSize, rotatedBitmapSize)); }
+
+					effectBitmap = rotatedBitmaps.at(rotatedBitmapsUsed++);
+					effectsToRotate.emplace_back(&postEffect, effectBitmap);
 				}
+				m_BinnedEffects.push_back({ effectBitmap, postEffect.m_BitmapHash, effectPosX, effectPosY, postEffect.m_Strength });
 			}
 		}
+
+		g_ThreadMan.ParallelFor(0, static_cast<int>(effectsToRotate.size()), 8, [&effectsToRotate](int firstEffect, int endEffect) {
+			for (int effectIndex = firstEffect; effectIndex < endEffect; ++effectIndex) {
+				const auto &[postEffect, rotatedBitmap] = effectsToRotate.at(effectIndex);
+				clear_to_color(rotatedBitmap, 0);
+
+				Matrix newAngle(postEffect->m_Angle);
+				rotate_sprite(rotatedBitmap, postEffect->m_Bitmap, 0, 0, ftofix(newAngle.GetAllegroAngle()));
+			}
+		});
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PostProcessMan::DrawBinnedEffects() {
+		BITMAP *backBuffer = g_FrameMan.GetBackBuffer32();
+		int tileCountX = (backBuffer->w + c_EffectTileSize - 1) / c_EffectTileSize;
+		int tileCountY = (backBuffer->h + c_EffectTileSize - 1) / c_EffectTileSize;
+		int tileCount = tileCountX * tileCountY;
+
+		m_EffectTileBins.resize(tileCount);
+		for (std::vector<int> &tileBin : m_EffectTileBins) {
+			tileBin.clear();
+		}
+
+		// Keep the effects using the same bitmap next to each other so they get drawn in sequence. The sort is stable so overlapping effects using the same bitmap still blend in the order they were registered.
+		std::stable_sort(m_BinnedEffects.begin(), m_BinnedEffects.end(), [](const BinnedPostEffect &lhs, const BinnedPostEffect &rhs) {
+			return (lhs.BitmapHash != rhs.BitmapHash) ? lhs.BitmapHash < rhs.BitmapHash : std::less<BITMAP *>()(lhs.Bitmap, rhs.Bitmap);
+		});
+
+		// Effect bitmaps that aren't 32bpp are handed off to Allegro, which blends them with its global blender state, so those can't be drawn on multiple threads.
+		bool drawTilesInParallel = true;
+
+		for (int effectIndex = 0; effectIndex < static_cast<int>(m_BinnedEffects.size()); ++effectIndex) {
+			const BinnedPostEffect &binnedEffect = m_BinnedEffects.at(effectIndex);
+			int effectEndX = binnedEffect.PosX + binnedEffect.Bitmap->w;
+			int effectEndY = binnedEffect.PosY + binnedEffect.Bitmap->h;
+
+			// Cull the effects that don't touch the back-buffer at all
+			if (effectEndX <= 0 || effectEndY <= 0 || binnedEffect.PosX >= backBuffer->w || binnedEffect.PosY >= backBuffer->h) {
+				continue;
+			}
+			int firstTileX = std::max(binnedEffect.PosX, 0) / c_EffectTileSize;
+			int firstTileY = std::max(binnedEffect.PosY, 0) / c_EffectTileSize;
+			int lastTileX = (std::min(effectEndX, backBuffer->w) - 1) / c_EffectTileSize;
+			int lastTileY = (std::min(effectEndY, backBuffer->h) - 1) / c_EffectTileSize;
+
+			for (int tileY = firstTileY; tileY <= lastTileY; ++tileY) {
+				for (int tileX = firstTileX; tileX <= lastTileX; ++tileX) {
+					m_EffectTileBins.at(tileY * tileCountX + tileX).push_back(effectIndex);
+				}
+			}
+			if (bitmap_color_depth(binnedEffect.Bitmap) != 32) { drawTilesInParallel = false; }
+		}
+
+		// Each tile is drawn through its own sub-bitmap of the back-buffer, which clips the effects to it so no two tiles touch the same pixels.
+		// Creating sub-bitmaps changes state in the parent and in Allegro, so they're all made up front.
+		std::vector<BITMAP *> tileBitmaps(tileCount, nullptr);
+		for (int tile = 0; tile < tileCount; ++tile) {
+			if (!m_EffectTileBins.at(tile).empty()) { tileBitmaps.at(tile) = create_sub_bitmap(backBuffer, (tile % tileCountX) * c_EffectTileSize, (tile / tileCountX) * c_EffectTileSize, c_EffectTileSize, c_EffectTileSize); }
+		}
+
+		auto drawTiles = [this, &tileBitmaps, tileCountX](int firstTile, int endTile) {
+			for (int tile = firstTile; tile < endTile; ++tile) {
+				if (BITMAP *tileBitmap = tileBitmaps.at(tile)) {
+					int tilePosX = (tile % tileCountX) * c_EffectTileSize;
+					int tilePosY = (tile / tileCountX) * c_EffectTileSize;
+					for (int effectIndex : m_EffectTileBins.at(tile)) {
+						const BinnedPostEffect &binnedEffect = m_BinnedEffects.at(effectIndex);
+						PixelKernels::DrawScreenBlendedSprite(tileBitmap, binnedEffect.Bitmap, binnedEffect.PosX - tilePosX, binnedEffect.PosY - tilePosY, binnedEffect.Strength);
+					}
+				}
+			}
+		};
+		if (drawTilesInParallel) {
+			g_ThreadMan.ParallelFor(0, tileCount, 1, drawTiles);
+		} else {
+			drawTiles(0, tileCount);
+		}
+
+		for (BITMAP *tileBitmap : tileBitmaps) {
+			if (tileBitmap) { destroy_bitmap(tileBitmap); }
+		}
+		m_BinnedEffects.clear();
 	}
 }
\ No newline at end of file
@@ -64,12 +64,13 @@ namespace RTE {
 		/// <summary>
 		/// Clears the list of registered post-processing scene effects and glow areas.
 		/// </summary>
-		void ClearScenePostEffects() { m_PostSceneEffects.clear(); m_GlowAreas.clear(); }
+		void ClearScenePostEffects() { m_PostSceneEffects.clear(); m_InterpolatedPostSceneEffects.clear(); m_GlowAreas.clear(); }
 #pragma endregion
 
 #pragma region Concrete Methods
 		/// <summary>
 		/// Takes the current state of the 8bpp back-buffer, copies it, and adds post-processing effects on top like glows etc.
+		/// The effects are binned into tiles of the back-buffer and each tile is drawn on the worker threads, with the effects using the same bitmap drawn in sequence.
 		/// </summary>
 		void PostProcess();
 
@@ -81,7 +82,7 @@ namespace RTE {
 		/// <param name="targetBitmapOffset">The position of the specified player's draw screen on the backbuffer.</param>
 		/// <param name="screenRelativeEffectsList">List of the specified player's accumulated post effects for this frame.</param>
 		/// <param name="screenRelativeGlowBoxesList">List of the specified player's accumulated glow boxes for this frame.</param>
-		void AdjustEffectsPosToPlayerScreen(int playerScreen, BITMAP *targetBitmap, const Vector &targetBitmapOffset, std::list<PostEffect> &screenRelativeEffectsList, std::list<Box> &screenRelativeGlowBoxesList) const;
+		void AdjustEffectsPosToPlayerScreen(int playerScreen, BITMAP *targetBitmap, const Vector &targetBitmapOffset, std::vector<PostEffect> &screenRelativeEffectsList, std::vector<Box> &screenRelativeGlowBoxesList) const;
 #pragma endregion
 
 #pragma region Post Effect Handling
@@ -89,7 +90,7 @@ namespace RTE {
 		/// Gets the list of effects to apply at the end of each frame.
 		/// </summary>
 		/// <returns>The list of effects to apply at the end of each frame.</returns>
-		std::list<PostEffect> * GetPostScreenEffectsList() { return &m_PostScreenEffects; }
+		std::vector<PostEffect> * GetPostScreenEffectsList() { return &m_PostScreenEffects; }
 
 		/// <summary>
 		/// Registers a post effect to be added at the very last stage of 32bpp rendering by the FrameMan.
@@ -101,6 +102,22 @@ namespace RTE {
 		/// <param name="angle">The angle this effect should be rotated at.</param>
 		void RegisterPostEffect(const Vector &effectPos, BITMAP *effect, size_t hash, int strength = 255, float angle = 0);
 
+		/// <summary>
+		/// Starts registering the post effects of MOs drawn at interpolated positions when render interpolation is enabled. Those MOs are redrawn every frame, so their effects are kept apart from the ones registered by the sim and replaced every frame.
+		/// </summary>
+		void StartInterpolatedPostEffects() { m_InterpolatedPostSceneEffects.clear(); m_InterpolatedPostEffectOffset.Reset(); m_RegisteringInterpolatedPostEffects = true; }
+
+		/// <summary>
+		/// Sets how far to move the interpolated post effects registered from now on, to line up with where the MO registering them is drawn.
+		/// </summary>
+		/// <param name="offset">The offset from the position of the MO to where it's drawn.</param>
+		void SetInterpolatedPostEffectOffset(const Vector &offset) { m_InterpolatedPostEffectOffset = offset; }
+
+		/// <summary>
+		/// Stops registering interpolated post effects. Effects registered after this are the sim's again.
+		/// </summary>
+		void StopInterpolatedPostEffects() { m_RegisteringInterpolatedPostEffects = false; }
+
 		/// <summary>
 		/// Gets all screen effects that are located within a box in the scene.
 		/// Their coordinates will be returned relative to the upper left corner of the box passed in here. Wrapping of the box will be taken care of.
@@ -111,7 +128,7 @@ namespace RTE {
 		/// <param name="effectsList">The list to add the screen effects that fall within the box to. The coordinates of the effects returned here will be relative to the boxPos passed in above.</param>
 		/// <param name="team">The team whose unseen layer should obscure the screen effects here.</param>
 		/// <returns>Whether any active post effects were found in that box.</returns>
-		bool GetPostScreenEffectsWrapped(const Vector &boxPos, int boxWidth, int boxHeight, std::list<PostEffect> &effectsList, int team = -1);
+		bool GetPostScreenEffectsWrapped(const Vector &boxPos, int boxWidth, int boxHeight, std::vector<PostEffect> &effectsList, int team = -1);
 
 		/// <summary>
 		/// Gets a temporary bitmap of specified size to rotate post effects in.
@@ -126,7 +143,7 @@ namespace RTE {
 		/// Gets the list of areas that will be processed with glow.
 		/// </summary>
 		/// <returns>The list of areas that will be processed with glow.</returns>
-		std::list<Box> * GetPostScreenGlowBoxesList() { return &m_PostScreenGlowBoxes; }
+		std::vector<Box> * GetPostScreenGlowBoxesList() { return &m_PostScreenGlowBoxes; }
 
 		/// <summary>
 		/// Registers a specific IntRect to be post-processed and have special pixel colors lit up by glow effects in it.
@@ -160,7 +177,7 @@ namespace RTE {
 		/// <param name="boxHeight">The height of the box.</param>
 		/// <param name="areaList">The list to add the glow Boxes that intersect to. The coordinates of the Boxes returned here will be relative to the boxPos passed in above.</param>
 		/// <returns>Whether any active post effects were found in that box.</returns>
-		bool GetGlowAreasWrapped(const Vector &boxPos, int boxWidth, int boxHeight, std::list<Box> &areaList) const;
+		bool GetGlowAreasWrapped(const Vector &boxPos, int boxWidth, int boxHeight, std::vector<Box> &areaList) const;
 #pragma endregion
 
 #pragma region Network Post Effect Handling
@@ -169,25 +186,41 @@ namespace RTE {
 		/// </summary>
 		/// <param name="whichScreen">Which player screen to get list for.</param>
 		/// <param name="outputList">Reference to the list of post effects to copy into.</param>
-		void GetNetworkPostEffectsList(int whichScreen, std::list<PostEffect> &outputList);
+		void GetNetworkPostEffectsList(int whichScreen, std::vector<PostEffect> &outputList);
 
 		/// <summary>
 		/// Copies the player's screen relative post effects from the referenced list to the list of this PostProcessMan. Used for receiving post effect data over the network.
 		/// </summary>
 		/// <param name="whichScreen">Which player screen to set list for.</param>
 		/// <param name="inputList">Reference to the list of post effects to copy from.</param>
-		void SetNetworkPostEffectsList(int whichScreen, std::list<PostEffect> &inputList);
+		void SetNetworkPostEffectsList(int whichScreen, std::vector<PostEffect> &inputList);
 #pragma endregion
 
 	protected:
 
-		std::list<PostEffect> m_PostScreenEffects; //!< List of effects to apply at the end of each frame. This list gets cleared out and re-filled each frame.
-		std::list<PostEffect> m_PostSceneEffects; //!< All post-processing effects registered for this draw frame in the scene.
-
-		std::list<Box> m_PostScreenGlowBoxes; //!< List of areas that will be processed with glow.
-		std::list<IntRect> m_GlowAreas; //!< All the areas to do post glow pixel effects on, in scene coordinates.
-
-		std::array<std::list<PostEffect>, c_MaxScreenCount> m_ScreenRelativeEffects; //!< List of screen relative effects for each player in online multiplayer.
+		/// <summary>
+		/// A post effect that is ready to be drawn onto the 32bpp back-buffer, with any rotation already applied.
+		/// </summary>
+		struct BinnedPostEffect {
+			BITMAP *Bitmap; //!< The bitmap to blend, not owned.
+			size_t BitmapHash; //!< Hash of the bitmap, used to group the effects using the same bitmap together.
+			int PosX; //!< The X position of the upper left corner of the bitmap on the back-buffer.
+			int PosY; //!< The Y position of the upper left corner of the bitmap on the back-buffer.
+			int Strength; //!< How hard to blend the bitmap in, 0 - 255.
+		};
+
+		static constexpr int c_EffectTileSize = 128; //!< The width and height of the tiles the back-buffer is split into for culling and drawing effects.
+
+		std::vector<PostEffect> m_PostScreenEffects; //!< List of effects to apply at the end of each frame. This list gets cleared out and re-filled each frame.
+		std::vector<PostEffect> m_PostSceneEffects; //!< All post-processing effects registered for this draw frame in the scene.
+		std::vector<PostEffect> m_InterpolatedPostSceneEffects; //!< The post-processing effects of MOs drawn at interpolated positions this frame, in the scene.
+		bool m_RegisteringInterpolatedPostEffects; //!< Whether registered effects are ones of MOs drawn at interpolated positions.
+		Vector m_InterpolatedPostEffectOffset; //!< How far to move the interpolated effects being registered, to line up with where their MO is drawn.
+
+		std::vector<Box> m_PostScreenGlowBoxes; //!< List of areas that will be processed with glow.
+		std::vector<IntRect> m_GlowAreas; //!< All the areas to do post glow pixel effects on, in scene coordinates.
+
+		std::array<std::vector<PostEffect>, c_MaxScreenCount> m_ScreenRelativeEffects; //!< List of screen relative effects for each player in online multiplayer.
 		std::array<std::mutex, c_MaxScreenCount> ScreenRelativeEffectsMutex; //!< Mutex for the ScreenRelativeEffects list when accessed by multiple threads in online multiplayer.
 
 		BITMAP *m_YellowGlow; //!< Bitmap for the yellow dot glow effect.
@@ -199,6 +232,10 @@ namespace RTE {
 		size_t m_BlueGlowHash; //!< Hash value for the blue dot glow effect bitmap.
 
 		std::unordered_map<int, BITMAP *> m_TempEffectBitmaps; //!< Stores temporary bitmaps to rotate post effects in for quick access.
+		std::unordered_map<int, std::vector<BITMAP *>> m_RotatedEffectBitmaps; //!< Bitmaps to rotate post effects in ahead of drawing them, by size. Each rotated effect drawn in a frame gets its own.
+
+		std::vector<BinnedPostEffect> m_BinnedEffects; //!< All the effects to draw this frame, sorted by bitmap once gathered.
+		std::vector<std::vector<int>> m_EffectTileBins; //!< Indices of the effects in m_BinnedEffects that overlap each tile of the back-buffer, in drawing order.
 
 	private:
 
@@ -212,7 +249,7 @@ namespace RTE {
 		/// <param name="effectsList">The list to add the screen effects that fall within the box to. The coordinates of the effects returned here will be relative to the boxPos passed in above.</param>
 		/// <param name="team">The team whose unseen area should block the glows.</param>
 		/// <returns>Whether any active post effects were found in that box.</returns>
-		bool GetPostScreenEffects(Vector boxPos, int boxWidth, int boxHeight, std::list<PostEffect> &effectsList, int team = -1);
+		bool GetPostScreenEffects(Vector boxPos, int boxWidth, int boxHeight, std::vector<PostEffect> &effectsList, int team = -1);
 
 		/// <summary>
 		/// Gets all screen effects that are located within a box in the scene. Their coordinates will be returned relative to the upper left corner of the box passed in here.
@@ -224,7 +261,7 @@ namespace RTE {
 		/// <param name="effectsList">The list to add the screen effects that fall within the box to. The coordinates of the effects returned here will be relative to the boxPos passed in above.</param>
 		/// <param name="team">The team whose unseen area should block the glows.</param>
 		/// <returns>Whether any active post effects were found in that box.</returns>
-		bool GetPostScreenEffects(int left, int top, int right, int bottom, std::list<PostEffect> &effectsList, int team = -1);
+		bool GetPostScreenEffects(int left, int top, int right, int bottom, std::vector<PostEffect> &effectsList, int team = -1);
 #pragma endregion
 
 #pragma region Post Pixel Glow Handling
@@ -245,14 +282,19 @@ namespace RTE {
 
 #pragma region PostProcess Breakdown
 		/// <summary>
-		/// Draws all the glow dot effects on pixels registered inside glow boxes for this frame. This is called from PostProcess().
+		/// Finds the pixels inside the glow boxes registered for this frame that should glow, and adds glow dot effects on them to the binned effects. This is called from PostProcess().
+		/// </summary>
+		void GatherDotGlowEffects();
+
+		/// <summary>
+		/// Adds all the screen effects registered for this frame to the binned effects, rotating the ones that need it. This is called from PostProcess().
 		/// </summary>
-		void DrawDotGlowEffects();
+		void GatherPostScreenEffects();
 
 		/// <summary>
-		/// Draws all the glow effects registered for this frame. This is called from PostProcess().
+		/// Sorts the binned effects by bitmap, bins them into the tiles of the back-buffer they overlap, culling the ones that don't overlap any, and draws each tile. This is called from PostProcess().
 		/// </summary>
-		void DrawPostScreenEffects() const;
+		void DrawBinnedEffects();
 #pragma endregion
 
 		/// <summary>
@@ -78,6 +78,7 @@ void SceneMan::Clear()
 	m_PlaceUnits = true;
     m_pCurrentScene = 0;
     m_pMOColorLayer = 0;
+    m_MOTrailPixels.clear();
     m_pMOIDLayer = 0;
     m_MOIDDrawings.clear();
     m_pDebugLayer = nullptr;
@@ -95,6 +96,7 @@ void SceneMan::Clear()
         m_Offset[i].Reset();
         m_DeltaOffset[i].Reset();
         m_ScrollTarget[i].Reset();
+        m_ScrollTargetInterpolationStart[i].Reset();
         m_ScreenTeam[i] = Activity::NoTeam;
         m_ScrollSpeed[i] = 0.1;
         m_ScrollTimer[i].Reset();
@@ -102,11 +104,16 @@ void SceneMan::Clear()
         m_TargetWrapped[i] = false;
         m_SeamCrossCount[i][X] = 0;
         m_SeamCrossCount[i][Y] = 0;
+        m_apTerrainViewCache[i] = nullptr;
+        m_aTerrainViewLayers[i].clear();
+        m_aTerrainViewBox[i].Reset();
+        m_aTerrainViewStale[i] = false;
     }
 
     m_pUnseenRevealSound = 0;
     m_DrawRayCastVisualizations = false;
     m_DrawPixelCheckVisualizations = false;
+    m_EnableTerrainViewCache = true;
     m_LastUpdatedScreen = 0;
     m_SecondStructPass = false;
 //    m_CalcTimer.Reset();
@@ -202,6 +209,12 @@ int SceneMan::LoadScene(Scene *pNewScene, bool placeObjects, bool placeUnits) {
 
 //    m_pCurrentScene->GetTerrain()->CleanAir();
 
+    // Make sure nothing of the previous scene lingers in the cached terrain views
+    for (int screen = 0; screen < c_MaxScreenCount; ++screen)
+    {
+        m_aTerrainViewLayers[screen].clear();
+    }
+
     // Re-create the MoveableObject:s color SceneLayer
     delete m_pMOColorLayer;
     BITMAP *pBitmap = create_bitmap_ex(8, GetSceneWidth(), GetSceneHeight());
@@ -406,6 +419,12 @@ void SceneMan::Destroy()
     delete m_pMOColorLayer;
     delete m_pUnseenRevealSound;
 
+    for (int i = 0; i < c_MaxScreenCount; ++i)
+    {
+        if (m_apTerrainViewCache[i])
+            destroy_bitmap(m_apTerrainViewCache[i]);
+    }
+
 	destroy_bitmap(m_pOrphanSearchBitmap);
 	m_pOrphanSearchBitmap = 0;
 
@@ -739,6 +758,19 @@ const Vector & SceneMan::GetScrollTarget(int screen) const {
 }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          SaveScrollTargetInterpolationStarts
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Has every screen remember its current scroll target as where scrolling
+//                  is interpolated from over the coming sim update.
+
+void SceneMan::SaveScrollTargetInterpolationStarts()
+{
+    for (int screen = 0; screen < c_MaxScreenCount; ++screen)
+        m_ScrollTargetInterpolationStart[screen] = m_ScrollTarget[screen];
+}
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          TargetDistanceScalar
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1204,6 +1236,7 @@ void SceneMan::RegisterTerrainChange(int x, int y, int w, int h, unsigned char c
 	g_NetworkServer.RegisterTerrainChange(tc);
 }
 
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          TryPenetrate
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -3408,17 +3441,24 @@ void SceneMan::Update(int screen)
 
     Vector oldOffset(m_Offset[screen]);
 
+    // When the MOs are drawn at interpolated positions, scroll towards where the scroll target was at the same point of the latest sim update,
+    // or the view would move in whole sim updates while what it's centered on moves smoothly, and that would shake on screen.
+    // Take the short way across wrapping seams, the offset is kept on the same side of them as the scroll target.
+    Vector scrollTarget = m_ScrollTarget[screen];
+    if (g_FrameMan.IsRenderInterpolationEnabled() && g_ActivityMan.IsInActivity())
+        scrollTarget += ShortestDistance(m_ScrollTargetInterpolationStart[screen], m_ScrollTarget[screen]) * (g_TimerMan.GetSimInterpolationAmount() - 1.0F);
+
     // Get the offset target, since the scroll target is centered on the target in scene units.
     Vector offsetTarget;
 	if (g_FrameMan.IsInMultiplayerMode())
 	{
-		offsetTarget.m_X = m_ScrollTarget[screen].m_X - (g_FrameMan.GetPlayerFrameBufferWidth(screen) / 2);
-		offsetTarget.m_Y = m_ScrollTarget[screen].m_Y - (g_FrameMan.GetPlayerFrameBufferHeight(screen) / 2);
+		offsetTarget.m_X = scrollTarget.m_X - (g_FrameMan.GetPlayerFrameBufferWidth(screen) / 2);
+		offsetTarget.m_Y = scrollTarget.m_Y - (g_FrameMan.GetPlayerFrameBufferHeight(screen) / 2);
 	}
 	else 
 	{
-		offsetTarget.m_X = m_ScrollTarget[screen].m_X - (g_FrameMan.GetResX() / (g_FrameMan.GetVSplit() ? 4 : 2));
-		offsetTarget.m_Y = m_ScrollTarget[screen].m_Y - (g_FrameMan.GetResY() / (g_FrameMan.GetHSplit() ? 4 : 2));
+		offsetTarget.m_X = scrollTarget.m_X - (g_FrameMan.GetResX() / (g_FrameMan.GetVSplit() ? 4 : 2));
+		offsetTarget.m_Y = scrollTarget.m_Y - (g_FrameMan.GetResY() / (g_FrameMan.GetHSplit() ? 4 : 2));
 	}
 
     // Take the occlusion of the screens into account,
@@ -3446,6 +3486,8 @@ void SceneMan::Update(int screen)
 
     pTerrain->SetOffset(m_Offset[screen]);
     pTerrain->Update();
+    // Set here rather than when drawing, since the screens may be drawn at the same time
+    pTerrain->SetToDrawMaterial(m_LayerDrawMode == g_LayerTerrainMatter);
 
     // Scroll the unexplored/unseen layer, if there is one
     if (pUnseenLayer)
@@ -3485,6 +3527,19 @@ void SceneMan::Update(int screen)
 //                  BITMAP of choice.
 
 void SceneMan::Draw(BITMAP *pTargetBitmap, BITMAP *pTargetGUIBitmap, const Vector &targetPos, bool skipSkybox, bool skipTerrain)
+{
+    DrawScreenLayers(m_LastUpdatedScreen, pTargetBitmap, skipSkybox, skipTerrain);
+    DrawScreenOverlays(m_LastUpdatedScreen, pTargetBitmap, pTargetGUIBitmap, targetPos);
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          DrawScreenLayers
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Draws the background layers, terrain and movable object colors of a
+//                  screen, as lined up by the last Update for that screen.
+
+void SceneMan::DrawScreenLayers(int screen, BITMAP *pTargetBitmap, bool skipSkybox, bool skipTerrain, bool skipMOs)
 {
     if (m_pCurrentScene == nullptr) {
         return;
@@ -3492,73 +3547,302 @@ void SceneMan::Draw(BITMAP *pTargetBitmap, BITMAP *pTargetGUIBitmap, const Vecto
     // Handy
     SLTerrain *pTerrain = m_pCurrentScene->GetTerrain();
 
-    // Learn about the unseen layer, if any
-    int team = m_ScreenTeam[m_LastUpdatedScreen];
-    SceneLayer *pUnseenLayer = team != Activity::NoTeam ? m_pCurrentScene->GetUnseenLayer(team) : 0;
+    Box targetBox = GetScreenTargetBox(pTargetBitmap);
 
-    // Set up the target box to draw to on the target bitmap, if it is larger than the scene in either dimension
-    Box targetBox(Vector(0, 0), pTargetBitmap->w, pTargetBitmap->h);
-
-    if (!pTerrain->WrapsX() && pTargetBitmap->w > GetSceneWidth())
-    {
-        targetBox.m_Corner.m_X = (pTargetBitmap->w - GetSceneWidth()) / 2;
-        targetBox.m_Width = GetSceneWidth();
-    }
-    if (!pTerrain->WrapsY() && pTargetBitmap->h > GetSceneHeight())
-    {
-        targetBox.m_Corner.m_Y = (pTargetBitmap->h - GetSceneHeight()) / 2;
-        targetBox.m_Height = GetSceneHeight();
-    }
+    // Every layer is drawn from this screen's own offset instead of the one last set on it, since other screens may be drawing the same layers at the same time
+    Vector terrainDrawOffset = GetLayerDrawOffset(pTerrain, screen);
 
     switch (m_LayerDrawMode)
     {
         case g_LayerTerrainMatter:
-            pTerrain->SetToDrawMaterial(true);
-            pTerrain->Draw(pTargetBitmap, targetBox);
+            pTerrain->Draw(pTargetBitmap, targetBox, &terrainDrawOffset);
             break;
         case g_LayerMOID:
-            m_pMOIDLayer->Draw(pTargetBitmap, targetBox);
+        {
+            Vector moidDrawOffset = GetLayerDrawOffset(m_pMOIDLayer, screen);
+            m_pMOIDLayer->Draw(pTargetBitmap, targetBox, &moidDrawOffset);
             break;
+        }
         // Draw normally
         default:
-			if (skipSkybox)
+			if (m_EnableTerrainViewCache && !skipSkybox && !skipTerrain)
 			{
-
-			} 
+				// Background layers and terrain background, from the cache kept for this screen
+				DrawTerrainView(screen, pTargetBitmap, targetBox);
+			}
 			else
 			{
-				// Background Layers
-				for (list<SceneLayer *>::reverse_iterator itr = m_pCurrentScene->GetBackLayers().rbegin(); itr != m_pCurrentScene->GetBackLayers().rend(); ++itr)
-					(*itr)->Draw(pTargetBitmap, targetBox);
+				if (!skipSkybox)
+				{
+					// Background Layers
+					for (list<SceneLayer *>::reverse_iterator itr = m_pCurrentScene->GetBackLayers().rbegin(); itr != m_pCurrentScene->GetBackLayers().rend(); ++itr)
+					{
+						Vector layerDrawOffset = GetLayerDrawOffset(*itr, screen, true);
+						(*itr)->Draw(pTargetBitmap, targetBox, &layerDrawOffset);
+					}
+				}
+
+				if (!skipTerrain)
+					// Terrain background
+					pTerrain->DrawBackground(pTargetBitmap, targetBox, &terrainDrawOffset);
 			}
-
-			if (!skipTerrain)
-				// Terrain background
-				pTerrain->DrawBackground(pTargetBitmap, targetBox);
             // Movables' color layer
-            m_pMOColorLayer->Draw(pTargetBitmap, targetBox);
+            if (!skipMOs)
+            {
+                Vector moColorDrawOffset = GetLayerDrawOffset(m_pMOColorLayer, screen);
+                m_pMOColorLayer->Draw(pTargetBitmap, targetBox, &moColorDrawOffset);
+            }
             // Terrain foreground
-            pTerrain->SetToDrawMaterial(false);
 			if (!skipTerrain)
-				pTerrain->Draw(pTargetBitmap, targetBox);
+				pTerrain->Draw(pTargetBitmap, targetBox, &terrainDrawOffset);
+    }
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          DrawScreenOverlays
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Draws the unseen layer, HUDs and GUIs of a screen over what
+//                  DrawScreenLayers drew.
+
+void SceneMan::DrawScreenOverlays(int screen, BITMAP *pTargetBitmap, BITMAP *pTargetGUIBitmap, const Vector &targetPos, float moInterpolationAmount)
+{
+    // Only drawn over the normal layers, the terrain material and MOID views are shown as they are
+    if (m_pCurrentScene == nullptr || m_LayerDrawMode == g_LayerTerrainMatter || m_LayerDrawMode == g_LayerMOID) {
+        return;
+    }
+    Box targetBox = GetScreenTargetBox(pTargetBitmap);
+
+    // Learn about the unseen layer, if any
+    int team = m_ScreenTeam[screen];
+    SceneLayer *pUnseenLayer = team != Activity::NoTeam ? m_pCurrentScene->GetUnseenLayer(team) : 0;
 
-            // Obscure unexplored/unseen areas
-            if (pUnseenLayer && !g_FrameMan.IsInMultiplayerMode())
+    // Obscure unexplored/unseen areas
+    if (pUnseenLayer && !g_FrameMan.IsInMultiplayerMode())
+    {
+        // Draw the unseen obstruction layer so it obscures the team's view
+        Vector unseenDrawOffset = GetLayerDrawOffset(pUnseenLayer, screen);
+        pUnseenLayer->DrawScaled(pTargetBitmap, targetBox, &unseenDrawOffset);
+    }
+
+    // Actor and gameplay HUDs and GUIs
+    g_MovableMan.DrawHUD(pTargetGUIBitmap, targetPos, screen, false, moInterpolationAmount);
+    g_PrimitiveMan.DrawPrimitives(screen, pTargetGUIBitmap, targetPos);
+    g_ActivityMan.GetActivity()->DrawGUI(pTargetGUIBitmap, targetPos, screen);
+
+    if (m_pDebugLayer)
+    {
+        Vector debugDrawOffset = GetLayerDrawOffset(m_pDebugLayer, screen);
+        m_pDebugLayer->Draw(pTargetBitmap, targetBox, &debugDrawOffset);
+    }
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          DrawTerrainView
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Brings the cached terrain view of a screen up to date, redrawing only
+//                  what scrolled into view or changed on the layers if possible, and then
+//                  draws it onto a bitmap.
+
+void SceneMan::DrawTerrainView(int screen, BITMAP *pTargetBitmap, Box &targetBox)
+{
+    SLTerrain *pTerrain = m_pCurrentScene->GetTerrain();
+    BITMAP *&pCacheBitmap = m_apTerrainViewCache[screen];
+    std::vector<TerrainViewLayer> &cachedLayers = m_aTerrainViewLayers[screen];
+
+    // Find out where each layer will be drawn from this frame, in the same order they're drawn in
+    std::vector<TerrainViewLayer> layers;
+    for (list<SceneLayer *>::reverse_iterator itr = m_pCurrentScene->GetBackLayers().rbegin(); itr != m_pCurrentScene->GetBackLayers().rend(); ++itr)
+    {
+        Vector drawOffset = GetLayerDrawOffset(*itr, screen, true);
+        TerrainViewLayer layer = { *itr, (*itr)->GetBitmap(), drawOffset.GetFloorIntX(), drawOffset.GetFloorIntY(), (*itr)->GetChangeCount() };
+        layers.push_back(layer);
+    }
+    Vector terrainDrawOffset = GetLayerDrawOffset(pTerrain, screen);
+    TerrainViewLayer terrainLayer = { pTerrain->GetBGColorLayer(), pTerrain->GetBGColorBitmap(), terrainDrawOffset.GetFloorIntX(), terrainDrawOffset.GetFloorIntY(), pTerrain->GetBGColorLayer()->GetChangeCount() };
+    layers.push_back(terrainLayer);
+
+    // Whether all layers are at least as large as the view, which means what they draw only depends on their offsets
+    bool layersCoverView = true;
+    for (const TerrainViewLayer &layer : layers)
+        layersCoverView = layersCoverView && layer.m_pBitmap->w >= pTargetBitmap->w && layer.m_pBitmap->h >= pTargetBitmap->h;
+
+    IntRect viewRect(targetBox.m_Corner.m_X, targetBox.m_Corner.m_Y, targetBox.m_Corner.m_X + targetBox.m_Width, targetBox.m_Corner.m_Y + targetBox.m_Height);
+    int viewWidth = viewRect.m_Right - viewRect.m_Left;
+    int viewHeight = viewRect.m_Bottom - viewRect.m_Top;
+
+    // Whether the same layers were last drawn within the same box, so how far each of them moved since tells how the camera moved
+    bool sameLayers = layers.size() == cachedLayers.size() && targetBox == m_aTerrainViewBox[screen];
+    for (size_t i = 0; i < layers.size() && sameLayers; ++i)
+        sameLayers = layers[i].m_pLayer == cachedLayers[i].m_pLayer && layers[i].m_pBitmap == cachedLayers[i].m_pBitmap;
+
+    int deltaX = 0;
+    int deltaY = 0;
+    if (sameLayers)
+    {
+        // The cached view can only be scrolled over if every layer moved by the same amount, otherwise the layers have slid past each other
+        bool layersSlid = false;
+        deltaX = layers.front().m_OffsetX - cachedLayers.front().m_OffsetX;
+        deltaY = layers.front().m_OffsetY - cachedLayers.front().m_OffsetY;
+        for (size_t i = 0; i < layers.size() && !layersSlid; ++i)
+            layersSlid = layers[i].m_OffsetX - cachedLayers[i].m_OffsetX != deltaX || layers[i].m_OffsetY - cachedLayers[i].m_OffsetY != deltaY;
+
+        // The whole view would have to be redrawn into the cache every frame the camera keeps moving like this, so draw it straight to the target instead, and only cache it again once the camera stops
+        if (layersSlid || ((deltaX != 0 || deltaY != 0) && (!layersCoverView || std::abs(deltaX) >= viewWidth || std::abs(deltaY) >= viewHeight)))
+        {
+            RedrawTerrainViewArea(pTargetBitmap, targetBox, IntRect(0, 0, pTargetBitmap->w, pTargetBitmap->h), layers);
+            cachedLayers = layers;
+            m_aTerrainViewStale[screen] = true;
+            return;
+        }
+    }
+
+    bool redrawAll = !sameLayers || m_aTerrainViewStale[screen];
+    if (!pCacheBitmap || pCacheBitmap->w != pTargetBitmap->w || pCacheBitmap->h != pTargetBitmap->h)
+    {
+        if (pCacheBitmap)
+            destroy_bitmap(pCacheBitmap);
+        pCacheBitmap = create_bitmap_ex(8, pTargetBitmap->w, pTargetBitmap->h);
+        redrawAll = true;
+    }
+
+    // Gather what changed on each layer since it went into the cached view, in view coordinates, including where it shows up across the wrapping seams
+    std::vector<IntRect> changedAreas;
+    std::vector<IntRect> layerChanges;
+    for (size_t i = 0; i < layers.size() && !redrawAll; ++i)
+    {
+        if (layers[i].m_ChangeCount == cachedLayers[i].m_ChangeCount)
+            continue;
+
+        layerChanges.clear();
+        if (!layers[i].m_pLayer->GetChangesSince(cachedLayers[i].m_ChangeCount, layerChanges) || changedAreas.size() + layerChanges.size() > MAXTERRAINVIEWCHANGES)
+        {
+            // Redrawing lots of separate areas ends up slower than just redrawing the whole view
+            redrawAll = true;
+            break;
+        }
+
+        int layerWidth = layers[i].m_pBitmap->w;
+        int layerHeight = layers[i].m_pBitmap->h;
+        bool wrapsX = layers[i].m_pLayer->WrapsX();
+        bool wrapsY = layers[i].m_pLayer->WrapsY();
+        for (const IntRect &layerChange : layerChanges)
+        {
+            for (int wrapX = wrapsX ? -1 : 0; wrapX <= (wrapsX ? 1 : 0); ++wrapX)
             {
-                // Draw the unseen obstruction layer so it obscures the team's view
-                pUnseenLayer->DrawScaled(pTargetBitmap, targetBox);
+                for (int wrapY = wrapsY ? -1 : 0; wrapY <= (wrapsY ? 1 : 0); ++wrapY)
+                {
+                    int viewX = viewRect.m_Left - layers[i].m_OffsetX + wrapX * layerWidth;
+                    int viewY = viewRect.m_Top - layers[i].m_OffsetY + wrapY * layerHeight;
+                    IntRect changedArea(layerChange.m_Left + viewX, layerChange.m_Top + viewY, layerChange.m_Right + viewX, layerChange.m_Bottom + viewY);
+                    if (changedArea.IntersectionCut(viewRect))
+                        changedAreas.push_back(changedArea);
+                }
             }
+        }
+    }
 
-            // Actor and gameplay HUDs and GUIs
-            g_MovableMan.DrawHUD(pTargetGUIBitmap, targetPos, m_LastUpdatedScreen);
-			g_PrimitiveMan.DrawPrimitives(m_LastUpdatedScreen, pTargetGUIBitmap, targetPos);
-//            g_ActivityMan.GetActivity()->Draw(pTargetBitmap, targetPos, m_LastUpdatedScreen);
-            g_ActivityMan.GetActivity()->DrawGUI(pTargetGUIBitmap, targetPos, m_LastUpdatedScreen);
+    if (redrawAll)
+        RedrawTerrainViewArea(pCacheBitmap, targetBox, IntRect(0, 0, pCacheBitmap->w, pCacheBitmap->h), layers);
+    else
+    {
+        if (deltaX != 0 || deltaY != 0)
+        {
+            // Move what is still in view over, then fill in the strips that scrolled into view
+            blit(pCacheBitmap, pCacheBitmap, viewRect.m_Left + MAX(deltaX, 0), viewRect.m_Top + MAX(deltaY, 0), viewRect.m_Left + MAX(-deltaX, 0), viewRect.m_Top + MAX(-deltaY, 0), viewWidth - std::abs(deltaX), viewHeight - std::abs(deltaY));
+            if (deltaX > 0)
+                RedrawTerrainViewArea(pCacheBitmap, targetBox, IntRect(viewRect.m_Right - deltaX, viewRect.m_Top, viewRect.m_Right, viewRect.m_Bottom), layers);
+            else if (deltaX < 0)
+                RedrawTerrainViewArea(pCacheBitmap, targetBox, IntRect(viewRect.m_Left, viewRect.m_Top, viewRect.m_Left - deltaX, viewRect.m_Bottom), layers);
+            if (deltaY > 0)
+                RedrawTerrainViewArea(pCacheBitmap, targetBox, IntRect(viewRect.m_Left, viewRect.m_Bottom - deltaY, viewRect.m_Right, viewRect.m_Bottom), layers);
+            else if (deltaY < 0)
+                RedrawTerrainViewArea(pCacheBitmap, targetBox, IntRect(viewRect.m_Left, viewRect.m_Top, viewRect.m_Right, viewRect.m_Top - deltaY), layers);
+        }
+        for (const IntRect &changedArea : changedAreas)
+            RedrawTerrainViewArea(pCacheBitmap, targetBox, changedArea, layers);
+    }
 
-//            std::snprintf(str, sizeof(str), "Normal Layer Draw Mode\nHit M to cycle modes");
+    cachedLayers = layers;
+    m_aTerrainViewBox[screen] = targetBox;
+    m_aTerrainViewStale[screen] = false;
 
-            if (m_pDebugLayer) { m_pDebugLayer->Draw(pTargetBitmap, targetBox); }
+    blit(pCacheBitmap, pTargetBitmap, 0, 0, 0, 0, pCacheBitmap->w, pCacheBitmap->h);
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          RedrawTerrainViewArea
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Redraws the background layers and the terrain background within an
+//                  area of a terrain view, cached or not.
+
+void SceneMan::RedrawTerrainViewArea(BITMAP *pTargetBitmap, Box &targetBox, const IntRect &area, const std::vector<TerrainViewLayer> &layers)
+{
+    // The layers only draw within the clipping rectangle, so limit it to the area being redrawn
+    set_clip_rect(pTargetBitmap, area.m_Left, area.m_Top, area.m_Right - 1, area.m_Bottom - 1);
+    clear_to_color(pTargetBitmap, g_FrameMan.GetBlackIndex());
+
+    int layerIndex = 0;
+    for (list<SceneLayer *>::reverse_iterator itr = m_pCurrentScene->GetBackLayers().rbegin(); itr != m_pCurrentScene->GetBackLayers().rend(); ++itr, ++layerIndex)
+    {
+        Vector layerDrawOffset(layers[layerIndex].m_OffsetX, layers[layerIndex].m_OffsetY);
+        (*itr)->Draw(pTargetBitmap, targetBox, &layerDrawOffset);
     }
+    Vector terrainDrawOffset(layers.back().m_OffsetX, layers.back().m_OffsetY);
+    m_pCurrentScene->GetTerrain()->DrawBackground(pTargetBitmap, targetBox, &terrainDrawOffset);
+
+    set_clip_rect(pTargetBitmap, 0, 0, pTargetBitmap->w - 1, pTargetBitmap->h - 1);
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetScreenTargetBox
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the box on a screen's target bitmap the scene is drawn within.
+
+Box SceneMan::GetScreenTargetBox(const BITMAP *pTargetBitmap) const
+{
+    SLTerrain *pTerrain = m_pCurrentScene->GetTerrain();
+
+    // Set up the target box to draw to on the target bitmap, if it is larger than the scene in either dimension
+    Box targetBox(Vector(0, 0), pTargetBitmap->w, pTargetBitmap->h);
+
+    if (!pTerrain->WrapsX() && pTargetBitmap->w > GetSceneWidth())
+    {
+        targetBox.m_Corner.m_X = (pTargetBitmap->w - GetSceneWidth()) / 2;
+        targetBox.m_Width = GetSceneWidth();
+    }
+    if (!pTerrain->WrapsY() && pTargetBitmap->h > GetSceneHeight())
+    {
+        targetBox.m_Corner.m_Y = (pTargetBitmap->h - GetSceneHeight()) / 2;
+        targetBox.m_Height = GetSceneHeight();
+    }
+    return targetBox;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetLayerDrawOffset
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the whole-pixel position in a layer to line up with the corner
+//                  of a screen, from that screen's own offset.
+
+Vector SceneMan::GetLayerDrawOffset(const SceneLayer *pLayer, int screen, bool backLayer) const
+{
+    Vector offset = m_Offset[screen];
+    if (backLayer)
+    {
+        // Same as the unwrapped offset Update gives the background layers
+        const BITMAP *pTerrainBitmap = m_pCurrentScene->GetTerrain()->GetBitmap();
+        offset.m_X += pTerrainBitmap->w * m_SeamCrossCount[screen][X];
+        offset.m_Y += pTerrainBitmap->h * m_SeamCrossCount[screen][Y];
+    }
+    int offsetX;
+    int offsetY;
+    pLayer->GetDrawOffset(offset, offsetX, offsetY);
+    return Vector(offsetX, offsetY);
 }
 
 
@@ -3572,6 +3856,40 @@ void SceneMan::ClearMOColorLayer()
     clear_to_color(m_pMOColorLayer->GetBitmap(), g_MaskColor);
 
     if (m_pDebugLayer) { clear_to_color(m_pDebugLayer->GetBitmap(), g_MaskColor); }
+
+    m_MOTrailPixels.clear();
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          DrawMOTrailPixel
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Draws a pixel of an Atom's trail on the color MO layer, and remembers
+//                  it so it can be drawn again if the MOs get redrawn before the layer is
+//                  next cleared.
+
+void SceneMan::DrawMOTrailPixel(int pixelX, int pixelY, int color)
+{
+    putpixel(m_pMOColorLayer->GetBitmap(), pixelX, pixelY, color);
+    m_MOTrailPixels.push_back({ pixelX, pixelY, color });
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          RedrawMOColorLayerTrails
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Clears the color MO layer and draws back all the trail pixels that
+//                  were drawn on it since it was last cleared with ClearMOColorLayer, so
+//                  the MOs themselves can be drawn again at different positions.
+
+void SceneMan::RedrawMOColorLayerTrails()
+{
+    BITMAP *pMOColorBitmap = m_pMOColorLayer->GetBitmap();
+    clear_to_color(pMOColorBitmap, g_MaskColor);
+
+    for (const MOTrailPixel &trailPixel : m_MOTrailPixels) {
+        putpixel(pMOColorBitmap, trailPixel.X, trailPixel.Y, trailPixel.Color);
+    }
 }
 
 
@@ -61,6 +61,7 @@ enum
 #define SCENEGRIDSIZE 24
 #define SCENESNAPSIZE 12
 #define MAXORPHANRADIUS 11
+#define MAXTERRAINVIEWCHANGES 64
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Struct:          IntRect
@@ -679,6 +680,20 @@ public:
 	const Vector & GetScrollTarget(int screen = 0) const;
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          SaveScrollTargetInterpolationStarts
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Has every screen remember its current scroll target as where scrolling
+//                  is interpolated from over the coming sim update, so the view follows
+//                  what it's centered on at the same interpolated position the MOs are
+//                  drawn at. Done at the start of every sim update when render
+//                  interpolation is enabled.
+// Arguments:       None.
+// Return value:    None.
+
+    void SaveScrollTargetInterpolationStarts();
+
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          TargetDistanceScalar
@@ -1594,6 +1609,43 @@ public:
     void Draw(BITMAP *pTargetBitmap, BITMAP *pTargetGUIBitmap,  const Vector &targetPos = Vector(), bool skipSkybox = false, bool skipTerrain = false);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          DrawScreenLayers
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Draws the background layers, terrain and movable object colors of a
+//                  screen, as lined up by the last Update for that screen. This only
+//                  touches state belonging to that screen, so different screens can be
+//                  drawn at the same time on different threads.
+// Arguments:       Which screen to draw.
+//                  A pointer to a BITMAP to draw on, appropriately sized for the split
+//                  screen segment.
+//                  Whether to skip drawing the background layers.
+//                  Whether to skip drawing the terrain.
+//                  Whether to skip drawing the movable objects.
+// Return value:    None.
+
+    void DrawScreenLayers(int screen, BITMAP *pTargetBitmap, bool skipSkybox = false, bool skipTerrain = false, bool skipMOs = false);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          DrawScreenOverlays
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Draws the unseen layer, HUDs and GUIs of a screen over what
+//                  DrawScreenLayers drew. These use state shared between the screens,
+//                  so this must be done on the main thread.
+// Arguments:       Which screen to draw.
+//                  A pointer to a BITMAP to draw on, appropriately sized for the split
+//                  screen segment.
+//                  A pointer to a BITMAP to draw the HUDs and GUIs on.
+//                  The offset into the scene where the target bitmap's upper left corner
+//                  is located.
+//                  How far between their positions at the start of the latest sim update
+//                  and their current ones to draw the HUDs of MOs, 1 being their current ones.
+// Return value:    None.
+
+    void DrawScreenOverlays(int screen, BITMAP *pTargetBitmap, BITMAP *pTargetGUIBitmap, const Vector &targetPos, float moInterpolationAmount = 1.0F);
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          ClearMOColorLayer
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1604,6 +1656,31 @@ public:
     void ClearMOColorLayer();
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          DrawMOTrailPixel
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Draws a pixel of an Atom's trail on the color MO layer, and remembers
+//                  it so it can be drawn again if the MOs get redrawn before the layer is
+//                  next cleared.
+// Arguments:       The scene coordinates of the pixel.
+//                  The palette index of the color to draw the pixel with.
+// Return value:    None.
+
+    void DrawMOTrailPixel(int pixelX, int pixelY, int color);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          RedrawMOColorLayerTrails
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Clears the color MO layer and draws back all the trail pixels that
+//                  were drawn on it since it was last cleared with ClearMOColorLayer, so
+//                  the MOs themselves can be drawn again at different positions.
+// Arguments:       None.
+// Return value:    None.
+
+    void RedrawMOColorLayerTrails();
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          ClearMOIDLayer
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1682,6 +1759,10 @@ public:
     Scene *m_pCurrentScene;
     // Color MO layer
     SceneLayer *m_pMOColorLayer;
+    // Pixel of an Atom trail drawn on the color MO layer
+    struct MOTrailPixel { int X; int Y; int Color; };
+    // All the trail pixels drawn on the color MO layer since it was last cleared
+    std::vector<MOTrailPixel> m_MOTrailPixels;
     // MovableObject ID layer
     SceneLayer *m_pMOIDLayer;
     // All the areas drawn within on the MOID layer since last Update
@@ -1710,6 +1791,8 @@ public:
     Vector m_DeltaOffset[c_MaxScreenCount];
     // The final offset target of the current scroll interpolation, in scene coordinates!
     Vector m_ScrollTarget[c_MaxScreenCount];
+    // The scroll target at the start of the latest sim update, which scrolling is interpolated from when render interpolation is enabled
+    Vector m_ScrollTargetInterpolationStart[c_MaxScreenCount];
     // The team associated with each screen.
     int m_ScreenTeam[c_MaxScreenCount];
     // The amount screen a screen is occluded or covered by GUI, etc
@@ -1748,6 +1831,28 @@ public:
 	// Bitmap to look for orphaned regions
 	BITMAP * m_pOrphanSearchBitmap;
 
+    // A layer that went into a cached terrain view, and the position in it that was lined up with the corner of the view
+    struct TerrainViewLayer
+    {
+        const SceneLayer *m_pLayer;
+        const BITMAP *m_pBitmap;
+        int m_OffsetX;
+        int m_OffsetY;
+        // The change count of the layer when it went into the view, to redraw what changed on it since
+        unsigned long m_ChangeCount;
+    };
+
+    // Whether to keep the background layers and terrain background of each screen composited in a cache, and only redraw the parts that scrolled into view or changed
+    bool m_EnableTerrainViewCache;
+    // The cached composited background layers and terrain background of each screen. Owned here
+    BITMAP *m_apTerrainViewCache[c_MaxScreenCount];
+    // The layers each screen's cached view was last drawn with, in drawing order, the terrain background last
+    std::vector<TerrainViewLayer> m_aTerrainViewLayers[c_MaxScreenCount];
+    // The target box each screen's cached view was last drawn within
+    Box m_aTerrainViewBox[c_MaxScreenCount];
+    // Whether each screen's view was last drawn straight to its target because the camera moved, so the cache has to be redrawn whole before it's used again
+    bool m_aTerrainViewStale[c_MaxScreenCount];
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Private member variable and method declarations
@@ -1756,6 +1861,62 @@ private:
 
 	static const std::string c_ClassName; //!< A string with the friendly-formatted type name of this object.
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          DrawTerrainView
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Brings the cached terrain view of a screen up to date, redrawing only
+//                  what scrolled into view or changed on the layers if possible, and then
+//                  draws it onto a bitmap. While the camera moves in a way the cached view
+//                  can't be scrolled for, like parallax layers sliding past each other,
+//                  the layers are drawn straight onto the bitmap instead.
+// Arguments:       Which screen to draw the terrain view of.
+//                  The bitmap to draw to.
+//                  The box on the target bitmap to limit drawing the layers to.
+// Return value:    None.
+
+    void DrawTerrainView(int screen, BITMAP *pTargetBitmap, Box &targetBox);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          RedrawTerrainViewArea
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Redraws the background layers and the terrain background within an
+//                  area of a terrain view, cached or not.
+// Arguments:       The bitmap to redraw on.
+//                  The box on the bitmap to limit drawing the layers to.
+//                  The area of the bitmap to redraw, right and bottom exclusive.
+//                  The layers to draw, in drawing order, the terrain background last.
+// Return value:    None.
+
+    void RedrawTerrainViewArea(BITMAP *pTargetBitmap, Box &targetBox, const IntRect &area, const std::vector<TerrainViewLayer> &layers);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetScreenTargetBox
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the box on a screen's target bitmap the scene is drawn within,
+//                  which is centered and smaller than the bitmap in any non-wrapping
+//                  dimension the scene is smaller than it in.
+// Arguments:       The bitmap the screen is drawn to.
+// Return value:    The box on the bitmap to draw the scene within.
+
+    Box GetScreenTargetBox(const BITMAP *pTargetBitmap) const;
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetLayerDrawOffset
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the whole-pixel position in a layer to line up with the corner
+//                  of a screen, from that screen's own offset rather than the one last
+//                  set on the layer.
+// Arguments:       The layer to get the draw offset in.
+//                  Which screen to get the draw offset for.
+//                  Whether the layer is a background layer, which gets the total offset
+//                  without taking any wrappings into account.
+// Return value:    The draw offset, to be passed to the layer's Draw as scroll override.
+
+    Vector GetLayerDrawOffset(const SceneLayer *pLayer, int screen, bool backLayer = false) const;
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          Clear
 //////////////////////////////////////////////////////////////////////////////////////////
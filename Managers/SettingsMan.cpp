@@ -5,6 +5,8 @@
 #include "PostProcessMan.h"
 #include "AudioMan.h"
 #include "PerformanceMan.h"
+#include "ThreadMan.h"
+#include "RotatedSpriteCache.h"
 #include "UInputMan.h"
 #include "NetworkClient.h"
 #include "NetworkServer.h"
@@ -42,6 +44,7 @@ namespace RTE {
 
 		m_RecommendedMOIDCount = 240;
 		m_SimplifiedCollisionDetection = false;
+		m_EnableSceneLayerCache = false;
 
 		m_SkipIntro = false;
 		m_ShowToolTips = true;
@@ -171,6 +174,18 @@ namespace RTE {
 			reader >> m_RecommendedMOIDCount;
 		} else if (propName == "SimplifiedCollisionDetection") {
 			reader >> m_SimplifiedCollisionDetection;
+		} else if (propName == "EnableSceneLayerCache") {
+			reader >> m_EnableSceneLayerCache;
+		} else if (propName == "WorkerThreadCount") {
+			reader >> g_ThreadMan.m_RequestedWorkerThreadCount;
+		} else if (propName == "RotatedSpriteCacheSize") {
+			RotatedSpriteCache::SetMemoryBudgetMB(std::stoi(reader.ReadPropValue()));
+		} else if (propName == "EnableTerrainViewCache") {
+			reader >> g_SceneMan.m_EnableTerrainViewCache;
+		} else if (propName == "EnableParallelScreenDrawing") {
+			reader >> g_FrameMan.m_ParallelScreenDrawing;
+		} else if (propName == "EnableRenderInterpolation") {
+			reader >> g_FrameMan.m_RenderInterpolation;
 		} else if (propName == "EnableParticleSettling") {
 			reader >> g_MovableMan.m_SettlingEnabled;
 		} else if (propName == "EnableMOSubtraction") {
@@ -231,12 +246,24 @@ namespace RTE {
 			reader >> m_UseExperimentalMultiplayerSpeedBoosts;
 		} else if (propName == "ClientInputFps") {
 			reader >> g_NetworkClient.m_ClientInputFps;
+		} else if (propName == "ClientPredictLocalInput") {
+			reader >> g_NetworkClient.m_PredictLocalInput;
 		} else if (propName == "ServerTransmitAsBoxes") {
 			reader >> g_NetworkServer.m_TransmitAsBoxes;
 		} else if (propName == "ServerBoxWidth") {
 			reader >> g_NetworkServer.m_BoxWidth;
 		} else if (propName == "ServerBoxHeight") {
 			reader >> g_NetworkServer.m_BoxHeight;
+		} else if (propName == "ServerUseDeltaCompression") {
+			reader >> g_NetworkServer.m_UseDeltaCompression;
+		} else if (propName == "ServerUseFrameBoxPrediction") {
+			reader >> g_NetworkServer.m_UseFrameBoxPrediction;
+		} else if (propName == "ServerTerrainChangeBytesPerFrame") {
+			reader >> g_NetworkServer.m_TerrainChangeBytesPerFrame;
+		} else if (propName == "ServerUseEntityReplication") {
+			reader >> g_NetworkServer.m_UseEntityReplication;
+		} else if (propName == "ServerEntityStateBytesPerFrame") {
+			reader >> g_NetworkServer.m_EntityStateBytesPerFrame;
 		} else if (propName == "ServerUseHighCompression") {
 			reader >> g_NetworkServer.m_UseHighCompression;
 		} else if (propName == "ServerUseFastCompression") {
@@ -249,10 +276,16 @@ namespace RTE {
 			reader >> g_NetworkServer.m_UseInterlacing;
 		} else if (propName == "ServerEncodingFps") {
 			reader >> g_NetworkServer.m_EncodingFps;
+		} else if (propName == "ServerUseAdaptiveEncoding") {
+			reader >> g_NetworkServer.m_UseAdaptiveEncoding;
+		} else if (propName == "ServerAdaptiveTargetLatency") {
+			reader >> g_NetworkServer.m_AdaptiveTargetLatency;
 		} else if (propName == "ServerSleepWhenIdle") {
 			reader >> g_NetworkServer.m_SleepWhenIdle;
 		} else if (propName == "ServerSimSleepWhenIdle") {
 			reader >> g_NetworkServer.m_SimSleepWhenIdle;
+		} else if (propName == "ServerStatsLogFile") {
+			reader >> g_NetworkServer.m_StatsLogPath;
 		} else if (propName == "VisibleAssemblyGroup") {
 			m_VisibleAssemblyGroupsList.push_back(reader.ReadPropValue());
 		} else if (propName == "DisableMod") {
@@ -345,6 +378,12 @@ namespace RTE {
 		writer.NewPropertyWithValue("DisableLuaJIT", g_LuaMan.m_DisableLuaJIT);
 		writer.NewPropertyWithValue("RecommendedMOIDCount", m_RecommendedMOIDCount);
 		writer.NewPropertyWithValue("SimplifiedCollisionDetection", m_SimplifiedCollisionDetection);
+		writer.NewPropertyWithValue("EnableSceneLayerCache", m_EnableSceneLayerCache);
+		writer.NewPropertyWithValue("WorkerThreadCount", g_ThreadMan.m_RequestedWorkerThreadCount);
+		writer.NewPropertyWithValue("RotatedSpriteCacheSize", RotatedSpriteCache::GetMemoryBudgetMB());
+		writer.NewPropertyWithValue("EnableTerrainViewCache", g_SceneMan.m_EnableTerrainViewCache);
+		writer.NewPropertyWithValue("EnableParallelScreenDrawing", g_FrameMan.m_ParallelScreenDrawing);
+		writer.NewPropertyWithValue("EnableRenderInterpolation", g_FrameMan.m_RenderInterpolation);
 		writer.NewPropertyWithValue("EnableParticleSettling", g_MovableMan.m_SettlingEnabled);
 		writer.NewPropertyWithValue("EnableMOSubtraction", g_MovableMan.m_MOSubtractionEnabled);
 		writer.NewPropertyWithValue("DeltaTime", g_TimerMan.GetDeltaTimeSecs());
@@ -400,17 +439,26 @@ namespace RTE {
 		writer.NewLineString("// Advanced Network Settings", false);
 		writer.NewLine(false);
 		writer.NewPropertyWithValue("ClientInputFps", g_NetworkClient.m_ClientInputFps);
+		writer.NewPropertyWithValue("ClientPredictLocalInput", g_NetworkClient.m_PredictLocalInput);
 		writer.NewPropertyWithValue("ServerTransmitAsBoxes", g_NetworkServer.m_TransmitAsBoxes);
 		writer.NewPropertyWithValue("ServerBoxWidth", g_NetworkServer.m_BoxWidth);
 		writer.NewPropertyWithValue("ServerBoxHeight", g_NetworkServer.m_BoxHeight);
+		writer.NewPropertyWithValue("ServerUseDeltaCompression", g_NetworkServer.m_UseDeltaCompression);
+		writer.NewPropertyWithValue("ServerUseFrameBoxPrediction", g_NetworkServer.m_UseFrameBoxPrediction);
+		writer.NewPropertyWithValue("ServerTerrainChangeBytesPerFrame", g_NetworkServer.m_TerrainChangeBytesPerFrame);
+		writer.NewPropertyWithValue("ServerUseEntityReplication", g_NetworkServer.m_UseEntityReplication);
+		writer.NewPropertyWithValue("ServerEntityStateBytesPerFrame", g_NetworkServer.m_EntityStateBytesPerFrame);
 		writer.NewPropertyWithValue("ServerUseHighCompression", g_NetworkServer.m_UseHighCompression);
 		writer.NewPropertyWithValue("ServerUseFastCompression", g_NetworkServer.m_UseFastCompression);
 		writer.NewPropertyWithValue("ServerHighCompressionLevel", g_NetworkServer.m_HighCompressionLevel);
 		writer.NewPropertyWithValue("ServerFastAccelerationFactor", g_NetworkServer.m_FastAccelerationFactor);
 		writer.NewPropertyWithValue("ServerUseInterlacing", g_NetworkServer.m_UseInterlacing);
 		writer.NewPropertyWithValue("ServerEncodingFps", g_NetworkServer.m_EncodingFps);
+		writer.NewPropertyWithValue("ServerUseAdaptiveEncoding", g_NetworkServer.m_UseAdaptiveEncoding);
+		writer.NewPropertyWithValue("ServerAdaptiveTargetLatency", g_NetworkServer.m_AdaptiveTargetLatency);
 		writer.NewPropertyWithValue("ServerSleepWhenIdle", g_NetworkServer.m_SleepWhenIdle);
 		writer.NewPropertyWithValue("ServerSimSleepWhenIdle", g_NetworkServer.m_SimSleepWhenIdle);
+		if (!g_NetworkServer.m_StatsLogPath.empty()) { writer.NewPropertyWithValue("ServerStatsLogFile", g_NetworkServer.m_StatsLogPath); }
 
 		if (!m_VisibleAssemblyGroupsList.empty()) {
 			writer.NewLine(false, 2);
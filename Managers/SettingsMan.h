@@ -68,6 +68,18 @@ namespace RTE {
 		/// </summary>
 		/// <returns>Whether simplified collision detection is enabled or not.</returns>
 		bool SimplifiedCollisionDetection() const { return m_SimplifiedCollisionDetection; }
+
+		/// <summary>
+		/// Gets whether fully processed terrain layers are cached to disk so repeat loads of the same Scene can skip decoding and post-processing.
+		/// </summary>
+		/// <returns>Whether the scene layer cache is enabled or not.</returns>
+		bool SceneLayerCacheEnabled() const { return m_EnableSceneLayerCache; }
+
+		/// <summary>
+		/// Sets whether fully processed terrain layers are cached to disk so repeat loads of the same Scene can skip decoding and post-processing.
+		/// </summary>
+		/// <param name="enable">Whether to enable the scene layer cache or not.</param>
+		void SetSceneLayerCacheEnabled(bool enable) { m_EnableSceneLayerCache = enable; }
 #pragma endregion
 
 #pragma region Gameplay Settings
@@ -457,6 +469,7 @@ namespace RTE {
 
 		int m_RecommendedMOIDCount; //!< Recommended max MOID's before removing actors from scenes.
 		bool m_SimplifiedCollisionDetection; //!< Whether simplified collision detection (reduced MOID layer sampling) is enabled.
+		bool m_EnableSceneLayerCache; //!< Whether fully processed terrain layers are cached to disk to speed up repeat loads of the same Scene.
 
 		bool m_SkipIntro; //!< Whether to play the intro of the game or skip directly to the main menu.
 		bool m_ShowToolTips; //!< Whether ToolTips are enabled or not.
@@ -1,62 +1,170 @@
-//////////////////////////////////////////////////////////////////////////////////////////
-// File:            ThreadMan.cpp
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Source file for the ThreadMan class.
-// Project:         Retro Terrain Engine
-// Author(s):       
-//                  
-//                  
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Inclusions of header files
-
-
 #include "ThreadMan.h"
 
-using namespace std;
-
-namespace RTE
-{
-
-#define DELTABUFFERSIZE 30
-
-const string ThreadMan::m_ClassName = "ThreadMan";
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Method:          Clear
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Clears all the member variables of this ThreadMan, effectively
-//                  resetting the members of this abstraction level only.
-
-void ThreadMan::Clear()
-{
-}
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Method:          Create
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Makes the ThreadMan object ready for use.
-
-int ThreadMan::Create()
-{
-
-	return 0;
+namespace RTE {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ThreadMan::Clear() {
+		m_RequestedWorkerThreadCount = 0;
+		m_WorkerThreads.clear();
+		m_QueuedTasks.clear();
+		m_BusyWorkerCount = 0;
+		m_StopWorkers = false;
+		m_CompletionCallbacks.clear();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int ThreadMan::Initialize() {
+		int workerThreadCount = m_RequestedWorkerThreadCount;
+		if (workerThreadCount <= 0) {
+			// Leave one hardware thread for the main thread. hardware_concurrency may report 0 if it can't be determined.
+			workerThreadCount = std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 1);
+		}
+		m_StopWorkers = false;
+		m_WorkerThreads.reserve(workerThreadCount);
+		for (int i = 0; i < workerThreadCount; ++i) {
+			m_WorkerThreads.emplace_back(&ThreadMan::WorkerThreadLoop, this);
+		}
+		return 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ThreadMan::Destroy() {
+		if (!m_WorkerThreads.empty()) {
+			{
+				std::lock_guard<std::mutex> queueLock(m_QueuedTasksMutex);
+				m_StopWorkers = true;
+			}
+			m_TaskQueuedCondition.notify_all();
+			for (std::thread &workerThread : m_WorkerThreads) {
+				workerThread.join();
+			}
+			m_WorkerThreads.clear();
+		}
+		Update();
+		Clear();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::future<void> ThreadMan::QueueTask(const std::function<void()> &task, const std::function<void()> &onComplete) {
+		std::shared_ptr<std::packaged_task<void()>> packagedTask = std::make_shared<std::packaged_task<void()>>([this, task, onComplete]() {
+			task();
+			if (onComplete) {
+				std::lock_guard<std::mutex> callbacksLock(m_CompletionCallbacksMutex);
+				m_CompletionCallbacks.emplace_back(onComplete);
+			}
+		});
+		std::future<void> taskFuture = packagedTask->get_future();
+
+		if (m_WorkerThreads.empty()) {
+			(*packagedTask)();
+		} else {
+			{
+				std::lock_guard<std::mutex> queueLock(m_QueuedTasksMutex);
+				m_QueuedTasks.emplace_back([packagedTask]() { (*packagedTask)(); });
+			}
+			m_TaskQueuedCondition.notify_one();
+		}
+		return taskFuture;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ThreadMan::ParallelFor(int begin, int end, int chunkSize, const std::function<void(int, int)> &function) {
+		if (begin >= end) {
+			return;
+		}
+		chunkSize = std::max(chunkSize, 1);
+		int chunkCount = (end - begin + chunkSize - 1) / chunkSize;
+		if (m_WorkerThreads.empty() || chunkCount == 1) {
+			function(begin, end);
+			return;
+		}
+
+		struct ParallelForState {
+			std::atomic<int> NextChunk = 0;
+			std::atomic<int> FinishedChunks = 0;
+			std::mutex FinishedChunksMutex;
+			std::condition_variable AllChunksFinishedCondition;
+		};
+		std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>();
+
+		// Helpers that only get to start after all chunks were taken return without touching the function, so capturing it by reference is safe even though they may outlive this call.
+		auto runChunks = [state, &function, begin, end, chunkSize, chunkCount]() {
+			for (int chunk = state->NextChunk++; chunk < chunkCount; chunk = state->NextChunk++) {
+				int chunkBegin = begin + chunk * chunkSize;
+				function(chunkBegin, std::min(chunkBegin + chunkSize, end));
+				if (++state->FinishedChunks == chunkCount) {
+					std::lock_guard<std::mutex> finishedLock(state->FinishedChunksMutex);
+					state->AllChunksFinishedCondition.notify_all();
+				}
+			}
+		};
+
+		int helperCount = std::min(chunkCount - 1, GetWorkerThreadCount());
+		{
+			std::lock_guard<std::mutex> queueLock(m_QueuedTasksMutex);
+			for (int helper = 0; helper < helperCount; ++helper) {
+				m_QueuedTasks.emplace_back(runChunks);
+			}
+		}
+		m_TaskQueuedCondition.notify_all();
+
+		// The calling thread does its share too, which also means this can't deadlock when called from a worker thread while all the others are busy.
+		runChunks();
+
+		std::unique_lock<std::mutex> finishedLock(state->FinishedChunksMutex);
+		state->AllChunksFinishedCondition.wait(finishedLock, [&state, chunkCount]() { return state->FinishedChunks == chunkCount; });
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ThreadMan::WaitForAllTasks() {
+		{
+			std::unique_lock<std::mutex> queueLock(m_QueuedTasksMutex);
+			m_AllTasksDoneCondition.wait(queueLock, [this]() { return m_QueuedTasks.empty() && m_BusyWorkerCount == 0; });
+		}
+		Update();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ThreadMan::Update() {
+		std::vector<std::function<void()>> completionCallbacks;
+		{
+			std::lock_guard<std::mutex> callbacksLock(m_CompletionCallbacksMutex);
+			completionCallbacks.swap(m_CompletionCallbacks);
+		}
+		for (const std::function<void()> &completionCallback : completionCallbacks) {
+			completionCallback();
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ThreadMan::WorkerThreadLoop() {
+		while (true) {
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> queueLock(m_QueuedTasksMutex);
+				m_TaskQueuedCondition.wait(queueLock, [this]() { return m_StopWorkers || !m_QueuedTasks.empty(); });
+				// Finish off whatever is still queued before stopping so nothing that was promised to be saved or sent gets dropped.
+				if (m_QueuedTasks.empty()) {
+					return;
+				}
+				task = std::move(m_QueuedTasks.front());
+				m_QueuedTasks.pop_front();
+				m_BusyWorkerCount++;
+			}
+			task();
+			{
+				std::lock_guard<std::mutex> queueLock(m_QueuedTasksMutex);
+				m_BusyWorkerCount--;
+				if (m_QueuedTasks.empty() && m_BusyWorkerCount == 0) { m_AllTasksDoneCondition.notify_all(); }
+			}
+		}
+	}
 }
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Method:          Destroy
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Destroys and resets (through Clear()) the ThreadMan object.
-
-void ThreadMan::Destroy()
-{
-
-
-    Clear();
-}
-
-} // namespace RTE
\ No newline at end of file
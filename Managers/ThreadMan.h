@@ -1,141 +1,113 @@
-#ifndef _RTEThreadMan_
-#define _RTEThreadMan_
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// File:            ThreadMan.h
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Header file for the ThreadMan class.
-// Project:         Retro Terrain Engine
-// Author(s):       
-//                  
-//                  
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Inclusions of header files
-
-#include "global_types.h"
-
-
-//#include <boost/thread.hpp>
+#ifndef _RTETHREADMAN_
+#define _RTETHREADMAN_
 
 #include "Singleton.h"
-#define g_ThreadMan ThreadMan::Instance()
-
-namespace RTE
-{
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Class:           ThreadMan
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     The centralized singleton manager of all threads.
-// Parent(s):       Singleton
-// Class history:   03/29/2014  ThreadMan created.
-
-
-class ThreadMan:
-    public Singleton<ThreadMan>
-{
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Public member variable, method and friend function declarations
-
-public:
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Constructor:     ThreadMan
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Constructor method used to instantiate a ThreadMan object in system
-//                  memory. Create() should be called before using the object.
-// Arguments:       None.
-
-    ThreadMan() { Clear(); Create(); }
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Destructor:      ~ThreadMan
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Destructor method used to clean up a ThreadMan object before deletion
-//                  from system memory.
-// Arguments:       None.
-
-    virtual ~ThreadMan() { Destroy(); }
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Method:          Create
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Makes the ThreadMan object ready for use.
-// Arguments:       None.
-// Return value:    An error return value signaling sucess or any particular failure.
-//                  Anything below 0 is an error signal.
 
-    virtual int Create();
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Virtual method:  Reset
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Resets the entire ThreadMan, including its inherited members, to
-//                  their default settings or values.
-// Arguments:       None.
-// Return value:    None.
-
-    virtual void Reset() { Clear(); }
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Method:          Destroy
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Destroys and resets (through Clear()) the ThreadMan object.
-// Arguments:       None.
-// Return value:    None.
-
-    void Destroy();
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Virtual method:  GetClassName
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Gets the class name of this Entity.
-// Arguments:       None.
-// Return value:    A string with the friendly-formatted type name of this object.
-
-    virtual const std::string & GetClassName() const { return m_ClassName; }
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Protected member variable and method declarations
-
-protected:
-
-    // Member variables
-    static const std::string m_ClassName;
-
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Private member variable and method declarations
-
-private:
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Method:          Clear
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Clears all the member variables of this ThreadMan, effectively
-//                  resetting the members of this abstraction level only.
-// Arguments:       None.
-// Return value:    None.
-
-    void Clear();
-
-    // Disallow the use of some implicit methods.
-    ThreadMan(const ThreadMan &reference);
-    ThreadMan & operator=(const ThreadMan &rhs);
-
-};
-
-} // namespace RTE
+#define g_ThreadMan ThreadMan::Instance()
 
-#endif // File
+namespace RTE {
+
+	/// <summary>
+	/// The centralized singleton manager of the worker thread pool used to offload work from the main thread.
+	/// </summary>
+	class ThreadMan : public Singleton<ThreadMan> {
+		friend class SettingsMan;
+
+	public:
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate a ThreadMan object in system memory. Initialize() should be called before using the object.
+		/// </summary>
+		ThreadMan() { Clear(); }
+
+		/// <summary>
+		/// Makes the ThreadMan object ready for use by starting up the worker threads.
+		/// </summary>
+		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
+		int Initialize();
+#pragma endregion
+
+#pragma region Destruction
+		/// <summary>
+		/// Destructor method used to clean up a ThreadMan object before deletion from system memory.
+		/// </summary>
+		~ThreadMan() { Destroy(); }
+
+		/// <summary>
+		/// Finishes all queued tasks, joins the worker threads and resets (through Clear()) the ThreadMan object.
+		/// </summary>
+		void Destroy();
+#pragma endregion
+
+#pragma region Getters and Setters
+		/// <summary>
+		/// Gets the number of worker threads in the pool.
+		/// </summary>
+		/// <returns>The number of worker threads in the pool.</returns>
+		int GetWorkerThreadCount() const { return static_cast<int>(m_WorkerThreads.size()); }
+#pragma endregion
+
+#pragma region Concrete Methods
+		/// <summary>
+		/// Queues a task to be run on one of the worker threads. If the pool isn't running the task is run immediately on the calling thread.
+		/// </summary>
+		/// <param name="task">The task to run. Must not touch anything the main thread may be modifying while it runs.</param>
+		/// <param name="onComplete">Optional callback that is run on the main thread during Update() after the task is finished.</param>
+		/// <returns>A future that becomes ready when the task is finished.</returns>
+		std::future<void> QueueTask(const std::function<void()> &task, const std::function<void()> &onComplete = nullptr);
+
+		/// <summary>
+		/// Splits a range into chunks and runs a function on each of them in parallel on the worker threads and the calling thread. Returns once all chunks are done.
+		/// The chunks may be run in any order and on any thread, so the function must only touch data that no other chunk touches, and must not use the RNG.
+		/// </summary>
+		/// <param name="begin">The start of the range.</param>
+		/// <param name="end">The end of the range, exclusive.</param>
+		/// <param name="chunkSize">The size of each chunk. Ranges that fit in a single chunk are run directly on the calling thread.</param>
+		/// <param name="function">The function to run on each chunk, taking the start and the exclusive end of the chunk.</param>
+		void ParallelFor(int begin, int end, int chunkSize, const std::function<void(int, int)> &function);
+
+		/// <summary>
+		/// Blocks until all queued tasks are finished, then runs any pending completion callbacks. Must be called from the main thread.
+		/// </summary>
+		void WaitForAllTasks();
+
+		/// <summary>
+		/// Runs the completion callbacks of all tasks that finished since the last update. Must be called from the main thread.
+		/// </summary>
+		void Update();
+#pragma endregion
+
+	protected:
+
+		int m_RequestedWorkerThreadCount; //!< The number of worker threads to start, as set in the settings. 0 or less means one less than the number of hardware threads.
+
+		std::vector<std::thread> m_WorkerThreads; //!< The worker threads of the pool.
+		std::deque<std::function<void()>> m_QueuedTasks; //!< Tasks waiting for a free worker thread.
+		std::mutex m_QueuedTasksMutex; //!< Mutex guarding the task queue and the busy worker count.
+		std::condition_variable m_TaskQueuedCondition; //!< Signaled when a task is queued or the workers should shut down.
+		std::condition_variable m_AllTasksDoneCondition; //!< Signaled when the task queue is empty and no worker is busy.
+		int m_BusyWorkerCount; //!< The number of workers currently running a task.
+		bool m_StopWorkers; //!< Whether the workers should exit once the task queue is empty.
+
+		std::vector<std::function<void()>> m_CompletionCallbacks; //!< Completion callbacks of finished tasks, waiting to be run on the main thread.
+		std::mutex m_CompletionCallbacksMutex; //!< Mutex guarding the completion callback list.
+
+	private:
+
+		/// <summary>
+		/// The loop each worker thread runs, taking and running tasks from the queue until the pool is stopped.
+		/// </summary>
+		void WorkerThreadLoop();
+
+		/// <summary>
+		/// Clears all the member variables of this ThreadMan, effectively resetting the members of this abstraction level only.
+		/// </summary>
+		void Clear();
+
+		// Disallow the use of some implicit methods.
+		ThreadMan(const ThreadMan &reference) = delete;
+		ThreadMan & operator=(const ThreadMan &rhs) = delete;
+	};
+}
+#endif
@@ -71,6 +71,12 @@ namespace RTE {
 		/// <returns>Whether this is the last sim update before a frame with its results will appear.</returns>
 		bool DrawnSimUpdate() const { return m_DrawnSimUpdate; }
 
+		/// <summary>
+		/// Gets how far along the real time is from the latest sim update towards the next one, as a fraction of the delta time. Drawing can use this to interpolate between the states before and after the latest sim update.
+		/// </summary>
+		/// <returns>The fraction of the delta time left over in the sim accumulator, from 0 to 1. Always 1 when forcing one sim update per frame, since nothing is left over then.</returns>
+		float GetSimInterpolationAmount() const { return (m_OneSimUpdatePerFrame || m_DeltaTime <= 0) ? 1.0F : std::clamp(static_cast<float>(m_SimAccumulator) / static_cast<float>(m_DeltaTime), 0.0F, 1.0F); }
+
 		/// <summary>
 		/// Tells how many sim updates have been performed since the last one that ended up being a drawn frame.
 		/// If negative, it means no sim updates have happened, and a same frame will be drawn again.
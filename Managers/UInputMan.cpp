@@ -849,9 +849,8 @@ namespace RTE {
 	void UInputMan::UpdateNetworkMouseMovement() {
 		for (int player = Players::PlayerOne; player < Players::MaxPlayerCount; player++) {
 			if (!m_NetworkAccumulatedRawMouseMovement[player].IsZero()) {
-				// TODO: Figure out why we're multiplying by 3 here. Possibly related to mouse sensitivity.
-				m_NetworkAnalogMoveData[player].m_X += m_NetworkAccumulatedRawMouseMovement[player].m_X * 3;
-				m_NetworkAnalogMoveData[player].m_Y += m_NetworkAccumulatedRawMouseMovement[player].m_Y * 3;
+				m_NetworkAnalogMoveData[player].m_X += m_NetworkAccumulatedRawMouseMovement[player].m_X * c_NetworkMouseMovementScale;
+				m_NetworkAnalogMoveData[player].m_Y += m_NetworkAccumulatedRawMouseMovement[player].m_Y * c_NetworkMouseMovementScale;
 				m_NetworkAnalogMoveData[player].CapMagnitude(m_MouseTrapRadius);
 			}
 			m_NetworkAccumulatedRawMouseMovement[player].Reset();
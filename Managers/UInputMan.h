@@ -25,6 +25,9 @@ namespace RTE {
 		/// </summary>
 		enum MenuCursorButtons { MENU_PRIMARY, MENU_SECONDARY, MENU_EITHER };
 
+		// TODO: Figure out why we're multiplying by 3 here. Possibly related to mouse sensitivity.
+		static constexpr float c_NetworkMouseMovementScale = 3.0F; //!< How much the raw mouse movement received from network clients moves their analog mouse data.
+
 #pragma region Creation
 		/// <summary>
 		/// Constructor method used to instantiate a UInputMan object in system memory. Create() should be called before using the object.
@@ -538,6 +541,19 @@ namespace RTE {
 		/// <param name="input">The new position of the mouse.</param>
 		void SetNetworkMouseMovement(int player, const Vector &input) { m_NetworkAccumulatedRawMouseMovement[player] = input; }
 
+		/// <summary>
+		/// Gets the emulated analog stick position of the mouse for a player during network multiplayer.
+		/// </summary>
+		/// <param name="player">The player to get for.</param>
+		/// <returns>The offset of the mouse from the middle of the mouse trap circle for the specified player.</returns>
+		const Vector & GetNetworkAnalogMoveData(int player) const { return m_NetworkAnalogMoveData[player]; }
+
+		/// <summary>
+		/// Gets the radius of the circle trapping the mouse for analog mouse data.
+		/// </summary>
+		/// <returns>The radius of the mouse trap circle, in pixels.</returns>
+		float GetMouseTrapRadius() const { return m_MouseTrapRadius; }
+
 		/// <summary>
 		/// Sets whether an input element is held by a player during network multiplayer.
 		/// </summary>
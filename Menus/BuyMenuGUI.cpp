@@ -147,6 +147,7 @@ int BuyMenuGUI::Create(Controller *pController)
 	}
     m_pGUIController->Load("Base.rte/GUIs/BuyMenuGUI.ini");
     m_pGUIController->EnableMouse(pController->IsMouseControlled());
+    m_pGUIController->EnableSurfaceCaching();
 
     if (!s_pCursor)
     {
@@ -374,6 +374,7 @@ int MetagameGUI::Create(Controller *pController)
 		RTEAbort("Failed to create GUI Control Manager and load it from Base.rte/GUIs/Skins/Menus/MainMenuSubMenuSkin.ini");
 	}
     m_pGUIController->Load("Base.rte/GUIs/MetagameGUI.ini");
+    m_pGUIController->EnableSurfaceCaching();
 
     // Make sure we have convenient points to the containing GUI colleciton boxes that we will manipulate the positions of
     GUICollectionBox *pRootBox = m_apScreenBox[ROOTBOX] = dynamic_cast<GUICollectionBox *>(m_pGUIController->GetControl("root"));
@@ -2951,8 +2952,8 @@ void MetagameGUI::CompletedActivity()
             // Suck up all the remaining Actors and Items left in the world and put them into the list to place next load
             // However, don't suck up actors of any non-winning team, and don't save the brains if we autoresolved, because that took care of placing the resident brains already
             pAlteredScene->RetrieveActorsAndDevices(winningTeam, autoResolved);
-            // Save out the altered scene before clearing out its data from memory
-            pAlteredScene->SaveData(METASAVEPATH + string(AUTOSAVENAME) + " - " + pAlteredScene->GetPresetName());
+            // Save out the altered scene before clearing out its data from memory, in the background since the layers are only read back through LoadData
+            pAlteredScene->SaveData(METASAVEPATH + string(AUTOSAVENAME) + " - " + pAlteredScene->GetPresetName(), true);
             // Clear the bitmap data etc of the altered scene, we don't need to copy that over
             pAlteredScene->ClearData();
             // Deep copy over all the edits made to the newly played Scene
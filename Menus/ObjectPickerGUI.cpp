@@ -70,6 +70,7 @@ namespace RTE {
 
 		m_GUIControlManager->Load("Base.rte/GUIs/ObjectPickerGUI.ini");
 		m_GUIControlManager->EnableMouse(controller->IsMouseControlled());
+		m_GUIControlManager->EnableSurfaceCaching();
 
 		if (!s_Cursor) {
 			ContentFile cursorFile("Base.rte/GUIs/Skins/Cursor.png");
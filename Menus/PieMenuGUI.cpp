@@ -10,6 +10,7 @@
 #include "GUI.h"
 #include "GUIFont.h"
 #include "AllegroBitmap.h"
+#include "PixelKernels.h"
 
 namespace RTE {
 
@@ -323,7 +324,7 @@ namespace RTE {
 		if (m_EnabledState != EnabledState::Disabled) {
 			if (m_DrawBackgroundTransparent && !g_FrameMan.IsInMultiplayerMode()) {
 				g_FrameMan.SetTransTable(MoreTrans);
-				draw_trans_sprite(targetBitmap, m_BGBitmap, drawPos.GetFloorIntX() - m_BGBitmap->w / 2, drawPos.GetFloorIntY() - m_BGBitmap->h / 2);
+				PixelKernels::DrawTransSprite(targetBitmap, m_BGBitmap, drawPos.GetFloorIntX() - m_BGBitmap->w / 2, drawPos.GetFloorIntY() - m_BGBitmap->h / 2);
 			} else {
 				draw_sprite(targetBitmap, m_BGBitmap, drawPos.GetFloorIntX() - m_BGBitmap->w / 2, drawPos.GetFloorIntY() - m_BGBitmap->h / 2);
 			}
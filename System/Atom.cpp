@@ -3,6 +3,7 @@
 #include "MovableObject.h"
 #include "MOSRotating.h"
 #include "PresetMan.h"
+#include "FrameMan.h"
 #include "Actor.h"
 
 namespace RTE {
@@ -968,9 +969,15 @@ namespace RTE {
 
 		// Draw the trail
 		if (g_TimerMan.DrawnSimUpdate() && m_TrailLength) {
+			// When MOs are drawn interpolated, the MO color layer is redrawn when rendering, so SceneMan has to keep the trail pixels to put them back
+			bool keepTrailPixels = g_FrameMan.IsRenderInterpolationEnabled();
 			int length = static_cast<int>(static_cast<float>(m_TrailLength) * RandomNum(1.0F - m_TrailLengthVariation, 1.0F));
 			for (int i = trailPoints.size() - std::min(length, static_cast<int>(trailPoints.size())); i < trailPoints.size(); ++i) {
-				putpixel(trailBitmap, trailPoints[i].first, trailPoints[i].second, m_TrailColor.GetIndex());
+				if (keepTrailPixels) {
+					g_SceneMan.DrawMOTrailPixel(trailPoints[i].first, trailPoints[i].second, m_TrailColor.GetIndex());
+				} else {
+					putpixel(trailBitmap, trailPoints[i].first, trailPoints[i].second, m_TrailColor.GetIndex());
+				}
 			}
 		}
 
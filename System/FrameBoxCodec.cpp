@@ -0,0 +1,95 @@
+#include "FrameBoxCodec.h"
+
+#include <lz4.h>
+#include <lz4hc.h>
+
+namespace RTE {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int FrameBoxCodec::Compress(const unsigned char *box, int width, int height, const unsigned char *previousBox, unsigned char allowedEncodings, int highCompressionLevel, int accelerationFactor, unsigned char *dest, int destCapacity, unsigned char &encoding) {
+		// The compression states are too big to keep on the stack, and the stream ones are slow to initialize, so each thread keeps its own
+		thread_local std::vector<char> compressionStateHC(LZ4_sizeofStateHC());
+		thread_local std::vector<char> compressionState(LZ4_sizeofState());
+		thread_local std::unique_ptr<LZ4_streamHC_t> dictionaryStreamHC = []() { std::unique_ptr<LZ4_streamHC_t> stream = std::make_unique<LZ4_streamHC_t>(); LZ4_initStreamHC(stream.get(), sizeof(LZ4_streamHC_t)); return stream; }();
+		thread_local std::unique_ptr<LZ4_stream_t> dictionaryStream = []() { std::unique_ptr<LZ4_stream_t> stream = std::make_unique<LZ4_stream_t>(); LZ4_initStream(stream.get(), sizeof(LZ4_stream_t)); return stream; }();
+		thread_local std::vector<unsigned char> filteredBox;
+
+		int size = width * height;
+		encoding = Plain;
+		int bestSize = 0;
+		thread_local std::vector<unsigned char> candidate;
+		candidate.resize(std::max(std::min(destCapacity, size), 1));
+
+		// Each allowed prediction is tried and the smallest result kept, with every try after the first only allowed to write less than the best so far, so LZ4 gives up on it early once it can't win
+		auto keepIfSmaller = [&](unsigned char candidateEncoding, const unsigned char *source, const unsigned char *dictionary) {
+			int capacity = (bestSize > 0) ? bestSize - 1 : std::min(destCapacity, size - 1);
+			if (capacity <= 0) {
+				return;
+			}
+			char *output = reinterpret_cast<char *>((bestSize > 0) ? candidate.data() : dest);
+			int result = 0;
+			if (dictionary) {
+				if (highCompressionLevel > 0) {
+					LZ4_resetStreamHC_fast(dictionaryStreamHC.get(), highCompressionLevel);
+					LZ4_loadDictHC(dictionaryStreamHC.get(), reinterpret_cast<const char *>(dictionary), size);
+					result = LZ4_compress_HC_continue(dictionaryStreamHC.get(), reinterpret_cast<const char *>(source), output, size, capacity);
+				} else {
+					LZ4_loadDict(dictionaryStream.get(), reinterpret_cast<const char *>(dictionary), size);
+					result = LZ4_compress_fast_continue(dictionaryStream.get(), reinterpret_cast<const char *>(source), output, size, capacity, accelerationFactor);
+				}
+			} else if (highCompressionLevel > 0) {
+				result = LZ4_compress_HC_extStateHC(compressionStateHC.data(), reinterpret_cast<const char *>(source), output, size, capacity, highCompressionLevel);
+			} else {
+				result = LZ4_compress_fast_extState(compressionState.data(), reinterpret_cast<const char *>(source), output, size, capacity, accelerationFactor);
+			}
+			if (result > 0 && result <= capacity) {
+				if (output != reinterpret_cast<char *>(dest)) { std::memcpy(dest, output, result); }
+				bestSize = result;
+				encoding = candidateEncoding;
+			}
+		};
+
+		// Whatever moved a little or changed only partly since the previous version can mostly be copied from it, which usually beats any prediction from within the box itself, so it's tried first
+		if (previousBox && (allowedEncodings & PreviousAsDictionary)) { keepIfSmaller(PreviousAsDictionary, box, previousBox); }
+		keepIfSmaller(Plain, box, nullptr);
+		if (allowedEncodings & UpFiltered) {
+			filteredBox.resize(size);
+			std::memcpy(filteredBox.data(), box, width);
+			for (int i = width; i < size; ++i) {
+				filteredBox[i] = box[i] ^ box[i - width];
+			}
+			keepIfSmaller(UpFiltered, filteredBox.data(), nullptr);
+		}
+
+		// Not worth compressing if no prediction got it smaller than the box itself
+		if (bestSize == 0) { encoding = Plain; }
+		return bestSize;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool FrameBoxCodec::Decompress(const unsigned char *source, int sourceSize, int width, int height, unsigned char encoding, const unsigned char *previousBox, unsigned char *dest) {
+		int size = width * height;
+		int result = 0;
+
+		if (encoding & PreviousAsDictionary) {
+			if (!previousBox) {
+				return false;
+			}
+			result = LZ4_decompress_safe_usingDict(reinterpret_cast<const char *>(source), reinterpret_cast<char *>(dest), sourceSize, size, reinterpret_cast<const char *>(previousBox), size);
+		} else {
+			result = LZ4_decompress_safe(reinterpret_cast<const char *>(source), reinterpret_cast<char *>(dest), sourceSize, size);
+		}
+		if (result != size) {
+			return false;
+		}
+
+		if (encoding & UpFiltered) {
+			for (int i = width; i < size; ++i) {
+				dest[i] ^= dest[i - width];
+			}
+		}
+		return true;
+	}
+}
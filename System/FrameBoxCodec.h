@@ -0,0 +1,57 @@
+#ifndef _RTEFRAMEBOXCODEC_
+#define _RTEFRAMEBOXCODEC_
+
+namespace RTE {
+
+	/// <summary>
+	/// Static collection of the routines that compress and decompress the boxes of 8 bit pixels multiplayer frames are sent to clients in.
+	/// Before being compressed with LZ4, a box is predicted either from the previous version of it the client has, which is used as a dictionary, or from the pixels above it.
+	/// Palette indices have no meaningful order, so pixels are predicted by XORing them together rather than subtracting, which turns every correctly predicted pixel into a 0 regardless of its color.
+	/// Safe to use from multiple threads at once.
+	/// </summary>
+	class FrameBoxCodec {
+
+	public:
+
+		/// <summary>
+		/// Bit flags for how a box was predicted before it was compressed.
+		/// </summary>
+		enum Encoding : unsigned char {
+			Plain = 0, //!< Compressed as is.
+			UpFiltered = 1 << 0, //!< Each pixel was XORed with the one above it before compressing.
+			PreviousAsDictionary = 1 << 1 //!< Compressed with the previous version of the box as dictionary.
+		};
+
+#pragma region Concrete Methods
+		/// <summary>
+		/// Compresses a box of 8 bit pixels with each allowed prediction, from the previous version of the box if there is one, as is and from the pixels above, and keeps whichever comes out smallest.
+		/// </summary>
+		/// <param name="box">The pixels of the box, row after row with no padding in between.</param>
+		/// <param name="width">The width of the box.</param>
+		/// <param name="height">The height of the box.</param>
+		/// <param name="previousBox">The pixels of the previous version of the box the receiver has, laid out the same way, or nullptr if it doesn't have one.</param>
+		/// <param name="allowedEncodings">The Encoding flags that may be used.</param>
+		/// <param name="highCompressionLevel">The LZ4HC level to compress with, or 0 to use fast LZ4 compression instead.</param>
+		/// <param name="accelerationFactor">The acceleration factor to use for fast LZ4 compression.</param>
+		/// <param name="dest">The buffer to write the compressed data to.</param>
+		/// <param name="destCapacity">The size of the buffer to write the compressed data to.</param>
+		/// <param name="encoding">Set to the Encoding flags that were used, to be passed on to Decompress. Plain if the box wasn't compressed.</param>
+		/// <returns>The size of the compressed data, or 0 if the box couldn't be compressed to less than its own size within destCapacity and should be sent as is.</returns>
+		static int Compress(const unsigned char *box, int width, int height, const unsigned char *previousBox, unsigned char allowedEncodings, int highCompressionLevel, int accelerationFactor, unsigned char *dest, int destCapacity, unsigned char &encoding);
+
+		/// <summary>
+		/// Decompresses a box of 8 bit pixels compressed by Compress.
+		/// </summary>
+		/// <param name="source">The compressed data.</param>
+		/// <param name="sourceSize">The size of the compressed data.</param>
+		/// <param name="width">The width of the box.</param>
+		/// <param name="height">The height of the box.</param>
+		/// <param name="encoding">The Encoding flags the box was compressed with.</param>
+		/// <param name="previousBox">The pixels of the previous version of the box, needed if the box was compressed with it as dictionary.</param>
+		/// <param name="dest">The buffer to write the pixels of the box to, row after row with no padding in between. Must be at least width * height bytes and not overlap previousBox.</param>
+		/// <returns>Whether the box was decompressed. False if the data was corrupt or the previous version of the box was needed but not given.</returns>
+		static bool Decompress(const unsigned char *source, int sourceSize, int width, int height, unsigned char encoding, const unsigned char *previousBox, unsigned char *dest);
+#pragma endregion
+	};
+}
+#endif
@@ -31,6 +31,7 @@ distribution.
 //#include <vector>
 #include <memory.h>
 #include <stdio.h>
+#include <algorithm>
 
 //#define DEBUG_PATH
 //#define DEBUG_PATH_DEEP
@@ -421,6 +422,21 @@ PathNode* PathNodePool::FetchPathNode( void* state )
 }
 
 
+void PathNodePool::ForgetNeighbors( void* state )
+{
+	PathNode* root = hashTable[ Hash( state ) ];
+	while( root ) {
+		if ( root->state == state ) {
+			// The old neighbors are left in the cache memory until the next Clear().
+			root->numAdjacent = -1;
+			root->cacheIndex = -1;
+			break;
+		}
+		root = ( state < root->state ) ? root->child[0] : root->child[1];
+	}
+}
+
+
 PathNode* PathNodePool::GetPathNode( unsigned frame, void* _state, float _costFromStart, float _estToGoal, PathNode* _parent )
 {
 	unsigned key = Hash( _state );
@@ -493,6 +509,18 @@ void MicroPather::Reset()
 }
 
 
+void MicroPather::StatesChanged( MP_VECTOR< void* >* states )
+{
+	std::sort( states->begin(), states->end() );
+	for( unsigned i=0; i<states->size(); ++i ) {
+		pathNodePool.ForgetNeighbors( (*states)[i] );
+	}
+	if ( pathCache ) {
+		pathCache->RemoveStates( *states );
+	}
+}
+
+
 void MicroPather::GoalReached( PathNode* node, void* start, void* end, MP_VECTOR< void* > *_path )
 {
 	MP_VECTOR< void* >& path = *_path;
@@ -770,6 +798,65 @@ int PathCache::Solve( void* start, void* end, MP_VECTOR< void* >* path, float* t
 }
 
 
+void PathCache::RemoveStates( const MP_VECTOR< void* >& sortedStates )
+{
+	if ( !nItems ) {
+		return;
+	}
+
+	// Follow each cached path towards its end until it either passes through a removed
+	// state or meets an item that's already known. -1 is unknown, 0 is kept, 1 is removed,
+	// 2 is on the path being followed, which would mean the path loops so it's removed too.
+	MP_VECTOR< signed char > removed( allocated, -1 );
+	MP_VECTOR< int > chain;
+	for( int i=0; i<allocated; ++i ) {
+		if ( mem[i].Empty() || removed[i] != -1 ) {
+			continue;
+		}
+		chain.resize( 0 );
+		signed char result = 0;
+		for( int index=i; ; ) {
+			if ( removed[index] != -1 ) {
+				result = removed[index] == 0 ? 0 : 1;
+				break;
+			}
+			chain.push_back( index );
+			removed[index] = 2;
+			const Item& item = mem[index];
+			if ( item.cost == FLT_MAX || std::binary_search( sortedStates.begin(), sortedStates.end(), item.start ) ) {
+				result = 1;
+				break;
+			}
+			if ( item.next == item.end ) {
+				break;
+			}
+			const Item* nextItem = Find( item.next, item.end );
+			if ( !nextItem ) {
+				result = 1;
+				break;
+			}
+			index = (int)(nextItem - mem);
+		}
+		for( unsigned j=0; j<chain.size(); ++j ) {
+			removed[chain[j]] = result;
+		}
+	}
+
+	// Items can't just be emptied in place without breaking the probing, so put the kept ones back in from scratch.
+	MP_VECTOR< Item > keep;
+	for( int i=0; i<allocated; ++i ) {
+		if ( !mem[i].Empty() && removed[i] == 0 ) {
+			keep.push_back( mem[i] );
+		}
+	}
+	memset( mem, 0, sizeof(*mem)*allocated );
+	nItems = 0;
+	for( unsigned i=0; i<keep.size(); ++i ) {
+		AddItem( keep[i] );
+	}
+}
+
+
 void PathCache::AddItem( const Item& item )
 {
 	MPASSERT( allocated );
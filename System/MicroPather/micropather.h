@@ -298,6 +298,10 @@ namespace micropather
 		// Get a pathnode that is already in the pool.
 		PathNode* FetchPathNode( void* state );
 
+		// Forget the cached neighbors of a state, if it has a pathnode in the pool,
+		// so they're queried from the graph again the next time they're needed.
+		void ForgetNeighbors( void* state );
+
 		// Store stuff in cache
 		bool PushCache( const NodeCost* nodes, int nNodes, int* start );
 
@@ -385,6 +389,10 @@ namespace micropather
 		void AddNoSolution( void* end, void* states[], int count );
 		int Solve( void* startState, void* endState, MP_VECTOR< void* >* path, float* totalCost );
 
+		// Remove all the cached paths that go through any of the passed in states (which
+		// must be sorted), along with all the unsolvable ones since they may be solvable now.
+		void RemoveStates( const MP_VECTOR< void* >& sortedStates );
+
 		int AllocatedBytes() const { return allocated * sizeof(Item); }
 		int UsedBytes() const { return nItems * sizeof(Item); }
 
@@ -483,6 +491,13 @@ namespace micropather
 		*/
 		void Reset();
 
+		/** Can be called instead of Reset() when only the costs from a few states to their neighbors
+			changed. Only forgets the cached costs of those states and the cached paths that go
+			through them, so paths elsewhere stay cached. Doesn't free any memory.
+			The states are sorted in place.
+		*/
+		void StatesChanged( MP_VECTOR< void* >* states );
+
 		// Debugging function to return all states that were used by the last "solve" 
 		void StatesInPool( MP_VECTOR< void* >* stateVec );
 		void GetCacheData( CacheData* data );
@@ -0,0 +1,346 @@
+#include "NetworkFrameDecoder.h"
+#include "FrameBoxCodec.h"
+#include "ThreadMan.h"
+
+#include <lz4.h>
+
+namespace RTE {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkFrameDecoder::Clear() {
+		m_FrameLayers[0] = nullptr;
+		m_FrameLayers[1] = nullptr;
+		m_SceneID = 0;
+		m_SceneBackgroundBitmap = nullptr;
+		m_SceneForegroundBitmap = nullptr;
+		m_FrameBoxVersions[0].clear();
+		m_FrameBoxVersions[1].clear();
+		m_PendingFrameMsgCount = 0;
+		m_PendingFrameMsgKeys[0].clear();
+		m_PendingFrameMsgKeys[1].clear();
+		m_DecodedFrameMsgCount = 0;
+		m_FailedFrameMsgCount = 0;
+		for (std::vector<EntityStateNetworkData> &entityStates : m_EntityStates) {
+			entityStates.clear();
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int NetworkFrameDecoder::Create(BITMAP *frameLayer, BITMAP *frameGUILayer) {
+		if (!frameLayer || !frameGUILayer || bitmap_color_depth(frameLayer) != 8 || bitmap_color_depth(frameGUILayer) != 8) {
+			return -1;
+		}
+		m_FrameLayers[0] = frameLayer;
+		m_FrameLayers[1] = frameGUILayer;
+		return 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkFrameDecoder::Destroy() {
+		if (m_SceneBackgroundBitmap) { destroy_bitmap(m_SceneBackgroundBitmap); }
+		if (m_SceneForegroundBitmap) { destroy_bitmap(m_SceneForegroundBitmap); }
+		Clear();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkFrameDecoder::DecodeSceneSetupMsg(const MsgSceneSetup *msg) {
+		m_SceneID = msg->SceneId;
+
+		if (m_SceneBackgroundBitmap) { destroy_bitmap(m_SceneBackgroundBitmap); }
+		if (m_SceneForegroundBitmap) { destroy_bitmap(m_SceneForegroundBitmap); }
+		m_SceneBackgroundBitmap = create_bitmap_ex(8, msg->Width, msg->Height);
+		m_SceneForegroundBitmap = create_bitmap_ex(8, msg->Width, msg->Height);
+		clear_to_color(m_SceneBackgroundBitmap, g_MaskColor);
+		clear_to_color(m_SceneForegroundBitmap, g_MaskColor);
+
+		// What's left of the previous scene's frames is of no use anymore, and the server starts sending every box whole again
+		m_PendingFrameMsgCount = 0;
+		m_PendingFrameMsgKeys[0].clear();
+		m_PendingFrameMsgKeys[1].clear();
+		ClearFrameBoxVersions();
+		for (BITMAP *frameLayer : m_FrameLayers) {
+			if (frameLayer) { clear_to_color(frameLayer, g_MaskColor); }
+		}
+		for (std::vector<EntityStateNetworkData> &entityStates : m_EntityStates) {
+			entityStates.clear();
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int NetworkFrameDecoder::DecodeSceneMsg(const unsigned char *msgData, size_t msgSize) {
+		const MsgSceneLine *msg = reinterpret_cast<const MsgSceneLine *>(msgData);
+		if (msgSize < sizeof(MsgSceneLine) || msg->SceneId != m_SceneID || msg->Layer > 1 || msgSize < sizeof(MsgSceneLine) + msg->DataSize) {
+			return -1;
+		}
+		BITMAP *bmp = (msg->Layer == 0) ? m_SceneBackgroundBitmap : m_SceneForegroundBitmap;
+		int lineX = msg->X;
+		int lineY = msg->Y;
+		int width = msg->UncompressedSize;
+		if (!bmp || lineY >= bmp->h || lineX + width > bmp->w) {
+			return -1;
+		}
+
+		if (msg->DataSize == 0) {
+			std::memset(bmp->line[lineY] + lineX, g_MaskColor, width);
+		} else if (msg->DataSize == msg->UncompressedSize) {
+			std::memcpy(bmp->line[lineY] + lineX, msgData + sizeof(MsgSceneLine), width);
+		} else if (LZ4_decompress_safe(reinterpret_cast<const char *>(msgData + sizeof(MsgSceneLine)), reinterpret_cast<char *>(bmp->line[lineY] + lineX), msg->DataSize, width) < 0) {
+			return -1;
+		}
+		return msg->Layer;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool NetworkFrameDecoder::DecodeTerrainChangeMsg(const unsigned char *msgData, size_t msgSize) {
+		const MsgTerrainChange *msg = reinterpret_cast<const MsgTerrainChange *>(msgData);
+		if (msgSize < sizeof(MsgTerrainChange) || msg->SceneId != m_SceneID || msgSize < sizeof(MsgTerrainChange) + msg->DataSize) {
+			return false;
+		}
+		BITMAP *bmp = msg->Back ? m_SceneBackgroundBitmap : m_SceneForegroundBitmap;
+		if (!bmp || msg->X + msg->W > bmp->w || msg->Y + msg->H > bmp->h) {
+			return false;
+		}
+
+		if (msg->W == 1 && msg->H == 1) {
+			putpixel(bmp, msg->X, msg->Y, msg->Color);
+			return true;
+		}
+		int size = msg->UncompressedSize;
+		if (size > c_MaxPixelLineBufferSize || size < msg->W * msg->H) {
+			return false;
+		}
+		if (msg->DataSize == msg->UncompressedSize) {
+			std::memcpy(m_TerrainChangeBuffer.data(), msgData + sizeof(MsgTerrainChange), size);
+		} else if (LZ4_decompress_safe(reinterpret_cast<const char *>(msgData + sizeof(MsgTerrainChange)), reinterpret_cast<char *>(m_TerrainChangeBuffer.data()), msg->DataSize, size) < 0) {
+			return false;
+		}
+
+		const unsigned char *src = m_TerrainChangeBuffer.data();
+		for (int y = 0; y < msg->H; y++) {
+			std::memcpy(bmp->line[msg->Y + y] + msg->X, src, msg->W);
+			src += msg->W;
+		}
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int NetworkFrameDecoder::DecodeFrameSetupMsg(const unsigned char *msgData, size_t msgSize) {
+		const MsgFrameSetup *msg = reinterpret_cast<const MsgFrameSetup *>(msgData);
+		if (msgSize < sizeof(MsgFrameSetup) || msg->FrameNumber >= c_FramesToRemember) {
+			return -1;
+		}
+		// The entity states of a frame arrive before its setup, so the ones for the next frame start coming in now
+		m_EntityStates[(msg->FrameNumber + 1) % c_FramesToRemember].clear();
+		return msg->FrameNumber;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool NetworkFrameDecoder::QueueFrameMsg(const unsigned char *msgData, size_t msgSize) {
+		int layer = 0;
+		int positionKey = 0;
+		if (msgData[0] == ID_SRV_FRAME_BOX) {
+			const MsgFrameBox *msg = reinterpret_cast<const MsgFrameBox *>(msgData);
+			if (msgSize < sizeof(MsgFrameBox) || msgSize < sizeof(MsgFrameBox) + msg->DataSize) {
+				return false;
+			}
+			layer = msg->Layer;
+			positionKey = msg->BoxY * 65536 + msg->BoxX;
+		} else {
+			const MsgFrameLine *msg = reinterpret_cast<const MsgFrameLine *>(msgData);
+			if (msgSize < sizeof(MsgFrameLine) || msgSize < sizeof(MsgFrameLine) + msg->DataSize) {
+				return false;
+			}
+			layer = msg->Layer;
+			positionKey = -1 - static_cast<int>(msg->LineNumber);
+		}
+		if (layer > 1 || !m_FrameLayers[layer]) {
+			return false;
+		}
+
+		// A second message for the same part of the frame is from a later frame and may be compressed against the first, so the first has to be decoded before it
+		if (!m_PendingFrameMsgKeys[layer].insert(positionKey).second) {
+			DecodePendingFrameMsgs();
+			m_PendingFrameMsgKeys[layer].insert(positionKey);
+		}
+		if (m_PendingFrameMsgCount == m_PendingFrameMsgs.size()) { m_PendingFrameMsgs.emplace_back(); }
+		m_PendingFrameMsgs[m_PendingFrameMsgCount].assign(msgData, msgData + msgSize);
+		m_PendingFrameMsgCount++;
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkFrameDecoder::DecodePendingFrameMsgs(bool outlineBoxes) {
+		if (m_PendingFrameMsgCount == 0) {
+			return;
+		}
+
+		// The versions of the boxes can't be looked up from the worker threads while they're being changed, so whether each box has the one it may have been compressed against is looked up beforehand
+		m_PendingFrameBoxHasPrevious.assign(m_PendingFrameMsgCount, 0);
+		m_PendingFrameMsgDecoded.assign(m_PendingFrameMsgCount, 0);
+		for (size_t i = 0; i < m_PendingFrameMsgCount; i++) {
+			const MsgFrameBox *frameData = reinterpret_cast<const MsgFrameBox *>(m_PendingFrameMsgs[i].data());
+			if (frameData->Id == ID_SRV_FRAME_BOX && (frameData->Encoding & FrameBoxCodec::PreviousAsDictionary)) {
+				std::unordered_map<int, unsigned char>::const_iterator versionItr = m_FrameBoxVersions[frameData->Layer].find(frameData->BoxY * 65536 + frameData->BoxX);
+				m_PendingFrameBoxHasPrevious[i] = versionItr != m_FrameBoxVersions[frameData->Layer].end() && versionItr->second == static_cast<unsigned char>(frameData->Version - 1);
+			}
+		}
+
+		for (BITMAP *frameLayer : m_FrameLayers) { acquire_bitmap(frameLayer); }
+		// Every message is for a different part of the frame, so they can all be decoded at once
+		g_ThreadMan.ParallelFor(0, static_cast<int>(m_PendingFrameMsgCount), 4, [this, outlineBoxes](int firstMsg, int lastMsg) {
+			for (int i = firstMsg; i < lastMsg; i++) {
+				const unsigned char *msgData = m_PendingFrameMsgs[i].data();
+				BITMAP *bmp = m_FrameLayers[reinterpret_cast<const MsgFrameLine *>(msgData)->Layer];
+				m_PendingFrameMsgDecoded[i] = (msgData[0] == ID_SRV_FRAME_BOX) ? DecodeFrameBoxMsg(msgData, bmp, m_PendingFrameBoxHasPrevious[i], outlineBoxes) : DecodeFrameLineMsg(msgData, bmp);
+			}
+		});
+		for (BITMAP *frameLayer : m_FrameLayers) { release_bitmap(frameLayer); }
+
+		for (size_t i = 0; i < m_PendingFrameMsgCount; i++) {
+			const MsgFrameBox *frameData = reinterpret_cast<const MsgFrameBox *>(m_PendingFrameMsgs[i].data());
+			if (!m_PendingFrameMsgDecoded[i]) {
+				m_FailedFrameMsgCount++;
+				continue;
+			}
+			if (frameData->Id == ID_SRV_FRAME_BOX) { m_FrameBoxVersions[frameData->Layer][frameData->BoxY * 65536 + frameData->BoxX] = frameData->Version; }
+			m_DecodedFrameMsgCount++;
+		}
+		m_PendingFrameMsgCount = 0;
+		m_PendingFrameMsgKeys[0].clear();
+		m_PendingFrameMsgKeys[1].clear();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool NetworkFrameDecoder::DecodeFrameLineMsg(const unsigned char *msgData, BITMAP *bmp) {
+		const MsgFrameLine *frameData = reinterpret_cast<const MsgFrameLine *>(msgData);
+		int lineNumber = frameData->LineNumber;
+		int pixels = std::min(bmp->w, static_cast<int>(frameData->DataSize));
+
+		if (lineNumber >= bmp->h) {
+			return false;
+		}
+		if (frameData->DataSize == 0) {
+			std::memset(bmp->line[lineNumber], g_MaskColor, bmp->w);
+		} else if (frameData->DataSize == frameData->UncompressedSize) {
+			std::memcpy(bmp->line[lineNumber], msgData + sizeof(MsgFrameLine), pixels);
+		} else if (LZ4_decompress_safe(reinterpret_cast<const char *>(msgData + sizeof(MsgFrameLine)), reinterpret_cast<char *>(bmp->line[lineNumber]), frameData->DataSize, bmp->w) < 0) {
+			return false;
+		}
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool NetworkFrameDecoder::DecodeFrameBoxMsg(const unsigned char *msgData, BITMAP *bmp, bool hasPreviousVersion, bool outlineBox) {
+		// Each worker thread decodes into its own buffers
+		thread_local std::array<unsigned char, c_MaxPixelLineBufferSize> boxBuffer;
+		thread_local std::array<unsigned char, c_MaxPixelLineBufferSize> previousBoxBuffer;
+
+		const MsgFrameBox *frameData = reinterpret_cast<const MsgFrameBox *>(msgData);
+		int bpx = frameData->BoxX;
+		int bpy = frameData->BoxY;
+		int maxWidth = frameData->BoxWidth;
+		int maxHeight = frameData->BoxHeight;
+		int size = frameData->DataSize;
+
+		// The server only sends the boxes that changed since it last sent them, so the rest of the frame is left as it was received before
+		if (bpx + maxWidth - 1 >= bmp->w || bpy + maxHeight - 1 >= bmp->h || maxWidth * maxHeight > c_MaxPixelLineBufferSize) {
+			return false;
+		}
+
+		// Unpack box
+		if (frameData->DataSize == 0) {
+			rectfill(bmp, bpx, bpy, bpx + maxWidth - 1, bpy + maxHeight - 1, g_MaskColor);
+			return true;
+		}
+		if (frameData->DataSize == frameData->UncompressedSize) {
+			if (size != maxWidth * maxHeight) {
+				return false;
+			}
+			std::memcpy(boxBuffer.data(), msgData + sizeof(MsgFrameBox), size);
+		} else {
+			const unsigned char *previousBox = nullptr;
+			// The box was compressed against its previous version, which is only of use if it's the one we have
+			if ((frameData->Encoding & FrameBoxCodec::PreviousAsDictionary) && hasPreviousVersion) {
+				unsigned char *previousBoxLine = previousBoxBuffer.data();
+				for (int y = 0; y < maxHeight; y++) {
+					std::memcpy(previousBoxLine, bmp->line[bpy + y] + bpx, maxWidth);
+					previousBoxLine += maxWidth;
+				}
+				previousBox = previousBoxBuffer.data();
+			}
+			// Leave the box as it is until the server refreshes it if it can't be decoded
+			if (!FrameBoxCodec::Decompress(msgData + sizeof(MsgFrameBox), size, maxWidth, maxHeight, frameData->Encoding, previousBox, boxBuffer.data())) {
+				return false;
+			}
+		}
+
+		// Copy box to bitmap line by line
+		const unsigned char *lineAddr = boxBuffer.data();
+		for (int y = 0; y < maxHeight; y++) {
+			std::memcpy(bmp->line[bpy + y] + bpx, lineAddr, maxWidth);
+			lineAddr += maxWidth;
+		}
+
+		if (outlineBox) { rect(bmp, bpx, bpy, bpx + maxWidth - 1, bpy + maxHeight - 1, g_BlackColor); }
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool NetworkFrameDecoder::DecodeEntityPresetsMsg(const unsigned char *msgData, size_t msgSize, const std::function<void(int, const std::string &, const std::string &, const std::string &)> &presetHandler) const {
+		if (msgSize < sizeof(MsgEntityPresets)) {
+			return false;
+		}
+		const MsgEntityPresets *msg = reinterpret_cast<const MsgEntityPresets *>(msgData);
+		const char *presetNames = reinterpret_cast<const char *>(msgData + sizeof(MsgEntityPresets));
+		const char *presetNamesEnd = reinterpret_cast<const char *>(msgData + msgSize);
+
+		for (int i = 0; i < msg->PresetCount; i++) {
+			// Class, data module and preset name, each terminated by a null character
+			std::array<std::string, 3> names;
+			for (std::string &name : names) {
+				const char *nameEnd = std::find(presetNames, presetNamesEnd, '\0');
+				if (nameEnd == presetNamesEnd) {
+					return false;
+				}
+				name.assign(presetNames, nameEnd);
+				presetNames = nameEnd + 1;
+			}
+			presetHandler(msg->FirstPresetIndex + i, names[0], names[1], names[2]);
+		}
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool NetworkFrameDecoder::DecodeEntityStatesMsg(const unsigned char *msgData, size_t msgSize) {
+		const MsgEntityStates *msg = reinterpret_cast<const MsgEntityStates *>(msgData);
+		if (msgSize < sizeof(MsgEntityStates) || msg->FrameNumber >= c_FramesToRemember || msgSize < sizeof(MsgEntityStates) + msg->DataSize) {
+			return false;
+		}
+		std::vector<EntityStateNetworkData> &entityStates = m_EntityStates[msg->FrameNumber];
+		size_t firstState = entityStates.size();
+		int rawSize = static_cast<int>(sizeof(EntityStateNetworkData) * msg->EntityCount);
+		entityStates.resize(firstState + msg->EntityCount);
+		unsigned char *dest = reinterpret_cast<unsigned char *>(entityStates.data() + firstState);
+
+		if (msg->DataSize == rawSize) {
+			std::memcpy(dest, msgData + sizeof(MsgEntityStates), rawSize);
+		} else if (!FrameBoxCodec::Decompress(msgData + sizeof(MsgEntityStates), msg->DataSize, rawSize, 1, FrameBoxCodec::Plain, nullptr, dest)) {
+			entityStates.resize(firstState);
+			return false;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,223 @@
+#ifndef _RTENETWORKFRAMEDECODER_
+#define _RTENETWORKFRAMEDECODER_
+
+#include "Constants.h"
+#include "NetworkMessages.h"
+
+struct BITMAP;
+
+namespace RTE {
+
+	/// <summary>
+	/// Decodes what a multiplayer server sends its clients to draw, the scene, terrain changes, frames and entity states, into bitmaps and lists a client can draw from.
+	/// Not tied to NetworkClient, so any number of them can be used at once, like the synthetic clients of the multiplayer load test do.
+	/// </summary>
+	class NetworkFrameDecoder {
+
+	public:
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate a NetworkFrameDecoder object in system memory. Create() should be called before using the object.
+		/// </summary>
+		NetworkFrameDecoder() { Clear(); }
+
+		/// <summary>
+		/// Makes the NetworkFrameDecoder object ready for use.
+		/// </summary>
+		/// <param name="frameLayer">The 8 bit bitmap to decode the frame layer onto, at the resolution the client asked the server frames in. Not owned.</param>
+		/// <param name="frameGUILayer">The 8 bit bitmap to decode the frame GUI layer onto, the same size as the frame layer. Not owned.</param>
+		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
+		int Create(BITMAP *frameLayer, BITMAP *frameGUILayer);
+#pragma endregion
+
+#pragma region Destruction
+		/// <summary>
+		/// Destructor method used to clean up a NetworkFrameDecoder object before deletion from system memory.
+		/// </summary>
+		~NetworkFrameDecoder() { Destroy(); }
+
+		/// <summary>
+		/// Destroys and resets (through Clear()) the NetworkFrameDecoder object.
+		/// </summary>
+		void Destroy();
+#pragma endregion
+
+#pragma region Getters
+		/// <summary>
+		/// Gets the ID of the scene being decoded, which scene lines and terrain changes are checked against.
+		/// </summary>
+		/// <returns>The ID of the scene being decoded.</returns>
+		unsigned char GetSceneID() const { return m_SceneID; }
+
+		/// <summary>
+		/// Gets the bitmap the background terrain of the scene is decoded onto.
+		/// </summary>
+		/// <returns>The background terrain bitmap, or nullptr if no scene was set up yet. Owned by this.</returns>
+		BITMAP * GetSceneBackgroundBitmap() const { return m_SceneBackgroundBitmap; }
+
+		/// <summary>
+		/// Gets the bitmap the foreground terrain of the scene is decoded onto.
+		/// </summary>
+		/// <returns>The foreground terrain bitmap, or nullptr if no scene was set up yet. Owned by this.</returns>
+		BITMAP * GetSceneForegroundBitmap() const { return m_SceneForegroundBitmap; }
+
+		/// <summary>
+		/// Gets how many frame box and line messages are waiting to be decoded.
+		/// </summary>
+		/// <returns>The number of frame box and line messages waiting to be decoded.</returns>
+		size_t GetPendingFrameMsgCount() const { return m_PendingFrameMsgCount; }
+
+		/// <summary>
+		/// Gets how many frame box and line messages were decoded since this was created.
+		/// </summary>
+		/// <returns>The number of frame box and line messages decoded.</returns>
+		int GetDecodedFrameMsgCount() const { return m_DecodedFrameMsgCount; }
+
+		/// <summary>
+		/// Gets how many frame box and line messages couldn't be decoded since this was created, because they were corrupt, out of bounds, or compressed against a version of their box that was lost.
+		/// </summary>
+		/// <returns>The number of frame box and line messages that couldn't be decoded.</returns>
+		int GetFailedFrameMsgCount() const { return m_FailedFrameMsgCount; }
+
+		/// <summary>
+		/// Gets the entity states decoded for a frame.
+		/// </summary>
+		/// <param name="frame">The frame to get the entity states of.</param>
+		/// <returns>The entity states of the frame.</returns>
+		const std::vector<EntityStateNetworkData> & GetEntityStates(int frame) const { return m_EntityStates[frame]; }
+#pragma endregion
+
+#pragma region Scene Decoding
+		/// <summary>
+		/// Starts decoding a new scene. Makes room for its terrain and forgets everything decoded for the previous one, including the frame boxes the server may have compressed against.
+		/// </summary>
+		/// <param name="msg">The scene setup message.</param>
+		void DecodeSceneSetupMsg(const MsgSceneSetup *msg);
+
+		/// <summary>
+		/// Decodes a line of the scene's terrain.
+		/// </summary>
+		/// <param name="msgData">The message, starting with its MsgSceneLine.</param>
+		/// <param name="msgSize">The size of the message.</param>
+		/// <returns>The terrain layer the line was for, 0 for the background and 1 for the foreground, or -1 if it was for another scene or couldn't be decoded.</returns>
+		int DecodeSceneMsg(const unsigned char *msgData, size_t msgSize);
+
+		/// <summary>
+		/// Decodes a change of the scene's terrain.
+		/// </summary>
+		/// <param name="msgData">The message, starting with its MsgTerrainChange.</param>
+		/// <param name="msgSize">The size of the message.</param>
+		/// <returns>Whether the change was applied. False if it was for another scene or couldn't be decoded.</returns>
+		bool DecodeTerrainChangeMsg(const unsigned char *msgData, size_t msgSize);
+#pragma endregion
+
+#pragma region Frame Decoding
+		/// <summary>
+		/// Decodes a frame setup message, after which the entity states of the frame that follows it start arriving.
+		/// </summary>
+		/// <param name="msgData">The message, starting with its MsgFrameSetup.</param>
+		/// <param name="msgSize">The size of the message.</param>
+		/// <returns>The number of the frame the message set up, or -1 if it was out of range.</returns>
+		int DecodeFrameSetupMsg(const unsigned char *msgData, size_t msgSize);
+
+		/// <summary>
+		/// Keeps a frame box or line message to be decoded with the rest of its frame. Decodes the ones already kept first if one of them is for the same part of the frame.
+		/// </summary>
+		/// <param name="msgData">The message, starting with its MsgFrameBox or MsgFrameLine.</param>
+		/// <param name="msgSize">The size of the message.</param>
+		/// <returns>Whether the message was kept. False if it was for a layer that doesn't exist or was cut short.</returns>
+		bool QueueFrameMsg(const unsigned char *msgData, size_t msgSize);
+
+		/// <summary>
+		/// Decodes all the frame box and line messages waiting to be onto the frame layers, in parallel on the worker threads.
+		/// </summary>
+		/// <param name="outlineBoxes">Whether to outline the decoded boxes, to see which parts of the frame the server sent.</param>
+		void DecodePendingFrameMsgs(bool outlineBoxes = false);
+
+		/// <summary>
+		/// Forgets the versions of the frame boxes decoded so far, so no box is decoded against what's left on the frame layers until the server sends it whole again.
+		/// </summary>
+		void ClearFrameBoxVersions() { m_FrameBoxVersions[0].clear(); m_FrameBoxVersions[1].clear(); }
+#pragma endregion
+
+#pragma region Entity Decoding
+		/// <summary>
+		/// Decodes a message of the presets the server will refer to in entity states.
+		/// </summary>
+		/// <param name="msgData">The message, starting with its MsgEntityPresets.</param>
+		/// <param name="msgSize">The size of the message.</param>
+		/// <param name="presetHandler">Called with the index of each preset in the message and its class, data module and preset name, to look it up by. The data module name may be empty.</param>
+		/// <returns>Whether every preset in the message was decoded. False if the message was cut short.</returns>
+		bool DecodeEntityPresetsMsg(const unsigned char *msgData, size_t msgSize, const std::function<void(int, const std::string &, const std::string &, const std::string &)> &presetHandler) const;
+
+		/// <summary>
+		/// Decodes a message of entity states, adding them to the ones of its frame.
+		/// </summary>
+		/// <param name="msgData">The message, starting with its MsgEntityStates.</param>
+		/// <param name="msgSize">The size of the message.</param>
+		/// <returns>Whether the entity states were decoded. False if the message was for a frame out of range, cut short or corrupt.</returns>
+		bool DecodeEntityStatesMsg(const unsigned char *msgData, size_t msgSize);
+
+		/// <summary>
+		/// Clears the entity states of a frame.
+		/// </summary>
+		/// <param name="frame">The frame to clear the entity states of.</param>
+		void ClearEntityStates(int frame) { m_EntityStates[frame].clear(); }
+#pragma endregion
+
+	protected:
+
+		BITMAP *m_FrameLayers[2]; //!< The frame and frame GUI layer bitmaps frame boxes and lines are decoded onto. Not owned.
+
+		unsigned char m_SceneID; //!< The ID of the scene being decoded.
+		BITMAP *m_SceneBackgroundBitmap; //!< The background terrain of the scene. Owned.
+		BITMAP *m_SceneForegroundBitmap; //!< The foreground terrain of the scene. Owned.
+		std::array<unsigned char, c_MaxPixelLineBufferSize> m_TerrainChangeBuffer; //!< The pixels of the terrain change being decoded.
+
+		std::unordered_map<int, unsigned char> m_FrameBoxVersions[2]; //!< The version of each frame box of each layer decoded, by the box's position packed as Y * 65536 + X.
+
+		/// <summary>
+		/// Frame boxes and lines are kept as they arrive and decoded all at once on the worker threads when the frame is drawn, instead of one by one on the thread handling packets.
+		/// </summary>
+		std::vector<std::vector<unsigned char>> m_PendingFrameMsgs; //!< The frame box and line messages waiting to be decoded. Only the first m_PendingFrameMsgCount are, the rest are kept to reuse their memory.
+		size_t m_PendingFrameMsgCount; //!< How many frame box and line messages are waiting to be decoded.
+		std::unordered_set<int> m_PendingFrameMsgKeys[2]; //!< The parts of each layer the waiting messages are for, boxes by their position packed as Y * 65536 + X and lines as -1 - line number.
+		std::vector<unsigned char> m_PendingFrameBoxHasPrevious; //!< Whether the version of each waiting box it may have been compressed against was decoded. Looked up before decoding since the versions can't be from the worker threads.
+		std::vector<unsigned char> m_PendingFrameMsgDecoded; //!< Whether each waiting message could be decoded.
+		int m_DecodedFrameMsgCount; //!< How many frame box and line messages were decoded since this was created.
+		int m_FailedFrameMsgCount; //!< How many frame box and line messages couldn't be decoded since this was created.
+
+		std::vector<EntityStateNetworkData> m_EntityStates[c_FramesToRemember]; //!< The entities to draw in each frame, when the server replicates them instead of drawing them into the frame.
+
+	private:
+
+		/// <summary>
+		/// Decodes a frame line message onto its layer. Safe to run on the worker threads alongside the decoding of other lines.
+		/// </summary>
+		/// <param name="msgData">The message, starting with its MsgFrameLine.</param>
+		/// <param name="bmp">The bitmap of the layer the line is for.</param>
+		/// <returns>Whether the line was decoded.</returns>
+		static bool DecodeFrameLineMsg(const unsigned char *msgData, BITMAP *bmp);
+
+		/// <summary>
+		/// Decodes a frame box message onto its layer. Safe to run on the worker threads alongside the decoding of boxes at other positions.
+		/// </summary>
+		/// <param name="msgData">The message, starting with its MsgFrameBox.</param>
+		/// <param name="bmp">The bitmap of the layer the box is for.</param>
+		/// <param name="hasPreviousVersion">Whether the bitmap has the version of the box it may have been compressed against.</param>
+		/// <param name="outlineBox">Whether to outline the box once decoded.</param>
+		/// <returns>Whether the box was decoded. False if it was corrupt, out of bounds, or compressed against a version of it the bitmap doesn't have.</returns>
+		static bool DecodeFrameBoxMsg(const unsigned char *msgData, BITMAP *bmp, bool hasPreviousVersion, bool outlineBox);
+
+		/// <summary>
+		/// Clears all the member variables of this NetworkFrameDecoder, effectively resetting the members of this abstraction level only.
+		/// </summary>
+		void Clear();
+
+		// Disallow the use of some implicit methods.
+		NetworkFrameDecoder(const NetworkFrameDecoder &reference) = delete;
+		NetworkFrameDecoder & operator=(const NetworkFrameDecoder &rhs) = delete;
+	};
+}
+#endif
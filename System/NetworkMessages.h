@@ -30,7 +30,9 @@ namespace RTE {
 		ID_SRV_TERRAIN,
 		ID_SRV_POST_EFFECTS,
 		ID_SRV_SOUND_EVENTS,
-		ID_SRV_MUSIC_EVENTS
+		ID_SRV_MUSIC_EVENTS,
+		ID_SRV_ENTITY_PRESETS,
+		ID_SRV_ENTITY_STATES
 	};
 
 // Pack the structs so 1 byte members are exactly 1 byte in memory instead of being aligned by 4 bytes (padding) so the correct representation is sent over the network without empty bytes consumed by alignment.
@@ -98,6 +100,16 @@ namespace RTE {
 	/// 
 	/// </summary>
 	struct MsgFrameSetup {
+		/// <summary>
+		/// What the player's mouse was moving on the server when the frame was drawn, for the client to draw ahead of the frame from its own input.
+		/// </summary>
+		enum PointerMode : unsigned char {
+			NoPointer = 0, //!< Nothing the client can predict.
+			GUICursor, //!< The cursor of a menu, at CursorPosX and CursorPosY.
+			Aim, //!< The aim of the controlled actor at AimOriginX and AimOriginY, in the direction of AimX and AimY.
+			PieMenu //!< The cursor of the controlled actor's pie menu, in the direction of AimX and AimY.
+		};
+
 		unsigned char Id;
 		unsigned char FrameNumber;
 
@@ -106,6 +118,15 @@ namespace RTE {
 
 		float OffsetX[c_MaxLayersStoredForNetwork];
 		float OffsetY[c_MaxLayersStoredForNetwork];
+
+		unsigned int InputSequence; //!< The InputSequence of the last MsgInput the server applied before drawing the frame.
+		unsigned char Pointer; //!< The PointerMode of the frame.
+		short int CursorPosX; //!< The X position of the menu cursor on the frame.
+		short int CursorPosY; //!< The Y position of the menu cursor on the frame.
+		short int AimOriginX; //!< The X position on the frame the controlled actor aims from.
+		short int AimOriginY; //!< The Y position on the frame the controlled actor aims from.
+		short int AimX; //!< The X offset of the mouse aim from the middle of the mouse trap circle.
+		short int AimY; //!< The Y offset of the mouse aim from the middle of the mouse trap circle.
 	};
 
 	/// <summary>
@@ -135,6 +156,8 @@ namespace RTE {
 		unsigned char BoxHeight;
 		unsigned short int DataSize;
 		unsigned short int UncompressedSize;
+		unsigned char Encoding; //!< The FrameBoxCodec::Encoding flags the box was compressed with.
+		unsigned char Version; //!< Counts up every time the box at this position and layer is sent, so the client can tell whether it has the previous version the box may have been compressed against.
 	};
 
 	/// <summary>
@@ -276,6 +299,51 @@ namespace RTE {
 		int MusicEventsCount;
 	};
 
+	/// <summary>
+	/// Presets the server will refer to by index in entity states, sent before the first entity state that uses them when replicating entities instead of sending them drawn into frames.
+	/// Followed by the class name, data module file name and preset name of each preset, each terminated by a null character.
+	/// </summary>
+	struct MsgEntityPresets {
+		unsigned char Id;
+		unsigned short int FirstPresetIndex; //!< The index of the first preset in the message. The rest follow in order.
+		unsigned short int PresetCount; //!< How many presets are in the message.
+	};
+
+	/// <summary>
+	/// What a client needs to draw one sprite or pixel of an entity by itself, from a preset it has loaded.
+	/// </summary>
+	struct EntityStateNetworkData {
+		/// <summary>
+		/// Bit flags for how to draw the entity.
+		/// </summary>
+		enum Flags : unsigned char {
+			HFlipped = 1 << 0 //!< The sprite is horizontally flipped.
+		};
+
+		static constexpr unsigned short c_PixelPresetIndex = 0xFFFF; //!< Preset index of single pixels, which are drawn in the color given in Frame.
+
+		unsigned short int PresetIndex; //!< The index of the preset whose sprite to draw, as sent with MsgEntityPresets, or c_PixelPresetIndex.
+		short int X; //!< The X position of the entity in the scene.
+		short int Y; //!< The Y position of the entity in the scene.
+		unsigned short int Frame; //!< The sprite frame to draw, or the palette index of a pixel.
+		unsigned char Angle; //!< The rotation of the sprite, in Allegro angle units where 256 is a full rotation.
+		short int SpriteOffsetX; //!< The X offset of the sprite's upper left corner from the entity's position, before flipping and rotating.
+		short int SpriteOffsetY; //!< The Y offset of the sprite's upper left corner from the entity's position, before flipping and rotating.
+		float Scale; //!< The scale to draw the sprite at.
+		unsigned char DrawFlags; //!< The Flags to draw the sprite with.
+	};
+
+	/// <summary>
+	/// The entities visible to a client in a frame, in the order they're drawn. All the messages for a frame are sent before its MsgFrameSetup, but unreliably, so some may arrive after it or not at all.
+	/// Followed by DataSize bytes of EntityCount EntityStateNetworkData, LZ4 compressed unless DataSize is their uncompressed size.
+	/// </summary>
+	struct MsgEntityStates {
+		unsigned char Id;
+		unsigned char FrameNumber;
+		unsigned short int EntityCount;
+		unsigned short int DataSize;
+	};
+
 	/// <summary>
 	/// 
 	/// </summary>
@@ -296,6 +364,8 @@ namespace RTE {
 		unsigned int InputElementPressed;
 		unsigned int InputElementReleased;
 		unsigned int InputElementHeld;
+
+		unsigned int InputSequence; //!< Counts up with every input message the client sends, so frames can tell it which of them they include.
 	};
 
 // Disables the previously set pack pragma.
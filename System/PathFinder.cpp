@@ -1,14 +1,32 @@
 #include "PathFinder.h"
+#include "ThreadMan.h"
+#include "Material.h"
 
 namespace RTE {
 
+	thread_local unsigned long long PathFinder::s_ExpandedNodeCount = 0;
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void PathFinder::Clear() {
 		m_NodeGrid.clear();
 		m_NodeDimension = 20;
-		m_DigStrength = 1;
-		m_Pather = 0;
+		m_Allocate = 2000;
+		m_CostsVersion = 0;
+		m_CostUpdateCount = 0;
+		m_DeferredCostUpdates = 0;
+		m_NodeCostsChangedAt.clear();
+		m_IdleSolvers.clear();
+		m_PendingRequests.clear();
+		m_Clusters.clear();
+		m_ClusterXCount = 0;
+		m_ClusterYCount = 0;
+		m_ClusterEntrances.clear();
+		m_ClusterBorderSegments.clear();
+		m_ClusterEntranceTrees.clear();
+		m_MaterialStrengths.clear();
+		m_FlowFields.clear();
+		m_FlowFieldRequestCounter = 0;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -17,6 +35,7 @@ namespace RTE {
 		RTEAssert(scene, "Scene doesn't exist or isn't loaded when creating PathFinder!");
 
 		m_NodeDimension = nodeDimension;
+		m_Allocate = allocate;
 		int sceneWidth = g_SceneMan.GetSceneWidth();
 		int sceneHeight = g_SceneMan.GetSceneHeight();
 
@@ -80,9 +99,6 @@ namespace RTE {
 				if (wrappedLeft >= 0 && wrappedUp >= 0) { node->LeftUp = m_NodeGrid[wrappedLeft][wrappedUp]; }
 			}
 		}
-		// Create and allocate the pather class which will do the work
-		m_Pather = new MicroPather(this, allocate);
-
 		// If the scene wraps we must find the cost over the seam before doing RecalculateAllCosts() the first time
 		// since the cost is equal to max(node->LeftCost, node->m_Left->RightCost)
 		if (scene->WrapsX()) {
@@ -91,6 +107,18 @@ namespace RTE {
 				if (node->Left) { node->Left->RightCost = CostAlongLine(node->Pos, node->Left->Pos); }
 			}
 		}
+		m_NodeCostsChangedAt.assign(nodeXCount * nodeYCount, 0);
+
+		// Doors are left out of the costs, see SceneMan::CastMaxStrengthRay
+		m_MaterialStrengths.assign(1, 0.0F);
+		for (const Material *material : g_SceneMan.GetMaterialPalette()) {
+			if (material && material->GetIndex() != g_MaterialDoor) { m_MaterialStrengths.push_back(material->GetIntegrity()); }
+		}
+		std::sort(m_MaterialStrengths.begin(), m_MaterialStrengths.end());
+		m_MaterialStrengths.erase(std::unique(m_MaterialStrengths.begin(), m_MaterialStrengths.end()), m_MaterialStrengths.end());
+
+		CreateClusters();
+
 		// Set up all the costs between all nodes
 		RecalculateAllCosts();
 
@@ -100,20 +128,30 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void PathFinder::Destroy() {
+		// Queued path calculations use the nodes, so they must be done with before those go away
+		for (std::future<void> &pendingRequest : m_PendingRequests) {
+			pendingRequest.wait();
+		}
 		for (unsigned int x = 0; x < m_NodeGrid.size(); ++x) {
 			for (unsigned int y = 0; y < m_NodeGrid[x].size(); ++y) {
 				delete m_NodeGrid[x][y];
 				m_NodeGrid[x][y] = 0;
 			}
 		}
-		delete m_Pather;
 		Clear();
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	PathNode * PathFinder::GetNodeAt(Vector pos) const {
+		g_SceneMan.ForceBounds(pos);
+		return m_NodeGrid[static_cast<int>(pos.m_X / static_cast<float>(m_NodeDimension))][static_cast<int>(pos.m_Y / static_cast<float>(m_NodeDimension))];
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	int PathFinder::CalculatePath(Vector start, Vector end, std::list<Vector> &pathResult, float &totalCostResult, float digStrength) {
-		RTEAssert(m_Pather, "No pather exists, can't calculate the path!");
+		RTEAssert(!m_NodeGrid.empty(), "No node grid exists, can't calculate the path!");
 
 		// Make sure start and end are within scene bounds
 		g_SceneMan.ForceBounds(start);
@@ -128,12 +166,34 @@ namespace RTE {
 		// Clear out the results if it happens to contain anything
 		pathResult.clear();
 
-		// Actors capable of digging can use m_DigStrength to modify the node adjacency cost
-		m_DigStrength = digStrength;
+		// All dig strengths of a class see the same costs, so solving for the class lets them share the pathers' caches and the cluster searches
+		digStrength = GetDigStrengthClass(digStrength);
+
+		// Paths between clusters that aren't next to each other are found hierarchically, so only the nodes near the start and end and the cluster entrances along the way get searched
+		int clusterDistanceX = std::abs(startNodeX / c_ClusterSize - endNodeX / c_ClusterSize);
+		if (g_SceneMan.SceneWrapsX()) { clusterDistanceX = std::min(clusterDistanceX, m_ClusterXCount - clusterDistanceX); }
+		int clusterDistanceY = std::abs(startNodeY / c_ClusterSize - endNodeY / c_ClusterSize);
+		if (g_SceneMan.SceneWrapsY()) { clusterDistanceY = std::min(clusterDistanceY, m_ClusterYCount - clusterDistanceY); }
 
 		// Do the actual pathfinding, fetch out the list of states that comprise the best path
 		std::vector<void *> statePath;
-		int result = m_Pather->Solve(static_cast<void *>(m_NodeGrid[startNodeX][startNodeY]), static_cast<void *>(m_NodeGrid[endNodeX][endNodeY]), &statePath, &totalCostResult);
+		int result;
+		{
+			std::shared_lock<std::shared_mutex> nodeCostsLock(m_NodeCostsMutex);
+			if (std::max(clusterDistanceX, clusterDistanceY) > 1 && CalculateHierarchicalPath(m_NodeGrid[startNodeX][startNodeY], m_NodeGrid[endNodeX][endNodeY], digStrength, statePath, totalCostResult)) {
+				result = MicroPather::SOLVED;
+			} else {
+				std::unique_ptr<PathSolver> solver = TakeSolver(digStrength);
+				// The pather caches costs, so reset it if it cached them for a different dig strength or from before the costs were last recalculated, as per the docs
+				if (solver->DigStrength != digStrength || solver->CostsVersion != m_CostsVersion) {
+					solver->Pather->Reset();
+					solver->DigStrength = digStrength;
+					solver->CostsVersion = m_CostsVersion;
+				}
+				result = solver->Pather->Solve(static_cast<void *>(m_NodeGrid[startNodeX][startNodeY]), static_cast<void *>(m_NodeGrid[endNodeX][endNodeY]), &statePath, &totalCostResult);
+				ReturnSolver(std::move(solver));
+			}
+		}
 
 		// We got something back
 		if (!statePath.empty()) {
@@ -161,27 +221,162 @@ namespace RTE {
 		return result;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::shared_ptr<PathRequest> PathFinder::CalculatePathAsync(const Vector &start, const Vector &end, float digStrength) {
+		std::shared_ptr<PathRequest> pathRequest = std::make_shared<PathRequest>();
+		pathRequest->StartPos = start;
+		pathRequest->TargetPos = end;
+
+		// Drop the futures of calculations that are done already so they don't pile up
+		m_PendingRequests.remove_if([](const std::future<void> &pendingRequest) { return pendingRequest.wait_for(std::chrono::seconds(0)) == std::future_status::ready; });
+		m_PendingRequests.emplace_back(g_ThreadMan.QueueTask([this, pathRequest, digStrength]() {
+			pathRequest->Status = CalculatePath(pathRequest->StartPos, pathRequest->TargetPos, pathRequest->Path, pathRequest->TotalCost, digStrength);
+			pathRequest->Complete = true;
+		}));
+		return pathRequest;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PathFinder::GetFlowFieldPath(Vector start, Vector end, std::list<Vector> &pathResult, float &totalCostResult, float digStrength) {
+		RTEAssert(!m_NodeGrid.empty(), "No node grid exists, can't get the path!");
+
+		g_SceneMan.ForceBounds(start);
+		g_SceneMan.ForceBounds(end);
+		int startNodeX = std::floor(start.m_X / static_cast<float>(m_NodeDimension));
+		int startNodeY = std::floor(start.m_Y / static_cast<float>(m_NodeDimension));
+		int endNodeX = std::floor(end.m_X / static_cast<float>(m_NodeDimension));
+		int endNodeY = std::floor(end.m_Y / static_cast<float>(m_NodeDimension));
+		std::pair<PathNode *, float> flowFieldKey(m_NodeGrid[endNodeX][endNodeY], GetDigStrengthClass(digStrength));
+
+		std::unique_lock<std::mutex> flowFieldsLock(m_FlowFieldsMutex);
+		FlowField &flowField = m_FlowFields[flowFieldKey];
+		flowField.RequestCount++;
+		flowField.LastRequest = ++m_FlowFieldRequestCounter;
+
+		if (flowField.Costs.empty()) {
+			if (flowField.Building) {
+				return false;
+			}
+			if (flowField.RequestCount < c_FlowFieldRequestThreshold) {
+				// Stop counting requests to the destination asked for least recently if there are too many being counted
+				if (m_FlowFields.size() > c_MaxFlowFieldCandidates) {
+					std::map<std::pair<PathNode *, float>, FlowField>::iterator leastRecentItr = m_FlowFields.end();
+					for (std::map<std::pair<PathNode *, float>, FlowField>::iterator flowFieldItr = m_FlowFields.begin(); flowFieldItr != m_FlowFields.end(); ++flowFieldItr) {
+						if (!flowFieldItr->second.Building && (leastRecentItr == m_FlowFields.end() || flowFieldItr->second.LastRequest < leastRecentItr->second.LastRequest)) { leastRecentItr = flowFieldItr; }
+					}
+					if (leastRecentItr != m_FlowFields.end()) { m_FlowFields.erase(leastRecentItr); }
+				}
+				return false;
+			}
+			// Make room by dropping the flow field asked for least recently, its requests keep being counted so it gets made again if it's still popular
+			std::map<std::pair<PathNode *, float>, FlowField>::iterator leastRecentItr = m_FlowFields.end();
+			int flowFieldCount = 0;
+			for (std::map<std::pair<PathNode *, float>, FlowField>::iterator flowFieldItr = m_FlowFields.begin(); flowFieldItr != m_FlowFields.end(); ++flowFieldItr) {
+				if (flowFieldItr->second.Building) {
+					flowFieldCount++;
+				} else if (!flowFieldItr->second.Costs.empty()) {
+					flowFieldCount++;
+					if (leastRecentItr == m_FlowFields.end() || flowFieldItr->second.LastRequest < leastRecentItr->second.LastRequest) { leastRecentItr = flowFieldItr; }
+				}
+			}
+			if (flowFieldCount >= c_MaxFlowFields) {
+				if (leastRecentItr == m_FlowFields.end()) {
+					return false;
+				}
+				leastRecentItr->second.Costs = std::vector<float>();
+				leastRecentItr->second.NextNodes = std::vector<PathNode *>();
+				leastRecentItr->second.RequestCount = 0;
+			}
+			// Paths are calculated the usual way until the flow field is ready. The lock is let go first since the build takes it once done, which may be right away if there are no worker threads
+			flowField.Building = true;
+			flowFieldsLock.unlock();
+			QueueBuildFlowField(flowFieldKey);
+			return false;
+		}
+
+		int startIndex = GetNodeIndex(startNodeX, startNodeY);
+		if (flowField.Costs[startIndex] == FLT_MAX) {
+			return false;
+		}
+
+		// Put together the path the same way CalculatePath does, starting and ending exactly at the start and end instead of the node centers
+		pathResult.clear();
+		pathResult.push_back(start);
+		for (const PathNode *node = flowField.NextNodes[startIndex]; node; node = flowField.NextNodes[GetNodeIndex(GetNodeX(node), GetNodeY(node))]) {
+			pathResult.push_back(node->Pos);
+		}
+		if (pathResult.size() > 2) {
+			pathResult.pop_back();
+			pathResult.push_back(end);
+		} else if (pathResult.size() == 1) {
+			pathResult.push_back(end);
+		}
+		totalCostResult = flowField.Costs[startIndex];
+		return true;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void PathFinder::RecalculateAllCosts() {
 		RTEAssert(g_SceneMan.GetScene(), "Scene doesn't exist or isn't loaded when recalculating PathFinder!");
+		std::unique_lock<std::shared_mutex> nodeCostsLock(m_NodeCostsMutex);
 
 		// Update all the costs going out from each node
-		for (const std::vector<PathNode *> &nodeEntry : m_NodeGrid) {
-			for (PathNode *pathNode : nodeEntry) {
-				UpdateNodeCosts(pathNode);
+		bool anyCostsChanged = false;
+		int gridWidth = static_cast<int>(m_NodeGrid.size());
+		int gridHeight = static_cast<int>(m_NodeGrid[0].size());
+		for (int nodeX = 0; nodeX < gridWidth; ++nodeX) {
+			for (int nodeY = 0; nodeY < gridHeight; ++nodeY) {
+				PathNode *pathNode = m_NodeGrid[nodeX][nodeY];
+				if (UpdateNodeCosts(pathNode)) {
+					m_NodeCostsChangedAt[GetNodeIndex(nodeX, nodeY)] = m_CostUpdateCount + 1;
+					anyCostsChanged = true;
+				}
 				// Should reset the changed flag since we're about to reset the pather
 				pathNode->IsChanged = false;
 			}
 		}
-		// Reset the pather when costs change, as per the docs
-		m_Pather->Reset();
+		// Everything worked out from the costs is still good if none of them changed since they were last calculated
+		if (!anyCostsChanged) {
+			return;
+		}
+		m_CostUpdateCount++;
+
+		// The pathers are reset when they're next used, since some may be busy solving right now
+		m_CostsVersion++;
+
+		UpdateClusterEntrances(std::vector<bool>(m_Clusters.size(), true));
+
+		// Flow fields are made again from scratch when they're next asked for, their requests were already counted
+		std::lock_guard<std::mutex> flowFieldsLock(m_FlowFieldsMutex);
+		for (auto &[flowFieldKey, flowField] : m_FlowFields) {
+			flowField.Costs.clear();
+			flowField.NextNodes.clear();
+		}
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void PathFinder::RecalculateAreaCosts(const std::list<Box> &boxList) {
+	bool PathFinder::RecalculateAreaCosts(const std::list<Box> &boxList, bool deferIfBusy) {
+		if (boxList.empty()) {
+			return true;
+		}
+		// Paths being solved hold the costs for as long as the solve takes, so rather than stall the main thread on them, put the update off until they're done
+		std::unique_lock<std::shared_mutex> nodeCostsLock(m_NodeCostsMutex, std::defer_lock);
+		if (deferIfBusy && m_DeferredCostUpdates < c_MaxDeferredCostUpdates) {
+			if (!nodeCostsLock.try_lock()) {
+				m_DeferredCostUpdates++;
+				return false;
+			}
+		} else {
+			nodeCostsLock.lock();
+		}
+		m_DeferredCostUpdates = 0;
+
 		Box box;
+		std::vector<PathNode *> changedNodeList;
 		// Go through all the boxes and see if any of the node centers are inside each
 		for (const Box &boxListEntry : boxList) {
 			// Get the current area box and make sure it's unflipped
@@ -189,7 +384,7 @@ namespace RTE {
 			box.Unflip();
 
 			// Do the updates
-			UpdateNodeCostsInBox(box);
+			UpdateNodeCostsInBox(box, changedNodeList);
 
 			// Take care of all wrapping situations of the box
 			if (g_SceneMan.SceneWrapsX()) {
@@ -197,10 +392,10 @@ namespace RTE {
 
 				if (box.m_Corner.m_X < 0) {
 					temp = Box(Vector(box.m_Corner.m_X + g_SceneMan.GetSceneWidth(), box.m_Corner.m_Y), box.m_Width, box.m_Height);
-					UpdateNodeCostsInBox(temp);
+					UpdateNodeCostsInBox(temp, changedNodeList);
 				} else if (box.m_Corner.m_X + box.m_Width > g_SceneMan.GetSceneWidth()) {
 					temp = Box(Vector(box.m_Corner.m_X - g_SceneMan.GetSceneWidth(), box.m_Corner.m_Y), box.m_Width, box.m_Height);
-					UpdateNodeCostsInBox(temp);
+					UpdateNodeCostsInBox(temp, changedNodeList);
 				}
 			}
 			if (g_SceneMan.SceneWrapsY()) {
@@ -208,60 +403,111 @@ namespace RTE {
 
 				if (box.m_Corner.m_Y < 0) {
 					temp = Box(Vector(box.m_Corner.m_X, box.m_Corner.m_Y + g_SceneMan.GetSceneHeight()), box.m_Width, box.m_Height);
-					UpdateNodeCostsInBox(temp);
+					UpdateNodeCostsInBox(temp, changedNodeList);
 				} else if (box.m_Corner.m_Y + box.m_Height > g_SceneMan.GetSceneHeight()) {
 					temp = Box(Vector(box.m_Corner.m_X, box.m_Corner.m_Y - g_SceneMan.GetSceneHeight()), box.m_Width, box.m_Height);
-					UpdateNodeCostsInBox(temp);
+					UpdateNodeCostsInBox(temp, changedNodeList);
 				}
 			}
 		}
 
-		// Reset the pather when costs change, as per the docs
-		m_Pather->Reset();
-
-		// Reset the changed flag on all nodes
+		// Reset the changed flag on all nodes for the next update
 		for (const std::vector<PathNode *> &nodeEntry : m_NodeGrid) {
 			for (PathNode *pathNode : nodeEntry) {
 				pathNode->IsChanged = false;
 			}
 		}
+		// Digging through air or rebuilding the same terrain doesn't change anything
+		if (changedNodeList.empty()) {
+			return true;
+		}
+		m_CostUpdateCount++;
+
+		// Note which nodes changed and which clusters they're in so only those have their entrances, searches, flow fields and cached paths redone
+		std::vector<bool> changedClusters(m_Clusters.size(), false);
+		std::vector<bool> changedNodes(m_NodeGrid.size() * m_NodeGrid[0].size(), false);
+		std::vector<void *> changedStates;
+		changedStates.reserve(changedNodeList.size());
+		for (PathNode *changedNode : changedNodeList) {
+			int nodeX = GetNodeX(changedNode);
+			int nodeY = GetNodeY(changedNode);
+			changedClusters[GetClusterIndex(nodeX, nodeY)] = true;
+			changedNodes[GetNodeIndex(nodeX, nodeY)] = true;
+			m_NodeCostsChangedAt[GetNodeIndex(nodeX, nodeY)] = m_CostUpdateCount;
+			changedStates.push_back(static_cast<void *>(changedNode));
+		}
+
+		// No paths are being solved while the costs are locked, so all the solvers are idle and can forget what they cached about the changed nodes right away.
+		// The ones that are due to be reset anyway are left alone
+		{
+			std::lock_guard<std::mutex> idleSolversLock(m_IdleSolversMutex);
+			for (const std::unique_ptr<PathSolver> &solver : m_IdleSolvers) {
+				if (solver->CostsVersion == m_CostsVersion) { solver->Pather->StatesChanged(&changedStates); }
+			}
+		}
+
+		UpdateClusterEntrances(changedClusters);
+
+		std::lock_guard<std::mutex> flowFieldsLock(m_FlowFieldsMutex);
+		for (auto &[flowFieldKey, flowField] : m_FlowFields) {
+			if (!flowField.Costs.empty()) { RepairFlowField(flowField, flowFieldKey.first, flowFieldKey.second, changedNodes); }
+		}
+		return true;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	float PathFinder::LeastCostEstimate(void *startState, void *endState) {
+	bool PathFinder::IsPathChangedSince(const std::list<Vector> &path, unsigned int costUpdateCount) const {
+		if (costUpdateCount == m_CostUpdateCount) {
+			return false;
+		}
+		for (Vector waypoint : path) {
+			g_SceneMan.ForceBounds(waypoint);
+			int nodeX = std::floor(waypoint.m_X / static_cast<float>(m_NodeDimension));
+			int nodeY = std::floor(waypoint.m_Y / static_cast<float>(m_NodeDimension));
+			if (m_NodeCostsChangedAt[GetNodeIndex(nodeX, nodeY)] > costUpdateCount) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	float PathFinder::LeastCostEstimate(void *startState, void *endState) const {
 		return g_SceneMan.ShortestDistance((static_cast<PathNode *>(startState))->Pos, (static_cast<PathNode *>(endState))->Pos).GetMagnitude();
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void PathFinder::AdjacentCost(void *state, std::vector<micropather::StateCost> *adjacentList) {
+	void PathFinder::AdjacentCost(void *state, std::vector<micropather::StateCost> *adjacentList, float digStrength) const {
 		const PathNode *node = static_cast<PathNode *>(state);
 		micropather::StateCost adjCost;
 		float strength = 0.0F;
+		s_ExpandedNodeCount++;
 
 		// Add cost for digging upwards
 		if (node->Up) {
 			strength = node->UpCost;
-			adjCost.cost = 1.0F + ((strength > m_DigStrength) ? strength * 2000.0F : strength * 4.0F); // Four times more expensive when digging
+			adjCost.cost = 1.0F + ((strength > digStrength) ? strength * 2000.0F : strength * 4.0F); // Four times more expensive when digging
 			adjCost.state = static_cast<void *>(node->Up);
 			adjacentList->push_back(adjCost);
 		}
 		if (node->Right) {
 			strength = node->RightCost;
-			adjCost.cost = 1.0F + ((strength > m_DigStrength) ? strength * 1000.0F : strength);
+			adjCost.cost = 1.0F + ((strength > digStrength) ? strength * 1000.0F : strength);
 			adjCost.state = static_cast<void *>(node->Right);
 			adjacentList->push_back(adjCost);
 		}
 		if (node->Down) {
 			strength = node->DownCost;
-			adjCost.cost = 1.0F + ((strength > m_DigStrength) ? strength * 1000.0F : strength);
+			adjCost.cost = 1.0F + ((strength > digStrength) ? strength * 1000.0F : strength);
 			adjCost.state = static_cast<void *>(node->Down);
 			adjacentList->push_back(adjCost);
 		}
 		if (node->Left) {
 			strength = node->LeftCost;
-			adjCost.cost = 1.0F + ((strength > m_DigStrength) ? strength * 1000.0F : strength);
+			adjCost.cost = 1.0F + ((strength > digStrength) ? strength * 1000.0F : strength);
 			adjCost.state = static_cast<void *>(node->Left);
 			adjacentList->push_back(adjCost);
 		}
@@ -269,25 +515,25 @@ namespace RTE {
 		// Add cost for digging at 45 degrees and for digging upwards
 		if (node->UpRight) {
 			strength = node->UpRightCost;
-			adjCost.cost = 1.4F + ((strength > m_DigStrength) ? strength * 2828.0F : strength * 4.2F);  // Three times more expensive when digging
+			adjCost.cost = 1.4F + ((strength > digStrength) ? strength * 2828.0F : strength * 4.2F);  // Three times more expensive when digging
 			adjCost.state = static_cast<void *>(node->UpRight);
 			adjacentList->push_back(adjCost);
 		}
 		if (node->RightDown) {
 			strength = node->RightDownCost;
-			adjCost.cost = 1.4F + ((strength > m_DigStrength) ? strength * 1414.0F : strength * 1.4F);
+			adjCost.cost = 1.4F + ((strength > digStrength) ? strength * 1414.0F : strength * 1.4F);
 			adjCost.state = static_cast<void *>(node->RightDown);
 			adjacentList->push_back(adjCost);
 		}
 		if (node->DownLeft) {
 			strength = node->DownLeftCost;
-			adjCost.cost = 1.4F + ((strength > m_DigStrength) ? strength * 1414.0F : strength * 1.4F);
+			adjCost.cost = 1.4F + ((strength > digStrength) ? strength * 1414.0F : strength * 1.4F);
 			adjCost.state = static_cast<void *>(node->DownLeft);
 			adjacentList->push_back(adjCost);
 		}
 		if (node->LeftUp) {
 			strength = node->LeftUpCost;
-			adjCost.cost = 1.4F + ((strength > m_DigStrength) ? strength * 2828.0F : strength * 4.2F);  // Three times more expensive when digging
+			adjCost.cost = 1.4F + ((strength > digStrength) ? strength * 2828.0F : strength * 4.2F);  // Three times more expensive when digging
 			adjCost.state = static_cast<void *>(node->LeftUp);
 			adjacentList->push_back(adjCost);
 		}
@@ -295,10 +541,468 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void PathFinder::UpdateNodeCosts(PathNode *node) {
+	std::unique_ptr<PathFinder::PathSolver> PathFinder::TakeSolver(float digStrength) {
+		std::lock_guard<std::mutex> idleSolversLock(m_IdleSolversMutex);
+		if (m_IdleSolvers.empty()) {
+			return std::make_unique<PathSolver>(this, m_Allocate);
+		}
+		std::vector<std::unique_ptr<PathSolver>>::iterator solverItr = std::find_if(m_IdleSolvers.begin(), m_IdleSolvers.end(), [digStrength](const std::unique_ptr<PathSolver> &solver) { return solver->DigStrength == digStrength; });
+		if (solverItr == m_IdleSolvers.end()) { solverItr = std::prev(m_IdleSolvers.end()); }
+
+		std::unique_ptr<PathSolver> solver = std::move(*solverItr);
+		m_IdleSolvers.erase(solverItr);
+		return solver;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::ReturnSolver(std::unique_ptr<PathSolver> solver) {
+		std::lock_guard<std::mutex> idleSolversLock(m_IdleSolversMutex);
+		m_IdleSolvers.emplace_back(std::move(solver));
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::CreateClusters() {
+		int nodeXCount = m_NodeGrid.size();
+		int nodeYCount = m_NodeGrid[0].size();
+		m_ClusterXCount = (nodeXCount + c_ClusterSize - 1) / c_ClusterSize;
+		m_ClusterYCount = (nodeYCount + c_ClusterSize - 1) / c_ClusterSize;
+
+		// Clusters are laid out column by column to match GetClusterIndex. The ones at the far edges are smaller if the node grid doesn't divide evenly
+		m_Clusters.clear();
+		m_Clusters.reserve(m_ClusterXCount * m_ClusterYCount);
+		for (int clusterX = 0; clusterX < m_ClusterXCount; ++clusterX) {
+			for (int clusterY = 0; clusterY < m_ClusterYCount; ++clusterY) {
+				PathCluster cluster;
+				cluster.FirstNodeX = clusterX * c_ClusterSize;
+				cluster.FirstNodeY = clusterY * c_ClusterSize;
+				cluster.Width = std::min(c_ClusterSize, nodeXCount - cluster.FirstNodeX);
+				cluster.Height = std::min(c_ClusterSize, nodeYCount - cluster.FirstNodeY);
+				m_Clusters.push_back(cluster);
+			}
+		}
+
+		// Set up a pair of entrances across every stretch of the right and bottom borders of each cluster. Going across the borders the other way is covered by the neighbouring clusters' right and bottom borders
+		m_ClusterEntrances.clear();
+		m_ClusterBorderSegments.clear();
+		int clusterCount = static_cast<int>(m_Clusters.size());
+		for (int clusterIndex = 0; clusterIndex < clusterCount; ++clusterIndex) {
+			const PathCluster &cluster = m_Clusters[clusterIndex];
+			for (bool horizontal : { false, true }) {
+				int borderLength = horizontal ? cluster.Width : cluster.Height;
+				int nearNodeX = horizontal ? cluster.FirstNodeX : cluster.FirstNodeX + cluster.Width - 1;
+				int nearNodeY = horizontal ? cluster.FirstNodeY + cluster.Height - 1 : cluster.FirstNodeY;
+				const PathNode *farNode = horizontal ? m_NodeGrid[nearNodeX][nearNodeY]->Down : m_NodeGrid[nearNodeX][nearNodeY]->Right;
+				// Nothing on the other side of a non-wrapping scene edge, or only this same cluster if it spans the whole of a wrapping one
+				if (!farNode) {
+					continue;
+				}
+				int farClusterIndex = GetClusterIndex(GetNodeX(farNode), GetNodeY(farNode));
+				if (farClusterIndex == clusterIndex) {
+					continue;
+				}
+				for (int segmentStart = 0; segmentStart < borderLength; segmentStart += c_EntranceSpacing) {
+					ClusterBorderSegment segment;
+					segment.FirstNodeX = nearNodeX + (horizontal ? segmentStart : 0);
+					segment.FirstNodeY = nearNodeY + (horizontal ? 0 : segmentStart);
+					segment.Length = std::min(c_EntranceSpacing, borderLength - segmentStart);
+					segment.Horizontal = horizontal;
+					segment.Entrance = m_ClusterEntrances.size();
+					m_ClusterBorderSegments.push_back(segment);
+
+					int nearEntrance = segment.Entrance;
+					int farEntrance = segment.Entrance + 1;
+					m_ClusterEntrances.push_back({ nullptr, clusterIndex, static_cast<int>(m_Clusters[clusterIndex].Entrances.size()), farEntrance });
+					m_Clusters[clusterIndex].Entrances.push_back(nearEntrance);
+					m_ClusterEntrances.push_back({ nullptr, farClusterIndex, static_cast<int>(m_Clusters[farClusterIndex].Entrances.size()), nearEntrance });
+					m_Clusters[farClusterIndex].Entrances.push_back(farEntrance);
+				}
+			}
+		}
+		m_ClusterEntranceTrees.clear();
+		m_ClusterEntranceTrees.resize(m_Clusters.size());
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::UpdateClusterEntrances(const std::vector<bool> &changedClusters) {
+		std::vector<bool> invalidatedClusters = changedClusters;
+
+		for (const ClusterBorderSegment &segment : m_ClusterBorderSegments) {
+			ClusterEntrance &nearEntrance = m_ClusterEntrances[segment.Entrance];
+			ClusterEntrance &farEntrance = m_ClusterEntrances[nearEntrance.Partner];
+			if (!changedClusters[nearEntrance.Cluster] && !changedClusters[farEntrance.Cluster]) {
+				continue;
+			}
+			// Cross where the material is the weakest, preferring the middle of the segment when it's all the same
+			PathNode *bestNode = nullptr;
+			float bestStrength = FLT_MAX;
+			int bestMiddleDistance = std::numeric_limits<int>::max();
+			for (int i = 0; i < segment.Length; ++i) {
+				PathNode *node = m_NodeGrid[segment.FirstNodeX + (segment.Horizontal ? i : 0)][segment.FirstNodeY + (segment.Horizontal ? 0 : i)];
+				float strength = segment.Horizontal ? std::max(node->DownCost, node->Down->UpCost) : std::max(node->RightCost, node->Right->LeftCost);
+				int middleDistance = std::abs(2 * i - (segment.Length - 1));
+				if (!bestNode || strength < bestStrength || (strength == bestStrength && middleDistance < bestMiddleDistance)) {
+					bestNode = node;
+					bestStrength = strength;
+					bestMiddleDistance = middleDistance;
+				}
+			}
+			if (bestNode != nearEntrance.Node) {
+				nearEntrance.Node = bestNode;
+				farEntrance.Node = segment.Horizontal ? bestNode->Down : bestNode->Right;
+				invalidatedClusters[nearEntrance.Cluster] = true;
+				invalidatedClusters[farEntrance.Cluster] = true;
+			}
+		}
+
+		std::lock_guard<std::mutex> entranceTreesLock(m_ClusterEntranceTreesMutex);
+		for (size_t clusterIndex = 0; clusterIndex < m_Clusters.size(); ++clusterIndex) {
+			if (invalidatedClusters[clusterIndex]) { m_ClusterEntranceTrees[clusterIndex].clear(); }
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	PathFinder::ClusterSearchTree PathFinder::SearchCluster(const PathCluster &cluster, const PathNode *origin, float digStrength) const {
+		int nodeCount = cluster.Width * cluster.Height;
+		ClusterSearchTree searchTree;
+		searchTree.Costs.resize(nodeCount, FLT_MAX);
+		searchTree.Parents.resize(nodeCount, -1);
+
+		// Plain Dijkstra, the clusters are small enough that a heuristic wouldn't save much
+		OpenNodeQueue openNodes;
+		int originIndex = GetIndexInCluster(cluster, origin);
+		searchTree.Costs[originIndex] = 0;
+		openNodes.emplace(0.0F, originIndex);
+
+		std::vector<micropather::StateCost> adjacentList;
+		while (!openNodes.empty()) {
+			auto [nodeCost, nodeIndex] = openNodes.top();
+			openNodes.pop();
+			// This was opened again more cheaply since, and already expanded at that cost
+			if (nodeCost > searchTree.Costs[nodeIndex]) {
+				continue;
+			}
+			adjacentList.clear();
+			AdjacentCost(static_cast<void *>(m_NodeGrid[cluster.FirstNodeX + nodeIndex % cluster.Width][cluster.FirstNodeY + nodeIndex / cluster.Width]), &adjacentList, digStrength);
+			for (const micropather::StateCost &adjacentCost : adjacentList) {
+				const PathNode *adjacentNode = static_cast<const PathNode *>(adjacentCost.state);
+				int adjacentX = GetNodeX(adjacentNode) - cluster.FirstNodeX;
+				int adjacentY = GetNodeY(adjacentNode) - cluster.FirstNodeY;
+				if (adjacentX < 0 || adjacentX >= cluster.Width || adjacentY < 0 || adjacentY >= cluster.Height) {
+					continue;
+				}
+				int adjacentIndex = adjacentX + adjacentY * cluster.Width;
+				float adjacentNodeCost = nodeCost + adjacentCost.cost;
+				if (adjacentNodeCost < searchTree.Costs[adjacentIndex]) {
+					searchTree.Costs[adjacentIndex] = adjacentNodeCost;
+					searchTree.Parents[adjacentIndex] = nodeIndex;
+					openNodes.emplace(adjacentNodeCost, adjacentIndex);
+				}
+			}
+		}
+		return searchTree;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::shared_ptr<const std::vector<PathFinder::ClusterSearchTree>> PathFinder::GetClusterEntranceTrees(int clusterIndex, float digStrength) {
+		digStrength = GetDigStrengthClass(digStrength);
+		{
+			std::lock_guard<std::mutex> entranceTreesLock(m_ClusterEntranceTreesMutex);
+			if (auto entranceTreesItr = m_ClusterEntranceTrees[clusterIndex].find(digStrength); entranceTreesItr != m_ClusterEntranceTrees[clusterIndex].end()) {
+				return entranceTreesItr->second;
+			}
+		}
+
+		// Search outside of the lock so other threads using clusters that are already searched don't have to wait on this
+		const PathCluster &cluster = m_Clusters[clusterIndex];
+		std::shared_ptr<std::vector<ClusterSearchTree>> entranceTrees = std::make_shared<std::vector<ClusterSearchTree>>();
+		entranceTrees->reserve(cluster.Entrances.size());
+		for (int entrance : cluster.Entrances) {
+			entranceTrees->emplace_back(SearchCluster(cluster, m_ClusterEntrances[entrance].Node, digStrength));
+		}
+
+		std::lock_guard<std::mutex> entranceTreesLock(m_ClusterEntranceTreesMutex);
+		std::unordered_map<float, std::shared_ptr<const std::vector<ClusterSearchTree>>> &clusterEntranceTrees = m_ClusterEntranceTrees[clusterIndex];
+		// Another thread may have gotten to searching the same cluster in the meantime, in which case its results are just as good
+		if (auto entranceTreesItr = clusterEntranceTrees.find(digStrength); entranceTreesItr != clusterEntranceTrees.end()) {
+			return entranceTreesItr->second;
+		}
+		// Make room by dropping the searches of another class. Searches that are still in use are kept alive by their users
+		if (clusterEntranceTrees.size() >= c_MaxEntranceTreeDigClasses) { clusterEntranceTrees.erase(clusterEntranceTrees.begin()); }
+		return clusterEntranceTrees.try_emplace(digStrength, entranceTrees).first->second;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::AddClusterSearchPath(const PathCluster &cluster, const ClusterSearchTree &searchTree, const PathNode *target, std::vector<void *> &statePath) const {
+		size_t firstAddedState = statePath.size();
+		for (int nodeIndex = GetIndexInCluster(cluster, target); searchTree.Parents[nodeIndex] != -1; nodeIndex = searchTree.Parents[nodeIndex]) {
+			statePath.push_back(static_cast<void *>(m_NodeGrid[cluster.FirstNodeX + nodeIndex % cluster.Width][cluster.FirstNodeY + nodeIndex / cluster.Width]));
+		}
+		std::reverse(statePath.begin() + firstAddedState, statePath.end());
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PathFinder::CalculateHierarchicalPath(PathNode *startNode, PathNode *endNode, float digStrength, std::vector<void *> &statePath, float &totalCostResult) {
+		int startClusterIndex = GetClusterIndex(GetNodeX(startNode), GetNodeY(startNode));
+		int endClusterIndex = GetClusterIndex(GetNodeX(endNode), GetNodeY(endNode));
+		const PathCluster &startCluster = m_Clusters[startClusterIndex];
+
+		// The states of the abstract search are the entrances, followed by the start and end nodes
+		int entranceCount = m_ClusterEntrances.size();
+		int startState = entranceCount;
+		int endState = entranceCount + 1;
+		auto getStateNode = [&](int state) { return (state == startState) ? startNode : ((state == endState) ? endNode : m_ClusterEntrances[state].Node); };
+
+		std::vector<float> stateCosts(entranceCount + 2, FLT_MAX);
+		std::vector<int> stateParents(entranceCount + 2, -1);
+		std::vector<bool> closedStates(entranceCount + 2, false);
+		std::vector<std::shared_ptr<const std::vector<ClusterSearchTree>>> entranceTrees(m_Clusters.size());
+		ClusterSearchTree startSearchTree = SearchCluster(startCluster, startNode, digStrength);
+
+		// The estimate is a lower bound on the cost that holds along every step, so no cheaper way to an already expanded state can turn up later
+		using OpenState = std::tuple<float, float, int>;
+		std::priority_queue<OpenState, std::vector<OpenState>, std::greater<OpenState>> openStates;
+		auto openState = [&](int state, int parentState, float cost) {
+			if (!closedStates[state] && cost < stateCosts[state]) {
+				stateCosts[state] = cost;
+				stateParents[state] = parentState;
+				openStates.emplace(cost + HierarchicalCostEstimate(getStateNode(state), endNode), cost, state);
+			}
+		};
+		stateCosts[startState] = 0;
+		openStates.emplace(HierarchicalCostEstimate(startNode, endNode), 0.0F, startState);
+
+		std::vector<micropather::StateCost> adjacentList;
+		while (!openStates.empty()) {
+			auto [stateEstimate, stateCost, state] = openStates.top();
+			openStates.pop();
+			if (state == endState) {
+				break;
+			} else if (closedStates[state] || stateCost > stateCosts[state]) {
+				// This was opened again more cheaply since, and already expanded at that cost
+				continue;
+			}
+			closedStates[state] = true;
+
+			if (state == startState) {
+				for (int entrance : startCluster.Entrances) {
+					openState(entrance, state, startSearchTree.Costs[GetIndexInCluster(startCluster, m_ClusterEntrances[entrance].Node)]);
+				}
+				continue;
+			}
+			const ClusterEntrance &entrance = m_ClusterEntrances[state];
+			const PathCluster &cluster = m_Clusters[entrance.Cluster];
+			if (!entranceTrees[entrance.Cluster]) { entranceTrees[entrance.Cluster] = GetClusterEntranceTrees(entrance.Cluster, digStrength); }
+			const ClusterSearchTree &searchTree = (*entranceTrees[entrance.Cluster])[entrance.LocalIndex];
+
+			// Go to the other entrances of the same cluster, or to the end if it's in this cluster
+			for (int otherEntrance : cluster.Entrances) {
+				if (otherEntrance != state) { openState(otherEntrance, state, stateCost + searchTree.Costs[GetIndexInCluster(cluster, m_ClusterEntrances[otherEntrance].Node)]); }
+			}
+			if (entrance.Cluster == endClusterIndex) { openState(endState, state, stateCost + searchTree.Costs[GetIndexInCluster(cluster, endNode)]); }
+
+			// Or cross the border into the neighbouring cluster
+			adjacentList.clear();
+			AdjacentCost(static_cast<void *>(entrance.Node), &adjacentList, digStrength);
+			for (const micropather::StateCost &adjacentCost : adjacentList) {
+				if (adjacentCost.state == static_cast<void *>(m_ClusterEntrances[entrance.Partner].Node)) {
+					openState(entrance.Partner, state, stateCost + adjacentCost.cost);
+					break;
+				}
+			}
+		}
+		if (stateParents[endState] == -1) {
+			return false;
+		}
+
+		std::vector<int> abstractPath;
+		for (int state = endState; state != -1; state = stateParents[state]) {
+			abstractPath.push_back(state);
+		}
+		std::reverse(abstractPath.begin(), abstractPath.end());
+
+		// Refine the path between each pair of states to the nodes along it, which the searches within the clusters already know
+		statePath.clear();
+		statePath.push_back(static_cast<void *>(startNode));
+		for (size_t i = 1; i < abstractPath.size(); ++i) {
+			int previousState = abstractPath[i - 1];
+			int state = abstractPath[i];
+			if (previousState == startState) {
+				AddClusterSearchPath(startCluster, startSearchTree, m_ClusterEntrances[state].Node, statePath);
+				continue;
+			}
+			const ClusterEntrance &previousEntrance = m_ClusterEntrances[previousState];
+			if (state == previousEntrance.Partner) {
+				statePath.push_back(static_cast<void *>(m_ClusterEntrances[state].Node));
+			} else {
+				const ClusterSearchTree &searchTree = (*entranceTrees[previousEntrance.Cluster])[previousEntrance.LocalIndex];
+				AddClusterSearchPath(m_Clusters[previousEntrance.Cluster], searchTree, (state == endState) ? endNode : m_ClusterEntrances[state].Node, statePath);
+			}
+		}
+		totalCostResult = stateCosts[endState];
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	float PathFinder::HierarchicalCostEstimate(const PathNode *startNode, const PathNode *endNode) const {
+		// A diagonal step costs 1.4 for a length of sqrt(2) nodes, the least per length of any step
+		return g_SceneMan.ShortestDistance(startNode->Pos, endNode->Pos).GetMagnitude() * (1.4F / (std::sqrt(2.0F) * static_cast<float>(m_NodeDimension)));
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	float PathFinder::GetDigStrengthClass(float digStrength) const {
+		std::vector<float>::const_iterator strongerItr = std::upper_bound(m_MaterialStrengths.begin(), m_MaterialStrengths.end(), digStrength);
+		return (strongerItr == m_MaterialStrengths.begin()) ? 0.0F : *(strongerItr - 1);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::QueueBuildFlowField(const std::pair<PathNode *, float> &flowFieldKey) {
+		m_PendingRequests.remove_if([](const std::future<void> &pendingRequest) { return pendingRequest.wait_for(std::chrono::seconds(0)) == std::future_status::ready; });
+		m_PendingRequests.emplace_back(g_ThreadMan.QueueTask([this, flowFieldKey]() {
+			// The costs are held until the flow field is in place, so it can't miss any changes made to them in between
+			std::shared_lock<std::shared_mutex> nodeCostsLock(m_NodeCostsMutex);
+			FlowField builtFlowField;
+			BuildFlowField(builtFlowField, flowFieldKey.first, flowFieldKey.second);
+
+			std::lock_guard<std::mutex> flowFieldsLock(m_FlowFieldsMutex);
+			std::map<std::pair<PathNode *, float>, FlowField>::iterator flowFieldItr = m_FlowFields.find(flowFieldKey);
+			if (flowFieldItr != m_FlowFields.end()) {
+				flowFieldItr->second.Costs = std::move(builtFlowField.Costs);
+				flowFieldItr->second.NextNodes = std::move(builtFlowField.NextNodes);
+				flowFieldItr->second.Building = false;
+			}
+		}));
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::BuildFlowField(FlowField &flowField, PathNode *destination, float digStrength) const {
+		int nodeCount = m_NodeGrid.size() * m_NodeGrid[0].size();
+		flowField.Costs.assign(nodeCount, FLT_MAX);
+		flowField.NextNodes.assign(nodeCount, nullptr);
+
+		int destinationIndex = GetNodeIndex(GetNodeX(destination), GetNodeY(destination));
+		flowField.Costs[destinationIndex] = 0;
+		OpenNodeQueue openNodes;
+		openNodes.emplace(0.0F, destinationIndex);
+		SpreadFlowField(flowField, digStrength, openNodes);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::RepairFlowField(FlowField &flowField, PathNode *destination, float digStrength, const std::vector<bool> &changedNodes) const {
+		int nodeCount = flowField.Costs.size();
+		int nodeYCount = m_NodeGrid[0].size();
+
+		// Find all the nodes whose ways to the destination lead through a changed node, since those may have gotten more expensive. Each way is only followed until it meets one that's already known
+		std::vector<signed char> affectedNodes(nodeCount, -1);
+		affectedNodes[GetNodeIndex(GetNodeX(destination), GetNodeY(destination))] = 0;
+		std::vector<int> wayNodes;
+		for (int nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex) {
+			wayNodes.clear();
+			signed char affected = 0;
+			for (int wayNodeIndex = nodeIndex; ; ) {
+				if (affectedNodes[wayNodeIndex] != -1) {
+					affected = affectedNodes[wayNodeIndex];
+					break;
+				}
+				wayNodes.push_back(wayNodeIndex);
+				if (changedNodes[wayNodeIndex]) {
+					affected = 1;
+					break;
+				}
+				const PathNode *nextNode = flowField.NextNodes[wayNodeIndex];
+				if (!nextNode) {
+					break;
+				}
+				wayNodeIndex = GetNodeIndex(GetNodeX(nextNode), GetNodeY(nextNode));
+			}
+			for (int wayNodeIndex : wayNodes) {
+				affectedNodes[wayNodeIndex] = affected;
+			}
+		}
+		for (int nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex) {
+			if (affectedNodes[nodeIndex] == 1) {
+				flowField.Costs[nodeIndex] = FLT_MAX;
+				flowField.NextNodes[nodeIndex] = nullptr;
+			}
+		}
+
+		// Work out the affected nodes again from their unaffected neighbours, then spread from them. That also carries any costs that went down on to the unaffected nodes
+		OpenNodeQueue openNodes;
+		std::vector<micropather::StateCost> adjacentList;
+		for (int nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex) {
+			if (affectedNodes[nodeIndex] != 1) {
+				continue;
+			}
+			adjacentList.clear();
+			AdjacentCost(static_cast<void *>(m_NodeGrid[nodeIndex / nodeYCount][nodeIndex % nodeYCount]), &adjacentList, digStrength);
+			for (const micropather::StateCost &adjacentCost : adjacentList) {
+				PathNode *adjacentNode = static_cast<PathNode *>(adjacentCost.state);
+				int adjacentIndex = GetNodeIndex(GetNodeX(adjacentNode), GetNodeY(adjacentNode));
+				if (affectedNodes[adjacentIndex] != 1 && flowField.Costs[adjacentIndex] != FLT_MAX && flowField.Costs[adjacentIndex] + adjacentCost.cost < flowField.Costs[nodeIndex]) {
+					flowField.Costs[nodeIndex] = flowField.Costs[adjacentIndex] + adjacentCost.cost;
+					flowField.NextNodes[nodeIndex] = adjacentNode;
+				}
+			}
+			if (flowField.Costs[nodeIndex] != FLT_MAX) { openNodes.emplace(flowField.Costs[nodeIndex], nodeIndex); }
+		}
+		SpreadFlowField(flowField, digStrength, openNodes);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::SpreadFlowField(FlowField &flowField, float digStrength, OpenNodeQueue &openNodes) const {
+		int nodeYCount = m_NodeGrid[0].size();
+		std::vector<micropather::StateCost> adjacentList;
+		while (!openNodes.empty()) {
+			auto [nodeCost, nodeIndex] = openNodes.top();
+			openNodes.pop();
+			// This was opened again more cheaply since, and already spread from at that cost
+			if (nodeCost > flowField.Costs[nodeIndex]) {
+				continue;
+			}
+			PathNode *node = m_NodeGrid[nodeIndex / nodeYCount][nodeIndex % nodeYCount];
+
+			// Costs are directional, so look at the cost of going from each adjacent node to this one rather than the other way around
+			for (PathNode *adjacentNode : { node->Up, node->Right, node->Down, node->Left, node->UpRight, node->RightDown, node->DownLeft, node->LeftUp }) {
+				if (!adjacentNode) {
+					continue;
+				}
+				adjacentList.clear();
+				AdjacentCost(static_cast<void *>(adjacentNode), &adjacentList, digStrength);
+				for (const micropather::StateCost &adjacentCost : adjacentList) {
+					if (adjacentCost.state == static_cast<void *>(node)) {
+						int adjacentIndex = GetNodeIndex(GetNodeX(adjacentNode), GetNodeY(adjacentNode));
+						if (nodeCost + adjacentCost.cost < flowField.Costs[adjacentIndex]) {
+							flowField.Costs[adjacentIndex] = nodeCost + adjacentCost.cost;
+							flowField.NextNodes[adjacentIndex] = node;
+							openNodes.emplace(flowField.Costs[adjacentIndex], adjacentIndex);
+						}
+						break;
+					}
+				}
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PathFinder::UpdateNodeCosts(PathNode *node) {
 		if (!node) {
-			return;
+			return false;
 		}
+		std::array<float, 8> previousCosts = { node->UpCost, node->RightCost, node->DownCost, node->LeftCost, node->UpRightCost, node->RightDownCost, node->DownLeftCost, node->LeftUpCost };
+
 		// Look at each existing adjacent node and calculate the cost for each, offset start and end to cover more terrain
 		if (node->Up) { node->UpCost = std::max(node->Up->DownCost, CostAlongLine(node->Pos + Vector(3, 0), node->Up->Pos + Vector(3, 0))); }
 		if (node->Right) { node->RightCost = CostAlongLine(node->Pos + Vector(0, 3), node->Right->Pos + Vector(0, 3)); }
@@ -312,11 +1016,13 @@ namespace RTE {
 
 		// Mark this as already changed so the above expensive calculation isn't done redundantly
 		node->IsChanged = true;
+
+		return previousCosts != std::array<float, 8>({ node->UpCost, node->RightCost, node->DownCost, node->LeftCost, node->UpRightCost, node->RightDownCost, node->DownLeftCost, node->LeftUpCost });
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void PathFinder::UpdateNodeCostsInBox(Box &box) {
+	void PathFinder::UpdateNodeCostsInBox(Box &box, std::vector<PathNode *> &changedNodes) {
 		box.Unflip();
 
 		// Get the extents of the box' potential influence on nodes and their connecting edges
@@ -337,7 +1043,7 @@ namespace RTE {
 			for (int nodeY = firstY; nodeY <= lastY; ++nodeY) {
 				node = m_NodeGrid[nodeX][nodeY];
 				// Update all the costs going out from each node which is found to be affected by the box
-				if (!node->IsChanged) { UpdateNodeCosts(node); }
+				if (!node->IsChanged && UpdateNodeCosts(node)) { changedNodes.push_back(node); }
 			}
 		}
 	}
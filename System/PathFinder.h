@@ -15,7 +15,7 @@ namespace RTE {
 	struct PathNode {
 
 		Vector Pos; //!< Absolute position of the center of this node in the scene.
-		bool IsChanged; //!< Whether this has been updated since last call to Reset the pather.
+		bool IsChanged; //!< Whether the costs of this have been recalculated during the current cost update, so it isn't done more than once.
 
 		/// <summary>
 		/// Pointers to all adjacent nodes. These are not owned, and may be 0 if adjacent to non-wrapping scene border.
@@ -49,10 +49,25 @@ namespace RTE {
 		}
 	};
 
+	/// <summary>
+	/// A request to calculate a path on worker threads. Nothing but Complete may be read until Complete is true, after which the request is no longer touched by the worker threads.
+	/// </summary>
+	struct PathRequest {
+
+		std::atomic<bool> Complete = false; //!< Whether the path has been calculated.
+		int Status = MicroPather::NO_SOLUTION; //!< Success or failure of the calculation, expressed as SOLVED, NO_SOLUTION, or START_END_SAME.
+		std::list<Vector> Path; //!< The waypoints between the start and end.
+		float TotalCost = 0; //!< The total minimum difficulty cost calculated between the start and end.
+		Vector StartPos; //!< The start position the path was requested from.
+		Vector TargetPos; //!< The end position the path was requested to.
+	};
+
 	/// <summary>
 	/// A class encapsulating and implementing the MicroPather A* pathfinding library.
+	/// Paths can be calculated from any thread and several at once, each calculation using its own pather. The costs between nodes may only be recalculated from the main thread.
+	/// Long paths are found hierarchically: the node grid is divided into clusters, a path is first found between entrances on the cluster borders and then refined to the nodes within each cluster it passes through.
 	/// </summary>
-	class PathFinder : public Graph {
+	class PathFinder {
 
 	public:
 
@@ -79,7 +94,7 @@ namespace RTE {
 		/// <summary>
 		/// Destructor method used to clean up a PathFinder object before deletion.
 		/// </summary>
-		~PathFinder() override { Destroy(); }
+		~PathFinder() { Destroy(); }
 
 		/// <summary>
 		/// Destroys and resets (through Clear()) this PathFinder object.
@@ -92,6 +107,22 @@ namespace RTE {
 		void Reset() { Clear(); }
 #pragma endregion
 
+#pragma region Getters
+		/// <summary>
+		/// Gets the node a point on the scene is in.
+		/// </summary>
+		/// <param name="pos">The point on the scene to get the node of. Wrapped or clamped to the scene if outside of it.</param>
+		/// <returns>The node the point is in. Ownership is NOT transferred!</returns>
+		PathNode * GetNodeAt(Vector pos) const;
+
+		/// <summary>
+		/// Gets how many nodes have had their adjacent nodes looked up by searches on the calling thread, by any PathFinder. Meant for benchmarking the searches.
+		/// Adjacent nodes that a pather had cached aren't looked up again, so they don't count.
+		/// </summary>
+		/// <returns>The number of nodes expanded on the calling thread so far.</returns>
+		static unsigned long long GetExpandedNodeCount() { return s_ExpandedNodeCount; }
+#pragma endregion
+
 #pragma region PathFinding
 		/// <summary>
 		/// Calculates and returns the least difficult path between two points on the current scene.
@@ -105,27 +136,66 @@ namespace RTE {
 		int CalculatePath(Vector start, Vector end, std::list<Vector> &pathResult, float &totalCostResult, float digStrength = 1);
 
 		/// <summary>
-		/// Recalculates all the costs between all the nodes by tracing lines in the material layer and summing all the material strengths for each encountered pixel. Also resets the pather itself.
+		/// Queues the least difficult path between two points on the current scene to be calculated on the worker threads, without waiting for it.
+		/// </summary>
+		/// <param name="start">Start positions on the scene to find the path between.</param>
+		/// <param name="end">End positions on the scene to find the path between.</param>
+		/// <param name="digStrength">What material strength the search is capable of digging through.</param>
+		/// <returns>The request, which will be marked complete once the path has been calculated.</returns>
+		std::shared_ptr<PathRequest> CalculatePathAsync(const Vector &start, const Vector &end, float digStrength = 1);
+
+		/// <summary>
+		/// Gets the least difficult path between two points from a flow field shared by everything heading to the same destination, if enough paths have been asked for to there lately to warrant making one.
+		/// Flow fields are kept for each destination node and dig strength class, and are made on the worker threads, so the first paths asked for after one is warranted are still not from it. Must only be called from the main thread.
+		/// </summary>
+		/// <param name="start">Start positions on the scene to find the path between.</param>
+		/// <param name="end">End positions on the scene to find the path between.</param>
+		/// <param name="pathResult">A list which will be filled out with waypoints between the start and end. Left untouched if there's no flow field to the end yet.</param>
+		/// <param name="totalCostResult">The total minimum difficulty cost calculated between the two points on the scene.</param>
+		/// <param name="digStrength">What material strength the search is capable of digging through. Flow fields are shared by the dig strengths that can dig through the same materials, see GetDigStrengthClass.</param>
+		/// <returns>Whether the path was gotten from a flow field. If not, it should be calculated with CalculatePath or CalculatePathAsync instead.</returns>
+		bool GetFlowFieldPath(Vector start, Vector end, std::list<Vector> &pathResult, float &totalCostResult, float digStrength = 1);
+
+		/// <summary>
+		/// Recalculates all the costs between all the nodes by tracing lines in the material layer and summing all the material strengths for each encountered pixel. Also resets the pather itself if any costs changed.
 		/// </summary>
 		void RecalculateAllCosts();
 
 		/// <summary>
-		/// Recalculates the costs between all the nodes touching a list of specific rectangular areas (which will be wrapped). Also resets the pather itself.
+		/// Recalculates the costs between all the nodes touching a list of specific rectangular areas (which will be wrapped).
+		/// Only the nodes whose costs actually changed are passed on, so only the cached paths through them are forgotten.
 		/// </summary>
 		/// <param name="boxList">The list of Boxes representing the updated areas.</param>
-		void RecalculateAreaCosts(const std::list<Box> &boxList);
+		/// <param name="deferIfBusy">
+		/// Whether to leave the costs be if paths are being solved on the worker threads right now, instead of waiting for them to finish.
+		/// The areas should then be passed in again later. Once deferred c_MaxDeferredCostUpdates times in a row, this waits anyway so the costs can't go stale indefinitely.
+		/// </param>
+		/// <returns>Whether the costs were recalculated. Always true if not deferring.</returns>
+		bool RecalculateAreaCosts(const std::list<Box> &boxList, bool deferIfBusy = false);
+
+		/// <summary>
+		/// Gets how many cost recalculations so far actually changed any costs, for telling whether paths found before may have become outdated.
+		/// </summary>
+		/// <returns>The number of cost recalculations that changed any costs.</returns>
+		unsigned int GetCostUpdateCount() const { return m_CostUpdateCount; }
+
+		/// <summary>
+		/// Tells whether the costs along a path have changed since a given cost update, meaning it may no longer be the least difficult or even passable. Must only be called from the main thread.
+		/// </summary>
+		/// <param name="path">The waypoints of the path to check, as calculated between node centers.</param>
+		/// <param name="costUpdateCount">The cost update count from when the path was calculated.</param>
+		/// <returns>Whether the costs going out of any of the nodes along the path have changed since then.</returns>
+		bool IsPathChangedSince(const std::list<Vector> &path, unsigned int costUpdateCount) const;
 
 		/// <summary>
-		/// Implementation of the abstract interface of Graph.
 		/// Gets the least possible cost to get from node A to B, if it all was air.
 		/// </summary>
 		/// <param name="startState">Pointer to node to start from. OWNERSHIP IS NOT TRANSFERRED!</param>
 		/// <param name="endState">Node to end up at. OWNERSHIP IS NOT TRANSFERRED!</param>
 		/// <returns>The cost of the absolutely fastest possible way between the two points, as if traveled through air all the way.</returns>
-		float LeastCostEstimate(void *startState, void *endState) override;
+		float LeastCostEstimate(void *startState, void *endState) const;
 
 		/// <summary>
-		/// Implementation of the abstract interface of Graph.
 		/// Gets the cost to go to any adjacent node of the one passed in.
 		/// </summary>
 		/// <param name="state">Pointer to node to get to cost of all adjacents for. OWNERSHIP IS NOT TRANSFERRED!</param>
@@ -133,28 +203,306 @@ namespace RTE {
 		/// An empty vector which will be filled out with all the valid nodes adjacent to the one passed in.
 		/// If at non-wrapping edge of seam, those non existent nodes won't be added.
 		/// </param>
-		void AdjacentCost(void *state, std::vector<micropather::StateCost> *adjacentList) override;
+		/// <param name="digStrength">What material strength the search is capable of digging through.</param>
+		void AdjacentCost(void *state, std::vector<micropather::StateCost> *adjacentList, float digStrength) const;
 #pragma endregion
 
-#pragma region Misc
+	protected:
+
+		static thread_local unsigned long long s_ExpandedNodeCount; //!< How many nodes have had their adjacent nodes looked up on each thread.
+
+		static constexpr int c_ClusterSize = 10; //!< The width and height of each cluster of nodes used for hierarchical pathfinding, in nodes.
+		static constexpr int c_EntranceSpacing = 5; //!< The length of the stretches of cluster borders that each get one entrance, in nodes.
+		static constexpr int c_MaxEntranceTreeDigClasses = 4; //!< How many dig strength classes the entrance searches of each cluster are kept for at once.
+
+		static constexpr int c_FlowFieldRequestThreshold = 3; //!< How many paths need to be asked for to the same destination before a flow field is made for it.
+		static constexpr int c_MaxFlowFields = 16; //!< How many flow fields can be kept at once. The ones asked for least recently are dropped first.
+		static constexpr int c_MaxFlowFieldCandidates = 64; //!< How many destinations to count path requests to at once, including the ones that have flow fields.
+
 		/// <summary>
-		/// Implementation of the abstract interface of Graph. This function is only used in DEBUG mode - it dumps output to stdout.
-		/// Since void* aren't really human readable, this will print out some concise info without an ending newline.
+		/// A rectangular block of nodes. Paths that span many clusters are first found between the entrances of clusters, then refined to the nodes within them.
 		/// </summary>
-		/// <param name="state">The state to print out info about.</param>
-		void PrintStateInfo(void *state) override {}
-#pragma endregion
+		struct PathCluster {
+			int FirstNodeX; //!< The X index of the top left node of this in the node grid.
+			int FirstNodeY; //!< The Y index of the top left node of this in the node grid.
+			int Width; //!< The width of this, in nodes.
+			int Height; //!< The height of this, in nodes.
+			std::vector<int> Entrances; //!< The indices of all the entrances into this in the entrance list.
+		};
 
-	protected:
+		/// <summary>
+		/// A node on the border of a cluster that paths cross through into the neighbouring cluster.
+		/// </summary>
+		struct ClusterEntrance {
+			PathNode *Node; //!< The node of this. Not owned.
+			int Cluster; //!< The index of the cluster this is in.
+			int LocalIndex; //!< The index of this in the entrance list of its cluster.
+			int Partner; //!< The index of the entrance on the other side of the border, which is adjacent to this.
+		};
+
+		/// <summary>
+		/// A stretch of the right or bottom border of a cluster that has one pair of entrances across it. The entrances are placed where crossing the border is the easiest.
+		/// </summary>
+		struct ClusterBorderSegment {
+			int FirstNodeX; //!< The X index of the first node of this on the near side of the border.
+			int FirstNodeY; //!< The Y index of the first node of this on the near side of the border.
+			int Length; //!< The length of this, in nodes.
+			bool Horizontal; //!< Whether this runs along a bottom border, crossing downwards. Otherwise it runs along a right border, crossing rightwards.
+			int Entrance; //!< The index of the entrance on the near side of the border. Its partner is on the far side.
+		};
+
+		/// <summary>
+		/// The results of searching from one node to all others within a cluster.
+		/// </summary>
+		struct ClusterSearchTree {
+			std::vector<float> Costs; //!< The least cost to get to each node in the cluster, by their index within the cluster. FLT_MAX if they can't be reached.
+			std::vector<int> Parents; //!< The index within the cluster of the node each node is reached from along its least costly path. -1 for the node searched from.
+		};
+
+		using OpenNodeQueue = std::priority_queue<std::pair<float, int>, std::vector<std::pair<float, int>>, std::greater<std::pair<float, int>>>; //!< Queue of nodes to expand in searches, by their index and ordered by their costs, cheapest first.
+
+		/// <summary>
+		/// The least costly ways from every node to one destination node for one class of dig strength, which any number of things heading there can read their paths from.
+		/// </summary>
+		struct FlowField {
+			int RequestCount = 0; //!< How many paths have been asked for to the destination of this.
+			unsigned int LastRequest = 0; //!< When a path was last asked for to the destination of this, in terms of the flow field request counter.
+			std::vector<float> Costs; //!< The least cost to get from each node to the destination, by node index. FLT_MAX if it can't be reached. Empty if this hasn't been made yet.
+			std::vector<PathNode *> NextNodes; //!< The next node along the least costly path from each node to the destination, by node index. Null for the destination and nodes that can't reach it.
+			bool Building = false; //!< Whether this is being made on the worker threads right now.
+		};
+
+		/// <summary>
+		/// A MicroPather along with the Graph it solves on, which is this PathFinder's node grid as seen by something with a specific dig strength.
+		/// Each path calculation uses one of these exclusively, so several paths can be calculated at once.
+		/// </summary>
+		class PathSolver : public Graph {
+
+		public:
+
+			/// <summary>
+			/// Constructor method used to instantiate a PathSolver object.
+			/// </summary>
+			/// <param name="owner">The PathFinder whose node grid to solve on. Ownership is NOT transferred!</param>
+			/// <param name="allocate">The block size that the node cache is allocated from.</param>
+			PathSolver(const PathFinder *owner, unsigned int allocate) : Owner(owner), DigStrength(1), CostsVersion(-1), Pather(std::make_unique<MicroPather>(this, allocate)) {}
+
+			/// <summary>
+			/// Implementation of the abstract interface of Graph. Gets the least possible cost to get from node A to B, if it all was air.
+			/// </summary>
+			/// <param name="startState">Pointer to node to start from. OWNERSHIP IS NOT TRANSFERRED!</param>
+			/// <param name="endState">Node to end up at. OWNERSHIP IS NOT TRANSFERRED!</param>
+			/// <returns>The cost of the absolutely fastest possible way between the two points, as if traveled through air all the way.</returns>
+			float LeastCostEstimate(void *startState, void *endState) override { return Owner->LeastCostEstimate(startState, endState); }
+
+			/// <summary>
+			/// Implementation of the abstract interface of Graph. Gets the cost to go to any adjacent node of the one passed in, for this solver's dig strength.
+			/// </summary>
+			/// <param name="state">Pointer to node to get to cost of all adjacents for. OWNERSHIP IS NOT TRANSFERRED!</param>
+			/// <param name="adjacentList">An empty vector which will be filled out with all the valid nodes adjacent to the one passed in.</param>
+			void AdjacentCost(void *state, std::vector<micropather::StateCost> *adjacentList) override { Owner->AdjacentCost(state, adjacentList, DigStrength); }
+
+			/// <summary>
+			/// Implementation of the abstract interface of Graph. This function is only used in DEBUG mode - it dumps output to stdout.
+			/// </summary>
+			/// <param name="state">The state to print out info about.</param>
+			void PrintStateInfo(void *state) override {}
+
+			const PathFinder *Owner; //!< The PathFinder whose node grid this solves on. Not owned.
+			float DigStrength; //!< What material strength the searches of this are capable of digging through. The pather must be reset when this changes, since it caches costs.
+			int CostsVersion; //!< The version of the node costs the pather was last reset for.
+			std::unique_ptr<MicroPather> Pather; //!< The actual pathing object that does the pathfinding work.
+		};
 
-		MicroPather *m_Pather; //!< The actual pathing object that does the pathfinding work. Owned.
 		std::vector<std::vector<PathNode *>> m_NodeGrid;  //!< The array of PathNodes representing the grid on the scene. The nodes are owned by this.
 		unsigned int m_NodeDimension; //!< The width and height of each node, in pixels on the scene.
+		unsigned int m_Allocate; //!< The block size that the node cache of each pather is allocated from.
+
+		std::shared_mutex m_NodeCostsMutex; //!< Mutex guarding the node costs. Held shared while solving paths, and exclusively while recalculating costs.
+		static constexpr int c_MaxDeferredCostUpdates = 30; //!< How many times in a row recalculating area costs can be put off because paths are being solved, before it waits for them instead.
+		int m_DeferredCostUpdates; //!< How many times in a row recalculating area costs was put off because paths were being solved.
+		int m_CostsVersion; //!< Incremented every time all node costs are recalculated, so pathers that cached the old costs know to reset.
+		unsigned int m_CostUpdateCount; //!< How many cost recalculations actually changed any costs.
+		std::vector<unsigned int> m_NodeCostsChangedAt; //!< The cost update count at which the costs going out of each node last changed, by node index.
+
+		std::vector<std::unique_ptr<PathSolver>> m_IdleSolvers; //!< The solvers not currently calculating a path.
+		std::mutex m_IdleSolversMutex; //!< Mutex guarding the idle solvers.
+
+		std::list<std::future<void>> m_PendingRequests; //!< Futures of the path calculations queued on the worker threads, which must be finished before this can be destroyed.
+
+		std::vector<PathCluster> m_Clusters; //!< The clusters the node grid is divided into, column by column.
+		int m_ClusterXCount; //!< The number of cluster columns.
+		int m_ClusterYCount; //!< The number of cluster rows.
+		std::vector<ClusterEntrance> m_ClusterEntrances; //!< All the entrances between clusters.
+		std::vector<ClusterBorderSegment> m_ClusterBorderSegments; //!< All the stretches of cluster borders that have entrances across them.
+		std::vector<std::unordered_map<float, std::shared_ptr<const std::vector<ClusterSearchTree>>>> m_ClusterEntranceTrees; //!< The searches from each entrance of each cluster, by cluster index and dig strength class. Made when first needed.
+		std::mutex m_ClusterEntranceTreesMutex; //!< Mutex guarding the cluster entrance searches.
 
-		float m_DigStrength; //!< What material strength the search is capable of digging through.
+		std::vector<float> m_MaterialStrengths; //!< The distinct strengths of the scene's materials that count towards node costs, in ascending order and starting with 0 for air.
+
+		std::map<std::pair<PathNode *, float>, FlowField> m_FlowFields; //!< The flow fields and request counts of the destinations paths were asked for to lately, by destination node and dig strength class.
+		unsigned int m_FlowFieldRequestCounter; //!< How many paths have been asked for through GetFlowFieldPath, for telling which flow fields were used least recently.
+		std::mutex m_FlowFieldsMutex; //!< Mutex guarding the flow fields, which are made on the worker threads. Taken after the node costs mutex when both are needed.
 
 	private:
 
+#pragma region Path Solving
+		/// <summary>
+		/// Takes an idle solver to calculate a path with, preferring one that last solved for the same dig strength so its cached costs stay valid. Creates a new one if none are idle.
+		/// </summary>
+		/// <param name="digStrength">What material strength the search is capable of digging through.</param>
+		/// <returns>The solver, which must be given back with ReturnSolver when done with.</returns>
+		std::unique_ptr<PathSolver> TakeSolver(float digStrength);
+
+		/// <summary>
+		/// Gives back a solver taken with TakeSolver so other calculations can use it.
+		/// </summary>
+		/// <param name="solver">The solver to give back.</param>
+		void ReturnSolver(std::unique_ptr<PathSolver> solver);
+#pragma endregion
+
+#pragma region Hierarchical Pathfinding
+		/// <summary>
+		/// Divides the node grid into clusters and sets up the border segments and entrances between them. The entrances aren't placed until UpdateClusterEntrances is called.
+		/// </summary>
+		void CreateClusters();
+
+		/// <summary>
+		/// Gets the index of the cluster a node of the node grid is in.
+		/// </summary>
+		/// <param name="nodeX">The X index of the node in the node grid.</param>
+		/// <param name="nodeY">The Y index of the node in the node grid.</param>
+		/// <returns>The index of the cluster.</returns>
+		int GetClusterIndex(int nodeX, int nodeY) const { return (nodeX / c_ClusterSize) * m_ClusterYCount + (nodeY / c_ClusterSize); }
+
+		/// <summary>
+		/// Gets the index of a node within the cluster it's in.
+		/// </summary>
+		/// <param name="cluster">The cluster the node is in.</param>
+		/// <param name="node">The node to get the index of. OWNERSHIP IS NOT TRANSFERRED!</param>
+		/// <returns>The index of the node within the cluster.</returns>
+		int GetIndexInCluster(const PathCluster &cluster, const PathNode *node) const { return (GetNodeX(node) - cluster.FirstNodeX) + (GetNodeY(node) - cluster.FirstNodeY) * cluster.Width; }
+
+		/// <summary>
+		/// Gets the X index of a node in the node grid.
+		/// </summary>
+		/// <param name="node">The node to get the index of. OWNERSHIP IS NOT TRANSFERRED!</param>
+		/// <returns>The X index of the node.</returns>
+		int GetNodeX(const PathNode *node) const { return static_cast<int>(node->Pos.m_X) / static_cast<int>(m_NodeDimension); }
+
+		/// <summary>
+		/// Gets the Y index of a node in the node grid.
+		/// </summary>
+		/// <param name="node">The node to get the index of. OWNERSHIP IS NOT TRANSFERRED!</param>
+		/// <returns>The Y index of the node.</returns>
+		int GetNodeY(const PathNode *node) const { return static_cast<int>(node->Pos.m_Y) / static_cast<int>(m_NodeDimension); }
+
+		/// <summary>
+		/// Gets the index of a node in flat per-node lists, such as those of flow fields.
+		/// </summary>
+		/// <param name="nodeX">The X index of the node in the node grid.</param>
+		/// <param name="nodeY">The Y index of the node in the node grid.</param>
+		/// <returns>The index of the node.</returns>
+		int GetNodeIndex(int nodeX, int nodeY) const { return nodeX * static_cast<int>(m_NodeGrid[0].size()) + nodeY; }
+
+		/// <summary>
+		/// Places the entrances across all the border segments that touch any of the passed in clusters where crossing is the easiest, and forgets the searches of all the clusters whose entrances or costs changed.
+		/// The node costs mutex must be held exclusively while calling this.
+		/// </summary>
+		/// <param name="changedClusters">Which clusters, by index, had any of their node costs changed.</param>
+		void UpdateClusterEntrances(const std::vector<bool> &changedClusters);
+
+		/// <summary>
+		/// Searches from a node to all other nodes within the cluster it's in, without leaving the cluster.
+		/// </summary>
+		/// <param name="cluster">The cluster to search within.</param>
+		/// <param name="origin">The node to search from. OWNERSHIP IS NOT TRANSFERRED!</param>
+		/// <param name="digStrength">What material strength the search is capable of digging through.</param>
+		/// <returns>The least costly paths from the node to all others within the cluster.</returns>
+		ClusterSearchTree SearchCluster(const PathCluster &cluster, const PathNode *origin, float digStrength) const;
+
+		/// <summary>
+		/// Gets the searches from each entrance of a cluster to all other nodes within it, making them if they haven't been already for this dig strength class.
+		/// Only the searches of the c_MaxEntranceTreeDigClasses dig strength classes made last are kept for each cluster.
+		/// </summary>
+		/// <param name="clusterIndex">The index of the cluster.</param>
+		/// <param name="digStrength">What material strength the search is capable of digging through. Searches are shared by its whole class, see GetDigStrengthClass.</param>
+		/// <returns>The searches from each entrance, in the same order as the entrance list of the cluster.</returns>
+		std::shared_ptr<const std::vector<ClusterSearchTree>> GetClusterEntranceTrees(int clusterIndex, float digStrength);
+
+		/// <summary>
+		/// Gets a lower bound on the cost to get from one node to another, for guiding the search between cluster entrances.
+		/// Every step between nodes costs at least its length in nodes, diagonal ones a little less than that, so this never overestimates and the search never has to expand an entrance twice.
+		/// </summary>
+		/// <param name="startNode">The node to start from. OWNERSHIP IS NOT TRANSFERRED!</param>
+		/// <param name="endNode">The node to end up at. OWNERSHIP IS NOT TRANSFERRED!</param>
+		/// <returns>The least the cost between the two nodes could possibly be.</returns>
+		float HierarchicalCostEstimate(const PathNode *startNode, const PathNode *endNode) const;
+
+		/// <summary>
+		/// Adds the nodes along the least costly path from the origin of a cluster search to a node to a list of states, excluding the origin.
+		/// </summary>
+		/// <param name="cluster">The cluster that was searched.</param>
+		/// <param name="searchTree">The search to get the path from.</param>
+		/// <param name="target">The node the path leads to. OWNERSHIP IS NOT TRANSFERRED!</param>
+		/// <param name="statePath">The list of states to add the nodes of the path to.</param>
+		void AddClusterSearchPath(const PathCluster &cluster, const ClusterSearchTree &searchTree, const PathNode *target, std::vector<void *> &statePath) const;
+
+		/// <summary>
+		/// Finds the least difficult path between two nodes hierarchically, first between cluster entrances, then refining that to the nodes within each cluster along the way.
+		/// The node costs mutex must be held shared while calling this.
+		/// </summary>
+		/// <param name="startNode">The node to find the path from. OWNERSHIP IS NOT TRANSFERRED!</param>
+		/// <param name="endNode">The node to find the path to. OWNERSHIP IS NOT TRANSFERRED!</param>
+		/// <param name="digStrength">What material strength the search is capable of digging through.</param>
+		/// <param name="statePath">A list which will be filled out with the nodes along the path, including the start and end nodes.</param>
+		/// <param name="totalCostResult">The total cost of the path.</param>
+		/// <returns>Whether a path was found.</returns>
+		bool CalculateHierarchicalPath(PathNode *startNode, PathNode *endNode, float digStrength, std::vector<void *> &statePath, float &totalCostResult);
+#pragma endregion
+
+#pragma region Flow Fields
+		/// <summary>
+		/// Gets the dig strength class of a dig strength, which is the strength of the strongest material it can dig through.
+		/// Node costs are the strengths of the materials along the way, so all dig strengths of a class see the same costs and can share flow fields and searches.
+		/// </summary>
+		/// <param name="digStrength">The dig strength to get the class of.</param>
+		/// <returns>The dig strength class.</returns>
+		float GetDigStrengthClass(float digStrength) const;
+
+		/// <summary>
+		/// Queues making a flow field from scratch on the worker threads. It's put in place once done, unless it was dropped meanwhile.
+		/// The flow field must already be marked as building, and the flow fields mutex must not be held when calling this.
+		/// </summary>
+		/// <param name="flowFieldKey">The destination node and dig strength class of the flow field to make.</param>
+		void QueueBuildFlowField(const std::pair<PathNode *, float> &flowFieldKey);
+
+		/// <summary>
+		/// Makes a flow field from scratch, finding the least costly ways from every node to its destination.
+		/// </summary>
+		/// <param name="flowField">The flow field to make.</param>
+		/// <param name="destination">The node the flow field leads to. OWNERSHIP IS NOT TRANSFERRED!</param>
+		/// <param name="digStrength">The dig strength class of the flow field.</param>
+		void BuildFlowField(FlowField &flowField, PathNode *destination, float digStrength) const;
+
+		/// <summary>
+		/// Updates a flow field after the costs of some nodes changed, only redoing the nodes whose ways to the destination went through changed nodes and spreading any improvements from there.
+		/// </summary>
+		/// <param name="flowField">The flow field to update.</param>
+		/// <param name="destination">The node the flow field leads to. OWNERSHIP IS NOT TRANSFERRED!</param>
+		/// <param name="digStrength">The dig strength class of the flow field.</param>
+		/// <param name="changedNodes">Which nodes had their costs changed, by node index.</param>
+		void RepairFlowField(FlowField &flowField, PathNode *destination, float digStrength, const std::vector<bool> &changedNodes) const;
+
+		/// <summary>
+		/// Spreads the costs of a flow field from the passed in open nodes to all nodes they lead to more cheaply than before, backwards along the edges.
+		/// </summary>
+		/// <param name="flowField">The flow field to spread the costs of.</param>
+		/// <param name="digStrength">The dig strength class of the flow field.</param>
+		/// <param name="openNodes">The nodes to spread from, by node index and along with their costs.</param>
+		void SpreadFlowField(FlowField &flowField, float digStrength, OpenNodeQueue &openNodes) const;
+#pragma endregion
+
 #pragma region Path Cost Updates
 		/// <summary>
 		/// Helper function for calculating the real actual cost of going in a straight line between any two points on the scene.
@@ -171,14 +519,16 @@ namespace RTE {
 		/// This does NOT update the pather, which is required before solving more paths after calling this.
 		/// </summary>
 		/// <param name="node">The node to update all costs of. It's safe to pass 0 here. OWNERSHIP IS NOT TRANSFERRED!</param>
-		void UpdateNodeCosts(PathNode *node);
+		/// <returns>Whether any of the costs actually changed.</returns>
+		bool UpdateNodeCosts(PathNode *node);
 
 		/// <summary>
 		/// Helper function for updating all the values of cost edges crossed by a specific box.
 		/// This does NOT update the pather, which is required before solving more paths after calling this. Also it does NOT wrap the box coming in here, only truncates it!
 		/// </summary>
 		/// <param name="box">The Box of which all edges it touches should be recalculated.</param>
-		void UpdateNodeCostsInBox(Box &box);
+		/// <param name="changedNodes">A list which the nodes whose costs actually changed will be added to.</param>
+		void UpdateNodeCostsInBox(Box &box, std::vector<PathNode *> &changedNodes);
 #pragma endregion
 
 		/// <summary>
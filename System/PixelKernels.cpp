@@ -0,0 +1,359 @@
+#include "PixelKernels.h"
+#include "RTEError.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PIXELKERNELS_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC allows using any intrinsics without enabling them for the whole build, GCC and Clang need the functions using them marked.
+#if defined(PIXELKERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_AVX2
+#endif
+
+namespace RTE {
+
+	namespace {
+
+		/// <summary>
+		/// Gets the index of the lowest set bit of a non-zero value.
+		/// </summary>
+		inline int LowestSetBit(unsigned int value) {
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward(&index, value);
+			return static_cast<int>(index);
+#else
+			return __builtin_ctz(value);
+#endif
+		}
+
+		/// <summary>
+		/// Screen blends one 32 bit pixel onto another exactly like Allegro's _blender_screen24 does, including the borrows between the packed red and blue components.
+		/// </summary>
+		inline uint32_t ScreenBlendPixel(uint32_t source, uint32_t dest, uint32_t strength) {
+			uint32_t screened = 0;
+			for (int shift = 0; shift < 24; shift += 8) {
+				screened |= (255 - (((255 - ((source >> shift) & 0xFF)) * (255 - ((dest >> shift) & 0xFF))) >> 8)) << shift;
+			}
+			uint32_t redBlue = ((((screened & 0xFF00FF) - (dest & 0xFF00FF)) * strength) >> 8) + dest;
+			uint32_t green = ((((screened & 0xFF00) - (dest & 0xFF00)) * strength) >> 8) + (dest & 0xFF00);
+			return (redBlue & 0xFF00FF) | (green & 0xFF00);
+		}
+
+#pragma region Scalar Kernels
+		void ExpandIndexedRowScalar(const unsigned char *source, uint32_t *dest, int width, const uint32_t *palette) {
+			for (int x = 0; x < width; ++x) {
+				dest[x] = palette[source[x]];
+			}
+		}
+
+		void ScreenBlendRowScalar(const uint32_t *source, uint32_t *dest, int width, uint32_t strength) {
+			for (int x = 0; x < width; ++x) {
+				if (source[x] != MASK_COLOR_32) { dest[x] = ScreenBlendPixel(source[x], dest[x], strength); }
+			}
+		}
+
+		void TransTableRowScalar(const unsigned char *source, unsigned char *dest, int width, const unsigned char *colorMap) {
+			for (int x = 0; x < width; ++x) {
+				dest[x] = colorMap[(source[x] << 8) | dest[x]];
+			}
+		}
+
+		const unsigned char * FindAnyOfScalar(const unsigned char *begin, const unsigned char *end, unsigned char firstValue, unsigned char secondValue, unsigned char thirdValue) {
+			for (; begin < end; ++begin) {
+				if (*begin == firstValue || *begin == secondValue || *begin == thirdValue) {
+					return begin;
+				}
+			}
+			return end;
+		}
+#pragma endregion
+
+#ifdef PIXELKERNELS_X86
+#pragma region SSE2 Kernels
+		/// <summary>
+		/// Multiplies 32 bit lanes keeping the low 32 bits of the products, which SSE2 has no single instruction for.
+		/// </summary>
+		TARGET_SSE2 inline __m128i MultiplyLow32SSE2(__m128i first, __m128i second) {
+			__m128i evenProducts = _mm_mul_epu32(first, second);
+			__m128i oddProducts = _mm_mul_epu32(_mm_srli_epi64(first, 32), _mm_srli_epi64(second, 32));
+			return _mm_unpacklo_epi32(_mm_shuffle_epi32(evenProducts, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(oddProducts, _MM_SHUFFLE(0, 0, 2, 0)));
+		}
+
+		TARGET_SSE2 void ScreenBlendRowSSE2(const uint32_t *source, uint32_t *dest, int width, uint32_t strength) {
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i full = _mm_set1_epi16(255);
+			const __m128i maskColor = _mm_set1_epi32(MASK_COLOR_32);
+			const __m128i redBlueMask = _mm_set1_epi32(0xFF00FF);
+			const __m128i greenMask = _mm_set1_epi32(0xFF00);
+			const __m128i strengths = _mm_set1_epi32(static_cast<int>(strength));
+
+			int x = 0;
+			for (; x + 4 <= width; x += 4) {
+				__m128i sourcePixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + x));
+				__m128i destPixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest + x));
+
+				// Screen each component in 16 bit lanes: 255 - (255 - source) * (255 - dest) / 256.
+				__m128i screenedLow = _mm_sub_epi16(full, _mm_srli_epi16(_mm_mullo_epi16(_mm_sub_epi16(full, _mm_unpacklo_epi8(sourcePixels, zero)), _mm_sub_epi16(full, _mm_unpacklo_epi8(destPixels, zero))), 8));
+				__m128i screenedHigh = _mm_sub_epi16(full, _mm_srli_epi16(_mm_mullo_epi16(_mm_sub_epi16(full, _mm_unpackhi_epi8(sourcePixels, zero)), _mm_sub_epi16(full, _mm_unpackhi_epi8(destPixels, zero))), 8));
+				__m128i screened = _mm_packus_epi16(screenedLow, screenedHigh);
+
+				// Then blend towards the screened color in the same packed 32 bit arithmetic as _blender_trans24.
+				__m128i redBlue = _mm_add_epi32(_mm_srli_epi32(MultiplyLow32SSE2(_mm_sub_epi32(_mm_and_si128(screened, redBlueMask), _mm_and_si128(destPixels, redBlueMask)), strengths), 8), destPixels);
+				__m128i destGreen = _mm_and_si128(destPixels, greenMask);
+				__m128i green = _mm_add_epi32(_mm_srli_epi32(MultiplyLow32SSE2(_mm_sub_epi32(_mm_and_si128(screened, greenMask), destGreen), strengths), 8), destGreen);
+				__m128i blended = _mm_or_si128(_mm_and_si128(redBlue, redBlueMask), _mm_and_si128(green, greenMask));
+
+				__m128i masked = _mm_cmpeq_epi32(sourcePixels, maskColor);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + x), _mm_or_si128(_mm_and_si128(masked, destPixels), _mm_andnot_si128(masked, blended)));
+			}
+			ScreenBlendRowScalar(source + x, dest + x, width - x, strength);
+		}
+
+		TARGET_SSE2 const unsigned char * FindAnyOfSSE2(const unsigned char *begin, const unsigned char *end, unsigned char firstValue, unsigned char secondValue, unsigned char thirdValue) {
+			const __m128i firstValues = _mm_set1_epi8(static_cast<char>(firstValue));
+			const __m128i secondValues = _mm_set1_epi8(static_cast<char>(secondValue));
+			const __m128i thirdValues = _mm_set1_epi8(static_cast<char>(thirdValue));
+
+			for (; end - begin >= 16; begin += 16) {
+				__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+				__m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, firstValues), _mm_cmpeq_epi8(bytes, secondValues)), _mm_cmpeq_epi8(bytes, thirdValues));
+				if (int matchBits = _mm_movemask_epi8(matches)) {
+					return begin + LowestSetBit(static_cast<unsigned int>(matchBits));
+				}
+			}
+			return FindAnyOfScalar(begin, end, firstValue, secondValue, thirdValue);
+		}
+#pragma endregion
+
+#pragma region AVX2 Kernels
+		TARGET_AVX2 void ExpandIndexedRowAVX2(const unsigned char *source, uint32_t *dest, int width, const uint32_t *palette) {
+			int x = 0;
+			for (; x + 8 <= width; x += 8) {
+				__m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(source + x)));
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + x), _mm256_i32gather_epi32(reinterpret_cast<const int *>(palette), indices, 4));
+			}
+			ExpandIndexedRowScalar(source + x, dest + x, width - x, palette);
+		}
+
+		TARGET_AVX2 void ScreenBlendRowAVX2(const uint32_t *source, uint32_t *dest, int width, uint32_t strength) {
+			const __m256i zero = _mm256_setzero_si256();
+			const __m256i full = _mm256_set1_epi16(255);
+			const __m256i maskColor = _mm256_set1_epi32(MASK_COLOR_32);
+			const __m256i redBlueMask = _mm256_set1_epi32(0xFF00FF);
+			const __m256i greenMask = _mm256_set1_epi32(0xFF00);
+			const __m256i strengths = _mm256_set1_epi32(static_cast<int>(strength));
+
+			int x = 0;
+			for (; x + 8 <= width; x += 8) {
+				__m256i sourcePixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + x));
+				__m256i destPixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dest + x));
+
+				// Unpacking and packing both work within 128 bit lanes, so the pixels end up back in order.
+				__m256i screenedLow = _mm256_sub_epi16(full, _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(full, _mm256_unpacklo_epi8(sourcePixels, zero)), _mm256_sub_epi16(full, _mm256_unpacklo_epi8(destPixels, zero))), 8));
+				__m256i screenedHigh = _mm256_sub_epi16(full, _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(full, _mm256_unpackhi_epi8(sourcePixels, zero)), _mm256_sub_epi16(full, _mm256_unpackhi_epi8(destPixels, zero))), 8));
+				__m256i screened = _mm256_packus_epi16(screenedLow, screenedHigh);
+
+				__m256i redBlue = _mm256_add_epi32(_mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(_mm256_and_si256(screened, redBlueMask), _mm256_and_si256(destPixels, redBlueMask)), strengths), 8), destPixels);
+				__m256i destGreen = _mm256_and_si256(destPixels, greenMask);
+				__m256i green = _mm256_add_epi32(_mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(_mm256_and_si256(screened, greenMask), destGreen), strengths), 8), destGreen);
+				__m256i blended = _mm256_or_si256(_mm256_and_si256(redBlue, redBlueMask), _mm256_and_si256(green, greenMask));
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + x), _mm256_blendv_epi8(blended, destPixels, _mm256_cmpeq_epi32(sourcePixels, maskColor)));
+			}
+			ScreenBlendRowSSE2(source + x, dest + x, width - x, strength);
+		}
+
+		TARGET_AVX2 void TransTableRowAVX2(const unsigned char *source, unsigned char *dest, int width, const unsigned char *colorMap) {
+			const __m256i lowByteOfEachDword = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+			const __m256i gatherLanes = _mm256_setr_epi32(0, 4, 1, 1, 1, 1, 1, 1);
+
+			int x = 0;
+			for (; x + 8 <= width; x += 8) {
+				__m256i sourceIndices = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(source + x)));
+				__m256i destIndices = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(dest + x)));
+				__m256i tableIndices = _mm256_or_si256(_mm256_slli_epi32(sourceIndices, 8), destIndices);
+
+				// Gather the aligned dwords the entries are in and shift the entries down, so nothing is read past the end of the table.
+				__m256i tableDwords = _mm256_i32gather_epi32(reinterpret_cast<const int *>(colorMap), _mm256_srli_epi32(tableIndices, 2), 4);
+				__m256i entries = _mm256_srlv_epi32(tableDwords, _mm256_slli_epi32(_mm256_and_si256(tableIndices, _mm256_set1_epi32(3)), 3));
+
+				__m256i packedEntries = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(entries, lowByteOfEachDword), gatherLanes);
+				_mm_storel_epi64(reinterpret_cast<__m128i *>(dest + x), _mm256_castsi256_si128(packedEntries));
+			}
+			TransTableRowScalar(source + x, dest + x, width - x, colorMap);
+		}
+
+		TARGET_AVX2 const unsigned char * FindAnyOfAVX2(const unsigned char *begin, const unsigned char *end, unsigned char firstValue, unsigned char secondValue, unsigned char thirdValue) {
+			const __m256i firstValues = _mm256_set1_epi8(static_cast<char>(firstValue));
+			const __m256i secondValues = _mm256_set1_epi8(static_cast<char>(secondValue));
+			const __m256i thirdValues = _mm256_set1_epi8(static_cast<char>(thirdValue));
+
+			for (; end - begin >= 32; begin += 32) {
+				__m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+				__m256i matches = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, firstValues), _mm256_cmpeq_epi8(bytes, secondValues)), _mm256_cmpeq_epi8(bytes, thirdValues));
+				if (int matchBits = _mm256_movemask_epi8(matches)) {
+					return begin + LowestSetBit(static_cast<unsigned int>(matchBits));
+				}
+			}
+			return FindAnyOfSSE2(begin, end, firstValue, secondValue, thirdValue);
+		}
+#pragma endregion
+#endif
+
+		// The kernels in use. These start out as the scalar versions and are replaced once the CPU features are known.
+		void (*s_ExpandIndexedRow)(const unsigned char *source, uint32_t *dest, int width, const uint32_t *palette) = &ExpandIndexedRowScalar;
+		void (*s_ScreenBlendRow)(const uint32_t *source, uint32_t *dest, int width, uint32_t strength) = &ScreenBlendRowScalar;
+		void (*s_TransTableRow)(const unsigned char *source, unsigned char *dest, int width, const unsigned char *colorMap) = &TransTableRowScalar;
+		const unsigned char * (*s_FindAnyOf)(const unsigned char *begin, const unsigned char *end, unsigned char firstValue, unsigned char secondValue, unsigned char thirdValue) = &FindAnyOfScalar;
+
+		/// <summary>
+		/// Clips drawing a sprite onto a bitmap the same way Allegro's sprite drawing routines do.
+		/// </summary>
+		/// <returns>Whether anything is left to draw after clipping.</returns>
+		bool ClipSprite(const BITMAP *target, const BITMAP *sprite, int posX, int posY, int &spriteX, int &spriteY, int &targetX, int &targetY, int &width, int &height) {
+			if (target->clip) {
+				spriteX = std::max(target->cl - posX, 0);
+				width = std::min(target->cr - posX, sprite->w) - spriteX;
+				spriteY = std::max(target->ct - posY, 0);
+				height = std::min(target->cb - posY, sprite->h) - spriteY;
+				if (width <= 0 || height <= 0) {
+					return false;
+				}
+			} else {
+				spriteX = 0;
+				spriteY = 0;
+				width = sprite->w;
+				height = sprite->h;
+			}
+			targetX = posX + spriteX;
+			targetY = posY + spriteY;
+			return true;
+		}
+	}
+
+	const PixelKernels::InstructionSet PixelKernels::s_InstructionSet = PixelKernels::SelectKernels();
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	PixelKernels::InstructionSet PixelKernels::SelectKernels() {
+		bool hasSSE2 = false;
+		bool hasAVX2 = false;
+#ifdef PIXELKERNELS_X86
+#ifdef _MSC_VER
+		int cpuInfo[4];
+		__cpuid(cpuInfo, 0);
+		int highestLeaf = cpuInfo[0];
+		__cpuid(cpuInfo, 1);
+		hasSSE2 = cpuInfo[3] & (1 << 26);
+		// AVX2 also needs the OS to save the YMM registers on context switches.
+		bool osSavesYMM = (cpuInfo[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+		if (highestLeaf >= 7 && osSavesYMM) {
+			__cpuidex(cpuInfo, 7, 0);
+			hasAVX2 = cpuInfo[1] & (1 << 5);
+		}
+#else
+		__builtin_cpu_init();
+		hasSSE2 = __builtin_cpu_supports("sse2");
+		hasAVX2 = __builtin_cpu_supports("avx2");
+#endif
+		if (hasAVX2) {
+			s_ExpandIndexedRow = &ExpandIndexedRowAVX2;
+			s_ScreenBlendRow = &ScreenBlendRowAVX2;
+			s_TransTableRow = &TransTableRowAVX2;
+			s_FindAnyOf = &FindAnyOfAVX2;
+			return InstructionSet::AVX2;
+		} else if (hasSSE2) {
+			// There are no gathers before AVX2, so palette and transparency table lookups stay scalar.
+			s_ScreenBlendRow = &ScreenBlendRowSSE2;
+			s_FindAnyOf = &FindAnyOfSSE2;
+			return InstructionSet::SSE2;
+		}
+#endif
+		return InstructionSet::Scalar;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelKernels::ExpandIndexedBitmap(BITMAP *source, BITMAP *dest) {
+		bool destClipped = dest->clip && (dest->cl > 0 || dest->ct > 0 || dest->cr < dest->w || dest->cb < dest->h);
+		if (bitmap_color_depth(source) != 8 || bitmap_color_depth(dest) != 32 || !is_memory_bitmap(source) || !is_memory_bitmap(dest) || source->w != dest->w || source->h != dest->h || destClipped) {
+			blit(source, dest, 0, 0, 0, 0, source->w, source->h);
+			return;
+		}
+		// Let Allegro expand each palette index once, so the expansion follows the current palette and color conversion settings exactly like its own blit does.
+		BITMAP *paletteIndices = create_bitmap_ex(8, 256, 1);
+		BITMAP *paletteColors = create_bitmap_ex(32, 256, 1);
+		for (int paletteIndex = 0; paletteIndex < 256; ++paletteIndex) {
+			paletteIndices->line[0][paletteIndex] = static_cast<unsigned char>(paletteIndex);
+		}
+		blit(paletteIndices, paletteColors, 0, 0, 0, 0, 256, 1);
+
+		const uint32_t *palette = reinterpret_cast<const uint32_t *>(paletteColors->line[0]);
+		for (int y = 0; y < source->h; ++y) {
+			s_ExpandIndexedRow(source->line[y], reinterpret_cast<uint32_t *>(dest->line[y]), source->w, palette);
+		}
+		destroy_bitmap(paletteIndices);
+		destroy_bitmap(paletteColors);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelKernels::DrawScreenBlendedSprite(BITMAP *target, BITMAP *sprite, int posX, int posY, int strength) {
+		if (bitmap_color_depth(target) != 32 || bitmap_color_depth(sprite) != 32 || !is_memory_bitmap(target)) {
+			set_screen_blender(strength, strength, strength, strength);
+			draw_trans_sprite(target, sprite, posX, posY);
+			return;
+		}
+		int spriteX;
+		int spriteY;
+		int targetX;
+		int targetY;
+		int width;
+		int height;
+		if (!ClipSprite(target, sprite, posX, posY, spriteX, spriteY, targetX, targetY, width, height)) {
+			return;
+		}
+		// Same as _blender_trans24, which bumps any non-zero strength by one so 255 is fully opaque.
+		uint32_t blendStrength = (strength != 0) ? static_cast<uint32_t>(strength) + 1 : 0;
+		for (int y = 0; y < height; ++y) {
+			s_ScreenBlendRow(reinterpret_cast<const uint32_t *>(sprite->line[spriteY + y]) + spriteX, reinterpret_cast<uint32_t *>(target->line[targetY + y]) + targetX, width, blendStrength);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelKernels::DrawTransSprite(BITMAP *target, BITMAP *sprite, int posX, int posY) {
+		if (bitmap_color_depth(target) != 8 || bitmap_color_depth(sprite) != 8 || !is_memory_bitmap(target) || !color_map) {
+			draw_trans_sprite(target, sprite, posX, posY);
+			return;
+		}
+		int spriteX;
+		int spriteY;
+		int targetX;
+		int targetY;
+		int width;
+		int height;
+		if (!ClipSprite(target, sprite, posX, posY, spriteX, spriteY, targetX, targetY, width, height)) {
+			return;
+		}
+		const unsigned char *colorMap = &color_map->data[0][0];
+		for (int y = 0; y < height; ++y) {
+			s_TransTableRow(sprite->line[spriteY + y] + spriteX, target->line[targetY + y] + targetX, width, colorMap);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	const unsigned char * PixelKernels::FindAnyOf(const unsigned char *begin, const unsigned char *end, unsigned char firstValue, unsigned char secondValue, unsigned char thirdValue) {
+		return s_FindAnyOf(begin, end, firstValue, secondValue, thirdValue);
+	}
+}
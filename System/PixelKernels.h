@@ -0,0 +1,82 @@
+#ifndef _RTEPIXELKERNELS_
+#define _RTEPIXELKERNELS_
+
+struct BITMAP;
+
+namespace RTE {
+
+	/// <summary>
+	/// Static collection of vectorized versions of the per-pixel Allegro routines that take up most of the post-processing and transparent drawing time at high resolutions.
+	/// The SSE2 or AVX2 versions are picked at runtime based on what the CPU supports. They all give exactly the same results as the Allegro routines they stand in for.
+	/// </summary>
+	class PixelKernels {
+
+	public:
+
+		/// <summary>
+		/// Enumeration for the instruction sets the kernels have versions for.
+		/// </summary>
+		enum class InstructionSet { Scalar, SSE2, AVX2 };
+
+#pragma region Getters
+		/// <summary>
+		/// Gets the instruction set the kernels were picked for, which is the best one the CPU supports.
+		/// </summary>
+		/// <returns>The instruction set the kernels are run with.</returns>
+		static InstructionSet GetInstructionSet() { return s_InstructionSet; }
+#pragma endregion
+
+#pragma region Concrete Methods
+		/// <summary>
+		/// Expands an 8 bit bitmap onto a 32 bit bitmap of the same size through the current palette. Same as blitting the whole source onto the destination.
+		/// Anything else, like video bitmaps or a clipped destination, is passed on to Allegro's blit.
+		/// </summary>
+		/// <param name="source">The 8 bit bitmap to expand.</param>
+		/// <param name="dest">The 32 bit bitmap to expand onto.</param>
+		static void ExpandIndexedBitmap(BITMAP *source, BITMAP *dest);
+
+		/// <summary>
+		/// Draws a 32 bit sprite onto a 32 bit bitmap with the screen blender at a specific strength. Same as set_screen_blender() with the strength for all components followed by draw_trans_sprite(),
+		/// except that it doesn't touch Allegro's global blender state. Anything other than 32 bit memory bitmaps is passed on to Allegro.
+		/// </summary>
+		/// <param name="target">The 32 bit bitmap to draw onto.</param>
+		/// <param name="sprite">The 32 bit sprite to draw. Pixels of the mask color are skipped.</param>
+		/// <param name="posX">The X position on the target to draw the upper left corner of the sprite at.</param>
+		/// <param name="posY">The Y position on the target to draw the upper left corner of the sprite at.</param>
+		/// <param name="strength">The strength of the blend, 0 to 255.</param>
+		static void DrawScreenBlendedSprite(BITMAP *target, BITMAP *sprite, int posX, int posY, int strength);
+
+		/// <summary>
+		/// Draws an 8 bit sprite onto an 8 bit bitmap through the current transparency table, as set by FrameMan::SetTransTable(). Same as draw_trans_sprite().
+		/// Anything other than 8 bit memory bitmaps is passed on to Allegro.
+		/// </summary>
+		/// <param name="target">The 8 bit bitmap to draw onto.</param>
+		/// <param name="sprite">The 8 bit sprite to draw.</param>
+		/// <param name="posX">The X position on the target to draw the upper left corner of the sprite at.</param>
+		/// <param name="posY">The Y position on the target to draw the upper left corner of the sprite at.</param>
+		static void DrawTransSprite(BITMAP *target, BITMAP *sprite, int posX, int posY);
+
+		/// <summary>
+		/// Finds the first byte in a range that is equal to any of three values. Used to look for glowing palette indices on a row of an 8 bit bitmap.
+		/// </summary>
+		/// <param name="begin">The start of the range to search.</param>
+		/// <param name="end">The end of the range to search, exclusive.</param>
+		/// <param name="firstValue">The first value to look for.</param>
+		/// <param name="secondValue">The second value to look for.</param>
+		/// <param name="thirdValue">The third value to look for.</param>
+		/// <returns>Pointer to the first matching byte, or end if there is none.</returns>
+		static const unsigned char * FindAnyOf(const unsigned char *begin, const unsigned char *end, unsigned char firstValue, unsigned char secondValue, unsigned char thirdValue);
+#pragma endregion
+
+	private:
+
+		static const InstructionSet s_InstructionSet; //!< The instruction set the kernels were picked for.
+
+		/// <summary>
+		/// Finds the best instruction set the CPU and OS support, and points the kernels at the versions for it.
+		/// </summary>
+		/// <returns>The instruction set the kernels were picked for.</returns>
+		static InstructionSet SelectKernels();
+	};
+}
+#endif
@@ -137,4 +137,32 @@ namespace RTE {
 			return RoundFloatToPrecision((roundingBuffer / precisionMagnitude), precision);
 		}
 	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	uint64_t StableHash(const void *data, size_t dataSize, uint64_t seed) {
+		const unsigned char *dataBytes = static_cast<const unsigned char *>(data);
+		uint64_t hash = seed;
+		for (size_t i = 0; i < dataSize; ++i) {
+			hash ^= static_cast<uint64_t>(dataBytes[i]);
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	uint64_t StableHashBitmap(BITMAP *bitmap, uint64_t seed) {
+		if (!bitmap) {
+			return seed;
+		}
+		const std::array<int, 3> bitmapFormat = { bitmap->w, bitmap->h, bitmap_color_depth(bitmap) };
+		uint64_t hash = StableHash(bitmapFormat.data(), sizeof(bitmapFormat), seed);
+
+		int rowSize = bitmap->w * ((bitmapFormat[2] + 7) / 8);
+		for (int y = 0; y < bitmap->h; ++y) {
+			hash = StableHash(bitmap->line[y], rowSize, hash);
+		}
+		return hash;
+	}
 }
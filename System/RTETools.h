@@ -226,6 +226,35 @@ namespace RTE {
 	std::string RoundFloatToPrecision(float input, int precision, int roundingMode = 0);
 #pragma endregion
 
+#pragma region Hashing
+	static constexpr uint64_t c_StableHashSeed = 14695981039346656037ULL; //!< The FNV-1a 64-bit offset basis, used as the starting value for StableHash.
+
+	/// <summary>
+	/// Hashes a block of memory with the 64-bit FNV-1a algorithm. Unlike std::hash, the result is the same between runs, builds and platforms, so it is safe to store on disk or send over the network.
+	/// </summary>
+	/// <param name="data">Pointer to the data to hash.</param>
+	/// <param name="dataSize">The size of the data to hash, in bytes.</param>
+	/// <param name="seed">The value to start hashing from. Pass in a previous result to combine several blocks into one hash.</param>
+	/// <returns>The hash of the data.</returns>
+	uint64_t StableHash(const void *data, size_t dataSize, uint64_t seed = c_StableHashSeed);
+
+	/// <summary>
+	/// Hashes a string with the 64-bit FNV-1a algorithm. See StableHash(const void *, size_t, uint64_t).
+	/// </summary>
+	/// <param name="stringToHash">The string to hash.</param>
+	/// <param name="seed">The value to start hashing from. Pass in a previous result to combine several blocks into one hash.</param>
+	/// <returns>The hash of the string.</returns>
+	inline uint64_t StableHash(const std::string &stringToHash, uint64_t seed = c_StableHashSeed) { return StableHash(stringToHash.data(), stringToHash.size(), seed); }
+
+	/// <summary>
+	/// Hashes the dimensions and pixels of a memory BITMAP with the 64-bit FNV-1a algorithm. See StableHash(const void *, size_t, uint64_t).
+	/// </summary>
+	/// <param name="bitmap">The BITMAP to hash. Ownership is NOT transferred!</param>
+	/// <param name="seed">The value to start hashing from. Pass in a previous result to combine several blocks into one hash.</param>
+	/// <returns>The hash of the BITMAP, or the seed if the BITMAP is null.</returns>
+	uint64_t StableHashBitmap(BITMAP *bitmap, uint64_t seed = c_StableHashSeed);
+#pragma endregion
+
 #pragma region Misc
 	/// <summary>
 	/// Convenience method that takes in a double pointer array and returns a std::vector with its contents, because pointers-to-pointers are the devil. The passed in array is deleted in the process so no need to delete it manually.
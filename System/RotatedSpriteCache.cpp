@@ -0,0 +1,116 @@
+#include "RotatedSpriteCache.h"
+#include "RTEError.h"
+#include "Constants.h"
+
+namespace RTE {
+
+	std::list<RotatedSpriteCache::CacheEntry> RotatedSpriteCache::s_Entries;
+	std::unordered_map<RotatedSpriteCache::CacheKey, std::list<RotatedSpriteCache::CacheEntry>::iterator, RotatedSpriteCache::CacheKeyHash> RotatedSpriteCache::s_EntryLookup;
+	size_t RotatedSpriteCache::s_MemoryUsed = 0;
+	size_t RotatedSpriteCache::s_MemoryBudget = 64 * 1024 * 1024;
+	std::mutex RotatedSpriteCache::s_CacheMutex;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	size_t RotatedSpriteCache::CacheKeyHash::operator()(const CacheKey &key) const {
+		size_t hash = std::hash<const BITMAP *>()(key.Sprite);
+		for (int value : { key.PivotX, key.PivotY, key.AngleBucket, static_cast<int>(key.HFlipped) }) {
+			hash ^= std::hash<int>()(value) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+		}
+		return hash;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void RotatedSpriteCache::SetMemoryBudgetMB(int memoryBudgetMB) {
+		std::lock_guard<std::mutex> cacheLock(s_CacheMutex);
+		s_MemoryBudget = static_cast<size_t>(std::max(memoryBudgetMB, 0)) * 1024 * 1024;
+		EvictToBudget();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::shared_ptr<BITMAP> RotatedSpriteCache::GetRotatedSprite(BITMAP *sprite, int pivotX, int pivotY, float allegroAngle, bool hFlipped) {
+		if (s_MemoryBudget == 0 || !sprite || bitmap_color_depth(sprite) != 8) {
+			return nullptr;
+		}
+		int angleBucket = static_cast<int>(std::round(allegroAngle * static_cast<float>(c_AngleBucketCount) / 256.0F)) % c_AngleBucketCount;
+		if (angleBucket < 0) { angleBucket += c_AngleBucketCount; }
+		CacheKey key = { sprite, pivotX, pivotY, angleBucket, hFlipped };
+
+		{
+			std::lock_guard<std::mutex> cacheLock(s_CacheMutex);
+			if (auto entryLookupItr = s_EntryLookup.find(key); entryLookupItr != s_EntryLookup.end()) {
+				s_Entries.splice(s_Entries.begin(), s_Entries, entryLookupItr->second);
+				return entryLookupItr->second->RotatedSprite;
+			}
+		}
+
+		// Rotate outside of the lock so other threads drawing sprites that are already cached don't have to wait on this.
+		std::shared_ptr<BITMAP> rotatedSprite(CreateRotatedSprite(key), destroy_bitmap);
+		size_t memorySize = static_cast<size_t>(rotatedSprite->w) * static_cast<size_t>(rotatedSprite->h);
+		if (memorySize > s_MemoryBudget / 4) {
+			// Something this big would push out a large part of the cache every time it's rotated to a new angle, so don't bother caching it.
+			return nullptr;
+		}
+
+		std::lock_guard<std::mutex> cacheLock(s_CacheMutex);
+		// Another thread may have gotten to caching the same thing in the meantime.
+		if (auto entryLookupItr = s_EntryLookup.find(key); entryLookupItr != s_EntryLookup.end()) {
+			return entryLookupItr->second->RotatedSprite;
+		}
+		s_Entries.push_front({ key, rotatedSprite, memorySize });
+		s_EntryLookup.try_emplace(key, s_Entries.begin());
+		s_MemoryUsed += memorySize;
+		EvictToBudget();
+		return rotatedSprite;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void RotatedSpriteCache::Clear() {
+		std::lock_guard<std::mutex> cacheLock(s_CacheMutex);
+		s_EntryLookup.clear();
+		s_Entries.clear();
+		s_MemoryUsed = 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	BITMAP * RotatedSpriteCache::CreateRotatedSprite(const CacheKey &key) {
+		BITMAP *sprite = const_cast<BITMAP *>(key.Sprite);
+		int pivotX = key.PivotX;
+		BITMAP *flippedSprite = nullptr;
+		if (key.HFlipped) {
+			flippedSprite = create_bitmap_ex(8, sprite->w, sprite->h);
+			clear_to_color(flippedSprite, g_MaskColor);
+			draw_sprite_h_flip(flippedSprite, sprite, 0, 0);
+			sprite = flippedSprite;
+			pivotX = sprite->w - pivotX;
+		}
+
+		// Make the rotated bitmap big enough to hold the sprite at any angle around the pivot point, which will be at its center.
+		float maxCornerDistance = 0;
+		for (const auto &[cornerX, cornerY] : { std::make_pair(0, 0), std::make_pair(sprite->w, 0), std::make_pair(0, sprite->h), std::make_pair(sprite->w, sprite->h) }) {
+			maxCornerDistance = std::max(maxCornerDistance, std::hypot(static_cast<float>(cornerX - pivotX), static_cast<float>(cornerY - key.PivotY)));
+		}
+		int rotatedSize = 2 * static_cast<int>(std::ceil(maxCornerDistance)) + 2;
+
+		BITMAP *rotatedSprite = create_bitmap_ex(8, rotatedSize, rotatedSize);
+		clear_to_color(rotatedSprite, g_MaskColor);
+		pivot_sprite(rotatedSprite, sprite, rotatedSize / 2, rotatedSize / 2, pivotX, key.PivotY, ftofix(static_cast<float>(key.AngleBucket) * 256.0F / static_cast<float>(c_AngleBucketCount)));
+
+		if (flippedSprite) { destroy_bitmap(flippedSprite); }
+		return rotatedSprite;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void RotatedSpriteCache::EvictToBudget() {
+		while (s_MemoryUsed > s_MemoryBudget && !s_Entries.empty()) {
+			s_MemoryUsed -= s_Entries.back().MemorySize;
+			s_EntryLookup.erase(s_Entries.back().Key);
+			s_Entries.pop_back();
+		}
+	}
+}
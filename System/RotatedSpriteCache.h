@@ -0,0 +1,101 @@
+#ifndef _RTEROTATEDSPRITECACHE_
+#define _RTEROTATEDSPRITECACHE_
+
+struct BITMAP;
+
+namespace RTE {
+
+	/// <summary>
+	/// Static cache of pre-rotated copies of sprites at quantized angles, so rotated objects can be drawn with plain blits instead of rotating them every draw.
+	/// The least recently used copies are evicted once the cache exceeds its memory budget. Safe to use from multiple threads at once.
+	/// </summary>
+	class RotatedSpriteCache {
+
+	public:
+
+		static constexpr int c_AngleBucketCount = 128; //!< How many evenly spaced angles a full rotation is quantized to.
+
+#pragma region Getters and Setters
+		/// <summary>
+		/// Gets the memory budget of the cache, in megabytes.
+		/// </summary>
+		/// <returns>The memory budget of the cache in megabytes. 0 means the cache is disabled.</returns>
+		static int GetMemoryBudgetMB() { return static_cast<int>(s_MemoryBudget / (1024 * 1024)); }
+
+		/// <summary>
+		/// Sets the memory budget of the cache, in megabytes. Evicts cached sprites as needed to fit within it.
+		/// </summary>
+		/// <param name="memoryBudgetMB">The new memory budget in megabytes. 0 or less disables the cache.</param>
+		static void SetMemoryBudgetMB(int memoryBudgetMB);
+#pragma endregion
+
+#pragma region Concrete Methods
+		/// <summary>
+		/// Gets a copy of a sprite rotated to the nearest quantized angle around a pivot point, creating it if it isn't cached yet.
+		/// The pivot point ends up at the center of the returned bitmap, i.e. at (w / 2, h / 2). The rest of the returned bitmap is filled with the mask color.
+		/// </summary>
+		/// <param name="sprite">The 8 bit sprite to get a rotated copy of. Must stay alive for as long as the cache does, which is the case for all sprites loaded through ContentFile. Ownership is NOT transferred!</param>
+		/// <param name="pivotX">The X position of the pivot point on the sprite, before flipping.</param>
+		/// <param name="pivotY">The Y position of the pivot point on the sprite.</param>
+		/// <param name="allegroAngle">The angle to rotate to, in Allegro angle units where 256 is a full rotation.</param>
+		/// <param name="hFlipped">Whether the sprite should be horizontally flipped before rotating.</param>
+		/// <returns>The rotated copy of the sprite, or nullptr if the cache is disabled or the copy wouldn't fit in the budget. The copy stays valid while held even if it gets evicted.</returns>
+		static std::shared_ptr<BITMAP> GetRotatedSprite(BITMAP *sprite, int pivotX, int pivotY, float allegroAngle, bool hFlipped);
+
+		/// <summary>
+		/// Removes all cached sprites. Must be done before the sprites they were made from are destroyed.
+		/// </summary>
+		static void Clear();
+#pragma endregion
+
+	private:
+
+		/// <summary>
+		/// Identifies a cached rotated sprite.
+		/// </summary>
+		struct CacheKey {
+			const BITMAP *Sprite; //!< The sprite that was rotated.
+			int PivotX; //!< The X position of the pivot point on the sprite, before flipping.
+			int PivotY; //!< The Y position of the pivot point on the sprite.
+			int AngleBucket; //!< The quantized angle the sprite was rotated to.
+			bool HFlipped; //!< Whether the sprite was horizontally flipped before rotating.
+
+			bool operator==(const CacheKey &rhs) const { return Sprite == rhs.Sprite && PivotX == rhs.PivotX && PivotY == rhs.PivotY && AngleBucket == rhs.AngleBucket && HFlipped == rhs.HFlipped; }
+		};
+
+		/// <summary>
+		/// Hash function for CacheKeys.
+		/// </summary>
+		struct CacheKeyHash {
+			size_t operator()(const CacheKey &key) const;
+		};
+
+		/// <summary>
+		/// A cached rotated sprite.
+		/// </summary>
+		struct CacheEntry {
+			CacheKey Key; //!< The key this entry is stored under.
+			std::shared_ptr<BITMAP> RotatedSprite; //!< The rotated copy of the sprite.
+			size_t MemorySize; //!< How much memory the pixels of the rotated copy take up.
+		};
+
+		static std::list<CacheEntry> s_Entries; //!< All the cached rotated sprites, with the most recently used ones first.
+		static std::unordered_map<CacheKey, std::list<CacheEntry>::iterator, CacheKeyHash> s_EntryLookup; //!< The cached rotated sprites by their keys.
+		static size_t s_MemoryUsed; //!< How much memory the pixels of all the cached rotated sprites take up.
+		static size_t s_MemoryBudget; //!< How much memory the cached rotated sprites are allowed to take up. 0 means the cache is disabled.
+		static std::mutex s_CacheMutex; //!< Mutex guarding all of the above.
+
+		/// <summary>
+		/// Creates a copy of a sprite rotated around a pivot point, with the pivot point at the center of the copy.
+		/// </summary>
+		/// <param name="key">The key describing which sprite to rotate and how.</param>
+		/// <returns>The rotated copy of the sprite.</returns>
+		static BITMAP * CreateRotatedSprite(const CacheKey &key);
+
+		/// <summary>
+		/// Evicts the least recently used cached sprites until the cache fits within the memory budget. The cache mutex must be locked while calling this.
+		/// </summary>
+		static void EvictToBudget();
+	};
+}
+#endif
@@ -51,6 +51,10 @@
 #include <functional>
 #include <thread>
 #include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <future>
+#include <atomic>
 #include <cctype>
 #include <string>
 #include <cstring>
@@ -16,6 +16,7 @@ namespace RTE {
 	bool System::s_CaseSensitive = true;
 	const std::string System::s_ScreenshotDirectory = "_ScreenShots";
 	const std::string System::s_ModDirectory = "_Mods";
+	const std::string System::s_SceneCacheDirectory = "_SceneCache";
 	const std::string System::s_ModulePackageExtension = ".rte";
 	const std::string System::s_ZippedModulePackageExtension = ".rte.zip";
 	const std::unordered_set<std::string> System::s_SupportedExtensions = { ".ini", ".txt", ".lua", ".cfg", ".bmp", ".png", ".jpg", ".jpeg", ".wav", ".ogg", ".mp3", ".flac" };
@@ -55,6 +55,12 @@ namespace RTE {
 		/// <returns>Folder name of the mod directory.</returns>
 		static const std::string & GetModDirectory() { return s_ModDirectory; }
 
+		/// <summary>
+		/// Gets the scene cache directory name.
+		/// </summary>
+		/// <returns>Folder name of the scene cache directory.</returns>
+		static const std::string & GetSceneCacheDirectory() { return s_SceneCacheDirectory; }
+
 		/// <summary>
 		/// Gets the extension that determines a directory/file is an RTE module.
 		/// </summary>
@@ -156,6 +162,7 @@ namespace RTE {
 		static bool s_CaseSensitive; //!< Whether case sensitivity is enforced when checking for file existence.
 		static const std::string s_ScreenshotDirectory; //!< String containing the folder name of the screenshots directory.
 		static const std::string s_ModDirectory; //!< String containing the folder name of the mod directory.
+		static const std::string s_SceneCacheDirectory; //!< String containing the folder name of the processed scene layer cache directory.
 		static const std::string s_ModulePackageExtension; //!< The extension that determines a directory/file is a RTE module.
 		static const std::string s_ZippedModulePackageExtension; //!< The extension that determines a file is a zipped RTE module.
 